@@ -0,0 +1,118 @@
+// Call-site cost of LP_DLOG, printed as ns per call.
+//
+//   bench_dlog [calls]
+//
+// A record with three fields (two integers and a short string), timestamped
+// with CLOCK_MONOTONIC unless noted. "burst" logs runs that fit the ring
+// and drains between them, untimed: the cost a call site sees. "steady"
+// runs a consumer thread formatting and discarding lines while the
+// producer logs flat out, so most calls hit a full ring and are dropped.
+// "sync" formats the same line with lp_fmt and writes it with fprintf to
+// /dev/null, as lp_port_log does on the caller's thread.
+#include "lp/lp.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t mono_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static lp_dlog g_log;
+static lp_atomic_size g_stop;
+static volatile size_t g_lines;
+
+static void* consumer(void* arg) {
+  (void)arg;
+  char line[256];
+  size_t n = 0;
+  for (;;) {
+    bool stop = lp_port_atomic_load(&g_stop, LP_MO_ACQUIRE) != 0;
+    lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+    if (lp_dlog_next(&g_log, &fb)) {
+      n++;
+      continue;
+    }
+    if (stop) break;
+  }
+  g_lines = n;
+  return NULL;
+}
+
+static void run_dlog(const char* name, lp_dlog_clock_fn clock, size_t calls) {
+  static uint8_t mem[1u << 20];
+  lp_dlog_chan ch;
+  lp_dlog_init(&g_log, clock, LP_LOG_INFO);
+  if (lp_dlog_chan_init(&g_log, &ch, mem, sizeof mem) != LP_OK) abort();
+  lp_port_atomic_store(&g_stop, (size_t)0, LP_MO_RELAXED);
+  pthread_t th;
+  pthread_create(&th, NULL, consumer, NULL);
+
+  double t0 = now_s();
+  for (size_t i = 0; i < calls; i++) {
+    (void)LP_DLOG(&ch, LP_LOG_INFO, "req={} bytes={} peer={}", (uint64_t)i, (uint32_t)(i & 4095u), "10.0.0.1");
+  }
+  double t1 = now_s();
+  lp_port_atomic_store(&g_stop, (size_t)1, LP_MO_RELEASE);
+  pthread_join(th, NULL);
+  printf("%-22s %7.1f ns/call  (%zu dropped, %zu lines)\n", name, (t1 - t0) * 1e9 / (double)calls,
+         lp_dlog_dropped(&g_log), (size_t)g_lines);
+}
+
+static void run_burst(const char* name, lp_dlog_clock_fn clock, size_t calls) {
+  static uint8_t mem[1u << 20];
+  enum { BURST = 8192 }; // ~400 KiB of records
+  lp_dlog_chan ch;
+  lp_dlog_init(&g_log, clock, LP_LOG_INFO);
+  if (lp_dlog_chan_init(&g_log, &ch, mem, sizeof mem) != LP_OK) abort();
+  char line[256];
+  double total = 0;
+  size_t done = 0;
+  while (done < calls) {
+    double t0 = now_s();
+    for (size_t i = 0; i < BURST; i++) {
+      (void)LP_DLOG(&ch, LP_LOG_INFO, "req={} bytes={} peer={}", (uint64_t)(done + i), (uint32_t)(i & 4095u), "10.0.0.1");
+    }
+    total += now_s() - t0;
+    done += BURST;
+    lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+    while (lp_dlog_next(&g_log, &fb)) fb = lp_fmtbuf_make(line, sizeof line);
+  }
+  printf("%-22s %7.1f ns/call  (%zu dropped)\n", name, total * 1e9 / (double)done, lp_dlog_dropped(&g_log));
+}
+
+static void run_sync(size_t calls) {
+  FILE* f = fopen("/dev/null", "w");
+  if (!f) abort();
+  char line[256];
+  double t0 = now_s();
+  for (size_t i = 0; i < calls; i++) {
+    lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+    uint64_t ts = mono_ns();
+    lp_fmt_appendf(&fb, "{}.{:09} INF req={} bytes={} peer={}", ts / 1000000000u, ts % 1000000000u, (uint64_t)i,
+                   (uint32_t)(i & 4095u), "10.0.0.1");
+    fprintf(f, "%s\n", line);
+  }
+  double t1 = now_s();
+  fclose(f);
+  printf("%-22s %7.1f ns/call\n", "sync", (t1 - t0) * 1e9 / (double)calls);
+}
+
+int main(int argc, char** argv) {
+  size_t calls = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 10) : 2000000u;
+  if (calls == 0) calls = 1;
+  run_burst("burst", mono_ns, calls);
+  run_burst("burst (no clock)", NULL, calls);
+  run_dlog("steady", mono_ns, calls);
+  run_sync(calls);
+  return 0;
+}
@@ -0,0 +1,88 @@
+// Endian conversion throughput: array APIs vs a per-element loop vs memcpy.
+//
+//   bench_endian [big_mib]
+//
+// Runs each variant over a cache-resident buffer (16 KiB) and a large one
+// (default 64 MiB) and prints GB/s of input converted. On the large buffer
+// the array byte-swap should sit close to memcpy, i.e. at memory bandwidth.
+#include "lp/lp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+typedef enum {
+  V_MEMCPY,
+  V_LOOP_U32_BE,
+  V_N_U16_BE,
+  V_N_U32_BE,
+  V_N_U64_BE,
+  V_N_U32_LE,
+  V_COUNT
+} variant;
+
+static const char* const k_names[V_COUNT] = {
+  "memcpy", "loop lp_load_u32_be", "lp_load_u16_be_n", "lp_load_u32_be_n",
+  "lp_load_u64_be_n", "lp_load_u32_le_n",
+};
+
+static volatile uint64_t g_sink;
+
+static void run_once(variant v, void* dst, const uint8_t* src, size_t bytes) {
+  switch (v) {
+    case V_MEMCPY: memcpy(dst, src, bytes); break;
+    case V_LOOP_U32_BE: {
+      uint32_t* d = (uint32_t*)dst;
+      for (size_t i = 0; i < bytes / 4u; i++) d[i] = lp_load_u32_be(src + 4u * i);
+      break;
+    }
+    case V_N_U16_BE: lp_load_u16_be_n((uint16_t*)dst, src, bytes / 2u); break;
+    case V_N_U32_BE: lp_load_u32_be_n((uint32_t*)dst, src, bytes / 4u); break;
+    case V_N_U64_BE: lp_load_u64_be_n((uint64_t*)dst, src, bytes / 8u); break;
+    case V_N_U32_LE: lp_load_u32_le_n((uint32_t*)dst, src, bytes / 4u); break;
+    default: break;
+  }
+  g_sink += ((const uint8_t*)dst)[bytes / 2u];
+}
+
+static void bench_size(size_t bytes) {
+  uint8_t* src = (uint8_t*)malloc(bytes);
+  uint64_t* dst = (uint64_t*)malloc(bytes);
+  if (!src || !dst) {
+    fprintf(stderr, "out of memory\n");
+    exit(1);
+  }
+  for (size_t i = 0; i < bytes; i++) src[i] = (uint8_t)(i * 131u);
+  memset(dst, 0, bytes);
+
+  // ~1 GiB of traffic per variant, at least 3 passes
+  size_t reps = (size_t)(1u << 30) / bytes;
+  if (reps < 3u) reps = 3u;
+
+  printf("buffer %zu KiB\n", bytes / 1024u);
+  for (int v = 0; v < V_COUNT; v++) {
+    run_once((variant)v, dst, src, bytes); // warm up
+    double t0 = now_s();
+    for (size_t r = 0; r < reps; r++) run_once((variant)v, dst, src, bytes);
+    double dt = now_s() - t0;
+    printf("  %-22s %8.2f GB/s\n", k_names[v], (double)bytes * (double)reps / dt / 1e9);
+  }
+
+  free(src);
+  free(dst);
+}
+
+int main(int argc, char** argv) {
+  size_t big_mib = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 10) : 64u;
+  if (big_mib == 0) big_mib = 64u;
+
+  bench_size(16u * 1024u);
+  bench_size(big_mib * 1024u * 1024u);
+  return 0;
+}
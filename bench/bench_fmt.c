@@ -0,0 +1,209 @@
+// Formatting benchmarks, printed as ns per item.
+//
+//   bench_fmt [iterations]
+//
+// 1. Integers: lp_fmt_append_u64 vs snprintf vs the previous
+//    divide-per-digit + reverse + byte-copy implementation. Values are
+//    drawn so every digit count (1..20) is equally likely, which is closer
+//    to log/metrics traffic than uniform 64-bit values (almost all 19-20
+//    digits).
+// 2. Log lines: one line with six mixed fields via lp_fmt_appendf, a
+//    precompiled format, chained single-value appends, and snprintf.
+// 3. Floats: shortest round-trip and 2-place fixed output vs snprintf
+//    "%.17g" and "%.2f", over metric-like values and random exponents.
+#include "lp/lp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define NVALS 4096u
+
+static volatile size_t g_sink;
+
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+// The pre-table implementation, kept here as the baseline.
+static lp_status_t legacy_append_u64(lp_fmtbuf* fb, uint64_t v) {
+  char tmp[20];
+  size_t n = 0;
+  if (v == 0) return lp_fmt_append_char(fb, '0');
+  while (v != 0) {
+    uint64_t q = v / 10u;
+    tmp[n++] = (char)('0' + (char)(v - q * 10u));
+    v = q;
+  }
+  for (size_t i = 0; i < n / 2; i++) {
+    char t = tmp[i];
+    tmp[i] = tmp[n - 1 - i];
+    tmp[n - 1 - i] = t;
+  }
+  fb->truncated |= (n > lp_fmt_remaining(fb));
+  for (size_t i = 0; i < n && lp_fmt_remaining(fb); i++) fb->dst[fb->len++] = tmp[i];
+  fb->dst[fb->len] = '\0';
+  return LP_OK;
+}
+
+typedef enum { V_LP, V_LEGACY, V_SNPRINTF, V_COUNT } variant;
+static const char* const k_names[V_COUNT] = { "lp_fmt_append_u64", "legacy", "snprintf" };
+
+static void bench_integers(size_t iters) {
+  static uint64_t vals[NVALS];
+  for (size_t i = 0; i < NVALS; i++) {
+    uint64_t p = 1;
+    for (uint64_t d = rnd64() % 20u; d; d--) p *= 10u;
+    vals[i] = p + rnd64() % (p * 9u);
+  }
+
+  char line[4096];
+  for (int v = 0; v < V_COUNT; v++) {
+    double t0 = now_s();
+    for (size_t it = 0; it < iters; it++) {
+      // ~100 numbers per line, like a wide metrics record
+      lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+      for (size_t i = 0; i < NVALS; i++) {
+        if ((i & 127u) == 0) fb = lp_fmtbuf_make(line, sizeof line);
+        switch (v) {
+          case V_LP: lp_fmt_append_u64(&fb, vals[i]); break;
+          case V_LEGACY: legacy_append_u64(&fb, vals[i]); break;
+          default: {
+            int n = snprintf(fb.dst + fb.len, sizeof line - fb.len, "%llu", (unsigned long long)vals[i]);
+            if (n > 0) fb.len += (size_t)n;
+            break;
+          }
+        }
+        g_sink += fb.len;
+      }
+    }
+    double dt = now_s() - t0;
+    printf("%-22s %6.2f ns/number\n", k_names[v], dt * 1e9 / ((double)iters * NVALS));
+  }
+}
+
+typedef enum { L_APPENDF, L_COMPILED, L_CHAINED, L_SNPRINTF, L_COUNT } line_variant;
+static const char* const k_line_names[L_COUNT] = {
+  "lp_fmt_appendf", "lp_fmt_appendcf", "chained appends", "snprintf",
+};
+
+#define LINE_FMT "ts={} lvl={:-5} mod={} seq={:08} addr={:#x} bytes={}"
+
+static void bench_log_lines(size_t iters) {
+  static const char* const levels[4] = { "DEBUG", "INFO", "WARN", "ERROR" };
+  static const char* const mods[4] = { "net", "storage", "sched", "ui" };
+
+  lp_fmt_spec specs[16];
+  lp_fmt_compiled compiled;
+  if (lp_fmt_compile(&compiled, LINE_FMT, specs, 16) != LP_OK) {
+    fprintf(stderr, "compile failed\n");
+    exit(1);
+  }
+
+  size_t lines = iters * 256u;
+  char line[256];
+  for (int v = 0; v < L_COUNT; v++) {
+    double t0 = now_s();
+    for (size_t i = 0; i < lines; i++) {
+      uint64_t ts = 1700000000000000000ull + i * 7919u;
+      const char* lvl = levels[i & 3u];
+      const char* mod = mods[(i >> 2) & 3u];
+      uint32_t seq = (uint32_t)i;
+      uint32_t addr = (uint32_t)(i * 2654435761u);
+      int32_t bytes = (int32_t)(i % 65536u) - 1024;
+      lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+
+      switch (v) {
+        case L_APPENDF:
+          lp_fmt_appendf(&fb, LINE_FMT, ts, lvl, mod, seq, addr, bytes);
+          break;
+        case L_COMPILED:
+          lp_fmt_appendcf(&fb, &compiled, ts, lvl, mod, seq, addr, bytes);
+          break;
+        case L_CHAINED:
+          // no padding/minimal hex available here, so slightly less work
+          lp_fmt_append_cstr(&fb, "ts=");
+          lp_fmt_append_u64(&fb, ts);
+          lp_fmt_append_cstr(&fb, " lvl=");
+          lp_fmt_append_cstr(&fb, lvl);
+          lp_fmt_append_cstr(&fb, " mod=");
+          lp_fmt_append_cstr(&fb, mod);
+          lp_fmt_append_cstr(&fb, " seq=");
+          lp_fmt_append_u32(&fb, seq);
+          lp_fmt_append_cstr(&fb, " addr=0x");
+          lp_fmt_append_hex_u32(&fb, addr, false);
+          lp_fmt_append_cstr(&fb, " bytes=");
+          lp_fmt_append_i32(&fb, bytes);
+          break;
+        default: {
+          int n = snprintf(line, sizeof line, "ts=%llu lvl=%-5s mod=%s seq=%08u addr=%#x bytes=%d",
+                           (unsigned long long)ts, lvl, mod, (unsigned)seq, (unsigned)addr, (int)bytes);
+          if (n > 0) fb.len = (size_t)n;
+          break;
+        }
+      }
+      g_sink += fb.len;
+    }
+    double dt = now_s() - t0;
+    printf("%-22s %6.1f ns/line\n", k_line_names[v], dt * 1e9 / (double)lines);
+  }
+}
+
+typedef enum { F_SHORTEST, F_SNPRINTF_17G, F_FIXED2, F_SNPRINTF_2F, F_COUNT } float_variant;
+static const char* const k_float_names[F_COUNT] = {
+  "lp_fmt_append_f64", "snprintf %.17g", "lp_fmt_append_f64_fixed", "snprintf %.2f",
+};
+
+static void bench_floats(size_t iters) {
+  static double vals[NVALS];
+  for (size_t i = 0; i < NVALS; i++) {
+    // mix of metric-like magnitudes and arbitrary bit patterns
+    if (i & 1u) {
+      vals[i] = (double)(rnd64() % 10000000u) / 1000.0;
+    } else {
+      uint64_t bits = rnd64() & ~(0x7FFull << 52);
+      bits |= (uint64_t)(900u + rnd64() % 250u) << 52;
+      memcpy(&vals[i], &bits, sizeof vals[i]);
+    }
+  }
+
+  char buf[192];
+  for (int v = 0; v < F_COUNT; v++) {
+    double t0 = now_s();
+    for (size_t it = 0; it < iters; it++) {
+      for (size_t i = 0; i < NVALS; i++) {
+        lp_fmtbuf fb = lp_fmtbuf_make(buf, sizeof buf);
+        switch (v) {
+          case F_SHORTEST: lp_fmt_append_f64(&fb, vals[i]); break;
+          case F_SNPRINTF_17G: fb.len = (size_t)snprintf(buf, sizeof buf, "%.17g", vals[i]); break;
+          case F_FIXED2: lp_fmt_append_f64_fixed(&fb, vals[i], 2); break;
+          default: fb.len = (size_t)snprintf(buf, sizeof buf, "%.2f", vals[i]); break;
+        }
+        g_sink += fb.len;
+      }
+    }
+    double dt = now_s() - t0;
+    printf("%-24s %6.1f ns/value\n", k_float_names[v], dt * 1e9 / (double)(iters * NVALS));
+  }
+}
+
+int main(int argc, char** argv) {
+  size_t iters = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 10) : 2000u;
+  if (iters == 0) iters = 2000u;
+
+  bench_integers(iters);
+  bench_log_lines(iters);
+  bench_floats(iters / 8u + 1u);
+  return 0;
+}
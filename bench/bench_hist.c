@@ -0,0 +1,67 @@
+// lp_hist_record cost and percentile accuracy against sorting the raw
+// samples, printed as ns per record.
+//
+//   bench_hist [samples]
+//
+// Samples are log-uniform over 100 ns .. ~100 ms, as latencies tend to be.
+#include "lp/lp.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static double secs(uint64_t ns) { return (double)ns * 1e-9; }
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+static int cmp_u64(const void* a, const void* b) {
+  uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+  return (x > y) - (x < y);
+}
+
+static uint64_t g_counts[4352];
+
+int main(int argc, char** argv) {
+  size_t n = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 10) : 10000000u;
+  if (n == 0) n = 1;
+  uint64_t* samples = malloc(n * sizeof *samples);
+  if (!samples) return 1;
+  for (size_t i = 0; i < n; i++) {
+    uint64_t v = 100u << (rnd64() % 20u);
+    samples[i] = v + rnd64() % v;
+  }
+
+  lp_hist h;
+  if (lp_hist_init(&h, g_counts, 4352, 7, 40) != LP_OK) abort();
+  uint64_t t0 = lp_port_now_ns();
+  for (size_t i = 0; i < n; i++) lp_hist_record(&h, samples[i]);
+  double rec = secs(lp_port_now_ns() - t0) * 1e9 / (double)n;
+
+  static const double ps[] = { 50.0, 90.0, 99.0, 99.9 };
+  uint64_t got[4];
+  t0 = lp_port_now_ns();
+  lp_hist_percentiles(&h, ps, got, 4);
+  double query = secs(lp_port_now_ns() - t0) * 1e9;
+
+  t0 = lp_port_now_ns();
+  qsort(samples, n, sizeof *samples, cmp_u64);
+  double sort = secs(lp_port_now_ns() - t0) * 1e9 / (double)n;
+
+  printf("%-16s %6.1f ns/record\n", "lp_hist_record", rec);
+  printf("%-16s %6.1f ns/sample\n", "qsort", sort);
+  printf("%-16s %6.0f ns (4 percentiles)\n", "lp_hist query", query);
+  for (int k = 0; k < 4; k++) {
+    size_t rank = (size_t)((double)n * ps[k] / 100.0);
+    uint64_t want = samples[rank ? rank - 1u : 0u];
+    printf("p%-6g hist %12llu  exact %12llu  err %+.3f%%\n", ps[k], (unsigned long long)got[k],
+           (unsigned long long)want, ((double)got[k] - (double)want) * 100.0 / (double)want);
+  }
+  printf("encoded %zu bytes vs %zu bytes of counters\n", lp_hist_encoded_len(&h), sizeof g_counts);
+  free(samples);
+  return 0;
+}
@@ -0,0 +1,124 @@
+// lp_map lookups and inserts, printed as ns per operation.
+//
+//   bench_map [entries]
+//
+// u64 keys with 8-byte values, against a chained table with one malloc'd
+// node per entry (the usual hand-rolled map). Lookups visit keys in random
+// order, half of them absent; "insert" builds the map from empty with
+// capacity reserved up front.
+#include "lp/lp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static volatile uint64_t g_sink;
+
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+typedef struct node {
+  struct node* next;
+  uint64_t     key;
+  uint64_t     val;
+} node;
+
+typedef struct {
+  node** heads;
+  size_t mask;
+} chained;
+
+static void chained_put(chained* c, uint64_t key, uint64_t val) {
+  node** h = &c->heads[lp_hash_u64(key, 0) & c->mask];
+  node* n = (node*)malloc(sizeof *n);
+  if (!n) abort();
+  n->key = key;
+  n->val = val;
+  n->next = *h;
+  *h = n;
+}
+
+static const uint64_t* chained_get(const chained* c, uint64_t key) {
+  for (const node* n = c->heads[lp_hash_u64(key, 0) & c->mask]; n; n = n->next) {
+    if (n->key == key) return &n->val;
+  }
+  return NULL;
+}
+
+static void chained_free(chained* c) {
+  for (size_t i = 0; i <= c->mask; i++) {
+    node* n = c->heads[i];
+    while (n) {
+      node* next = n->next;
+      free(n);
+      n = next;
+    }
+  }
+  free(c->heads);
+}
+
+int main(int argc, char** argv) {
+  size_t max = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 10) : (1u << 20);
+  if (max < 1024u) max = 1024u;
+
+  printf("%-10s %12s %12s %12s %12s\n", "entries", "map_get", "chained_get", "map_insert", "chained_ins");
+  for (size_t n = 1024u; n <= max; n *= 16u) {
+    uint64_t* keys = (uint64_t*)malloc(2u * n * sizeof(uint64_t));
+    size_t bytes = lp_map_mem_size(LP_MAP_KEY_U64, sizeof(uint64_t), n);
+    void* mem = malloc(bytes);
+    chained c = { (node**)calloc(n, sizeof(node*)), n - 1u }; // n is a power of two
+    if (!keys || !mem || !c.heads) return 1;
+    for (size_t i = 0; i < 2u * n; i++) keys[i] = rnd64();
+
+    lp_map m;
+    double t0 = now_s();
+    if (lp_map_init(&m, LP_MAP_KEY_U64, sizeof(uint64_t), mem, bytes) != LP_OK) return 1;
+    for (size_t i = 0; i < n; i++) lp_map_put_u64(&m, keys[i], &keys[i]);
+    double t_map_ins = now_s() - t0;
+    t0 = now_s();
+    for (size_t i = 0; i < n; i++) chained_put(&c, keys[i], keys[i]);
+    double t_ch_ins = now_s() - t0;
+
+    // probe order: random mix of the n present and n absent keys
+    size_t probes = (n < (1u << 22)) ? (1u << 22) : n;
+    size_t* order = (size_t*)malloc(probes * sizeof(size_t));
+    if (!order) return 1;
+    for (size_t i = 0; i < probes; i++) order[i] = (size_t)(rnd64() % (2u * n));
+
+    uint64_t acc = 0;
+    t0 = now_s();
+    for (size_t i = 0; i < probes; i++) {
+      const uint64_t* v = (const uint64_t*)lp_map_get_u64(&m, keys[order[i]]);
+      acc += v ? *v : 1u;
+    }
+    double t_map = now_s() - t0;
+    t0 = now_s();
+    for (size_t i = 0; i < probes; i++) {
+      const uint64_t* v = chained_get(&c, keys[order[i]]);
+      acc += v ? *v : 1u;
+    }
+    double t_ch = now_s() - t0;
+    g_sink = acc;
+
+    printf("%-10zu %9.1f ns %9.1f ns %9.1f ns %9.1f ns\n", n, t_map * 1e9 / (double)probes,
+           t_ch * 1e9 / (double)probes, t_map_ins * 1e9 / (double)n, t_ch_ins * 1e9 / (double)n);
+
+    chained_free(&c);
+    free(order);
+    free(mem);
+    free(keys);
+  }
+  return 0;
+}
@@ -0,0 +1,120 @@
+// Contention benchmark: lp_mpmc_queue vs a mutex-wrapped lp_ring.
+//
+//   bench_mpmc [max_threads] [items_per_producer]
+//
+// For k = 1..max_threads runs k producers and k consumers moving 8-byte
+// items and prints total ops/sec (one op = one push or one pop).
+#include "lp/lp.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define QUEUE_CAP 1024u
+
+typedef struct {
+  lp_mpmc_queue   mpmc;
+  lp_ring         ring;
+  pthread_mutex_t lock;
+  uint64_t        items;
+} bench_ctx;
+
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void* mpmc_producer(void* arg) {
+  bench_ctx* c = (bench_ctx*)arg;
+  for (uint64_t i = 0; i < c->items; i++) {
+    while (lp_mpmc_queue_push(&c->mpmc, &i) != LP_OK) sched_yield();
+  }
+  return NULL;
+}
+
+static void* mpmc_consumer(void* arg) {
+  bench_ctx* c = (bench_ctx*)arg;
+  uint64_t v;
+  for (uint64_t i = 0; i < c->items; i++) {
+    while (lp_mpmc_queue_pop(&c->mpmc, &v) != LP_OK) sched_yield();
+  }
+  return NULL;
+}
+
+static void* ring_producer(void* arg) {
+  bench_ctx* c = (bench_ctx*)arg;
+  for (uint64_t i = 0; i < c->items; i++) {
+    for (;;) {
+      pthread_mutex_lock(&c->lock);
+      lp_status_t st = lp_ring_push(&c->ring, &i, sizeof(i));
+      pthread_mutex_unlock(&c->lock);
+      if (st == LP_OK) break;
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static void* ring_consumer(void* arg) {
+  bench_ctx* c = (bench_ctx*)arg;
+  uint64_t v;
+  for (uint64_t i = 0; i < c->items; i++) {
+    for (;;) {
+      pthread_mutex_lock(&c->lock);
+      lp_status_t st = lp_ring_pop(&c->ring, &v, sizeof(v));
+      pthread_mutex_unlock(&c->lock);
+      if (st == LP_OK) break;
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static double run(bench_ctx* c, int k, void* (*prod)(void*), void* (*cons)(void*)) {
+  pthread_t* th = (pthread_t*)malloc(sizeof(pthread_t) * (size_t)(2 * k));
+  if (!th) return 0.0;
+
+  double t0 = now_s();
+  for (int i = 0; i < k; i++) {
+    pthread_create(&th[i], NULL, prod, c);
+    pthread_create(&th[k + i], NULL, cons, c);
+  }
+  for (int i = 0; i < 2 * k; i++) pthread_join(th[i], NULL);
+  double dt = now_s() - t0;
+
+  free(th);
+  return (double)(2u * (uint64_t)k * c->items) / dt;
+}
+
+int main(int argc, char** argv) {
+  int max_threads = (argc > 1) ? atoi(argv[1]) : 4;
+  uint64_t items = (argc > 2) ? strtoull(argv[2], NULL, 10) : 200000u;
+  if (max_threads < 1) max_threads = 1;
+
+  static bench_ctx c;
+  static uint64_t ring_mem[QUEUE_CAP];
+  size_t need = 0;
+  if (lp_mpmc_queue_mem_size(QUEUE_CAP, sizeof(uint64_t), &need) != LP_OK) return 1;
+  size_t* mpmc_mem = (size_t*)malloc(need);
+  if (!mpmc_mem) return 1;
+
+  pthread_mutex_init(&c.lock, NULL);
+  c.items = items;
+
+  printf("%-8s %16s %16s %8s\n", "threads", "mpmc ops/s", "mutex+ring ops/s", "speedup");
+  for (int k = 1; k <= max_threads; k++) {
+    lp_mpmc_queue_init(&c.mpmc, mpmc_mem, need, QUEUE_CAP, sizeof(uint64_t));
+    double a = run(&c, k, mpmc_producer, mpmc_consumer);
+
+    lp_ring_init(&c.ring, ring_mem, sizeof(ring_mem));
+    double b = run(&c, k, ring_producer, ring_consumer);
+
+    printf("%dP/%dC    %16.0f %16.0f %7.2fx\n", k, k, a, b, (b > 0.0) ? a / b : 0.0);
+  }
+
+  pthread_mutex_destroy(&c.lock);
+  free(mpmc_mem);
+  return 0;
+}
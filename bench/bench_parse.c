@@ -0,0 +1,121 @@
+// Number parsing benchmarks, printed as ns per number.
+//
+//   bench_parse [iterations]
+//
+// Tokens are packed back to back in one buffer (space separated), so the
+// lp_parse_* calls see length-bounded views while strtoull/strtod get the
+// NUL-terminated copy they need, the way config/protocol code has to do it.
+// 1. Integers with 1..20 digits, equally likely.
+// 2. Doubles: shortest round-trip text of random values, plus metric-like
+//    "1234.567" values.
+#include "lp/lp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define NVALS 4096u
+
+static volatile uint64_t g_sink;
+
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+typedef struct {
+  char   text[NVALS * 28u];
+  size_t off[NVALS];
+  size_t len[NVALS];
+} corpus;
+
+static corpus g_ints, g_floats;
+
+static void add_token(corpus* c, size_t* pos, size_t i, const char* s, size_t n) {
+  memcpy(c->text + *pos, s, n);
+  c->off[i] = *pos;
+  c->len[i] = n;
+  *pos += n;
+  c->text[(*pos)++] = ' ';
+}
+
+static void build_corpora(void) {
+  size_t pi = 0, pf = 0;
+  char buf[64];
+  for (size_t i = 0; i < NVALS; i++) {
+    uint32_t digits = 1u + (uint32_t)(rnd64() % 20u);
+    uint64_t v = rnd64();
+    uint64_t lim = 1;
+    for (uint32_t d = 1; d < digits && lim <= UINT64_MAX / 10u; d++) lim *= 10u;
+    if (digits < 20u) v %= lim * 10u;
+    lp_fmtbuf fb = lp_fmtbuf_make(buf, sizeof buf);
+    lp_fmt_append_u64(&fb, v);
+    add_token(&g_ints, &pi, i, buf, fb.len);
+
+    double d;
+    if (i & 1u) {
+      d = (double)(rnd64() % 100000000u) / 1000.0;
+    } else {
+      uint64_t bits = rnd64() & ~(0x7FFull << 52);
+      bits |= (uint64_t)(900u + rnd64() % 250u) << 52;
+      memcpy(&d, &bits, sizeof d);
+    }
+    fb = lp_fmtbuf_make(buf, sizeof buf);
+    lp_fmt_append_f64(&fb, d);
+    add_token(&g_floats, &pf, i, buf, fb.len);
+  }
+}
+
+typedef enum { V_LP, V_LIBC, V_COUNT } variant;
+
+static void bench(const char* name, const char* libc_name, const corpus* c, bool is_float, size_t iters) {
+  char tmp[64];
+  for (int v = 0; v < V_COUNT; v++) {
+    double t0 = now_s();
+    for (size_t it = 0; it < iters; it++) {
+      for (size_t i = 0; i < NVALS; i++) {
+        const char* s = c->text + c->off[i];
+        size_t n = c->len[i];
+        if (v == V_LP) {
+          lp_strview sv = { .ptr = s, .len = n };
+          if (is_float) {
+            double d = 0.0;
+            lp_parse_f64(sv, &d, NULL);
+            g_sink += (uint64_t)(d != 0.0);
+          } else {
+            uint64_t x = 0;
+            lp_parse_u64(sv, &x, NULL);
+            g_sink += x;
+          }
+        } else {
+          memcpy(tmp, s, n);
+          tmp[n] = '\0';
+          if (is_float) g_sink += (uint64_t)(strtod(tmp, NULL) != 0.0);
+          else g_sink += strtoull(tmp, NULL, 10);
+        }
+      }
+    }
+    double dt = now_s() - t0;
+    printf("%-20s %6.1f ns/number\n", v == V_LP ? name : libc_name, dt * 1e9 / (double)(iters * NVALS));
+  }
+}
+
+int main(int argc, char** argv) {
+  size_t iters = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 10) : 1000u;
+  if (iters == 0) iters = 1000u;
+
+  build_corpora();
+  bench("lp_parse_u64", "copy + strtoull", &g_ints, false, iters);
+  bench("lp_parse_f64", "copy + strtod", &g_floats, true, iters);
+  return 0;
+}
@@ -0,0 +1,65 @@
+// Cost of an LP_PROF_BEGIN/END pair and of the port clocks, printed as ns
+// per call.
+//
+//   bench_prof [iters]
+//
+// "probe" wraps an lp_spsc_ring push + pop of 32 bytes; "bare" is the same
+// loop without it, so the difference is the probe's cost. Built with
+// LP_CFG_ENABLE_PROF=1.
+#include "lp/lp.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static double secs(uint64_t ns) { return (double)ns * 1e-9; }
+
+static uint8_t g_mem[4096];
+static uint8_t g_rec[32];
+
+static double run(size_t iters, bool probe) {
+  lp_spsc_ring r;
+  if (lp_spsc_ring_init(&r, g_mem, sizeof g_mem) != LP_OK) abort();
+  uint64_t t0 = lp_port_now_ns();
+  for (size_t i = 0; i < iters; i++) {
+    g_rec[0] = (uint8_t)i;
+    if (probe) {
+      LP_PROF_BEGIN(ring_push_pop);
+      (void)lp_spsc_ring_push(&r, g_rec, sizeof g_rec);
+      (void)lp_spsc_ring_pop(&r, g_rec, sizeof g_rec);
+      LP_PROF_END(ring_push_pop);
+    } else {
+      (void)lp_spsc_ring_push(&r, g_rec, sizeof g_rec);
+      (void)lp_spsc_ring_pop(&r, g_rec, sizeof g_rec);
+    }
+  }
+  return secs(lp_port_now_ns() - t0) * 1e9 / (double)iters;
+}
+
+int main(int argc, char** argv) {
+  size_t iters = (argc > 1) ? (size_t)strtoull(argv[1], NULL, 10) : 10000000u;
+  if (iters == 0) iters = 1;
+
+  volatile uint64_t sink = 0;
+  uint64_t t0 = lp_port_now_ns();
+  for (size_t i = 0; i < iters; i++) sink += lp_port_cycles();
+  printf("%-16s %6.1f ns/call\n", "lp_port_cycles", secs(lp_port_now_ns() - t0) * 1e9 / (double)iters);
+  t0 = lp_port_now_ns();
+  for (size_t i = 0; i < iters; i++) sink += lp_port_now_ns();
+  printf("%-16s %6.1f ns/call\n", "lp_port_now_ns", secs(lp_port_now_ns() - t0) * 1e9 / (double)iters);
+  (void)sink;
+
+  (void)run(iters / 10u + 1u, true); // registration and warm-up
+  double bare = run(iters, false);
+  double probed = run(iters, true);
+  printf("%-16s %6.1f ns/iter\n", "bare", bare);
+  printf("%-16s %6.1f ns/iter  (probe: %.1f ns)\n", "probe", probed, probed - bare);
+
+  lp_prof_stat st[4];
+  size_t n = lp_prof_snapshot(st, 4);
+  uint64_t hz = lp_port_cycles_per_sec();
+  for (size_t i = 0; i < n; i++) {
+    printf("%-16s %llu calls, %.1f ns avg, %.0f ns max  (%llu cycles/s)\n", st[i].name,
+           (unsigned long long)st[i].calls, (double)st[i].cycles * 1e9 / (double)hz / (double)st[i].calls,
+           (double)st[i].max_cycles * 1e9 / (double)hz, (unsigned long long)hz);
+  }
+  return 0;
+}
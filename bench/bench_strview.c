@@ -0,0 +1,168 @@
+// lp_strview search benchmarks, printed as GB/s or ns per call.
+//
+//   bench_strview [iterations]
+//
+// 1. find_char vs memchr, match in the last byte, over several lengths.
+// 2. find vs memmem, needle at the end of English-like text.
+// 3. find_any vs strcspn (needs a NUL) on a 4 KiB buffer.
+// 4. Tokenizing request lines: lp_sv_split vs a byte loop.
+// 5. eq_ci vs strncasecmp on header names.
+#define _GNU_SOURCE
+#include "lp/lp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+static volatile size_t g_sink;
+
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+#define BUF_LEN 65536u
+static char g_text[BUF_LEN + 1];
+
+static void fill_text(void) {
+  static const char* const words[] = { "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "and", "runs" };
+  size_t n = 0;
+  while (n < BUF_LEN) {
+    const char* w = words[rnd64() % 10u];
+    while (*w && n < BUF_LEN) g_text[n++] = *w++;
+    if (n < BUF_LEN) g_text[n++] = ' ';
+  }
+  g_text[BUF_LEN] = '\0';
+}
+
+static void bench_find_char(size_t iters) {
+  static const size_t lens[] = { 8, 32, 256, 4096, 65536 };
+  printf("find_char (match at end)     lp_sv_find_char     memchr\n");
+  for (size_t li = 0; li < sizeof lens / sizeof lens[0]; li++) {
+    size_t n = lens[li];
+    static char buf[BUF_LEN];
+    memset(buf, 'a', n);
+    buf[n - 1] = '!';
+    size_t reps = iters * (BUF_LEN * 4u / n + 1u);
+    double r[2];
+    for (int v = 0; v < 2; v++) {
+      double t0 = now_s();
+      for (size_t i = 0; i < reps; i++) {
+        if (v == 0) g_sink += lp_sv_find_char(lp_sv_n(buf, n), '!');
+        else g_sink += (size_t)((const char*)memchr(buf, '!', n) - buf);
+      }
+      double dt = now_s() - t0;
+      r[v] = dt * 1e9 / (double)reps;
+    }
+    printf("  %6zu bytes           %9.1f ns %9.1f ns\n", n, r[0], r[1]);
+  }
+}
+
+static void bench_find(size_t iters) {
+  static const char* const needles[] = { "zq", "zebra", "zebra crossing!!" };
+  printf("find (needle at end, 64 KiB) lp_sv_find          memmem\n");
+  for (size_t ni = 0; ni < 3; ni++) {
+    size_t m = strlen(needles[ni]);
+    memcpy(g_text + BUF_LEN - m, needles[ni], m);
+    double r[2];
+    for (int v = 0; v < 2; v++) {
+      double t0 = now_s();
+      for (size_t i = 0; i < iters; i++) {
+        if (v == 0) g_sink += lp_sv_find(lp_sv_n(g_text, BUF_LEN), lp_sv(needles[ni]));
+        else g_sink += (size_t)((const char*)memmem(g_text, BUF_LEN, needles[ni], m) - g_text);
+      }
+      r[v] = (double)BUF_LEN * (double)iters / (now_s() - t0) / 1e9;
+    }
+    printf("  needle %-20s %6.2f GB/s %8.2f GB/s\n", needles[ni], r[0], r[1]);
+    memset(g_text + BUF_LEN - m, ' ', m);
+  }
+}
+
+static void bench_find_any(size_t iters) {
+  char buf[4097];
+  for (size_t i = 0; i < 4096; i++) buf[i] = (char)('a' + rnd64() % 26u);
+  buf[4095] = '&';
+  buf[4096] = '\0';
+  lp_sv_charset cs;
+  lp_sv_charset_init(&cs, lp_sv("=;,&"));
+  size_t reps = iters * 16u;
+  double r[2];
+  for (int v = 0; v < 2; v++) {
+    double t0 = now_s();
+    for (size_t i = 0; i < reps; i++) {
+      if (v == 0) g_sink += lp_sv_find_any(lp_sv_n(buf, 4096), &cs);
+      else g_sink += strcspn(buf, "=;,&");
+    }
+    r[v] = 4096.0 * (double)reps / (now_s() - t0) / 1e9;
+  }
+  printf("find_any (4 KiB, 4 chars)    %6.2f GB/s   strcspn %6.2f GB/s\n", r[0], r[1]);
+}
+
+static void bench_split(size_t iters) {
+  static const char line[] = "GET /api/v1/items?id=42&sort=name HTTP/1.1";
+  lp_strview sv = lp_sv(line);
+  size_t reps = iters * 4096u;
+  double r[2];
+  for (int v = 0; v < 2; v++) {
+    double t0 = now_s();
+    for (size_t i = 0; i < reps; i++) {
+      if (v == 0) {
+        lp_sv_split it = lp_sv_split_on(sv, ' ', 0);
+        lp_strview tok;
+        while (lp_sv_split_next(&it, &tok)) g_sink += tok.len;
+      } else {
+        size_t start = 0;
+        for (size_t j = 0; j <= sv.len; j++) {
+          if (j == sv.len || sv.ptr[j] == ' ') {
+            g_sink += j - start;
+            start = j + 1u;
+          }
+        }
+      }
+    }
+    r[v] = (now_s() - t0) * 1e9 / (double)reps;
+  }
+  printf("split request line           %6.1f ns/line  byte loop %6.1f ns/line\n", r[0], r[1]);
+}
+
+static void bench_eq_ci(size_t iters) {
+  static const char* const names[] = { "Content-Length", "content-type", "X-Request-Id", "ACCEPT-ENCODING" };
+  static const char* const keys[] = { "content-length", "Content-Type", "x-request-id", "accept-encoding" };
+  size_t reps = iters * 4096u;
+  double r[2];
+  for (int v = 0; v < 2; v++) {
+    double t0 = now_s();
+    for (size_t i = 0; i < reps; i++) {
+      const char* a = names[i & 3u];
+      const char* b = keys[i & 3u];
+      if (v == 0) g_sink += lp_sv_eq_ci(lp_sv(a), lp_sv(b));
+      else g_sink += (strlen(a) == strlen(b) && strncasecmp(a, b, strlen(a)) == 0);
+    }
+    r[v] = (now_s() - t0) * 1e9 / (double)reps;
+  }
+  printf("eq_ci header names           %6.1f ns/call  strncasecmp %6.1f ns/call\n", r[0], r[1]);
+}
+
+int main(int argc, char** argv) {
+  size_t iters = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 10) : 2000u;
+  if (iters == 0) iters = 2000u;
+
+  fill_text();
+  bench_find_char(iters / 20u + 1u);
+  bench_find(iters);
+  bench_find_any(iters);
+  bench_split(iters);
+  bench_eq_ci(iters);
+  return 0;
+}
@@ -0,0 +1,105 @@
+// UTF-8 validation and counting benchmarks, printed as GB/s.
+//
+//   bench_utf8 [iterations]
+//
+// Three 64 KiB corpora: pure ASCII, Latin text with ~10% two-byte
+// characters, and mixed CJK/emoji text. lp_utf8_validate and lp_utf8_count
+// run against a byte-at-a-time decoder of the kind most code carries.
+#include "lp/lp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BUF_LEN 65536u
+
+static volatile size_t g_sink;
+
+static double now_s(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+static size_t fill(uint8_t* buf, int kind) {
+  static const char* const latin[] = { "\xC3\xA9", "\xC3\xB6", "\xC3\xA7", "\xC3\x9F" };
+  static const char* const wide[] = { "\xE4\xB8\xAD", "\xE6\x96\x87", "\xF0\x9F\x98\x80", "\xE2\x82\xAC" };
+  size_t n = 0;
+  while (n + 4u <= BUF_LEN) {
+    uint64_t r = rnd64();
+    const char* s = NULL;
+    if (kind == 1 && r % 10u == 0) s = latin[(r >> 8) & 3u];
+    if (kind == 2 && r % 2u == 0) s = wide[(r >> 8) & 3u];
+    if (s) {
+      size_t m = strlen(s);
+      memcpy(buf + n, s, m);
+      n += m;
+    } else {
+      buf[n++] = (uint8_t)('a' + (r >> 16) % 26u);
+    }
+  }
+  return n;
+}
+
+// Decodes one sequence per step; same acceptance rules as lp_utf8.
+static bool naive_valid(const uint8_t* p, size_t n) {
+  size_t i = 0;
+  while (i < n) {
+    uint8_t b = p[i];
+    if (b < 0x80u) { i++; continue; }
+    size_t len = (b >= 0xF0u) ? 4u : (b >= 0xE0u) ? 3u : 2u;
+    if (b < 0xC2u || b > 0xF4u || n - i < len) return false;
+    uint32_t cp = b & (0x7Fu >> len);
+    for (size_t k = 1; k < len; k++) {
+      if ((p[i + k] & 0xC0u) != 0x80u) return false;
+      cp = (cp << 6) | (p[i + k] & 0x3Fu);
+    }
+    if ((len == 3 && cp < 0x800u) || (len == 4 && cp < 0x10000u) || cp > 0x10FFFFu) return false;
+    if (cp >= 0xD800u && cp <= 0xDFFFu) return false;
+    i += len;
+  }
+  return true;
+}
+
+static size_t naive_count(const uint8_t* p, size_t n) {
+  size_t c = 0;
+  for (size_t i = 0; i < n; i++) c += ((p[i] & 0xC0u) != 0x80u);
+  return c;
+}
+
+int main(int argc, char** argv) {
+  size_t iters = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 10) : 2000u;
+  if (iters == 0) iters = 2000u;
+
+  static uint8_t buf[BUF_LEN];
+  static const char* const names[] = { "ascii", "latin", "cjk+emoji" };
+  printf("%-10s %14s %14s %14s %14s\n", "corpus", "validate", "naive", "count", "naive count");
+  for (int kind = 0; kind < 3; kind++) {
+    size_t n = fill(buf, kind);
+    lp_strview s = lp_sv_n((const char*)buf, n);
+    double r[4];
+    for (int v = 0; v < 4; v++) {
+      double t0 = now_s();
+      for (size_t i = 0; i < iters; i++) {
+        switch (v) {
+          case 0: g_sink += (lp_utf8_validate(s) == LP_OK); break;
+          case 1: g_sink += naive_valid(buf, n); break;
+          case 2: g_sink += lp_utf8_count(s); break;
+          default: g_sink += naive_count(buf, n); break;
+        }
+      }
+      r[v] = (double)n * (double)iters / (now_s() - t0) / 1e9;
+    }
+    printf("%-10s %9.2f GB/s %9.2f GB/s %9.2f GB/s %9.2f GB/s\n", names[kind], r[0], r[1], r[2], r[3]);
+  }
+  return 0;
+}
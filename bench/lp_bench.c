@@ -0,0 +1,480 @@
+// Hot-path benchmark suite with a shared harness, for regression tracking.
+//
+//   lp_bench [--json] [--reps N] [--filter TEXT]
+//
+// Each case runs a batch of operations sized to take about 1 ms, after a
+// calibration pass and a few warm-up batches. Every repetition is timed
+// with lp_port_now_ns and lp_port_cycles; the table (or JSON with --json)
+// reports the median, p99 and minimum per operation. Cases come in groups
+// (ring, fmt, endian, arena, crc) with a libc baseline next to the lp
+// call where one exists. --filter keeps the cases whose "group/name"
+// contains TEXT.
+#include "lp/lp.h"
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_REPS   1001u
+#define WARMUP     3u
+#define BATCH_NS   1000000u
+#define NVALS      1024u
+
+typedef struct {
+  const char* group;
+  const char* name;
+  void (*fn)(const void* arg, size_t iters);
+  const void* arg;
+  size_t      bytes; // per operation, for MB/s; 0 if not meaningful
+} bench_case;
+
+typedef struct {
+  double ns_med, ns_p99, ns_min;
+  double cyc_med, cyc_p99;
+  size_t iters;
+} bench_result;
+
+static volatile uint64_t g_sink;
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+// -------------------------
+// Harness
+
+static int cmp_double(const void* a, const void* b) {
+  double x = *(const double*)a, y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of a sorted array.
+static double pct(const double* v, size_t n, double p) {
+  size_t rank = (size_t)((double)n * p / 100.0 + 0.999999);
+  if (rank == 0) rank = 1;
+  if (rank > n) rank = n;
+  return v[rank - 1u];
+}
+
+static bench_result run_case(const bench_case* c, size_t reps) {
+  size_t iters = 1;
+  for (;;) {
+    uint64_t t0 = lp_port_now_ns();
+    c->fn(c->arg, iters);
+    uint64_t dt = lp_port_now_ns() - t0;
+    if (dt >= BATCH_NS / 4u || iters >= ((size_t)1 << 30)) {
+      if (dt && dt < BATCH_NS) iters = (size_t)((double)iters * (double)BATCH_NS / (double)dt);
+      break;
+    }
+    iters *= 4u;
+  }
+  if (iters == 0) iters = 1;
+  for (size_t w = 0; w < WARMUP; w++) c->fn(c->arg, iters);
+
+  static double ns[MAX_REPS], cyc[MAX_REPS];
+  for (size_t r = 0; r < reps; r++) {
+    uint64_t c0 = lp_port_cycles();
+    uint64_t t0 = lp_port_now_ns();
+    c->fn(c->arg, iters);
+    uint64_t t1 = lp_port_now_ns();
+    uint64_t c1 = lp_port_cycles();
+    ns[r] = (double)(t1 - t0) / (double)iters;
+    cyc[r] = (double)(c1 - c0) / (double)iters;
+  }
+  qsort(ns, reps, sizeof ns[0], cmp_double);
+  qsort(cyc, reps, sizeof cyc[0], cmp_double);
+  return (bench_result){
+    .ns_med = pct(ns, reps, 50.0), .ns_p99 = pct(ns, reps, 99.0), .ns_min = ns[0],
+    .cyc_med = pct(cyc, reps, 50.0), .cyc_p99 = pct(cyc, reps, 99.0), .iters = iters,
+  };
+}
+
+// -------------------------
+// Ring: push + pop of n bytes. The ring is empty after each pair, so the
+// position steps by n modulo cap. A capacity that's a multiple of n never
+// splits a copy. With cap = n + 1 the position steps back one byte per
+// pair and a copy straddles the end unless it starts at 0 or 1: (n-1)/(n+1)
+// of them, 78% at n = 8 and over 99% at 512.
+
+typedef struct {
+  size_t cap;
+  size_t n;
+} ring_arg;
+
+static uint8_t g_ring_mem[4096];
+static uint8_t g_ring_io[512];
+
+static void b_ring(const void* arg, size_t iters) {
+  const ring_arg* a = (const ring_arg*)arg;
+  lp_ring r;
+  lp_ring_init(&r, g_ring_mem, a->cap);
+  for (size_t i = 0; i < iters; i++) {
+    g_ring_io[0] = (uint8_t)i;
+    (void)lp_ring_push(&r, g_ring_io, a->n);
+    (void)lp_ring_pop(&r, g_ring_io, a->n);
+  }
+  g_sink += g_ring_io[0];
+}
+
+// libc baseline: the two copies a push + pop amounts to
+static void b_ring_memcpy(const void* arg, size_t iters) {
+  const ring_arg* a = (const ring_arg*)arg;
+  size_t off = 0;
+  for (size_t i = 0; i < iters; i++) {
+    g_ring_io[0] = (uint8_t)i;
+    memcpy(g_ring_mem + off, g_ring_io, a->n);
+    memcpy(g_ring_io, g_ring_mem + off, a->n);
+    off = (off + a->n <= a->cap - a->n) ? off + a->n : 0;
+  }
+  g_sink += g_ring_io[0];
+}
+
+static const ring_arg k_ring8 = { 4096, 8 }, k_ring8w = { 9, 8 };
+static const ring_arg k_ring64 = { 4096, 64 }, k_ring64w = { 65, 64 };
+static const ring_arg k_ring512 = { 4096, 512 }, k_ring512w = { 513, 512 };
+
+// -------------------------
+// Fmt: one append into a reset buffer vs the snprintf spelling of it.
+
+static uint64_t g_u64[NVALS];
+static double   g_f64[NVALS];
+static char     g_out[128];
+
+typedef enum {
+  F_BYTES, F_CSTR, F_SV, F_CHAR, F_U32, F_U64, F_I32, F_I64, F_HEX32, F_HEX64, F_PTR,
+  F_F32, F_F64, F_F32_FIXED, F_F64_FIXED,
+} fmt_kind;
+
+static const char k_word[] = "request_id";
+
+static void b_fmt(const void* arg, size_t iters) {
+  fmt_kind k = *(const fmt_kind*)arg;
+  size_t acc = 0;
+  for (size_t i = 0; i < iters; i++) {
+    lp_fmtbuf fb = lp_fmtbuf_make(g_out, sizeof g_out);
+    uint64_t v = g_u64[i & (NVALS - 1u)];
+    double d = g_f64[i & (NVALS - 1u)];
+    switch (k) {
+      case F_BYTES: (void)lp_fmt_append_bytes(&fb, k_word, sizeof k_word - 1u); break;
+      case F_CSTR: (void)lp_fmt_append_cstr(&fb, k_word); break;
+      case F_SV: (void)lp_fmt_append_sv(&fb, lp_sv_n(k_word, sizeof k_word - 1u)); break;
+      case F_CHAR: (void)lp_fmt_append_char(&fb, (char)('a' + (v & 15u))); break;
+      case F_U32: (void)lp_fmt_append_u32(&fb, (uint32_t)v); break;
+      case F_U64: (void)lp_fmt_append_u64(&fb, v); break;
+      case F_I32: (void)lp_fmt_append_i32(&fb, (int32_t)v); break;
+      case F_I64: (void)lp_fmt_append_i64(&fb, (int64_t)v); break;
+      case F_HEX32: (void)lp_fmt_append_hex_u32(&fb, (uint32_t)v, false); break;
+      case F_HEX64: (void)lp_fmt_append_hex_u64(&fb, v, false); break;
+      case F_PTR: (void)lp_fmt_append_ptr(&fb, (const void*)(uintptr_t)v); break;
+      case F_F32: (void)lp_fmt_append_f32(&fb, (float)d); break;
+      case F_F64: (void)lp_fmt_append_f64(&fb, d); break;
+      case F_F32_FIXED: (void)lp_fmt_append_f32_fixed(&fb, (float)d, 3); break;
+      case F_F64_FIXED: (void)lp_fmt_append_f64_fixed(&fb, d, 3); break;
+    }
+    acc += fb.len;
+  }
+  g_sink += acc;
+}
+
+static void b_fmt_libc(const void* arg, size_t iters) {
+  fmt_kind k = *(const fmt_kind*)arg;
+  size_t acc = 0;
+  for (size_t i = 0; i < iters; i++) {
+    uint64_t v = g_u64[i & (NVALS - 1u)];
+    double d = g_f64[i & (NVALS - 1u)];
+    int n = 0;
+    switch (k) {
+      case F_BYTES: memcpy(g_out, k_word, sizeof k_word - 1u); n = (int)sizeof k_word - 1; break;
+      case F_CSTR: n = snprintf(g_out, sizeof g_out, "%s", k_word); break;
+      case F_SV: n = snprintf(g_out, sizeof g_out, "%.*s", (int)sizeof k_word - 1, k_word); break;
+      case F_CHAR: n = snprintf(g_out, sizeof g_out, "%c", (char)('a' + (v & 15u))); break;
+      case F_U32: n = snprintf(g_out, sizeof g_out, "%u", (unsigned)(uint32_t)v); break;
+      case F_U64: n = snprintf(g_out, sizeof g_out, "%llu", (unsigned long long)v); break;
+      case F_I32: n = snprintf(g_out, sizeof g_out, "%d", (int)(int32_t)v); break;
+      case F_I64: n = snprintf(g_out, sizeof g_out, "%lld", (long long)(int64_t)v); break;
+      case F_HEX32: n = snprintf(g_out, sizeof g_out, "%x", (unsigned)(uint32_t)v); break;
+      case F_HEX64: n = snprintf(g_out, sizeof g_out, "%llx", (unsigned long long)v); break;
+      case F_PTR: n = snprintf(g_out, sizeof g_out, "%p", (void*)(uintptr_t)v); break;
+      case F_F32: n = snprintf(g_out, sizeof g_out, "%.9g", (double)(float)d); break;
+      case F_F64: n = snprintf(g_out, sizeof g_out, "%.17g", d); break;
+      case F_F32_FIXED: n = snprintf(g_out, sizeof g_out, "%.3f", (double)(float)d); break;
+      case F_F64_FIXED: n = snprintf(g_out, sizeof g_out, "%.3f", d); break;
+    }
+    acc += (size_t)n;
+  }
+  g_sink += acc;
+}
+
+static const fmt_kind k_fmt[] = {
+  F_BYTES, F_CSTR, F_SV, F_CHAR, F_U32, F_U64, F_I32, F_I64, F_HEX32, F_HEX64, F_PTR,
+  F_F32, F_F64, F_F32_FIXED, F_F64_FIXED,
+};
+
+// -------------------------
+// Endian: one load or store per element over a cache-resident 16 KiB
+// buffer; ntohl/htonl + memcpy as the libc baseline.
+
+#define EBUF 16384u
+
+static uint8_t g_ebuf[EBUF + 8u];
+
+typedef enum {
+  E_LOAD16_LE, E_LOAD16_BE, E_LOAD32_LE, E_LOAD32_BE, E_LOAD64_LE, E_LOAD64_BE,
+  E_STORE16_LE, E_STORE16_BE, E_STORE32_LE, E_STORE32_BE, E_STORE64_LE, E_STORE64_BE,
+  E_NTOHL, E_HTONL,
+} endian_kind;
+
+static const size_t k_ewidth[] = { 2, 2, 4, 4, 8, 8, 2, 2, 4, 4, 8, 8, 4, 4 };
+
+static void b_endian(const void* arg, size_t iters) {
+  endian_kind k = *(const endian_kind*)arg;
+  size_t w = k_ewidth[k], mask = EBUF / w - 1u;
+  uint64_t acc = 0;
+  for (size_t i = 0; i < iters; i++) {
+    uint8_t* p = g_ebuf + (i & mask) * w;
+    switch (k) {
+      case E_LOAD16_LE: acc += lp_load_u16_le(p); break;
+      case E_LOAD16_BE: acc += lp_load_u16_be(p); break;
+      case E_LOAD32_LE: acc += lp_load_u32_le(p); break;
+      case E_LOAD32_BE: acc += lp_load_u32_be(p); break;
+      case E_LOAD64_LE: acc += lp_load_u64_le(p); break;
+      case E_LOAD64_BE: acc += lp_load_u64_be(p); break;
+      case E_STORE16_LE: lp_store_u16_le(p, (uint16_t)i); break;
+      case E_STORE16_BE: lp_store_u16_be(p, (uint16_t)i); break;
+      case E_STORE32_LE: lp_store_u32_le(p, (uint32_t)i); break;
+      case E_STORE32_BE: lp_store_u32_be(p, (uint32_t)i); break;
+      case E_STORE64_LE: lp_store_u64_le(p, (uint64_t)i); break;
+      case E_STORE64_BE: lp_store_u64_be(p, (uint64_t)i); break;
+      case E_NTOHL: {
+        uint32_t x;
+        memcpy(&x, p, 4);
+        acc += ntohl(x);
+        break;
+      }
+      case E_HTONL: {
+        uint32_t x = htonl((uint32_t)i);
+        memcpy(p, &x, 4);
+        break;
+      }
+    }
+  }
+  g_sink += acc + g_ebuf[0];
+}
+
+static const endian_kind k_endian[] = {
+  E_LOAD16_LE, E_LOAD16_BE, E_LOAD32_LE, E_LOAD32_BE, E_LOAD64_LE, E_LOAD64_BE,
+  E_STORE16_LE, E_STORE16_BE, E_STORE32_LE, E_STORE32_BE, E_STORE64_LE, E_STORE64_BE,
+  E_NTOHL, E_HTONL,
+};
+
+// -------------------------
+// Arena: 24-byte allocations at a given alignment, reset when full, vs
+// malloc/free and aligned_alloc/free.
+
+static LP_ALIGNAS(64) uint8_t g_arena_mem[65536];
+
+static const size_t k_align[] = { 1, 8, 16, 64 };
+
+static void b_arena(const void* arg, size_t iters) {
+  size_t align = *(const size_t*)arg;
+  lp_arena a;
+  lp_arena_init(&a, g_arena_mem, sizeof g_arena_mem);
+  uintptr_t acc = 0;
+  for (size_t i = 0; i < iters; i++) {
+    void* p;
+    if (lp_arena_alloc(&a, 24, align, &p) != LP_OK) {
+      lp_arena_reset(&a);
+      (void)lp_arena_alloc(&a, 24, align, &p);
+    }
+    acc += (uintptr_t)p;
+  }
+  g_sink += acc;
+}
+
+static void b_malloc(const void* arg, size_t iters) {
+  size_t align = *(const size_t*)arg;
+  uintptr_t acc = 0;
+  for (size_t i = 0; i < iters; i++) {
+    void* p = (align > 16u) ? aligned_alloc(align, align) : malloc(24);
+    acc += (uintptr_t)p;
+    free(p);
+  }
+  g_sink += acc;
+}
+
+// -------------------------
+// CRC: the dispatched lp_crc32 / lp_crc32c and the table fallback, per
+// buffer. libc has no CRC.
+
+static uint8_t g_crc_buf[4096];
+
+typedef struct {
+  uint32_t (*update)(uint32_t st, const void* data, size_t n);
+  size_t n;
+} crc_arg;
+
+static void b_crc(const void* arg, size_t iters) {
+  const crc_arg* a = (const crc_arg*)arg;
+  uint32_t acc = 0;
+  for (size_t i = 0; i < iters; i++) {
+    g_crc_buf[0] = (uint8_t)i;
+    acc ^= a->update(0xFFFFFFFFu, g_crc_buf, a->n);
+  }
+  g_sink += acc;
+}
+
+static const crc_arg k_crc64 = { lp_crc32_update, 64 }, k_crc4k = { lp_crc32_update, 4096 };
+static const crc_arg k_crcsw64 = { lp_crc32_update_sw, 64 }, k_crcsw4k = { lp_crc32_update_sw, 4096 };
+static const crc_arg k_crcc64 = { lp_crc32c_update, 64 }, k_crcc4k = { lp_crc32c_update, 4096 };
+
+// -------------------------
+
+static const bench_case k_cases[] = {
+  { "ring", "lp_ring push+pop 8", b_ring, &k_ring8, 8 },
+  { "ring", "lp_ring push+pop 8 wrap", b_ring, &k_ring8w, 8 },
+  { "ring", "memcpy x2 8", b_ring_memcpy, &k_ring8, 8 },
+  { "ring", "lp_ring push+pop 64", b_ring, &k_ring64, 64 },
+  { "ring", "lp_ring push+pop 64 wrap", b_ring, &k_ring64w, 64 },
+  { "ring", "memcpy x2 64", b_ring_memcpy, &k_ring64, 64 },
+  { "ring", "lp_ring push+pop 512", b_ring, &k_ring512, 512 },
+  { "ring", "lp_ring push+pop 512 wrap", b_ring, &k_ring512w, 512 },
+  { "ring", "memcpy x2 512", b_ring_memcpy, &k_ring512, 512 },
+
+  { "fmt", "lp_fmt_append_bytes", b_fmt, &k_fmt[0], 0 },
+  { "fmt", "memcpy", b_fmt_libc, &k_fmt[0], 0 },
+  { "fmt", "lp_fmt_append_cstr", b_fmt, &k_fmt[1], 0 },
+  { "fmt", "snprintf %s", b_fmt_libc, &k_fmt[1], 0 },
+  { "fmt", "lp_fmt_append_sv", b_fmt, &k_fmt[2], 0 },
+  { "fmt", "snprintf %.*s", b_fmt_libc, &k_fmt[2], 0 },
+  { "fmt", "lp_fmt_append_char", b_fmt, &k_fmt[3], 0 },
+  { "fmt", "snprintf %c", b_fmt_libc, &k_fmt[3], 0 },
+  { "fmt", "lp_fmt_append_u32", b_fmt, &k_fmt[4], 0 },
+  { "fmt", "snprintf %u", b_fmt_libc, &k_fmt[4], 0 },
+  { "fmt", "lp_fmt_append_u64", b_fmt, &k_fmt[5], 0 },
+  { "fmt", "snprintf %llu", b_fmt_libc, &k_fmt[5], 0 },
+  { "fmt", "lp_fmt_append_i32", b_fmt, &k_fmt[6], 0 },
+  { "fmt", "snprintf %d", b_fmt_libc, &k_fmt[6], 0 },
+  { "fmt", "lp_fmt_append_i64", b_fmt, &k_fmt[7], 0 },
+  { "fmt", "snprintf %lld", b_fmt_libc, &k_fmt[7], 0 },
+  { "fmt", "lp_fmt_append_hex_u32", b_fmt, &k_fmt[8], 0 },
+  { "fmt", "snprintf %x", b_fmt_libc, &k_fmt[8], 0 },
+  { "fmt", "lp_fmt_append_hex_u64", b_fmt, &k_fmt[9], 0 },
+  { "fmt", "snprintf %llx", b_fmt_libc, &k_fmt[9], 0 },
+  { "fmt", "lp_fmt_append_ptr", b_fmt, &k_fmt[10], 0 },
+  { "fmt", "snprintf %p", b_fmt_libc, &k_fmt[10], 0 },
+#if LP_CFG_FMT_FLOAT
+  { "fmt", "lp_fmt_append_f32", b_fmt, &k_fmt[11], 0 },
+  { "fmt", "snprintf %.9g", b_fmt_libc, &k_fmt[11], 0 },
+  { "fmt", "lp_fmt_append_f64", b_fmt, &k_fmt[12], 0 },
+  { "fmt", "snprintf %.17g", b_fmt_libc, &k_fmt[12], 0 },
+  { "fmt", "lp_fmt_append_f32_fixed 3", b_fmt, &k_fmt[13], 0 },
+  { "fmt", "snprintf %.3f (float)", b_fmt_libc, &k_fmt[13], 0 },
+  { "fmt", "lp_fmt_append_f64_fixed 3", b_fmt, &k_fmt[14], 0 },
+  { "fmt", "snprintf %.3f", b_fmt_libc, &k_fmt[14], 0 },
+#endif
+
+  { "endian", "lp_load_u16_le", b_endian, &k_endian[0], 2 },
+  { "endian", "lp_load_u16_be", b_endian, &k_endian[1], 2 },
+  { "endian", "lp_load_u32_le", b_endian, &k_endian[2], 4 },
+  { "endian", "lp_load_u32_be", b_endian, &k_endian[3], 4 },
+  { "endian", "ntohl+memcpy", b_endian, &k_endian[12], 4 },
+  { "endian", "lp_load_u64_le", b_endian, &k_endian[4], 8 },
+  { "endian", "lp_load_u64_be", b_endian, &k_endian[5], 8 },
+  { "endian", "lp_store_u16_le", b_endian, &k_endian[6], 2 },
+  { "endian", "lp_store_u16_be", b_endian, &k_endian[7], 2 },
+  { "endian", "lp_store_u32_le", b_endian, &k_endian[8], 4 },
+  { "endian", "lp_store_u32_be", b_endian, &k_endian[9], 4 },
+  { "endian", "htonl+memcpy", b_endian, &k_endian[13], 4 },
+  { "endian", "lp_store_u64_le", b_endian, &k_endian[10], 8 },
+  { "endian", "lp_store_u64_be", b_endian, &k_endian[11], 8 },
+
+  { "arena", "lp_arena_alloc align 1", b_arena, &k_align[0], 0 },
+  { "arena", "lp_arena_alloc align 8", b_arena, &k_align[1], 0 },
+  { "arena", "lp_arena_alloc align 16", b_arena, &k_align[2], 0 },
+  { "arena", "malloc+free", b_malloc, &k_align[2], 0 },
+  { "arena", "lp_arena_alloc align 64", b_arena, &k_align[3], 0 },
+  { "arena", "aligned_alloc+free 64", b_malloc, &k_align[3], 0 },
+
+  { "crc", "lp_crc32 64", b_crc, &k_crc64, 64 },
+  { "crc", "lp_crc32_update_sw 64", b_crc, &k_crcsw64, 64 },
+  { "crc", "lp_crc32c 64", b_crc, &k_crcc64, 64 },
+  { "crc", "lp_crc32 4096", b_crc, &k_crc4k, 4096 },
+  { "crc", "lp_crc32_update_sw 4096", b_crc, &k_crcsw4k, 4096 },
+  { "crc", "lp_crc32c 4096", b_crc, &k_crcc4k, 4096 },
+};
+
+#define NCASES (sizeof k_cases / sizeof k_cases[0])
+
+static bool matches(const bench_case* c, const char* filter) {
+  if (!filter) return true;
+  char full[96];
+  snprintf(full, sizeof full, "%s/%s", c->group, c->name);
+  return strstr(full, filter) != NULL;
+}
+
+static void init_inputs(void) {
+  for (size_t i = 0; i < NVALS; i++) {
+    // every digit count about equally likely
+    uint64_t v = rnd64();
+    g_u64[i] = v >> (rnd64() % 64u);
+    g_f64[i] = (double)(int64_t)(v >> 20) * 1e-6 / (double)(1u + (i & 1023u));
+  }
+  for (size_t i = 0; i < sizeof g_ebuf; i++) g_ebuf[i] = (uint8_t)rnd64();
+  for (size_t i = 0; i < sizeof g_crc_buf; i++) g_crc_buf[i] = (uint8_t)rnd64();
+}
+
+int main(int argc, char** argv) {
+  bool json = false;
+  size_t reps = 31;
+  const char* filter = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0) {
+      json = true;
+    } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+      reps = (size_t)strtoull(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      fprintf(stderr, "usage: %s [--json] [--reps N] [--filter TEXT]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (reps == 0) reps = 1;
+  if (reps > MAX_REPS) reps = MAX_REPS;
+  init_inputs();
+
+  if (json) {
+    printf("{\"suite\":\"lp_bench\",\"reps\":%zu,\"cycles_per_sec\":%llu,\"results\":[", reps,
+           (unsigned long long)lp_port_cycles_per_sec());
+  } else {
+    printf("%-8s %-28s %10s %10s %10s %10s %10s\n", "group", "case", "ns med", "ns p99", "ns min",
+           "cyc med", "MB/s");
+  }
+  bool first = true;
+  for (size_t i = 0; i < NCASES; i++) {
+    const bench_case* c = &k_cases[i];
+    if (!matches(c, filter)) continue;
+    bench_result r = run_case(c, reps);
+    double mbs = c->bytes ? (double)c->bytes * 1e3 / r.ns_med : 0.0;
+    if (json) {
+      printf("%s\n{\"group\":\"%s\",\"name\":\"%s\",\"iters\":%zu,\"bytes\":%zu,"
+             "\"ns_median\":%.3f,\"ns_p99\":%.3f,\"ns_min\":%.3f,"
+             "\"cycles_median\":%.1f,\"cycles_p99\":%.1f}",
+             first ? "" : ",", c->group, c->name, r.iters, c->bytes, r.ns_med, r.ns_p99, r.ns_min,
+             r.cyc_med, r.cyc_p99);
+    } else {
+      printf("%-8s %-28s %10.2f %10.2f %10.2f %10.1f", c->group, c->name, r.ns_med, r.ns_p99, r.ns_min,
+             r.cyc_med);
+      if (mbs > 0.0) printf(" %10.0f", mbs);
+      printf("\n");
+    }
+    first = false;
+  }
+  if (json) printf("\n]}\n");
+  return 0;
+}
@@ -6,9 +6,24 @@
 #include "lp_assert.h"
 #include "lp_types.h"
 #include "lp_strview.h"
+#include "lp_utf8.h"
+#include "lp_alloc_stats.h"
 #include "lp_arena.h"
+#include "lp_buf.h"
+#include "lp_pool.h"
+#include "lp_scratch.h"
 #include "lp_ring.h"
+#include "lp_spsc_ring.h"
+#include "lp_mpmc_queue.h"
+#include "lp_mirror_ring.h"
 #include "lp_fmt.h"
+#include "lp_dlog.h"
+#include "lp_prof.h"
+#include "lp_hist.h"
+#include "lp_parse.h"
 #include "lp_crc32.h"
+#include "lp_hash.h"
+#include "lp_map.h"
+#include "lp_intern.h"
 #include "lp_bytes.h"
 
@@ -0,0 +1,41 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_status.h"
+#include "lp_fmt.h"
+
+/*
+  lp_alloc_stats: allocator counters for sizing arenas and pools from data.
+
+  Embedded in lp_arena and lp_pool when LP_CFG_ALLOC_STATS is set (zero cost
+  otherwise). Counters survive reset/rewind.
+
+  - bytes_consumed = bytes_requested + bytes_padding
+  - high_water: arena: largest offset reached in any block;
+                pool:  most objects live at once, in bytes (count * stride)
+  - blocks: heap blocks taken by a chained arena
+*/
+
+typedef struct {
+  uint64_t allocs;
+  uint64_t failures;
+  uint64_t bytes_requested;
+  uint64_t bytes_consumed;
+  uint64_t bytes_padding;
+  uint64_t blocks;
+  size_t   high_water;
+} lp_alloc_stats;
+
+static LP_INLINE void lp_alloc_stats_hit(lp_alloc_stats* s, size_t req, size_t pad, size_t in_use) {
+  s->allocs++;
+  s->bytes_requested += req;
+  s->bytes_padding += pad;
+  s->bytes_consumed += req + pad;
+  if (in_use > s->high_water) s->high_water = in_use;
+}
+
+static LP_INLINE void lp_alloc_stats_miss(lp_alloc_stats* s) {
+  s->failures++;
+}
+
+// One line: "<name>: allocs=.. fail=.. req=.. used=.. pad=.. hwm=.. blocks=.."
+lp_status_t lp_alloc_stats_dump(lp_fmtbuf* fb, const char* name, const lp_alloc_stats* s);
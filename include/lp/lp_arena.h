@@ -1,25 +1,131 @@
 #pragma once
 #include "lp_platform.h"
+#include "lp_config.h"
 #include "lp_status.h"
 #include "lp_assert.h"
+#include "lp_alloc_stats.h"
+
+/*
+  lp_arena: bump allocator over caller memory.
+
+  - lp_arena_mark / lp_arena_rewind give nested savepoints: everything
+    allocated after a mark is released by rewinding to it.
+  - With LP_CFG_ENABLE_ALLOC, an arena may be chained: when the current block
+    is exhausted another one (>= min_block bytes) is taken from
+    lp_port_malloc. Released blocks are either freed or kept on a spare list
+    for reuse (LP_ARENA_KEEP_BLOCKS), so a reused arena reaches a steady
+    state with no heap calls.
+*/
+
+#if LP_CFG_ENABLE_ALLOC
+typedef struct lp_arena_block lp_arena_block;
+struct lp_arena_block {
+  lp_arena_block* prev;
+  size_t          cap;  // usable bytes after the header
+};
+
+enum {
+  LP_ARENA_FREE_BLOCKS = 0, // rewind/reset returns blocks to the heap
+  LP_ARENA_KEEP_BLOCKS = 1, // rewind/reset keeps blocks for reuse
+};
+#endif
 
 typedef struct {
   uint8_t* mem;
   size_t   cap;
   size_t   off;
+#if LP_CFG_ENABLE_ALLOC
+  lp_arena_block* chain;     // current heap block (NULL: in the base region)
+  lp_arena_block* spare;     // released blocks kept for reuse
+  uint8_t*        base_mem;  // caller region (may be NULL)
+  size_t          base_cap;
+  size_t          min_block; // 0: chaining disabled
+  uint32_t        flags;
+#endif
+#if LP_CFG_ALLOC_STATS
+  lp_alloc_stats  stats;
+#endif
 } lp_arena;
 
+// Savepoint: where the arena's top was when lp_arena_mark was called.
+typedef struct {
+  void*  block;
+  size_t off;
+} lp_arena_pos;
+
 static LP_INLINE void lp_arena_init(lp_arena* a, void* mem, size_t cap) {
   LP_ASSERT(a);
   a->mem = (uint8_t*)mem;
   a->cap = cap;
   a->off = 0;
+#if LP_CFG_ENABLE_ALLOC
+  a->chain = NULL;
+  a->spare = NULL;
+  a->base_mem = a->mem;
+  a->base_cap = cap;
+  a->min_block = 0;
+  a->flags = LP_ARENA_FREE_BLOCKS;
+#endif
+#if LP_CFG_ALLOC_STATS
+  a->stats = (lp_alloc_stats){ 0 };
+#endif
+}
+
+static LP_INLINE lp_arena_pos lp_arena_mark(const lp_arena* a) {
+  LP_ASSERT(a);
+#if LP_CFG_ENABLE_ALLOC
+  return (lp_arena_pos){ .block = a->chain, .off = a->off };
+#else
+  return (lp_arena_pos){ .block = NULL, .off = a->off };
+#endif
+}
+
+#if LP_CFG_ENABLE_ALLOC
+// mem may be NULL/0 to start directly on the heap.
+void lp_arena_init_chained(lp_arena* a, void* mem, size_t cap, size_t min_block, uint32_t flags);
+void lp__arena_rewind_chain(lp_arena* a, lp_arena_pos pos);
+// Frees every heap block, including kept spares. The arena is left reset.
+void lp_arena_release(lp_arena* a);
+#endif
+
+// Releases everything allocated since `pos` was taken. Positions taken
+// after `pos` become invalid.
+static LP_INLINE void lp_arena_rewind(lp_arena* a, lp_arena_pos pos) {
+  LP_ASSERT(a);
+#if LP_CFG_ENABLE_ALLOC
+  if (a->chain || pos.block) { lp__arena_rewind_chain(a, pos); return; }
+#endif
+  LP_ASSERT(pos.off <= a->off);
+  a->off = pos.off;
 }
 
 static LP_INLINE void lp_arena_reset(lp_arena* a) {
   LP_ASSERT(a);
-  a->off = 0;
+  lp_arena_rewind(a, (lp_arena_pos){ .block = NULL, .off = 0 });
 }
 
 lp_status_t lp_arena_alloc(lp_arena* a, size_t size, size_t align, void** out);
 
+// Resizes the most recent allocation in place: p (old_size bytes) must end
+// at the arena's top. Shrinking always succeeds; growing needs room in the
+// current block. false leaves the arena unchanged (allocate and copy).
+bool lp_arena_resize_top(lp_arena* a, void* p, size_t old_size, size_t new_size);
+
+/*
+  Scoped temporaries:
+    lp_arena_temp t = lp_arena_temp_begin(a);
+    ... scratch allocations ...
+    lp_arena_temp_end(t);
+*/
+typedef struct {
+  lp_arena*    arena;
+  lp_arena_pos pos;
+} lp_arena_temp;
+
+static LP_INLINE lp_arena_temp lp_arena_temp_begin(lp_arena* a) {
+  return (lp_arena_temp){ .arena = a, .pos = lp_arena_mark(a) };
+}
+
+static LP_INLINE void lp_arena_temp_end(lp_arena_temp t) {
+  lp_arena_rewind(t.arena, t.pos);
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_assert.h"
+#include "lp_types.h"
+#include "lp_arena.h"
+#include "lp_bytes.h"
+
+/*
+  lp_buf: growable byte buffer; LP_VEC_DEFINE builds typed vectors on it.
+
+  - Backing store, chosen at init:
+      lp_buf_init        caller memory only; growing past it: LP_ERR_NOMEM
+      lp_buf_init_arena  grows in an lp_arena
+      lp_buf_init_heap   grows with lp_port_malloc (LP_CFG_ENABLE_ALLOC)
+    The arena and heap variants take optional inline storage (typically a
+    local array). Data starts there and only moves to the backend once it
+    outgrows it, so short buffers never allocate.
+  - Capacity at least doubles on each move, so appends are amortized O(1);
+    all size math is overflow-checked (LP_ERR_OVERFLOW).
+  - In an arena, a buffer that is still the most recent allocation grows
+    in place (lp_arena_resize_top) instead of being copied. Space left
+    behind by a move is only reclaimed when the arena is rewound.
+  - data may move on any call that can grow the buffer.
+*/
+
+enum {
+  LP_BUF_FIXED = 0,
+  LP_BUF_ARENA = 1,
+  LP_BUF_HEAP  = 2,
+};
+
+typedef struct {
+  uint8_t*  data;
+  size_t    len;
+  size_t    cap;
+  uint8_t*  inline_mem; // caller storage the data starts in (not owned)
+  size_t    inline_cap;
+  lp_arena* arena;      // LP_BUF_ARENA
+  size_t    align;      // of data taken from the backend
+  uint8_t   kind;
+} lp_buf;
+
+void lp_buf_init(lp_buf* b, void* mem, size_t cap);
+void lp_buf_init_arena(lp_buf* b, lp_arena* a, void* inline_mem, size_t inline_cap);
+#if LP_CFG_ENABLE_ALLOC
+void lp_buf_init_heap(lp_buf* b, void* inline_mem, size_t inline_cap);
+#endif
+
+// Slow path of lp_buf_reserve: make cap >= need.
+lp_status_t lp__buf_grow(lp_buf* b, size_t need);
+
+// Room for `extra` more bytes without moving.
+static LP_INLINE lp_status_t lp_buf_reserve(lp_buf* b, size_t extra) {
+  LP_ASSERT(b);
+  if (LP_LIKELY(extra <= b->cap - b->len)) return LP_OK;
+  if (extra > SIZE_MAX - b->len) return LP_ERR_OVERFLOW;
+  return lp__buf_grow(b, b->len + extra);
+}
+
+lp_status_t lp_buf_append(lp_buf* b, const void* p, size_t n);
+
+static LP_INLINE lp_status_t lp_buf_append_sv(lp_buf* b, lp_strview s) {
+  return lp_buf_append(b, s.ptr, s.len);
+}
+
+static LP_INLINE void lp_buf_clear(lp_buf* b) {
+  LP_ASSERT(b);
+  b->len = 0;
+}
+
+// Drops spare capacity: back into the inline storage if the data fits,
+// else trimmed in place (arena top) or moved to an exact-size block (heap).
+lp_status_t lp_buf_shrink(lp_buf* b);
+
+// Hands the contents over and leaves b empty on its inline storage.
+//   heap:  out->ptr came from lp_port_malloc; free it with lp_port_free
+//   arena: out->ptr lives in the arena
+//   fixed: out->ptr points into the caller memory; b keeps no storage
+// Data still in inline storage is first copied to the backend, so the
+// result never points at it. An empty buffer gives { NULL, 0 }.
+lp_status_t lp_buf_detach(lp_buf* b, lp_span_u8_mut* out);
+
+// Returns backend memory (heap: freed; arena: given back if on top) and
+// leaves b empty on its inline storage.
+void lp_buf_free(lp_buf* b);
+
+/*
+  LP_VEC_DEFINE(name, T): typed vector over lp_buf.
+
+    LP_VEC_DEFINE(lp_vec_u32, uint32_t)
+
+    uint32_t small[16];
+    lp_vec_u32 v;
+    lp_vec_u32_init_arena(&v, &arena, small, 16);
+    lp_vec_u32_push(&v, 7);
+    for (size_t i = 0; i < lp_vec_u32_len(&v); i++) use(lp_vec_u32_data(&v)[i]);
+
+  Generates name_init / _init_arena / _init_heap (LP_CFG_ENABLE_ALLOC),
+  _len, _cap, _data, _at, _reserve, _push, _push_n, _pop, _clear,
+  _shrink, _detach and _free. Element counts go through
+  lp_checked_mul_size; the init functions return LP_ERR_OVERFLOW (and
+  leave the vector valid with no storage) if n * sizeof(T) wraps.
+  Storage is aligned for T.
+*/
+
+#if LP_CFG_ENABLE_ALLOC
+  #define LP__VEC_DEFINE_HEAP(name, T)                                                \
+    static LP_INLINE lp_status_t name##_init_heap(name* v, T* inline_mem, size_t inline_n) { \
+      size_t bytes = 0;                                                               \
+      lp_status_t st = lp_checked_mul_size(inline_n, sizeof(T), &bytes);              \
+      lp_buf_init_heap(&v->buf, inline_mem, st == LP_OK ? bytes : 0u);                \
+      v->buf.align = _Alignof(T);                                                     \
+      return st == LP_OK ? LP_OK : LP_ERR_OVERFLOW;                                   \
+    }
+#else
+  #define LP__VEC_DEFINE_HEAP(name, T)
+#endif
+
+#define LP_VEC_DEFINE(name, T)                                                        \
+  typedef struct { lp_buf buf; } name;                                                \
+                                                                                      \
+  static LP_INLINE lp_status_t name##_init(name* v, T* mem, size_t n) {               \
+    size_t bytes = 0;                                                                 \
+    lp_status_t st = lp_checked_mul_size(n, sizeof(T), &bytes);                       \
+    lp_buf_init(&v->buf, mem, st == LP_OK ? bytes : 0u);                              \
+    v->buf.align = _Alignof(T);                                                       \
+    return st == LP_OK ? LP_OK : LP_ERR_OVERFLOW;                                     \
+  }                                                                                   \
+  static LP_INLINE lp_status_t name##_init_arena(name* v, lp_arena* a, T* inline_mem, \
+                                                 size_t inline_n) {                   \
+    size_t bytes = 0;                                                                 \
+    lp_status_t st = lp_checked_mul_size(inline_n, sizeof(T), &bytes);                \
+    lp_buf_init_arena(&v->buf, a, inline_mem, st == LP_OK ? bytes : 0u);              \
+    v->buf.align = _Alignof(T);                                                       \
+    return st == LP_OK ? LP_OK : LP_ERR_OVERFLOW;                                     \
+  }                                                                                   \
+  LP__VEC_DEFINE_HEAP(name, T)                                                        \
+                                                                                      \
+  static LP_INLINE size_t name##_len(const name* v) { return v->buf.len / sizeof(T); } \
+  static LP_INLINE size_t name##_cap(const name* v) { return v->buf.cap / sizeof(T); } \
+  static LP_INLINE T* name##_data(name* v) { return (T*)(void*)v->buf.data; }         \
+                                                                                      \
+  static LP_INLINE T* name##_at(name* v, size_t i) {                                  \
+    LP_ASSERT(i < name##_len(v));                                                     \
+    return (T*)(void*)v->buf.data + i;                                                \
+  }                                                                                   \
+                                                                                      \
+  static LP_INLINE lp_status_t name##_reserve(name* v, size_t extra) {                \
+    size_t bytes = 0;                                                                 \
+    if (lp_checked_mul_size(extra, sizeof(T), &bytes) != LP_OK) return LP_ERR_OVERFLOW; \
+    return lp_buf_reserve(&v->buf, bytes);                                            \
+  }                                                                                   \
+                                                                                      \
+  static LP_INLINE lp_status_t name##_push(name* v, T x) {                            \
+    if (LP_UNLIKELY(v->buf.cap - v->buf.len < sizeof(T))) {                           \
+      lp_status_t st = lp_buf_reserve(&v->buf, sizeof(T));                            \
+      if (st != LP_OK) return st;                                                     \
+    }                                                                                 \
+    *(T*)(void*)(v->buf.data + v->buf.len) = x;                                       \
+    v->buf.len += sizeof(T);                                                          \
+    return LP_OK;                                                                     \
+  }                                                                                   \
+                                                                                      \
+  static LP_INLINE lp_status_t name##_push_n(name* v, const T* p, size_t n) {         \
+    size_t bytes = 0;                                                                 \
+    if (lp_checked_mul_size(n, sizeof(T), &bytes) != LP_OK) return LP_ERR_OVERFLOW;   \
+    return lp_buf_append(&v->buf, p, bytes);                                          \
+  }                                                                                   \
+                                                                                      \
+  static LP_INLINE bool name##_pop(name* v, T* out) {                                 \
+    if (v->buf.len < sizeof(T)) return false;                                         \
+    v->buf.len -= sizeof(T);                                                          \
+    if (out) *out = *(const T*)(const void*)(v->buf.data + v->buf.len);               \
+    return true;                                                                      \
+  }                                                                                   \
+                                                                                      \
+  static LP_INLINE void name##_clear(name* v) { lp_buf_clear(&v->buf); }               \
+  static LP_INLINE lp_status_t name##_shrink(name* v) { return lp_buf_shrink(&v->buf); } \
+  static LP_INLINE void name##_free(name* v) { lp_buf_free(&v->buf); }                 \
+                                                                                      \
+  static LP_INLINE lp_status_t name##_detach(name* v, T** out, size_t* n) {           \
+    lp_span_u8_mut s = { NULL, 0 };                                                   \
+    lp_status_t st = lp_buf_detach(&v->buf, &s);                                      \
+    if (st != LP_OK) return st;                                                       \
+    *out = (T*)(void*)s.ptr;                                                          \
+    *n = s.len / sizeof(T);                                                           \
+    return LP_OK;                                                                     \
+  }
@@ -1,11 +1,15 @@
 #pragma once
 #include "lp_platform.h"
 #include "lp_status.h"
+#include "lp_types.h"
 
 /*
   lp_bytes: portable byte/endian utilities + checked arithmetic helpers.
   - Core-only: no OS, no malloc, no stdio.
   - No UB on overflow: checked ops return LP_ERR_OVERFLOW.
+  - Endian arrays: memcpy or a vectorized byte swap (SSSE3/AVX2 on x86).
+  - Hex/base64 codecs: SSSE3/AVX2 on x86 (LP_CFG_ENABLE_SIMD, picked at
+    runtime), SWAR/table code elsewhere.
 */
 
 // -------------------------
@@ -33,6 +37,29 @@ void lp_store_u32_be(void* p, uint32_t v);
 void lp_store_u64_le(void* p, uint64_t v);
 void lp_store_u64_be(void* p, uint64_t v);
 
+// -------------------------
+// Endian arrays
+// -------------------------
+//
+// Convert count elements between a byte stream (any alignment) and a native
+// array. A plain memcpy when the host order already matches, a vectorized
+// byte swap otherwise. dst may equal src (in-place); other overlap is not
+// allowed.
+
+void lp_load_u16_le_n(uint16_t* dst, const void* src, size_t count);
+void lp_load_u16_be_n(uint16_t* dst, const void* src, size_t count);
+void lp_load_u32_le_n(uint32_t* dst, const void* src, size_t count);
+void lp_load_u32_be_n(uint32_t* dst, const void* src, size_t count);
+void lp_load_u64_le_n(uint64_t* dst, const void* src, size_t count);
+void lp_load_u64_be_n(uint64_t* dst, const void* src, size_t count);
+
+void lp_store_u16_le_n(void* dst, const uint16_t* src, size_t count);
+void lp_store_u16_be_n(void* dst, const uint16_t* src, size_t count);
+void lp_store_u32_le_n(void* dst, const uint32_t* src, size_t count);
+void lp_store_u32_be_n(void* dst, const uint32_t* src, size_t count);
+void lp_store_u64_le_n(void* dst, const uint64_t* src, size_t count);
+void lp_store_u64_be_n(void* dst, const uint64_t* src, size_t count);
+
 // -------------------------
 // Bit utilities
 // -------------------------
@@ -66,3 +93,32 @@ static LP_INLINE size_t lp_align_up_size(size_t x, size_t align) {
   return (x + (align - 1u)) & ~(align - 1u);
 }
 
+
+// -------------------------
+// Hex / base64 codecs
+// -------------------------
+//
+// Encoders write text into dst, decoders read text from src. *out_len gets
+// the bytes written. LP_ERR_RANGE if dst is too small, LP_ERR_INVALID on any
+// malformed input (decoding is strict). dst contents are unspecified on error.
+
+static LP_INLINE size_t lp_hex_encoded_len(size_t n) { return n * 2u; }
+static LP_INLINE size_t lp_hex_decoded_len(size_t n) { return n / 2u; }
+
+lp_status_t lp_hex_encode(lp_span_u8_mut dst, lp_span_u8 src, bool uppercase, size_t* out_len);
+// Accepts upper and lower case; odd length is invalid.
+lp_status_t lp_hex_decode(lp_span_u8_mut dst, lp_strview src, size_t* out_len);
+
+typedef enum {
+  LP_BASE64_STD = 0, // RFC 4648 "+/", padded with '='
+  LP_BASE64_URL = 1, // RFC 4648 "-_", unpadded
+} lp_base64_alphabet;
+
+size_t lp_base64_encoded_len(size_t n, lp_base64_alphabet alpha);
+// Upper bound for decoding n characters.
+static LP_INLINE size_t lp_base64_decoded_max(size_t n) { return (n / 4u) * 3u + ((n % 4u) * 3u) / 4u; }
+
+lp_status_t lp_base64_encode(lp_span_u8_mut dst, lp_span_u8 src, lp_base64_alphabet alpha, size_t* out_len);
+// STD requires canonical '=' padding; URL rejects '='. Non-zero trailing
+// bits are rejected in both.
+lp_status_t lp_base64_decode(lp_span_u8_mut dst, lp_strview src, lp_base64_alphabet alpha, size_t* out_len);
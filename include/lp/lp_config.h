@@ -15,6 +15,8 @@
 #endif
 
 #ifndef LP_CFG_ENABLE_TIME
+  // lp_port_now_ns / lp_port_cycles (the host CMake build turns it on);
+  // the bare-metal port then needs LP_PORT_CPU_HZ or an AArch64 core
   #define LP_CFG_ENABLE_TIME 0
 #endif
 
@@ -28,3 +30,68 @@
   #define LP_CFG_FMT_TMP_SIZE 128u
 #endif
 
+
+#ifndef LP_CFG_ENABLE_ATOMICS
+  // lock-free containers (lp_spsc_ring, ...) need lp_port_atomic_*
+  #define LP_CFG_ENABLE_ATOMICS 1
+#endif
+
+#ifndef LP_CFG_CACHE_LINE
+  // used to keep producer/consumer state on separate lines
+  #define LP_CFG_CACHE_LINE 64
+#endif
+
+#ifndef LP_CFG_CRC32_SLICE8
+  // 1: slicing-by-8 tables (16 KiB const); 0: byte-at-a-time (2 KiB)
+  #define LP_CFG_CRC32_SLICE8 1
+#endif
+
+#ifndef LP_CFG_CRC32_HW
+  // allow CLMUL/SSE4.2/ARMv8 CRC kernels when the target has them
+  #define LP_CFG_CRC32_HW 1
+#endif
+
+#ifndef LP_CFG_ALLOC_STATS
+  // per-allocator counters in lp_arena / lp_pool (adds a few adds per alloc)
+  #define LP_CFG_ALLOC_STATS 0
+#endif
+
+#ifndef LP_CFG_ENABLE_SIMD
+  // allow SSSE3/AVX2 kernels (runtime-dispatched) in byte codecs etc.
+  #define LP_CFG_ENABLE_SIMD 1
+#endif
+
+#ifndef LP_CFG_FMT_FLOAT
+  // lp_fmt float/double output (uses a ~10 KiB power-of-ten table)
+  #define LP_CFG_FMT_FLOAT 1
+#endif
+
+#ifndef LP_CFG_PARSE_FLOAT
+  // lp_parse_f64 (same table as LP_CFG_FMT_FLOAT; linked once if both)
+  #define LP_CFG_PARSE_FLOAT 1
+#endif
+
+#ifndef LP_CFG_DLOG_MAX_CHANS
+  // lp_dlog: producer channels per logger
+  #define LP_CFG_DLOG_MAX_CHANS 16u
+#endif
+
+#ifndef LP_CFG_DLOG_MAX_RECORD
+  // lp_dlog: bytes per encoded record; longer string arguments are cut
+  #define LP_CFG_DLOG_MAX_RECORD 256u
+#endif
+
+#ifndef LP_CFG_ENABLE_PROF
+  // LP_PROF_BEGIN/END probes; 0 compiles them out (needs TIME and ATOMICS)
+  #define LP_CFG_ENABLE_PROF 0
+#endif
+
+#ifndef LP_CFG_PROF_MAX_PROBES
+  // lp_prof: distinct probe sites; later ones are not counted
+  #define LP_CFG_PROF_MAX_PROBES 64u
+#endif
+
+#ifndef LP_CFG_PROF_MAX_THREADS
+  // lp_prof: threads with their own counters; later ones are not counted
+  #define LP_CFG_PROF_MAX_THREADS 16u
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+#include "lp_platform.h"
+
+/*
+  lp_crc32: CRC-32 (IEEE 802.3 / zlib) and CRC-32C (Castagnoli).
+
+  - Incremental: st = init(); st = update(st, ...)...; crc = final(st).
+  - Portable slicing-by-8 tables (LP_CFG_CRC32_SLICE8), with hardware
+    kernels picked at compile time, or at runtime on x86 (LP_CFG_CRC32_HW):
+      CRC-32:  x86 PCLMULQDQ folding, ARMv8 CRC32 instructions
+      CRC-32C: x86 SSE4.2 crc32,      ARMv8 CRC32C instructions
+  - Check values: lp_crc32("123456789") == 0xCBF43926,
+                  lp_crc32c("123456789") == 0xE3069283.
+*/
+
+static LP_INLINE uint32_t lp_crc32_init(void) { return 0xFFFFFFFFu; }
+static LP_INLINE uint32_t lp_crc32_final(uint32_t st) { return st ^ 0xFFFFFFFFu; }
+
+uint32_t lp_crc32_update(uint32_t st, const void* data, size_t n);
+
+static LP_INLINE uint32_t lp_crc32(const void* data, size_t n) {
+  return lp_crc32_final(lp_crc32_update(lp_crc32_init(), data, n));
+}
+
+static LP_INLINE uint32_t lp_crc32c_init(void) { return 0xFFFFFFFFu; }
+static LP_INLINE uint32_t lp_crc32c_final(uint32_t st) { return st ^ 0xFFFFFFFFu; }
+
+uint32_t lp_crc32c_update(uint32_t st, const void* data, size_t n);
+
+static LP_INLINE uint32_t lp_crc32c(const void* data, size_t n) {
+  return lp_crc32c_final(lp_crc32c_update(lp_crc32c_init(), data, n));
+}
+
+// Table-only paths, bypassing hardware dispatch (tests/benchmarks).
+uint32_t lp_crc32_update_sw(uint32_t st, const void* data, size_t n);
+uint32_t lp_crc32c_update_sw(uint32_t st, const void* data, size_t n);
@@ -0,0 +1,92 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_port.h"
+#include "lp_assert.h"
+#include "lp_fmt.h"
+#include "lp_spsc_ring.h"
+
+/*
+  lp_dlog: deferred binary logging. Call sites only encode; formatting and
+  I/O happen later, on whichever thread drains.
+
+  - Each producer thread owns an lp_dlog_chan: an lp_spsc_ring over
+    caller memory, so memory is bounded and a push is one copy plus a
+    release store. A full ring drops the record and counts it; the drain
+    reports the count as a line of its own.
+  - A record holds the level, a timestamp (the logger's clock), the
+    format string's address as its id, and the arguments as raw bytes
+    (string arguments are copied, cut to fit LP_CFG_DLOG_MAX_RECORD). The
+    format must therefore outlive the drain: use a string literal.
+  - LP_DLOG(ch, level, "fmt {} {}", a, b) takes lp_fmt_appendf formats and
+    arguments, with a format string and 1..15 arguments; LP_DLOG_MSG logs a
+    plain string literal.
+  - One consumer at a time: lp_dlog_next pops from the channels round-robin
+    (in order within a channel, not across channels) and formats a line.
+    lp_port_dlog_start runs a drain thread on ports that have one.
+*/
+
+#if LP_CFG_ENABLE_ATOMICS
+
+// Nanoseconds, e.g. lp_port_now_ns.
+typedef uint64_t (*lp_dlog_clock_fn)(void);
+
+typedef struct lp_dlog lp_dlog;
+
+typedef struct {
+  lp_spsc_ring   ring;
+  lp_dlog*       log;
+  lp_atomic_size dropped;  // records lost to a full ring
+  size_t         reported; // consumer: drops already reported
+  uint32_t       id;       // registration order
+} lp_dlog_chan;
+
+struct lp_dlog {
+  lp_atomic_size   chans[LP_CFG_DLOG_MAX_CHANS]; // lp_dlog_chan*, 0 until published
+  lp_atomic_size   nchans;                       // slots claimed (may overshoot)
+  lp_dlog_clock_fn clock;     // NULL: timestamps are 0
+  lp_log_level_t   min_level; // lower levels are skipped at the call site
+  // consumer-owned
+  size_t           next_chan;
+  uint8_t          rec[LP_CFG_DLOG_MAX_RECORD];
+};
+
+void lp_dlog_init(lp_dlog* log, lp_dlog_clock_fn clock, lp_log_level_t min_level);
+
+// Registers a channel over mem (cap bytes, a power of two, at least
+// LP_CFG_DLOG_MAX_RECORD). Thread-safe; LP_ERR_FULL past
+// LP_CFG_DLOG_MAX_CHANS. Channels stay registered for the logger's life.
+lp_status_t lp_dlog_chan_init(lp_dlog* log, lp_dlog_chan* ch, void* mem, size_t cap);
+
+// args[0] is the format (LP_FMT_ARG_STR), the rest are the fields.
+// LP_ERR_FULL when the record was dropped.
+lp_status_t lp__dlog_write(lp_dlog_chan* ch, lp_log_level_t lvl, const lp_fmt_arg* args, size_t n);
+
+#define LP_DLOG(ch, lvl, ...)                                                        \
+  (((lvl) < (ch)->log->min_level) ? LP_OK                                            \
+   : lp__dlog_write((ch), (lvl), (const lp_fmt_arg[]){ LP__FMT_MAP(__VA_ARGS__) },   \
+                    LP__FMT_NARGS(__VA_ARGS__)))
+
+#define LP_DLOG_MSG(ch, lvl, msg)                                                    \
+  (((lvl) < (ch)->log->min_level) ? LP_OK                                            \
+   : lp__dlog_write((ch), (lvl), (const lp_fmt_arg[]){ lp_fmt_arg_str("{}"),         \
+                    lp_fmt_arg_str(msg) }, 2u))
+
+// Consumer: formats the next record (or a dropped-records notice) into
+// line, without a trailing newline:
+//   "<seconds>.<9 digits> <LVL> <text>"
+// false when every channel is empty.
+bool lp_dlog_next(lp_dlog* log, lp_fmtbuf* line);
+
+// Records dropped so far, over all channels.
+size_t lp_dlog_dropped(const lp_dlog* log);
+
+// Port: background drain (POSIX: a thread writing batches of lines to
+// stderr with writev, also flushed from lp_port_panic). One logger at a
+// time; LP_ERR_UNSUP without threads, LP_ERR_INVALID if already running.
+// Stop drains what is left.
+lp_status_t lp_port_dlog_start(lp_dlog* log);
+void        lp_port_dlog_stop(void);
+
+#endif
@@ -2,6 +2,7 @@
 #include "lp_platform.h"
 #include "lp_status.h"
 #include "lp_strview.h"
+#include "lp_utf8.h"
 
 /*
   lp_fmt: deterministic formatting into a preallocated buffer.
@@ -9,7 +10,9 @@
   Guarantees:
   - Never writes past cap.
   - Always keeps dst NUL-terminated if cap > 0.
-  - Tracks truncation.
+  - Tracks truncation. A cut never splits a UTF-8 sequence: the partial
+    sequence is dropped, and once truncated the buffer takes no more text
+    (so nothing lands after the gap).
   - No heap, no stdio, core-only.
 */
 
@@ -27,7 +30,7 @@ static LP_INLINE lp_fmtbuf lp_fmtbuf_make(char* dst, size_t cap) {
 }
 
 static LP_INLINE size_t lp_fmt_remaining(const lp_fmtbuf* fb) {
-  if (!fb || fb->cap == 0) return 0;
+  if (!fb || fb->cap == 0 || fb->truncated) return 0;
   // reserve 1 for NUL
   if (fb->len >= fb->cap) return 0;
   size_t usable = fb->cap - 1;
@@ -51,4 +54,168 @@ lp_status_t lp_fmt_append_hex_u32(lp_fmtbuf* fb, uint32_t v, bool uppercase);
 lp_status_t lp_fmt_append_hex_u64(lp_fmtbuf* fb, uint64_t v, bool uppercase);
 
 // Convenience: hex with 0x prefix
-lp_status_t lp_fmt_append_ptr(lp_fmtbuf* fb, const void* p);
\ No newline at end of file
+lp_status_t lp_fmt_append_ptr(lp_fmtbuf* fb, const void* p);
+
+// Floating point (no libc; LP_ERR_UNSUP when LP_CFG_FMT_FLOAT is 0).
+// Shortest digits that parse back to the same value, %g-like layout:
+// "0.1", "-2.5", "1e+21", "5e-324", "inf", "nan".
+lp_status_t lp_fmt_append_f32(lp_fmtbuf* fb, float v);
+lp_status_t lp_fmt_append_f64(lp_fmtbuf* fb, double v);
+
+// Fixed point, like "%.*f", but built from the shortest digits: they are
+// rounded half-to-even, and places past them print as 0 rather than the
+// binary expansion printf shows (0.1 at 20 places is 0.1000...). A value
+// whose shortest form ends in 5 right at the cut (2.675 at 2 places) can
+// differ from printf in the last digit.
+#define LP_FMT_MAX_PRECISION 40u
+lp_status_t lp_fmt_append_f32_fixed(lp_fmtbuf* fb, float v, uint32_t precision);
+lp_status_t lp_fmt_append_f64_fixed(lp_fmtbuf* fb, double v, uint32_t precision);
+
+// -------------------------
+// Format strings
+// -------------------------
+//
+//   lp_fmt_appendf(&fb, "id={} t={:8.3} flags={:#06x} name={:-10}|", id, t, f, name);
+//
+// Fields are "{}" or "{:spec}", spec = [flags][width][.prec][conv]:
+//   flags  '-' left-align, '0' zero-pad, '+' sign on positives, '#' 0x prefix
+//   width  minimum field width, 0..255
+//   prec   float/double only: fixed with prec fraction digits (else shortest)
+//   conv   'd' decimal, 'x'/'X' hex (minimal digits); omitted = by type
+// "{{" and "}}" are literal braces. The type comes from the argument itself
+// (_Generic), so there is no format/argument type mismatch to get wrong;
+// unsupported argument types fail to compile. Note that `true` and 'c' are
+// int constants in C; pass (bool)/(char) values to get those forms.
+//
+// Returns LP_ERR_INVALID for a malformed format, a conv that doesn't suit
+// the argument, or a field/argument count mismatch, and LP_ERR_RANGE for a
+// format of 64 KiB or more; text before the bad field has already been
+// appended. Truncation works as for every lp_fmt
+// append (LP_OK, fb->truncated set).
+
+typedef enum {
+  LP_FMT_ARG_I32 = 0,
+  LP_FMT_ARG_I64,
+  LP_FMT_ARG_U32,
+  LP_FMT_ARG_U64,
+  LP_FMT_ARG_BOOL,
+  LP_FMT_ARG_CHAR,
+  LP_FMT_ARG_STR,  // NUL-terminated; NULL prints "(null)"
+  LP_FMT_ARG_SV,
+  LP_FMT_ARG_PTR,
+  LP_FMT_ARG_F32,
+  LP_FMT_ARG_F64,
+} lp_fmt_arg_kind;
+
+typedef struct {
+  uint8_t kind; // lp_fmt_arg_kind
+  union {
+    int64_t     i;
+    uint64_t    u;
+    const char* s;
+    lp_strview  sv;
+    const void* p;
+    double      f;
+  } v;
+} lp_fmt_arg;
+
+static LP_INLINE lp_fmt_arg lp_fmt_arg_i32(int32_t x)       { lp_fmt_arg a = { .kind = LP_FMT_ARG_I32 }; a.v.i = x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_i64(int64_t x)       { lp_fmt_arg a = { .kind = LP_FMT_ARG_I64 }; a.v.i = x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_u32(uint32_t x)      { lp_fmt_arg a = { .kind = LP_FMT_ARG_U32 }; a.v.u = x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_u64(uint64_t x)      { lp_fmt_arg a = { .kind = LP_FMT_ARG_U64 }; a.v.u = x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_bool(bool x)         { lp_fmt_arg a = { .kind = LP_FMT_ARG_BOOL }; a.v.u = x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_char(char x)         { lp_fmt_arg a = { .kind = LP_FMT_ARG_CHAR }; a.v.u = (uint8_t)x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_str(const char* x)   { lp_fmt_arg a = { .kind = LP_FMT_ARG_STR }; a.v.s = x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_sv(lp_strview x)     { lp_fmt_arg a = { .kind = LP_FMT_ARG_SV }; a.v.sv = x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_ptr(const void* x)   { lp_fmt_arg a = { .kind = LP_FMT_ARG_PTR }; a.v.p = x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_f32(float x)         { lp_fmt_arg a = { .kind = LP_FMT_ARG_F32 }; a.v.f = x; return a; }
+static LP_INLINE lp_fmt_arg lp_fmt_arg_f64(double x)        { lp_fmt_arg a = { .kind = LP_FMT_ARG_F64 }; a.v.f = x; return a; }
+
+#define LP_FMT_ARG(x) _Generic((x),                                          \
+  bool: lp_fmt_arg_bool,                                                    \
+  char: lp_fmt_arg_char,                                                    \
+  signed char: lp_fmt_arg_i32, short: lp_fmt_arg_i32, int: lp_fmt_arg_i32,  \
+  long: lp_fmt_arg_i64, long long: lp_fmt_arg_i64,                          \
+  unsigned char: lp_fmt_arg_u32, unsigned short: lp_fmt_arg_u32,            \
+  unsigned int: lp_fmt_arg_u32,                                             \
+  unsigned long: lp_fmt_arg_u64, unsigned long long: lp_fmt_arg_u64,        \
+  char*: lp_fmt_arg_str, const char*: lp_fmt_arg_str,                       \
+  float: lp_fmt_arg_f32, double: lp_fmt_arg_f64,                           \
+  lp_strview: lp_fmt_arg_sv,                                                \
+  default: lp_fmt_arg_ptr)(x)
+
+// Precompiled format: parse once, reuse on the hot path. Each spec is a
+// literal run of the format followed by at most one field.
+enum {
+  LP_FMT_CONV_NONE = 0, // literal only
+  LP_FMT_CONV_DEFAULT,
+  LP_FMT_CONV_DEC,
+  LP_FMT_CONV_HEX,
+  LP_FMT_CONV_HEX_UPPER,
+};
+
+enum {
+  LP_FMT_F_LEFT = 1u << 0,
+  LP_FMT_F_ZERO = 1u << 1,
+  LP_FMT_F_PLUS = 1u << 2,
+  LP_FMT_F_ALT  = 1u << 3,
+};
+
+typedef struct {
+  uint16_t lit_off; // literal text before the field, as an offset into fmt
+  uint16_t lit_len;
+  uint8_t  conv;    // LP_FMT_CONV_*
+  uint8_t  flags;   // LP_FMT_F_*
+  uint8_t  width;
+  uint8_t  prec;    // LP_FMT_PREC_NONE or 0..LP_FMT_MAX_PRECISION
+} lp_fmt_spec;
+
+#define LP_FMT_PREC_NONE 0xFFu
+
+typedef struct {
+  const char*        fmt;   // must outlive the compiled form
+  const lp_fmt_spec* specs;
+  size_t             count;
+  size_t             nargs; // fields expected
+} lp_fmt_compiled;
+
+// Formats must be shorter than 64 KiB (LP_ERR_RANGE otherwise, also when
+// specs[cap] is too small).
+lp_status_t lp_fmt_compile(lp_fmt_compiled* out, const char* fmt, lp_fmt_spec* specs, size_t cap);
+lp_status_t lp_fmt_appendc(lp_fmtbuf* fb, const lp_fmt_compiled* c, const lp_fmt_arg* args, size_t nargs);
+
+// Same 64 KiB format limit (LP_ERR_RANGE), as for lp_fmt_appendf.
+lp_status_t lp_fmt_appendv(lp_fmtbuf* fb, const char* fmt, const lp_fmt_arg* args, size_t nargs);
+
+// Up to 15 arguments after the format. lp_fmt_appendcf needs at least one
+// argument; call lp_fmt_appendc(fb, c, NULL, 0) for a field-less format.
+#define lp_fmt_appendf(fb, ...) \
+  lp__fmt_appendf((fb), (const lp_fmt_arg[]){ LP__FMT_MAP(__VA_ARGS__) }, LP__FMT_NARGS(__VA_ARGS__))
+
+#define lp_fmt_appendcf(fb, compiled, ...) \
+  lp_fmt_appendc((fb), (compiled), (const lp_fmt_arg[]){ LP__FMT_MAP(__VA_ARGS__) }, LP__FMT_NARGS(__VA_ARGS__))
+
+// args[0] is the format (LP_FMT_ARG_STR), the rest are the fields.
+lp_status_t lp__fmt_appendf(lp_fmtbuf* fb, const lp_fmt_arg* args, size_t n);
+
+#define LP__FMT_NARGS(...) LP__FMT_NARGS_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LP__FMT_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+#define LP__FMT_CAT(a, b) LP__FMT_CAT_(a, b)
+#define LP__FMT_CAT_(a, b) a##b
+#define LP__FMT_MAP(...) LP__FMT_CAT(LP__FMT_MAP_, LP__FMT_NARGS(__VA_ARGS__))(__VA_ARGS__)
+#define LP__FMT_MAP_1(a) LP_FMT_ARG(a)
+#define LP__FMT_MAP_2(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_1(__VA_ARGS__)
+#define LP__FMT_MAP_3(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_2(__VA_ARGS__)
+#define LP__FMT_MAP_4(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_3(__VA_ARGS__)
+#define LP__FMT_MAP_5(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_4(__VA_ARGS__)
+#define LP__FMT_MAP_6(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_5(__VA_ARGS__)
+#define LP__FMT_MAP_7(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_6(__VA_ARGS__)
+#define LP__FMT_MAP_8(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_7(__VA_ARGS__)
+#define LP__FMT_MAP_9(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_8(__VA_ARGS__)
+#define LP__FMT_MAP_10(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_9(__VA_ARGS__)
+#define LP__FMT_MAP_11(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_10(__VA_ARGS__)
+#define LP__FMT_MAP_12(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_11(__VA_ARGS__)
+#define LP__FMT_MAP_13(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_12(__VA_ARGS__)
+#define LP__FMT_MAP_14(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_13(__VA_ARGS__)
+#define LP__FMT_MAP_15(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_14(__VA_ARGS__)
+#define LP__FMT_MAP_16(a, ...) LP_FMT_ARG(a), LP__FMT_MAP_15(__VA_ARGS__)
@@ -0,0 +1,58 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_types.h"
+
+/*
+  lp_hash: fast non-cryptographic 64-bit hashing, for hash tables,
+  sharding and dedup. Not for anything an attacker can choose keys for
+  unless the seed is secret, and never for integrity (see lp_crc32).
+
+  - lp_hash64 follows the wyhash (final version 4) construction: inputs
+    up to 16 bytes take two overlapping loads and two 64x64->128
+    multiplies; longer ones are folded 48 bytes per step in three
+    independent lanes. Values are lp_hash64's own, not those of any
+    particular wyhash build.
+  - Output is the same on every platform (input read little-endian) and
+    is pinned by tests/test_hash.c, so it may be persisted.
+  - The streaming state gives the same value as one lp_hash64 call over
+    the concatenated input, however it is split.
+*/
+
+uint64_t lp_hash64(const void* data, size_t n, uint64_t seed);
+
+static LP_INLINE uint64_t lp_hash_sv(lp_strview s, uint64_t seed) {
+  return lp_hash64(s.ptr, s.len, seed);
+}
+
+// Integer keys: a bijective finalizer (MurmurHash3 fmix64), fully inline.
+// Not equal to lp_hash64 of the key's bytes.
+static LP_INLINE uint64_t lp_hash_u64(uint64_t x, uint64_t seed) {
+  x ^= seed;
+  x ^= x >> 33;
+  x *= 0xFF51AFD7ED558CCDull;
+  x ^= x >> 33;
+  x *= 0xC4CEB9FE1A85EC53ull;
+  x ^= x >> 33;
+  return x;
+}
+
+// -------------------------
+// Streaming
+// -------------------------
+//
+//   lp_hash64_state st;
+//   lp_hash64_init(&st, seed);
+//   lp_hash64_update(&st, a, na);
+//   lp_hash64_update(&st, b, nb);
+//   uint64_t h = lp_hash64_final(&st); // == lp_hash64(a ++ b, seed)
+
+typedef struct {
+  uint64_t lane[3];
+  uint64_t total;   // bytes so far
+  uint32_t pending; // bytes in buf[16..], at most 48
+  uint8_t  buf[64]; // last 16 bytes folded, then the pending bytes
+} lp_hash64_state;
+
+void lp_hash64_init(lp_hash64_state* st, uint64_t seed);
+void lp_hash64_update(lp_hash64_state* st, const void* data, size_t n);
+uint64_t lp_hash64_final(const lp_hash64_state* st); // state stays usable
@@ -0,0 +1,120 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_types.h"
+#include "lp_arena.h"
+#include "lp_fmt.h"
+
+/*
+  lp_hist: log-linear (HDR-style) histogram of uint64_t values.
+
+  - Each power of two is split into 2^sub_bits equal buckets (values below
+    2^(sub_bits+1) get one bucket each), so a bucket's width is under
+    2^-sub_bits of its values: sub_bits 7 keeps reported values within
+    0.8%. Values up to 2^max_bits - 1 are tracked; larger ones are counted
+    in the top bucket and in `clamped`.
+  - Counters live in caller memory (lp_hist_buckets of them) or an arena;
+    there is no heap use. sub_bits 7, max_bits 40 (ns up to ~18 min):
+    4352 counters, 34 KiB. sub_bits 4 (6% buckets), max_bits 32: 464
+    counters, 3.6 KiB.
+  - lp_hist_record is O(1) and branch-free: a clz, a shift and a few
+    adds/selects.
+  - Not thread-safe: give each thread its own histogram and lp_hist_merge
+    them (same sub_bits) once the writers are quiescent.
+  - lp_hist_encode writes a compact form (varints over runs of non-empty
+    buckets); lp_hist_decode_add merges one back. lp_hist_dump and
+    lp_hist_dump_encoded render a summary line or the base64 form through
+    lp_fmt.
+*/
+
+#define LP_HIST_MAX_SUB_BITS 16u
+
+typedef struct {
+  uint64_t* counts;
+  size_t    nbuckets;
+  uint64_t  highest; // largest trackable value, 2^max_bits - 1
+  uint64_t  total;
+  uint64_t  sum;     // of recorded (clamped) values; wraps on overflow
+  uint64_t  min;     // UINT64_MAX while empty
+  uint64_t  max;
+  uint64_t  clamped; // values above `highest`
+  uint8_t   sub_bits;
+  uint8_t   max_bits;
+} lp_hist;
+
+// Counters needed; 0 unless 1 <= sub_bits <= LP_HIST_MAX_SUB_BITS and
+// sub_bits < max_bits <= 64.
+size_t lp_hist_buckets(uint32_t sub_bits, uint32_t max_bits);
+
+// LP_ERR_INVALID on bad parameters, LP_ERR_NOMEM if n is too small.
+lp_status_t lp_hist_init(lp_hist* h, uint64_t* counts, size_t n, uint32_t sub_bits, uint32_t max_bits);
+lp_status_t lp_hist_init_arena(lp_hist* h, lp_arena* a, uint32_t sub_bits, uint32_t max_bits);
+
+void lp_hist_reset(lp_hist* h);
+
+static LP_INLINE uint32_t lp__hist_clz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (uint32_t)__builtin_clzll(x);
+#else
+  uint32_t n = 0;
+  while (!(x & (1ull << 63))) { x <<= 1; n++; }
+  return n;
+#endif
+}
+
+// v < 2^(sub_bits+1) maps to itself; above, v keeps its top sub_bits+1
+// bits and the bucket is (shift << sub_bits) + (v >> shift).
+static LP_INLINE size_t lp__hist_index(uint64_t v, uint32_t sub_bits) {
+  uint32_t shift = 63u - lp__hist_clz64(v | (1ull << sub_bits)) - sub_bits;
+  return ((size_t)shift << sub_bits) + (size_t)(v >> shift);
+}
+
+static LP_INLINE void lp_hist_record_n(lp_hist* h, uint64_t v, uint64_t n) {
+  uint64_t over = v > h->highest;
+  v = over ? h->highest : v;
+  h->counts[lp__hist_index(v, h->sub_bits)] += n;
+  h->clamped += over * n;
+  h->total += n;
+  h->sum += v * n;
+  h->min = (v < h->min) ? v : h->min;
+  h->max = (v > h->max) ? v : h->max;
+}
+
+static LP_INLINE void lp_hist_record(lp_hist* h, uint64_t v) {
+  lp_hist_record_n(h, v, 1u);
+}
+
+// Value at or below which p percent (0..100) of the recorded values fall,
+// reported as the top of its bucket and kept within [min, max]. 0 when
+// empty.
+uint64_t lp_hist_percentile(const lp_hist* h, double p);
+
+// Several percentiles in one pass; ps must be ascending.
+void lp_hist_percentiles(const lp_hist* h, const double* ps, uint64_t* out, size_t n);
+
+static LP_INLINE uint64_t lp_hist_mean(const lp_hist* h) {
+  return h->total ? h->sum / h->total : 0u;
+}
+
+// dst += src. LP_ERR_INVALID unless both have the same sub_bits; counts
+// above dst's range go to its top bucket (and into clamped).
+lp_status_t lp_hist_merge(lp_hist* dst, const lp_hist* src);
+
+// Exact size of lp_hist_encode's output (one pass over the buckets).
+size_t lp_hist_encoded_len(const lp_hist* h);
+
+// LP_ERR_RANGE if dst is too small.
+lp_status_t lp_hist_encode(const lp_hist* h, lp_span_u8_mut dst, size_t* out_len);
+
+// Adds an encoded histogram into h, as lp_hist_merge. LP_ERR_INVALID on
+// malformed input; h is unchanged on error.
+lp_status_t lp_hist_decode_add(lp_hist* h, lp_span_u8 src);
+
+// One line:
+//   "<name>: n=.. min=.. p50=.. p90=.. p99=.. p999=.. max=.. mean=.. clamped=.."
+lp_status_t lp_hist_dump(lp_fmtbuf* fb, const char* name, const lp_hist* h);
+
+// lp_hist_encode's output as unpadded base64url, appended in chunks (no
+// scratch buffer needed). Truncates like any lp_fmt append.
+lp_status_t lp_hist_dump_encoded(lp_fmtbuf* fb, const lp_hist* h);
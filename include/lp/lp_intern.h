@@ -0,0 +1,76 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_port.h"
+#include "lp_assert.h"
+#include "lp_types.h"
+#include "lp_arena.h"
+
+/*
+  lp_interner: stores each distinct string once and hands back a dense id
+  (0, 1, 2, ... in first-seen order) and a canonical lp_strview. Two
+  canonical views are equal exactly when their pointers are, so hot-path
+  comparisons become lp_intern_eq / id compares instead of lp_sv_eq.
+
+  - String bytes are copied into the arena (NUL-terminated) and stay put
+    for the interner's lifetime; don't rewind the arena past them.
+  - max_ids is fixed at init: the id table and an open-addressing index
+    (linear probing, at most half full) are taken from the same arena, so
+    nothing ever moves. lp_intern returns LP_ERR_FULL past max_ids.
+  - Index slots hold id + 1 in the low 24 bits and high hash bits above,
+    so a probe rejects most non-matching slots without touching the
+    string. Hence max_ids <= LP_INTERN_MAX_IDS.
+  - LP_INTERN_CONCURRENT (needs LP_CFG_ENABLE_ATOMICS): lp_intern_find,
+    lp_intern_str and the lookup half of lp_intern are lock-free and may
+    run on any thread; adding a new string takes a spin lock shared by
+    writers. The arena must not be used elsewhere meanwhile.
+*/
+
+typedef uint32_t lp_intern_id;
+
+#define LP_INTERN_NONE    ((lp_intern_id)UINT32_MAX)
+#define LP_INTERN_MAX_IDS 0xFFFFFFu
+
+enum {
+  LP_INTERN_CONCURRENT = 1u,
+};
+
+#if LP_CFG_ENABLE_ATOMICS
+typedef lp_atomic_size lp__intern_word;
+#else
+typedef size_t lp__intern_word;
+#endif
+
+typedef struct {
+  lp_arena*        arena;
+  lp_strview*      strs;       // by id
+  lp__intern_word* index;      // 0: empty
+  size_t           index_mask;
+  uint64_t         seed;
+  uint32_t         max_ids;
+  uint32_t         flags;
+  lp__intern_word  count;      // ids handed out
+  lp__intern_word  lock;       // LP_INTERN_CONCURRENT writers
+} lp_interner;
+
+// Bytes taken from the arena by lp_intern_init (string bytes come on top).
+size_t lp_intern_table_size(uint32_t max_ids);
+
+lp_status_t lp_intern_init(lp_interner* in, lp_arena* a, uint32_t max_ids, uint32_t flags);
+
+// Finds or adds s. id and canon are optional outputs.
+lp_status_t lp_intern(lp_interner* in, lp_strview s, lp_intern_id* id, lp_strview* canon);
+
+// Id of s if already interned, else LP_INTERN_NONE. Never modifies.
+lp_intern_id lp_intern_find(const lp_interner* in, lp_strview s);
+
+// Canonical view for id; an empty view for an unknown id.
+lp_strview lp_intern_str(const lp_interner* in, lp_intern_id id);
+
+size_t lp_intern_count(const lp_interner* in);
+
+// Both views must be canonical (from the same interner).
+static LP_INLINE bool lp_intern_eq(lp_strview a, lp_strview b) {
+  return a.ptr == b.ptr;
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_assert.h"
+#include "lp_types.h"
+#include "lp_arena.h"
+
+/*
+  lp_map: open-addressing hash map (Swiss-table layout).
+
+  - One control byte per slot: EMPTY, DELETED, or the low 7 bits of the
+    key's hash. A lookup hashes once, then checks a group of 16 control
+    bytes at a time (SSE2 on x86, 8-byte SWAR elsewhere); keys are only
+    compared where those 7 bits match, so a miss rarely touches a slot.
+  - Keys are uint64_t or lp_strview, chosen at init; values are val_size
+    bytes stored inline next to the key, 8-byte aligned.
+  - lp_strview keys are not copied: the bytes must stay valid while the
+    entry is in the map (keep them in an arena, or intern them).
+  - Storage:
+      lp_map_init        caller memory, fixed capacity
+      lp_map_init_arena  from an lp_arena, fixed capacity
+      lp_map_init_heap   lp_port_malloc (LP_CFG_ENABLE_ALLOC), grows
+    Fixed maps hold up to 7/8 of their slots and then return LP_ERR_FULL;
+    deleted slots are reclaimed in place. A heap map grows by allocating
+    the next table and moving 16 old slots per insert/remove, so no single
+    call pays for a full rehash; lookups check both tables meanwhile.
+  - Value pointers stay valid until the next insert or remove.
+*/
+
+typedef enum {
+  LP_MAP_KEY_U64 = 0,
+  LP_MAP_KEY_SV  = 1,
+} lp_map_key_kind;
+
+typedef struct {
+  uint8_t* ctrl;        // cap control bytes; slots follow (one allocation)
+  uint8_t* slots;
+  size_t   cap;         // power of two >= 16, or 0 for no table
+  size_t   used;        // live entries
+  size_t   growth_left; // EMPTY slots that may still be filled
+} lp_map_table;
+
+typedef struct {
+  lp_map_table t;           // inserts go here
+  lp_map_table old;         // heap map: table being drained (cap 0 if none)
+  size_t       migrate_pos; // next slot of old to move
+  size_t       val_size;
+  size_t       val_off;     // value offset within a slot
+  size_t       stride;      // bytes per slot
+  uint64_t     seed;        // hash seed; set before the first insert
+  uint8_t      kind;        // lp_map_key_kind
+  bool         heap;
+} lp_map;
+
+// Bytes lp_map_init needs to hold `entries` entries.
+size_t lp_map_mem_size(lp_map_key_kind kind, size_t val_size, size_t entries);
+
+lp_status_t lp_map_init(lp_map* m, lp_map_key_kind kind, size_t val_size, void* mem, size_t mem_size);
+lp_status_t lp_map_init_arena(lp_map* m, lp_map_key_kind kind, size_t val_size, lp_arena* a, size_t entries);
+
+#if LP_CFG_ENABLE_ALLOC
+// entries: initial capacity hint (0 allocates on first insert).
+lp_status_t lp_map_init_heap(lp_map* m, lp_map_key_kind kind, size_t val_size, size_t entries);
+#endif
+
+// Frees heap tables; a no-op for caller/arena storage. The map is left empty.
+void lp_map_destroy(lp_map* m);
+void lp_map_clear(lp_map* m);
+
+static LP_INLINE size_t lp_map_len(const lp_map* m) {
+  LP_ASSERT(m);
+  return m->t.used + m->old.used;
+}
+
+// Pointer to the value, or NULL.
+void* lp_map_get_u64(const lp_map* m, uint64_t key);
+void* lp_map_get_sv(const lp_map* m, lp_strview key);
+
+// Finds or inserts key; *val points at its value (zeroed when new).
+// *inserted (optional) tells which. LP_ERR_FULL when a fixed map is full,
+// LP_ERR_NOMEM when a heap map can't grow.
+lp_status_t lp_map_emplace_u64(lp_map* m, uint64_t key, void** val, bool* inserted);
+lp_status_t lp_map_emplace_sv(lp_map* m, lp_strview key, void** val, bool* inserted);
+
+// Insert or overwrite with val_size bytes from val.
+lp_status_t lp_map_put_u64(lp_map* m, uint64_t key, const void* val);
+lp_status_t lp_map_put_sv(lp_map* m, lp_strview key, const void* val);
+
+// true if the key was there.
+bool lp_map_remove_u64(lp_map* m, uint64_t key);
+bool lp_map_remove_sv(lp_map* m, lp_strview key);
+
+// Iteration in no particular order; the map must not change meanwhile.
+//
+//   size_t it = 0;
+//   lp_map_entry e;
+//   while (lp_map_next(&m, &it, &e)) { ... }
+typedef struct {
+  uint64_t   key_u64; // LP_MAP_KEY_U64
+  lp_strview key_sv;  // LP_MAP_KEY_SV
+  void*      val;
+} lp_map_entry;
+
+bool lp_map_next(const lp_map* m, size_t* it, lp_map_entry* e);
@@ -0,0 +1,46 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_status.h"
+#include "lp_assert.h"
+#include "lp_types.h"
+
+/*
+  lp_mirror_ring: byte ring whose storage is mapped twice back to back by the
+  port (lp_port_vm_mirror_alloc), so any region of up to cap bytes is one
+  contiguous span even when it crosses the end. Records never need to be
+  copied out to be parsed.
+
+  - Storage comes from the port; returns LP_ERR_UNSUP where there is no MMU.
+  - cap is the requested size rounded up to the page size.
+  - Single-threaded, like lp_ring.
+*/
+
+typedef struct {
+  uint8_t* buf;  // 2 * cap bytes of address space
+  size_t   cap;  // bytes
+  size_t   tail; // read offset, [0, cap)
+  size_t   len;  // bytes queued
+} lp_mirror_ring;
+
+lp_status_t lp_mirror_ring_create(lp_mirror_ring* r, size_t min_cap);
+void        lp_mirror_ring_destroy(lp_mirror_ring* r);
+
+static LP_INLINE size_t lp_mirror_ring_len(const lp_mirror_ring* r) {
+  LP_ASSERT(r);
+  return r->len;
+}
+
+static LP_INLINE size_t lp_mirror_ring_free(const lp_mirror_ring* r) {
+  LP_ASSERT(r);
+  return r->cap - r->len;
+}
+
+// Zero-copy access, same contract as lp_ring_reserve/peek but one span.
+lp_status_t lp_mirror_ring_reserve(lp_mirror_ring* r, size_t n, lp_span_u8_mut* out);
+lp_status_t lp_mirror_ring_commit (lp_mirror_ring* r, size_t n);
+lp_status_t lp_mirror_ring_peek   (const lp_mirror_ring* r, size_t n, lp_span_u8* out);
+lp_status_t lp_mirror_ring_consume(lp_mirror_ring* r, size_t n);
+
+// Copying access: a single memcpy each regardless of wrap.
+lp_status_t lp_mirror_ring_push(lp_mirror_ring* r, const void* data, size_t n);
+lp_status_t lp_mirror_ring_pop (lp_mirror_ring* r, void* out, size_t n);
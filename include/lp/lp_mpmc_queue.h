@@ -0,0 +1,57 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_port.h"
+#include "lp_assert.h"
+
+/*
+  lp_mpmc_queue: bounded lock-free multi-producer/multi-consumer queue of
+  fixed-size slots over caller-provided memory.
+
+  - Each slot carries a sequence number that says whether it is ready for
+    the next producer (seq == pos) or consumer (seq == pos + 1); producers
+    and consumers claim positions with a CAS on their own counter.
+  - cap must be a power of two. Use lp_mpmc_queue_mem_size() to size `mem`;
+    `mem` must be aligned to sizeof(size_t).
+  - Items are copied in and out with memcpy (elem_size bytes).
+*/
+
+#if LP_CFG_ENABLE_ATOMICS
+
+typedef struct {
+  // read-only after init
+  uint8_t* slots;
+  size_t   stride;    // bytes per slot (seq + item, padded)
+  size_t   elem_size;
+  size_t   mask;      // cap - 1
+
+  LP_ALIGNAS(LP_CFG_CACHE_LINE) lp_atomic_size enq; // next position to fill
+  LP_ALIGNAS(LP_CFG_CACHE_LINE) lp_atomic_size deq; // next position to drain
+} lp_mpmc_queue;
+
+// Bytes of backing memory needed for `cap` slots of `elem_size` bytes.
+lp_status_t lp_mpmc_queue_mem_size(size_t cap, size_t elem_size, size_t* out);
+
+lp_status_t lp_mpmc_queue_init(lp_mpmc_queue* q, void* mem, size_t mem_size,
+                               size_t cap, size_t elem_size);
+
+static LP_INLINE size_t lp_mpmc_queue_cap(const lp_mpmc_queue* q) {
+  LP_ASSERT(q);
+  return q->mask + 1u;
+}
+
+// Snapshot only; may be stale by the time it returns.
+static LP_INLINE size_t lp_mpmc_queue_len(const lp_mpmc_queue* q) {
+  LP_ASSERT(q);
+  size_t deq = lp_port_atomic_load(&q->deq, LP_MO_ACQUIRE);
+  size_t enq = lp_port_atomic_load(&q->enq, LP_MO_ACQUIRE);
+  size_t n = enq - deq;
+  return (n > q->mask + 1u) ? 0 : n;
+}
+
+// LP_ERR_FULL / LP_ERR_EMPTY when no slot is available right now.
+lp_status_t lp_mpmc_queue_push(lp_mpmc_queue* q, const void* item);
+lp_status_t lp_mpmc_queue_pop (lp_mpmc_queue* q, void* out);
+
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_status.h"
+#include "lp_types.h"
+
+/*
+  lp_parse: numbers from length-bounded text (no NUL needed, no heap, no
+  locale, no errno).
+
+  - The number must start at s.ptr[0]. Leading whitespace is not skipped.
+  - consumed != NULL: parse the longest valid prefix and store its length.
+    consumed == NULL: the whole view must be the number.
+  - LP_ERR_INVALID: no digits (or trailing junk when consumed is NULL).
+    *out is untouched and *consumed is 0.
+  - LP_ERR_OVERFLOW: syntactically valid but out of range. *out is clamped
+    (UINT64_MAX, INT64_MIN/MAX, +-inf) and *consumed covers the number.
+*/
+
+// Decimal digits only: "0", "007", "18446744073709551615". No sign.
+lp_status_t lp_parse_u64(lp_strview s, uint64_t* out, size_t* consumed);
+// Optional '+' or '-', then decimal digits.
+lp_status_t lp_parse_i64(lp_strview s, int64_t* out, size_t* consumed);
+
+// strtod syntax without hex floats: [+-] digits [. digits] [(e|E) [+-] digits],
+// at least one mantissa digit; also "inf", "infinity" and "nan" (any case).
+// Correctly rounded (round-half-even) for any number of digits. Results that
+// underflow to zero or a subnormal are LP_OK. LP_ERR_UNSUP when
+// LP_CFG_PARSE_FLOAT is 0.
+lp_status_t lp_parse_f64(lp_strview s, double* out, size_t* consumed);
@@ -6,13 +6,27 @@
 #if defined(_MSC_VER)
   #define LP_INLINE __forceinline
   #define LP_NORETURN __declspec(noreturn)
+  #define LP_ALIGNAS(n) __declspec(align(n))
+  #define LP_LIKELY(x) (x)
+  #define LP_UNLIKELY(x) (x)
 #else
   #define LP_INLINE inline __attribute__((always_inline))
   #define LP_NORETURN __attribute__((noreturn))
+  #define LP_ALIGNAS(n) __attribute__((aligned(n)))
+  #define LP_LIKELY(x) __builtin_expect(!!(x), 1)
+  #define LP_UNLIKELY(x) __builtin_expect(!!(x), 0)
 #endif
 
 #define LP_UNUSED(x) ((void)(x))
 
+// Host byte order, when the compiler tells us; otherwise left undefined and
+// lp_bytes falls back to a runtime check.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+  #define LP_LITTLE_ENDIAN (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#elif defined(_MSC_VER)
+  #define LP_LITTLE_ENDIAN 1
+#endif
+
 #if __STDC_VERSION__ >= 201112L
   #define LP_STATIC_ASSERT(expr, msg) _Static_assert((expr), msg)
 #else
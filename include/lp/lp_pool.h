@@ -0,0 +1,77 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_port.h"
+#include "lp_assert.h"
+#include "lp_arena.h"
+#include "lp_alloc_stats.h"
+
+/*
+  lp_pool: fixed-size object pool with an intrusive free list.
+
+  - Storage from caller memory (lp_pool_init) or an lp_arena
+    (lp_pool_init_arena). Free objects hold the list link, so there is no
+    per-object overhead; alloc and free are O(1).
+  - live / high_water count objects currently out and the peak since init.
+  - With LP_CFG_DEBUG, freed objects are poisoned (0xDD) and checked on
+    reuse, fresh objects are filled with 0xCD, and freeing an object twice
+    or one the pool doesn't own returns LP_ERR_INVALID.
+*/
+
+typedef struct lp_pool_node lp_pool_node;
+struct lp_pool_node {
+  lp_pool_node* next;
+#if LP_CFG_DEBUG
+  uintptr_t     tag;  // next ^ LP__POOL_FREE_TAG while on the free list
+#endif
+};
+
+typedef struct {
+  uint8_t*      mem;
+  size_t        stride;  // bytes per object (>= sizeof(lp_pool_node), aligned)
+  size_t        count;   // objects in the pool
+  lp_pool_node* free_list;
+  size_t        live;
+  size_t        high_water;
+#if LP_CFG_ALLOC_STATS
+  size_t        obj_size;  // as requested; stride - obj_size counts as padding
+  lp_alloc_stats stats;
+#endif
+} lp_pool;
+
+lp_status_t lp_pool_init(lp_pool* p, void* mem, size_t mem_size, size_t obj_size, size_t align);
+lp_status_t lp_pool_init_arena(lp_pool* p, lp_arena* a, size_t count, size_t obj_size, size_t align);
+
+lp_status_t lp_pool_alloc(lp_pool* p, void** out); // LP_ERR_NOMEM when exhausted
+lp_status_t lp_pool_free (lp_pool* p, void* obj);
+
+static LP_INLINE size_t lp_pool_live(const lp_pool* p) {
+  LP_ASSERT(p);
+  return p->live;
+}
+
+static LP_INLINE size_t lp_pool_high_water(const lp_pool* p) {
+  LP_ASSERT(p);
+  return p->high_water;
+}
+
+#if LP_CFG_ENABLE_ATOMICS
+/*
+  lp_pool_mt: thread-safe variant. The free list is a lock-free stack whose
+  head packs a 32-bit object index with a 32-bit version tag, bumped on every
+  pop, so a stale CAS after an ABA reuse always fails. No live/high-water
+  counters (they would put a shared cache line on the hot path).
+*/
+typedef struct {
+  uint8_t* mem;
+  size_t   stride;
+  uint32_t count;
+
+  LP_ALIGNAS(LP_CFG_CACHE_LINE) uint64_t head; // (tag << 32) | (index + 1); 0 = empty
+} lp_pool_mt;
+
+lp_status_t lp_pool_mt_init(lp_pool_mt* p, void* mem, size_t mem_size, size_t obj_size, size_t align);
+lp_status_t lp_pool_mt_alloc(lp_pool_mt* p, void** out);
+lp_status_t lp_pool_mt_free (lp_pool_mt* p, void* obj);
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 #include "lp_platform.h"
 #include "lp_config.h"
+#include "lp_status.h"
 
 typedef enum {
   LP_LOG_DEBUG = 0,
@@ -12,13 +13,25 @@ typedef enum {
 // Must exist on all platforms
 LP_NORETURN void lp_port_panic(const char* msg);
 
+// Run once by lp_port_panic before it reports (e.g. to flush deferred
+// logs); a panic from inside the hook skips it. NULL clears it.
+void lp_port_set_panic_hook(void (*hook)(void));
+
 // Optional
 #if LP_CFG_ENABLE_LOG
 void lp_port_log(lp_log_level_t lvl, const char* msg);
 #endif
 
 #if LP_CFG_ENABLE_TIME
+// Monotonic clock (not wall time), from an arbitrary origin.
+uint64_t lp_port_now_ns(void);
 uint64_t lp_port_now_us(void);
+
+// Free-running cycle counter (TSC, CNTVCT, DWT CYCCNT): cheap, meant for
+// short intervals. lp_port_cycles_per_sec converts; where the rate isn't
+// architectural it is calibrated against lp_port_now_ns on first use.
+uint64_t lp_port_cycles(void);
+uint64_t lp_port_cycles_per_sec(void);
 #endif
 
 #if LP_CFG_ENABLE_ALLOC
@@ -26,3 +39,54 @@ void* lp_port_malloc(size_t sz);
 void  lp_port_free(void* p);
 #endif
 
+
+#if LP_CFG_ENABLE_ATOMICS
+/*
+  Atomics used by the lock-free containers. Memory order is passed as one of
+  the LP_MO_* constants; implementations may strengthen but never weaken it.
+
+  The default maps onto the GCC/Clang __atomic builtins. A port that needs its
+  own barriers (e.g. single-core MCU with DMB) defines LP_PORT_ATOMICS_H to a
+  header providing the same names; see port/baremetal/lp_port_atomics.h.
+*/
+typedef size_t lp_atomic_size;
+
+#if defined(LP_PORT_ATOMICS_H)
+  #include LP_PORT_ATOMICS_H
+#elif defined(__GNUC__) || defined(__clang__)
+  #define LP_MO_RELAXED __ATOMIC_RELAXED
+  #define LP_MO_ACQUIRE __ATOMIC_ACQUIRE
+  #define LP_MO_RELEASE __ATOMIC_RELEASE
+  #define LP_MO_ACQ_REL __ATOMIC_ACQ_REL
+  #define LP_MO_SEQ_CST __ATOMIC_SEQ_CST
+
+  #define lp_port_atomic_load(p, mo)      __atomic_load_n((p), (mo))
+  #define lp_port_atomic_store(p, v, mo)  __atomic_store_n((p), (v), (mo))
+  #define lp_port_atomic_fetch_add(p, v, mo) __atomic_fetch_add((p), (v), (mo))
+  // On failure *expected is updated with the current value.
+  #define lp_port_atomic_cas_weak(p, expected, desired, mo_ok, mo_fail) \
+    __atomic_compare_exchange_n((p), (expected), (desired), true, (mo_ok), (mo_fail))
+#else
+  #error "lp: no default atomics for this toolchain; define LP_PORT_ATOMICS_H"
+#endif
+
+// Thread-local storage class (LP_PORT_ATOMICS_H may define it first; a
+// single-threaded target can define it empty).
+#ifndef LP_PORT_THREAD_LOCAL
+  #if defined(_MSC_VER)
+    #define LP_PORT_THREAD_LOCAL __declspec(thread)
+  #elif defined(__GNUC__) || defined(__clang__)
+    #define LP_PORT_THREAD_LOCAL __thread
+  #else
+    #define LP_PORT_THREAD_LOCAL _Thread_local
+  #endif
+#endif
+#endif
+
+/*
+  Virtual-memory mirror: maps the same `size` bytes twice back to back so
+  that base[i] and base[i + size] alias. `size` is rounded up to the page
+  size (reported via *out_size). Ports without an MMU return LP_ERR_UNSUP.
+*/
+lp_status_t lp_port_vm_mirror_alloc(size_t size, void** base, size_t* out_size);
+void        lp_port_vm_mirror_free(void* base, size_t size);
@@ -0,0 +1,100 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_port.h"
+
+/*
+  lp_prof: named probes for hot paths.
+
+    LP_PROF_BEGIN(ring_push);
+    lp_spsc_ring_push(&r, rec, n);
+    LP_PROF_END(ring_push);
+
+  - With LP_CFG_ENABLE_PROF 0 (the default) both macros expand to nothing.
+  - BEGIN declares locals, so it goes at block scope and END in the same
+    block. Each BEGIN site is its own probe, named by its argument; it is
+    registered on first use (up to LP_CFG_PROF_MAX_PROBES).
+  - A probe adds calls, lp_port_cycles and the largest single interval to
+    the calling thread's counters: no shared writes once a thread and a
+    probe are registered. Each thread takes a fixed slot on first use (up
+    to LP_CFG_PROF_MAX_THREADS) and keeps it for the process's life;
+    threads past the limit are not counted.
+  - lp_prof_snapshot sums the threads, from any thread at any time.
+    Counters are size_t: on 32-bit targets cycles wrap, so difference
+    snapshots often enough.
+  - The only state is the fixed, process-wide counter table.
+*/
+
+#if LP_CFG_ENABLE_PROF
+
+#if !LP_CFG_ENABLE_TIME || !LP_CFG_ENABLE_ATOMICS
+  #error "LP_CFG_ENABLE_PROF needs LP_CFG_ENABLE_TIME and LP_CFG_ENABLE_ATOMICS"
+#endif
+
+typedef struct {
+  const char*    name;
+  lp_atomic_size id; // index + 1; 0 until registered, LP__PROF_FULL if no room
+} lp_prof_probe;
+
+#define LP__PROF_FULL SIZE_MAX
+
+typedef struct {
+  lp_atomic_size calls;
+  lp_atomic_size cycles;
+  lp_atomic_size max;
+} lp_prof_counter;
+
+typedef struct {
+  LP_ALIGNAS(LP_CFG_CACHE_LINE) lp_prof_counter c[LP_CFG_PROF_MAX_PROBES];
+} lp_prof_thread;
+
+extern LP_PORT_THREAD_LOCAL lp_prof_thread* lp__prof_self;
+
+// Registers the probe and/or the thread, then counts.
+void lp__prof_add_slow(lp_prof_probe* p, uint64_t dt);
+
+// Single writer per counter: plain load + store, no read-modify-write.
+static LP_INLINE void lp__prof_add(lp_prof_probe* p, uint64_t dt) {
+  size_t id = lp_port_atomic_load(&p->id, LP_MO_RELAXED);
+  lp_prof_thread* t = lp__prof_self;
+  if (LP_UNLIKELY(id - 1u >= LP_CFG_PROF_MAX_PROBES || !t)) {
+    lp__prof_add_slow(p, dt);
+    return;
+  }
+  lp_prof_counter* c = &t->c[id - 1u];
+  lp_port_atomic_store(&c->calls, lp_port_atomic_load(&c->calls, LP_MO_RELAXED) + 1u, LP_MO_RELAXED);
+  lp_port_atomic_store(&c->cycles, lp_port_atomic_load(&c->cycles, LP_MO_RELAXED) + (size_t)dt, LP_MO_RELAXED);
+  if ((size_t)dt > lp_port_atomic_load(&c->max, LP_MO_RELAXED)) {
+    lp_port_atomic_store(&c->max, (size_t)dt, LP_MO_RELAXED);
+  }
+}
+
+#define LP_PROF_BEGIN(name)                                                  \
+  static lp_prof_probe lp__prof_probe_##name = { #name, 0 };                 \
+  const uint64_t lp__prof_t0_##name = lp_port_cycles()
+
+#define LP_PROF_END(name) \
+  lp__prof_add(&lp__prof_probe_##name, lp_port_cycles() - lp__prof_t0_##name)
+
+typedef struct {
+  const char* name;
+  uint64_t    calls;
+  uint64_t    cycles;     // total
+  uint64_t    max_cycles; // longest single interval, over all threads
+} lp_prof_stat;
+
+// Probes in registration order into out[0..cap); returns how many were
+// written. Probes not hit yet are absent.
+size_t lp_prof_snapshot(lp_prof_stat* out, size_t cap);
+
+// Threads and probes that went uncounted for lack of a slot.
+size_t lp_prof_dropped_threads(void);
+size_t lp_prof_dropped_probes(void);
+
+#else
+
+#define LP_PROF_BEGIN(name) ((void)0)
+#define LP_PROF_END(name)   ((void)0)
+
+#endif
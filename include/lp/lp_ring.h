@@ -2,6 +2,7 @@
 #include "lp_platform.h"
 #include "lp_status.h"
 #include "lp_assert.h"
+#include "lp_types.h"
 
 typedef struct {
   uint8_t* buf;
@@ -34,3 +35,17 @@ static LP_INLINE size_t lp_ring_free(const lp_ring* r) {
 lp_status_t lp_ring_push(lp_ring* r, const void* data, size_t n);
 lp_status_t lp_ring_pop (lp_ring* r, void* out, size_t n);
 
+/*
+  Zero-copy access. A region of n bytes may straddle the end of the buffer,
+  so it is described by two segments: seg[0] up to the end, seg[1] from the
+  start (seg[1].len == 0 when it doesn't wrap). Pass lp_ring_free()/len() as
+  n to get everything available.
+
+  reserve/commit: fill the segments in place, then commit what was written.
+  peek/consume:   read the segments in place, then consume what was used.
+*/
+lp_status_t lp_ring_reserve(lp_ring* r, size_t n, lp_span_u8_mut seg[2]);
+lp_status_t lp_ring_commit (lp_ring* r, size_t n);
+lp_status_t lp_ring_peek   (const lp_ring* r, size_t n, lp_span_u8 seg[2]);
+lp_status_t lp_ring_consume(lp_ring* r, size_t n);
+
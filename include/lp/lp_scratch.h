@@ -0,0 +1,48 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_port.h"
+#include "lp_arena.h"
+
+/*
+  lp_scratch: per-thread scratch arenas carved from one shared region.
+
+  - Each thread bump-allocates from a private block. Blocks are claimed
+    from the shared region with an atomic compare-exchange, the only
+    shared write, and only when the thread's current block runs out.
+  - Blocks stay with the thread that claimed them. lp_scratch_mark /
+    lp_scratch_rewind move the thread's top back, and later blocks are
+    reused before any new claim, so a steady-state request loop never
+    touches shared state.
+  - lp_scratch_reset returns every block to the region. Callers must make
+    sure no thread is using the scratch while it runs.
+  - Per-thread state lives in LP_PORT_THREAD_LOCAL storage and follows one
+    lp_scratch at a time. Switching a thread to another lp_scratch drops
+    its blocks in the old one until that scratch is reset.
+*/
+
+#if LP_CFG_ENABLE_ATOMICS
+
+typedef struct {
+  // read-mostly
+  uint8_t*       mem;
+  size_t         cap;
+  size_t         block;  // bytes per block, including a small header
+  lp_atomic_size epoch;  // fresh on every init and reset
+
+  LP_ALIGNAS(LP_CFG_CACHE_LINE) lp_atomic_size next; // offset of next unclaimed block
+} lp_scratch;
+
+lp_status_t lp_scratch_init(lp_scratch* s, void* mem, size_t cap, size_t block);
+void        lp_scratch_reset(lp_scratch* s);
+
+// Calling thread's allocator. LP_ERR_NOMEM if the region has no free blocks
+// left, LP_ERR_RANGE if size (plus alignment) can never fit in one block.
+lp_status_t lp_scratch_alloc(lp_scratch* s, size_t size, size_t align, void** out);
+
+// Savepoints for the calling thread (same contract as lp_arena_mark/rewind).
+lp_arena_pos lp_scratch_mark(lp_scratch* s);
+void         lp_scratch_rewind(lp_scratch* s, lp_arena_pos pos);
+
+#endif
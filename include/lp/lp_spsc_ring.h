@@ -0,0 +1,56 @@
+#pragma once
+#include "lp_platform.h"
+#include "lp_config.h"
+#include "lp_status.h"
+#include "lp_port.h"
+#include "lp_assert.h"
+
+/*
+  lp_spsc_ring: lock-free single-producer/single-consumer byte ring.
+
+  - Exactly one thread/ISR may push and exactly one may pop.
+  - cap must be a power of two; indices are free-running counters masked on
+    access, so there is no `full` flag and no division.
+  - Producer and consumer state live on separate cache lines; each side keeps
+    a cached copy of the other's index and only re-reads it (acquire) when
+    the cached value says the ring is full/empty.
+*/
+
+#if LP_CFG_ENABLE_ATOMICS
+
+typedef struct {
+  // read-only after init
+  uint8_t* buf;
+  size_t   cap;   // bytes, power of two
+  size_t   mask;  // cap - 1
+
+  // producer-owned
+  LP_ALIGNAS(LP_CFG_CACHE_LINE) lp_atomic_size head; // total bytes written
+  size_t tail_cache;
+
+  // consumer-owned
+  LP_ALIGNAS(LP_CFG_CACHE_LINE) lp_atomic_size tail; // total bytes read
+  size_t head_cache;
+} lp_spsc_ring;
+
+lp_status_t lp_spsc_ring_init(lp_spsc_ring* r, void* mem, size_t cap);
+
+// Snapshot; exact only when called from the producer or consumer side with
+// the other side idle.
+static LP_INLINE size_t lp_spsc_ring_len(const lp_spsc_ring* r) {
+  LP_ASSERT(r);
+  size_t tail = lp_port_atomic_load(&r->tail, LP_MO_ACQUIRE);
+  size_t head = lp_port_atomic_load(&r->head, LP_MO_ACQUIRE);
+  return head - tail;
+}
+
+static LP_INLINE size_t lp_spsc_ring_free(const lp_spsc_ring* r) {
+  return r->cap - lp_spsc_ring_len(r);
+}
+
+// Producer side. All-or-nothing: LP_ERR_FULL if n bytes don't fit.
+lp_status_t lp_spsc_ring_push(lp_spsc_ring* r, const void* data, size_t n);
+// Consumer side. All-or-nothing: LP_ERR_EMPTY if fewer than n bytes queued.
+lp_status_t lp_spsc_ring_pop (lp_spsc_ring* r, void* out, size_t n);
+
+#endif
@@ -2,17 +2,138 @@
 #include "lp_types.h"
 #include "lp_status.h"
 
+/*
+  lp_strview: non-owning (ptr, len) text. Nothing here allocates, and
+  nothing but lp_sv()/lp_cstr_len() looks for a NUL.
+
+  Searches return the byte index of the first match, or LP_SV_NPOS. They
+  run 16/32 bytes at a time with SSE2/AVX2 on x86 (LP_CFG_ENABLE_SIMD)
+  and 8 bytes at a time (SWAR) everywhere else. Case-insensitive
+  functions fold ASCII only; other bytes compare exactly.
+*/
+
+#define LP_SV_NPOS ((size_t)-1)
+
+// strlen without libc; reads whole aligned words, never past the word
+// holding the NUL.
+size_t lp_cstr_len(const char* s);
+
 static LP_INLINE lp_strview lp_sv(const char* s) {
   // safe for null? treat null as empty
   if (!s) return (lp_strview){ .ptr = "", .len = 0 };
-  size_t n = 0;
-  while (s[n] != '\0') n++;
+  return (lp_strview){ .ptr = s, .len = lp_cstr_len(s) };
+}
+
+static LP_INLINE lp_strview lp_sv_n(const char* s, size_t n) {
   return (lp_strview){ .ptr = s, .len = n };
 }
 
+// Byte order like memcmp; on a common prefix the shorter view sorts first.
+int lp_sv_cmp(lp_strview a, lp_strview b);
+int lp_sv_cmp_ci(lp_strview a, lp_strview b);
+bool lp_sv_eq_ci(lp_strview a, lp_strview b);
+
 static LP_INLINE bool lp_sv_eq(lp_strview a, lp_strview b) {
-  if (a.len != b.len) return false;
-  for (size_t i = 0; i < a.len; i++) if (a.ptr[i] != b.ptr[i]) return false;
-  return true;
+  return a.len == b.len && lp_sv_cmp(a, b) == 0;
+}
+
+// -------------------------
+// Slicing
+// -------------------------
+
+// s[pos, pos + n), clamped to s.
+static LP_INLINE lp_strview lp_sv_sub(lp_strview s, size_t pos, size_t n) {
+  if (pos > s.len) pos = s.len;
+  if (n > s.len - pos) n = s.len - pos;
+  return (lp_strview){ .ptr = s.ptr + pos, .len = n };
+}
+
+static LP_INLINE bool lp_sv_starts_with(lp_strview s, lp_strview prefix) {
+  return s.len >= prefix.len && lp_sv_eq(lp_sv_sub(s, 0, prefix.len), prefix);
+}
+
+static LP_INLINE bool lp_sv_ends_with(lp_strview s, lp_strview suffix) {
+  return s.len >= suffix.len && lp_sv_eq(lp_sv_sub(s, s.len - suffix.len, suffix.len), suffix);
+}
+
+static LP_INLINE bool lp__sv_is_space(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// ASCII whitespace: space, \t \n \v \f \r.
+static LP_INLINE lp_strview lp_sv_trim_left(lp_strview s) {
+  while (s.len && lp__sv_is_space(s.ptr[0])) { s.ptr++; s.len--; }
+  return s;
+}
+
+static LP_INLINE lp_strview lp_sv_trim_right(lp_strview s) {
+  while (s.len && lp__sv_is_space(s.ptr[s.len - 1])) s.len--;
+  return s;
+}
+
+static LP_INLINE lp_strview lp_sv_trim(lp_strview s) {
+  return lp_sv_trim_right(lp_sv_trim_left(s));
+}
+
+// -------------------------
+// Search
+// -------------------------
+
+size_t lp_sv_find_char(lp_strview s, char c);
+
+// Substring search; an empty needle matches at 0. Candidate positions are
+// found by first/last byte, so the worst case (long runs of one repeated
+// byte) is O(len * needle.len).
+size_t lp_sv_find(lp_strview s, lp_strview needle);
+
+// A set of bytes for lp_sv_find_any / lp_sv_split_any. Build it once.
+typedef struct {
+  uint64_t bits[4]; // membership bitmap
+  uint8_t  nib[16]; // bit (c >> 4) of nib[c & 15]; used by the SIMD path
+  bool     ascii;   // all members < 0x80 (required by the SIMD path)
+} lp_sv_charset;
+
+void lp_sv_charset_init(lp_sv_charset* cs, lp_strview chars);
+
+static LP_INLINE bool lp_sv_charset_has(const lp_sv_charset* cs, char c) {
+  uint8_t b = (uint8_t)c;
+  return ((cs->bits[b >> 6] >> (b & 63u)) & 1u) != 0;
+}
+
+size_t lp_sv_find_any(lp_strview s, const lp_sv_charset* set);
+
+// -------------------------
+// Split
+// -------------------------
+//
+//   lp_sv_split it = lp_sv_split_on(line, ',', 0);
+//   lp_strview tok;
+//   while (lp_sv_split_next(&it, &tok)) { ... }
+//
+// By default every separator ends a token: "a,,b," gives "a", "", "b", ""
+// and "" gives one empty token. LP_SV_SPLIT_SKIP_EMPTY drops empty tokens
+// (for runs of whitespace and the like).
+
+enum { LP_SV_SPLIT_SKIP_EMPTY = 1u << 0 };
+
+typedef struct {
+  lp_strview           rest;
+  const lp_sv_charset* set; // NULL: split on delim
+  char                 delim;
+  uint8_t              flags;
+  bool                 done;
+} lp_sv_split;
+
+static LP_INLINE lp_sv_split lp_sv_split_on(lp_strview s, char delim, uint32_t flags) {
+  lp_sv_split it = { .rest = s, .set = NULL, .delim = delim, .flags = (uint8_t)flags, .done = false };
+  return it;
+}
+
+// set must outlive the iterator.
+static LP_INLINE lp_sv_split lp_sv_split_any(lp_strview s, const lp_sv_charset* set, uint32_t flags) {
+  lp_sv_split it = { .rest = s, .set = set, .delim = 0, .flags = (uint8_t)flags, .done = false };
+  return it;
 }
 
+// Next token into *tok (a view into the original text); false when done.
+bool lp_sv_split_next(lp_sv_split* it, lp_strview* tok);
@@ -0,0 +1,46 @@
+#pragma once
+#include "lp_types.h"
+#include "lp_status.h"
+
+/*
+  lp_utf8: UTF-8 checks over views. Nothing allocates.
+
+  Validation follows the Unicode definition (Table 3-7): no overlong
+  forms, no surrogates (U+D800..DFFF), nothing above U+10FFFF. ASCII runs
+  are skipped a block at a time; multibyte text goes through a lookup-
+  table validator, 16/32 bytes per step with SSSE3/AVX2 on x86 and NEON on
+  AArch64 (LP_CFG_ENABLE_SIMD), scalar elsewhere.
+*/
+
+// LP_OK if s is well-formed UTF-8, LP_ERR_INVALID otherwise.
+lp_status_t lp_utf8_validate(lp_strview s);
+
+// Length of the longest well-formed prefix (s.len when valid), i.e. the
+// offset of the first bad sequence.
+size_t lp_utf8_valid_len(lp_strview s);
+
+// Code points in s, which is assumed valid: counts every byte that is not
+// a continuation byte (10xxxxxx).
+size_t lp_utf8_count(lp_strview s);
+
+// Cut point for keeping s[0, k): k itself, or the start of the sequence
+// that k would split (looks back at most 3 bytes). Requires k < s.len;
+// bytes that are not valid UTF-8 are left as they are.
+static LP_INLINE size_t lp__utf8_cut(const char* s, size_t k) {
+  const uint8_t* p = (const uint8_t*)s;
+  if ((p[k] & 0xC0u) != 0x80u) return k;
+  for (size_t j = k; j > 0 && k - j < 3u;) {
+    uint8_t b = p[--j];
+    if ((b & 0xC0u) == 0x80u) continue;
+    size_t len = (b >= 0xF0u) ? 4u : (b >= 0xE0u) ? 3u : (b >= 0xC0u) ? 2u : 1u;
+    return (j + len > k) ? j : k;
+  }
+  return k;
+}
+
+// Longest prefix of at most max_bytes that does not end inside a
+// multibyte sequence.
+static LP_INLINE lp_strview lp_utf8_truncate(lp_strview s, size_t max_bytes) {
+  if (max_bytes < s.len) s.len = lp__utf8_cut(s.ptr, max_bytes);
+  return s;
+}
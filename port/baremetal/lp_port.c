@@ -1,7 +1,18 @@
 #include "lp/lp_port.h"
+#include "lp/lp_dlog.h"
+
+static void (*volatile g_panic_hook)(void);
+static volatile int g_panicking;
+
+void lp_port_set_panic_hook(void (*hook)(void)) { g_panic_hook = hook; }
 
 LP_NORETURN void lp_port_panic(const char* msg) {
   (void)msg;
+  void (*hook)(void) = g_panic_hook;
+  if (hook && !g_panicking) {
+    g_panicking = 1;
+    hook();
+  }
   // Optionally breakpoint:
   // __asm volatile("bkpt #0");
   while (1) { /* halt */ }
@@ -14,3 +25,84 @@ void lp_port_log(lp_log_level_t lvl, const char* msg) {
 }
 #endif
 
+#if LP_CFG_ENABLE_TIME
+// Core clock in Hz (e.g. SystemCoreClock's value). Required with the DWT
+// counter; AArch64 reads the counter frequency from cntfrq_el0.
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+  #if !defined(LP_PORT_CPU_HZ) || (LP_PORT_CPU_HZ + 0) == 0
+    #error "define LP_PORT_CPU_HZ (core clock in Hz) or build with LP_CFG_ENABLE_TIME=0"
+  #endif
+#elif !defined(__aarch64__)
+  #error "no cycle counter for this core: implement lp_port_cycles or build with LP_CFG_ENABLE_TIME=0"
+#endif
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define LP__DEMCR      (*(volatile uint32_t*)0xE000EDFCu)
+#define LP__DWT_CTRL   (*(volatile uint32_t*)0xE0001000u)
+#define LP__DWT_CYCCNT (*(volatile uint32_t*)0xE0001004u)
+
+static uint32_t g_cyc_last;
+static uint64_t g_cyc_high;
+
+// DWT CYCCNT is 32 bits; extended here, so it must be read at least once
+// per wrap (~25 s at 168 MHz). Interrupts are masked around the update.
+uint64_t lp_port_cycles(void) {
+  uint32_t primask;
+  __asm volatile("mrs %0, primask\n cpsid i" : "=r"(primask) :: "memory");
+  if (!(LP__DWT_CTRL & 1u)) {
+    LP__DEMCR |= 1u << 24; // TRCENA
+    LP__DWT_CYCCNT = 0;
+    LP__DWT_CTRL |= 1u;    // CYCCNTENA
+  }
+  uint32_t now = LP__DWT_CYCCNT;
+  if (now < g_cyc_last) g_cyc_high += 1ull << 32;
+  g_cyc_last = now;
+  uint64_t v = g_cyc_high | now;
+  __asm volatile("msr primask, %0" :: "r"(primask) : "memory");
+  return v;
+}
+#else // __aarch64__
+uint64_t lp_port_cycles(void) {
+  uint64_t v;
+  __asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+}
+#endif
+
+uint64_t lp_port_cycles_per_sec(void) {
+#if defined(__aarch64__)
+  uint64_t f;
+  __asm volatile("mrs %0, cntfrq_el0" : "=r"(f));
+  return f;
+#else
+  return LP_PORT_CPU_HZ;
+#endif
+}
+
+uint64_t lp_port_now_ns(void) {
+  uint64_t hz = lp_port_cycles_per_sec();
+  uint64_t c = lp_port_cycles();
+  return (c / hz) * 1000000000u + (c % hz) * 1000000000u / hz;
+}
+
+uint64_t lp_port_now_us(void) { return lp_port_now_ns() / 1000u; }
+#endif
+
+lp_status_t lp_port_vm_mirror_alloc(size_t size, void** base, size_t* out_size) {
+  (void)size; (void)base; (void)out_size;
+  return LP_ERR_UNSUP; // no MMU
+}
+
+void lp_port_vm_mirror_free(void* base, size_t size) {
+  (void)base; (void)size;
+}
+
+#if LP_CFG_ENABLE_ATOMICS
+// No threads here: drain from the main loop with lp_dlog_next.
+lp_status_t lp_port_dlog_start(lp_dlog* log) {
+  (void)log;
+  return LP_ERR_UNSUP;
+}
+
+void lp_port_dlog_stop(void) {}
+#endif
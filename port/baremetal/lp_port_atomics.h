@@ -0,0 +1,59 @@
+#pragma once
+
+/*
+  Bare-metal atomics for single-core Cortex-M class parts.
+
+  Aligned word loads/stores are single-copy atomic, so only ordering needs
+  help: acquire/release map onto DMB. Enable with
+    -DLP_PORT_ATOMICS_H='"lp_port_atomics.h"' -Iport/baremetal
+*/
+
+// No threads: per-thread state is plain static storage.
+#define LP_PORT_THREAD_LOCAL
+
+#define LP_MO_RELAXED 0
+#define LP_MO_ACQUIRE 2
+#define LP_MO_RELEASE 3
+#define LP_MO_ACQ_REL 4
+#define LP_MO_SEQ_CST 5
+
+#if defined(__ARM_ARCH)
+  #define lp__port_dmb() __asm volatile("dmb" ::: "memory")
+  // Read-modify-write runs with interrupts masked (single core).
+  #define lp__port_irq_save(m) __asm volatile("mrs %0, primask\n cpsid i" : "=r"(m) :: "memory")
+  #define lp__port_irq_restore(m) __asm volatile("msr primask, %0" :: "r"(m) : "memory")
+#else
+  #define lp__port_dmb() __asm volatile("" ::: "memory")
+  #define lp__port_irq_save(m) ((m) = 0u)
+  #define lp__port_irq_restore(m) ((void)(m))
+#endif
+
+#define lp_port_atomic_load(p, mo) __extension__ ({                 \
+    __typeof__(*(p)) lp__v = *(volatile __typeof__(*(p))*)(p);      \
+    if ((mo) != LP_MO_RELAXED) lp__port_dmb();                      \
+    lp__v; })
+
+#define lp_port_atomic_store(p, v, mo) do {                         \
+    if ((mo) != LP_MO_RELAXED) lp__port_dmb();                      \
+    *(volatile __typeof__(*(p))*)(p) = (v);                         \
+    if ((mo) == LP_MO_SEQ_CST) lp__port_dmb();                      \
+  } while (0)
+
+#define lp_port_atomic_fetch_add(p, v, mo) __extension__ ({        \
+    unsigned lp__m;                                                 \
+    lp__port_irq_save(lp__m);                                       \
+    __typeof__(*(p)) lp__old = *(p);                                \
+    *(p) = lp__old + (v);                                           \
+    lp__port_irq_restore(lp__m);                                    \
+    (void)(mo);                                                     \
+    lp__old; })
+
+#define lp_port_atomic_cas_weak(p, expected, desired, mo_ok, mo_fail) __extension__ ({ \
+    unsigned lp__m;                                                 \
+    bool lp__ok;                                                    \
+    lp__port_irq_save(lp__m);                                       \
+    lp__ok = (*(p) == *(expected));                                 \
+    if (lp__ok) *(p) = (desired); else *(expected) = *(p);          \
+    lp__port_irq_restore(lp__m);                                    \
+    (void)(mo_ok); (void)(mo_fail);                                 \
+    lp__ok; })
@@ -1,8 +1,27 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+  #define _GNU_SOURCE // memfd_create
+#endif
 #include "lp/lp_port.h"
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+static void (*volatile g_panic_hook)(void);
+static volatile int g_panicking;
+
+void lp_port_set_panic_hook(void (*hook)(void)) { g_panic_hook = hook; }
 
 LP_NORETURN void lp_port_panic(const char* msg) {
+  void (*hook)(void) = g_panic_hook;
+  if (hook && !g_panicking) {
+    g_panicking = 1;
+    hook();
+  }
   fprintf(stderr, "PANIC: %s\n", msg ? msg : "(null)");
   abort();
 }
@@ -14,8 +33,130 @@ void lp_port_log(lp_log_level_t lvl, const char* msg) {
 }
 #endif
 
+#if LP_CFG_ENABLE_TIME
+uint64_t lp_port_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts); // vDSO on Linux: no syscall
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t lp_port_now_us(void) { return lp_port_now_ns() / 1000u; }
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+uint64_t lp_port_cycles(void) {
+  uint32_t lo, hi;
+  __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+  return ((uint64_t)hi << 32) | lo;
+}
+
+static uint64_t g_cycles_per_sec;
+
+// Invariant TSC assumed (every x86 of the last decade): count it across
+// ~10 ms of lp_port_now_ns.
+static void lp__cycles_calibrate(void) {
+  uint64_t t0 = lp_port_now_ns(), c0 = lp_port_cycles();
+  uint64_t t1 = t0, c1 = c0;
+  while (t1 - t0 < 10000000u) {
+    t1 = lp_port_now_ns();
+    c1 = lp_port_cycles();
+  }
+  g_cycles_per_sec = (uint64_t)((double)(c1 - c0) * 1e9 / (double)(t1 - t0));
+}
+
+uint64_t lp_port_cycles_per_sec(void) {
+  static pthread_once_t once = PTHREAD_ONCE_INIT;
+  pthread_once(&once, lp__cycles_calibrate);
+  return g_cycles_per_sec;
+}
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+uint64_t lp_port_cycles(void) {
+  uint64_t v;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+}
+
+uint64_t lp_port_cycles_per_sec(void) {
+  uint64_t f;
+  __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(f));
+  return f;
+}
+#else
+uint64_t lp_port_cycles(void) { return lp_port_now_ns(); }
+uint64_t lp_port_cycles_per_sec(void) { return 1000000000u; }
+#endif
+#endif
+
 #if LP_CFG_ENABLE_ALLOC
 void* lp_port_malloc(size_t sz) { return malloc(sz); }
 void  lp_port_free(void* p) { free(p); }
 #endif
 
+
+// -------------------------
+// Virtual-memory mirror
+// -------------------------
+
+#if !defined(__linux__)
+  #if LP_CFG_ENABLE_ATOMICS
+static lp_atomic_size lp__vm_mirror_seq;
+  #else
+static size_t lp__vm_mirror_seq;
+  #endif
+#endif
+
+static int lp__vm_mirror_fd(size_t size) {
+#if defined(__linux__)
+  int fd = memfd_create("lp_mirror", MFD_CLOEXEC);
+#else
+  // pid plus a per-process sequence, so threads creating mirrors at the
+  // same time don't collide; retry if a stale name is still around.
+  int fd = -1;
+  for (int tries = 0; tries < 16 && fd < 0; tries++) {
+#if LP_CFG_ENABLE_ATOMICS
+    size_t seq = lp_port_atomic_fetch_add(&lp__vm_mirror_seq, (size_t)1, LP_MO_RELAXED);
+#else
+    size_t seq = lp__vm_mirror_seq++;
+#endif
+    char name[48];
+    snprintf(name, sizeof(name), "/lp_mirror_%ld_%zu", (long)getpid(), seq);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) shm_unlink(name);
+    else if (errno != EEXIST) break;
+  }
+#endif
+  if (fd < 0) return -1;
+  if (ftruncate(fd, (off_t)size) != 0) { close(fd); return -1; }
+  return fd;
+}
+
+lp_status_t lp_port_vm_mirror_alloc(size_t size, void** base, size_t* out_size) {
+  if (!base || !out_size || size == 0) return LP_ERR_INVALID;
+
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  if (size > (SIZE_MAX / 2u) - page) return LP_ERR_OVERFLOW;
+  size = (size + page - 1u) / page * page;
+
+  int fd = lp__vm_mirror_fd(size);
+  if (fd < 0) return LP_ERR_IO;
+
+  // Reserve 2*size of address space, then map the file over both halves.
+  uint8_t* p = (uint8_t*)mmap(NULL, 2u * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) { close(fd); return LP_ERR_NOMEM; }
+
+  void* a = mmap(p, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+  void* b = mmap(p + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+  close(fd); // mappings keep the pages alive
+
+  if (a != (void*)p || b != (void*)(p + size)) {
+    munmap(p, 2u * size);
+    return LP_ERR_NOMEM;
+  }
+
+  *base = p;
+  *out_size = size;
+  return LP_OK;
+}
+
+void lp_port_vm_mirror_free(void* base, size_t size) {
+  if (base && size) munmap(base, 2u * size);
+}
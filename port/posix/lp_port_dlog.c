@@ -0,0 +1,126 @@
+#if !defined(_POSIX_C_SOURCE)
+  #define _POSIX_C_SOURCE 200809L // nanosleep
+#endif
+#include "lp/lp_dlog.h"
+
+#if LP_CFG_ENABLE_ATOMICS
+#include <errno.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+// Lines per writev, and the room for each (longer lines are cut).
+#define LP__DLOG_BATCH 64u
+#define LP__DLOG_LINE  256u
+
+static struct {
+  lp_dlog*       log;
+  pthread_t      thread;
+  lp_atomic_size running;
+  lp_atomic_size busy; // consumer lock: drain thread vs panic flush
+  char           lines[LP__DLOG_BATCH][LP__DLOG_LINE];
+  struct iovec   iov[LP__DLOG_BATCH];
+} g_dlog;
+
+static bool lp__dlog_try_lock(void) {
+  size_t expected = 0;
+  return lp_port_atomic_cas_weak(&g_dlog.busy, &expected, (size_t)1, LP_MO_ACQUIRE, LP_MO_RELAXED);
+}
+
+static void lp__dlog_unlock(void) {
+  lp_port_atomic_store(&g_dlog.busy, (size_t)0, LP_MO_RELEASE);
+}
+
+static void lp__dlog_sleep_ms(long ms) {
+  struct timespec ts = { 0, ms * 1000000L };
+  while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {}
+}
+
+static void lp__dlog_writev(struct iovec* iov, int n) {
+  while (n > 0) {
+    ssize_t w = writev(STDERR_FILENO, iov, n);
+    if (w < 0) {
+      if (errno == EINTR) continue;
+      return; // nowhere to report it
+    }
+    size_t left = (size_t)w;
+    while (n > 0 && left >= iov->iov_len) {
+      left -= iov->iov_len;
+      iov++;
+      n--;
+    }
+    if (n > 0) {
+      iov->iov_base = (char*)iov->iov_base + left;
+      iov->iov_len -= left;
+    }
+  }
+}
+
+// Formats up to a batch of lines and writes them. Caller holds the lock.
+static size_t lp__dlog_batch(lp_dlog* log) {
+  size_t n = 0;
+  while (n < LP__DLOG_BATCH) {
+    lp_fmtbuf fb = lp_fmtbuf_make(g_dlog.lines[n], LP__DLOG_LINE);
+    if (!lp_dlog_next(log, &fb)) break;
+    g_dlog.lines[n][fb.len] = '\n'; // over the NUL
+    g_dlog.iov[n].iov_base = g_dlog.lines[n];
+    g_dlog.iov[n].iov_len = fb.len + 1u;
+    n++;
+  }
+  if (n) lp__dlog_writev(g_dlog.iov, (int)n);
+  return n;
+}
+
+static void* lp__dlog_thread(void* arg) {
+  lp_dlog* log = (lp_dlog*)arg;
+  while (lp_port_atomic_load(&g_dlog.running, LP_MO_ACQUIRE)) {
+    size_t n = 0;
+    if (lp__dlog_try_lock()) {
+      n = lp__dlog_batch(log);
+      lp__dlog_unlock();
+    }
+    if (n == 0) lp__dlog_sleep_ms(1);
+  }
+  return NULL;
+}
+
+// Panic hook: drain everything on the panicking thread. If the drain
+// thread holds the lock (possibly because it is the one panicking) and
+// doesn't let go soon, give up rather than hang.
+static void lp__dlog_panic_flush(void) {
+  lp_dlog* log = g_dlog.log;
+  if (!log) return;
+  for (int i = 0; !lp__dlog_try_lock(); i++) {
+    if (i == 100) return;
+    lp__dlog_sleep_ms(1);
+  }
+  while (lp__dlog_batch(log)) {}
+  lp__dlog_unlock();
+}
+
+lp_status_t lp_port_dlog_start(lp_dlog* log) {
+  if (!log || g_dlog.log) return LP_ERR_INVALID;
+  g_dlog.log = log;
+  lp_port_atomic_store(&g_dlog.running, (size_t)1, LP_MO_RELEASE);
+  if (pthread_create(&g_dlog.thread, NULL, lp__dlog_thread, log) != 0) {
+    lp_port_atomic_store(&g_dlog.running, (size_t)0, LP_MO_RELAXED);
+    g_dlog.log = NULL;
+    return LP_ERR_IO;
+  }
+  lp_port_set_panic_hook(lp__dlog_panic_flush);
+  return LP_OK;
+}
+
+void lp_port_dlog_stop(void) {
+  lp_dlog* log = g_dlog.log;
+  if (!log) return;
+  lp_port_atomic_store(&g_dlog.running, (size_t)0, LP_MO_RELEASE);
+  pthread_join(g_dlog.thread, NULL);
+  lp_port_set_panic_hook(NULL);
+  while (!lp__dlog_try_lock()) {}
+  while (lp__dlog_batch(log)) {}
+  lp__dlog_unlock();
+  g_dlog.log = NULL;
+}
+#endif
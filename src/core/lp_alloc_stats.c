@@ -0,0 +1,21 @@
+#include "lp/lp_alloc_stats.h"
+
+static lp_status_t lp__stats_field(lp_fmtbuf* fb, const char* key, uint64_t v) {
+  lp_status_t st = lp_fmt_append_cstr(fb, key);
+  if (st != LP_OK) return st;
+  return lp_fmt_append_u64(fb, v);
+}
+
+lp_status_t lp_alloc_stats_dump(lp_fmtbuf* fb, const char* name, const lp_alloc_stats* s) {
+  if (!fb || !s) return LP_ERR_INVALID;
+
+  lp_status_t st = lp_fmt_append_cstr(fb, name ? name : "alloc");
+  if (st == LP_OK) st = lp__stats_field(fb, ": allocs=", s->allocs);
+  if (st == LP_OK) st = lp__stats_field(fb, " fail=",    s->failures);
+  if (st == LP_OK) st = lp__stats_field(fb, " req=",     s->bytes_requested);
+  if (st == LP_OK) st = lp__stats_field(fb, " used=",    s->bytes_consumed);
+  if (st == LP_OK) st = lp__stats_field(fb, " pad=",     s->bytes_padding);
+  if (st == LP_OK) st = lp__stats_field(fb, " hwm=",     (uint64_t)s->high_water);
+  if (st == LP_OK) st = lp__stats_field(fb, " blocks=",  s->blocks);
+  return st;
+}
@@ -1,24 +1,156 @@
 #include "lp/lp_arena.h"
+#include "lp/lp_bytes.h"
+#include "lp/lp_port.h"
 
 static bool lp__is_pow2(size_t x) { return x && ((x & (x - 1u)) == 0); }
 
-lp_status_t lp_arena_alloc(lp_arena* a, size_t size, size_t align, void** out) {
-  if (!a || !out || !a->mem) return LP_ERR_INVALID;
-  if (size == 0) { *out = NULL; return LP_OK; }
-  if (align == 0) align = 1;
-  if (!lp__is_pow2(align)) return LP_ERR_INVALID;
+// Bump within the current block. Aligns the address, not just the offset,
+// so blocks need no particular alignment of their own.
+static lp_status_t lp__arena_bump(lp_arena* a, size_t size, size_t align, void** out) {
+  if (!a->mem) return LP_ERR_NOMEM;
 
   size_t off = a->off;
-  size_t mask = align - 1u;
-  size_t aligned = (off + mask) & ~mask;
+  size_t pad = (size_t)(0u - (uintptr_t)(a->mem + off)) & (align - 1u);
 
-  // overflow / bounds checks
-  if (aligned < off) return LP_ERR_OVERFLOW;
-  if (aligned > a->cap) return LP_ERR_NOMEM;
+  // bounds checks (off <= cap always holds)
+  if (pad > a->cap - off) return LP_ERR_NOMEM;
+  size_t aligned = off + pad;
   if (size > (a->cap - aligned)) return LP_ERR_NOMEM;
 
   *out = a->mem + aligned;
   a->off = aligned + size;
+#if LP_CFG_ALLOC_STATS
+  lp_alloc_stats_hit(&a->stats, size, pad, a->off);
+#endif
+  return LP_OK;
+}
+
+#if LP_CFG_ENABLE_ALLOC
+
+static LP_INLINE uint8_t* lp__arena_block_data(lp_arena_block* b) {
+  return (uint8_t*)(b + 1);
+}
+
+void lp_arena_init_chained(lp_arena* a, void* mem, size_t cap, size_t min_block, uint32_t flags) {
+  lp_arena_init(a, mem, cap);
+  if (!mem) { a->base_cap = 0; a->cap = 0; }
+  a->min_block = min_block;
+  a->flags = flags;
+}
+
+// Push a block with room for `size` bytes at `align` (spare first-fit, else heap).
+static lp_status_t lp__arena_grow(lp_arena* a, size_t size, size_t align) {
+  size_t need = 0;
+  if (lp_checked_add_size(size, align - 1u, &need) != LP_OK) return LP_ERR_OVERFLOW;
+
+  lp_arena_block* b = NULL;
+  for (lp_arena_block** pp = &a->spare; *pp; pp = &(*pp)->prev) {
+    if ((*pp)->cap >= need) {
+      b = *pp;
+      *pp = b->prev;
+      break;
+    }
+  }
+
+  if (!b) {
+    size_t cap = (need > a->min_block) ? need : a->min_block;
+    size_t total = 0;
+    if (lp_checked_add_size(cap, sizeof(lp_arena_block), &total) != LP_OK) return LP_ERR_OVERFLOW;
+    b = (lp_arena_block*)lp_port_malloc(total);
+    if (!b) return LP_ERR_NOMEM;
+    b->cap = cap;
+#if LP_CFG_ALLOC_STATS
+    a->stats.blocks++;
+#endif
+  }
+
+  b->prev = a->chain;
+  a->chain = b;
+  a->mem = lp__arena_block_data(b);
+  a->cap = b->cap;
+  a->off = 0;
   return LP_OK;
 }
 
+void lp__arena_rewind_chain(lp_arena* a, lp_arena_pos pos) {
+  lp_arena_block* target = (lp_arena_block*)pos.block;
+
+  while (a->chain && a->chain != target) {
+    lp_arena_block* b = a->chain;
+    a->chain = b->prev;
+    if (a->flags & LP_ARENA_KEEP_BLOCKS) {
+      b->prev = a->spare;
+      a->spare = b;
+    } else {
+      lp_port_free(b);
+    }
+  }
+  LP_ASSERT(a->chain == target);
+
+  if (a->chain) {
+    a->mem = lp__arena_block_data(a->chain);
+    a->cap = a->chain->cap;
+  } else {
+    a->mem = a->base_mem;
+    a->cap = a->base_cap;
+  }
+  LP_ASSERT(pos.off <= a->cap);
+  a->off = pos.off;
+}
+
+void lp_arena_release(lp_arena* a) {
+  if (!a) return;
+  uint32_t flags = a->flags;
+  a->flags = LP_ARENA_FREE_BLOCKS;
+  lp__arena_rewind_chain(a, (lp_arena_pos){ .block = NULL, .off = 0 });
+  a->flags = flags;
+
+  while (a->spare) {
+    lp_arena_block* b = a->spare;
+    a->spare = b->prev;
+    lp_port_free(b);
+  }
+}
+
+#endif // LP_CFG_ENABLE_ALLOC
+
+lp_status_t lp_arena_alloc(lp_arena* a, size_t size, size_t align, void** out) {
+  if (!a || !out) return LP_ERR_INVALID;
+#if LP_CFG_ENABLE_ALLOC
+  if (!a->mem && a->min_block == 0) return LP_ERR_INVALID;
+#else
+  if (!a->mem) return LP_ERR_INVALID;
+#endif
+  if (size == 0) { *out = NULL; return LP_OK; }
+  if (align == 0) align = 1;
+  if (!lp__is_pow2(align)) return LP_ERR_INVALID;
+
+  lp_status_t st = lp__arena_bump(a, size, align, out);
+#if LP_CFG_ENABLE_ALLOC
+  if (st == LP_ERR_NOMEM && a->min_block) {
+    st = lp__arena_grow(a, size, align);
+    if (st == LP_OK) st = lp__arena_bump(a, size, align, out);
+  }
+#endif
+#if LP_CFG_ALLOC_STATS
+  if (st != LP_OK) lp_alloc_stats_miss(&a->stats);
+#endif
+  return st;
+}
+
+bool lp_arena_resize_top(lp_arena* a, void* p, size_t old_size, size_t new_size) {
+  if (!a || !p || !a->mem) return false;
+  uintptr_t base = (uintptr_t)a->mem, at = (uintptr_t)p;
+  if (at < base || at - base > a->off || a->off - (at - base) != old_size) return false;
+  size_t start = (size_t)(at - base);
+  if (new_size > a->cap - start) return false;
+#if LP_CFG_ALLOC_STATS
+  if (new_size > old_size) {
+    a->stats.bytes_requested += new_size - old_size;
+    a->stats.bytes_consumed += new_size - old_size;
+    if (start + new_size > a->stats.high_water) a->stats.high_water = start + new_size;
+  }
+#endif
+  a->off = start + new_size;
+  return true;
+}
@@ -0,0 +1,182 @@
+#include "lp/lp_buf.h"
+#include "lp/lp_port.h"
+#include <string.h>
+
+// Smallest block taken from a backend.
+#define LP__BUF_MIN_CAP 16u
+
+static void lp__buf_reset(lp_buf* b) {
+  b->data = b->inline_mem;
+  b->cap = b->inline_cap;
+  b->len = 0;
+}
+
+static void lp__buf_setup(lp_buf* b, uint8_t kind, lp_arena* a, void* inline_mem, size_t inline_cap) {
+  LP_ASSERT(b);
+  b->inline_mem = inline_mem ? (uint8_t*)inline_mem : NULL;
+  b->inline_cap = inline_mem ? inline_cap : 0u;
+  b->arena = a;
+  b->align = 1u;
+  b->kind = kind;
+  lp__buf_reset(b);
+}
+
+void lp_buf_init(lp_buf* b, void* mem, size_t cap) {
+  lp__buf_setup(b, LP_BUF_FIXED, NULL, mem, cap);
+}
+
+void lp_buf_init_arena(lp_buf* b, lp_arena* a, void* inline_mem, size_t inline_cap) {
+  LP_ASSERT(a);
+  lp__buf_setup(b, LP_BUF_ARENA, a, inline_mem, inline_cap);
+}
+
+#if LP_CFG_ENABLE_ALLOC
+void lp_buf_init_heap(lp_buf* b, void* inline_mem, size_t inline_cap) {
+  lp__buf_setup(b, LP_BUF_HEAP, NULL, inline_mem, inline_cap);
+}
+#endif
+
+// Data lives in backend memory (as opposed to inline storage or nothing).
+static LP_INLINE bool lp__buf_owned(const lp_buf* b) {
+  return b->kind != LP_BUF_FIXED && b->data && b->data != b->inline_mem;
+}
+
+// Gives back the backend block holding the data, if any.
+static void lp__buf_release(lp_buf* b) {
+  if (!lp__buf_owned(b)) return;
+#if LP_CFG_ENABLE_ALLOC
+  if (b->kind == LP_BUF_HEAP) {
+    lp_port_free(b->data);
+    return;
+  }
+#endif
+  (void)lp_arena_resize_top(b->arena, b->data, b->cap, 0u);
+}
+
+// New backend block of `cap` bytes (or at least `need` if that fails)
+// holding the current contents. The old block is not released.
+static lp_status_t lp__buf_move(lp_buf* b, size_t cap, size_t need, uint8_t** out, size_t* out_cap) {
+  uint8_t* p = NULL;
+#if LP_CFG_ENABLE_ALLOC
+  if (b->kind == LP_BUF_HEAP) {
+    p = (uint8_t*)lp_port_malloc(cap);
+    if (!p && need < cap) p = (uint8_t*)lp_port_malloc(cap = need);
+    if (!p) return LP_ERR_NOMEM;
+  }
+#endif
+  if (b->kind == LP_BUF_ARENA) {
+    void* q = NULL;
+    lp_status_t st = lp_arena_alloc(b->arena, cap, b->align, &q);
+    if (st == LP_ERR_NOMEM && need < cap) st = lp_arena_alloc(b->arena, cap = need, b->align, &q);
+    if (st != LP_OK) return st;
+    p = (uint8_t*)q;
+  }
+  if (!p) return LP_ERR_NOMEM;
+  if (b->len) memcpy(p, b->data, b->len);
+  *out = p;
+  *out_cap = cap;
+  return LP_OK;
+}
+
+lp_status_t lp__buf_grow(lp_buf* b, size_t need) {
+  if (!b) return LP_ERR_INVALID;
+  if (need <= b->cap) return LP_OK;
+  if (b->kind == LP_BUF_FIXED) return LP_ERR_NOMEM;
+
+  size_t cap = 0;
+  if (lp_checked_mul_size(b->cap, 2u, &cap) != LP_OK || cap < need) cap = need;
+  if (cap < LP__BUF_MIN_CAP) cap = LP__BUF_MIN_CAP;
+
+  if (b->kind == LP_BUF_ARENA && lp__buf_owned(b)) {
+    if (lp_arena_resize_top(b->arena, b->data, b->cap, cap)) {
+      b->cap = cap;
+      return LP_OK;
+    }
+    if (cap > need && lp_arena_resize_top(b->arena, b->data, b->cap, need)) {
+      b->cap = need;
+      return LP_OK;
+    }
+  }
+
+  uint8_t* p = NULL;
+  lp_status_t st = lp__buf_move(b, cap, need, &p, &cap);
+  if (st != LP_OK) return st;
+  lp__buf_release(b);
+  b->data = p;
+  b->cap = cap;
+  return LP_OK;
+}
+
+lp_status_t lp_buf_append(lp_buf* b, const void* p, size_t n) {
+  if (!b || (!p && n)) return LP_ERR_INVALID;
+  lp_status_t st = lp_buf_reserve(b, n);
+  if (st != LP_OK) return st;
+  if (n) memcpy(b->data + b->len, p, n);
+  b->len += n;
+  return LP_OK;
+}
+
+lp_status_t lp_buf_shrink(lp_buf* b) {
+  if (!b) return LP_ERR_INVALID;
+  if (!lp__buf_owned(b) || b->cap == b->len) return LP_OK;
+
+  if (b->inline_mem && b->len <= b->inline_cap) {
+    if (b->len) memcpy(b->inline_mem, b->data, b->len);
+    lp__buf_release(b);
+    b->data = b->inline_mem;
+    b->cap = b->inline_cap;
+    return LP_OK;
+  }
+  if (b->len == 0) {
+    lp__buf_release(b);
+    lp__buf_reset(b);
+    return LP_OK;
+  }
+  if (b->kind == LP_BUF_ARENA) {
+    // not on top: the space can't be reused anyway
+    if (lp_arena_resize_top(b->arena, b->data, b->cap, b->len)) b->cap = b->len;
+    return LP_OK;
+  }
+  uint8_t* p = NULL;
+  size_t cap = 0;
+  lp_status_t st = lp__buf_move(b, b->len, b->len, &p, &cap);
+  if (st != LP_OK) return st;
+  lp__buf_release(b);
+  b->data = p;
+  b->cap = cap;
+  return LP_OK;
+}
+
+lp_status_t lp_buf_detach(lp_buf* b, lp_span_u8_mut* out) {
+  if (!b || !out) return LP_ERR_INVALID;
+  if (b->kind == LP_BUF_FIXED) {
+    *out = (lp_span_u8_mut){ .ptr = b->len ? b->data : NULL, .len = b->len };
+    b->inline_mem = NULL;
+    b->inline_cap = 0;
+    lp__buf_reset(b);
+    return LP_OK;
+  }
+  if (b->len == 0) {
+    *out = (lp_span_u8_mut){ NULL, 0 };
+    lp__buf_release(b);
+    lp__buf_reset(b);
+    return LP_OK;
+  }
+  uint8_t* p = b->data;
+  if (!lp__buf_owned(b)) {
+    size_t cap = 0;
+    lp_status_t st = lp__buf_move(b, b->len, b->len, &p, &cap);
+    if (st != LP_OK) return st;
+  } else if (b->kind == LP_BUF_ARENA) {
+    (void)lp_arena_resize_top(b->arena, p, b->cap, b->len); // trim the spare tail
+  }
+  *out = (lp_span_u8_mut){ .ptr = p, .len = b->len };
+  lp__buf_reset(b);
+  return LP_OK;
+}
+
+void lp_buf_free(lp_buf* b) {
+  if (!b) return;
+  lp__buf_release(b);
+  lp__buf_reset(b);
+}
@@ -1,4 +1,14 @@
 #include "lp/lp_bytes.h"
+#include "lp/lp_assert.h"
+#include "lp/lp_config.h"
+#include "lp_cpu.h"
+#include <string.h>
+
+#if LP_CFG_ENABLE_SIMD && LP__CPU_X86
+  #define LP__BYTES_X86 1
+  #define LP__TARGET_SSSE3 __attribute__((target("ssse3")))
+  #define LP__TARGET_AVX2  __attribute__((target("avx2")))
+#endif
 
 // -------------------------
 // Checked arithmetic
@@ -23,18 +33,33 @@ lp_status_t lp_checked_mul_size(size_t a, size_t b, size_t* out) {
 // Endian helpers
 // -------------------------
 
+#if defined(__GNUC__) || defined(__clang__)
+  #define LP__HAVE_BSWAP_BUILTINS 1
+#endif
+
 static LP_INLINE uint16_t lp__bswap16(uint16_t x) {
+#if LP__HAVE_BSWAP_BUILTINS
+  return __builtin_bswap16(x);
+#else
   return (uint16_t)((x >> 8) | (x << 8));
+#endif
 }
 
 static LP_INLINE uint32_t lp__bswap32(uint32_t x) {
+#if LP__HAVE_BSWAP_BUILTINS
+  return __builtin_bswap32(x);
+#else
   return ((x & 0x000000FFu) << 24) |
          ((x & 0x0000FF00u) <<  8) |
          ((x & 0x00FF0000u) >>  8) |
          ((x & 0xFF000000u) >> 24);
+#endif
 }
 
 static LP_INLINE uint64_t lp__bswap64(uint64_t x) {
+#if LP__HAVE_BSWAP_BUILTINS
+  return __builtin_bswap64(x);
+#else
   return ((x & 0x00000000000000FFull) << 56) |
          ((x & 0x000000000000FF00ull) << 40) |
          ((x & 0x0000000000FF0000ull) << 24) |
@@ -43,119 +68,213 @@ static LP_INLINE uint64_t lp__bswap64(uint64_t x) {
          ((x & 0x0000FF0000000000ull) >> 24) |
          ((x & 0x00FF000000000000ull) >> 40) |
          ((x & 0xFF00000000000000ull) >> 56);
+#endif
 }
 
+#if defined(LP_LITTLE_ENDIAN)
+  #define LP__HOST_LE LP_LITTLE_ENDIAN
+#else
 static LP_INLINE bool lp__is_little_endian(void) {
   const uint16_t x = 1;
   return *((const uint8_t*)&x) == 1;
 }
+  #define LP__HOST_LE lp__is_little_endian()
+#endif
 
-// Unaligned-safe loads via byte assembly (no aliasing/align UB)
+// Unaligned-safe: memcpy through a local compiles to a plain load/store
+// (plus bswap when the byte order differs) and has no aliasing/align UB.
 uint16_t lp_load_u16_le(const void* p) {
-  const uint8_t* b = (const uint8_t*)p;
-  return (uint16_t)((uint16_t)b[0] | ((uint16_t)b[1] << 8));
+  uint16_t v;
+  memcpy(&v, p, sizeof v);
+  return LP__HOST_LE ? v : lp__bswap16(v);
 }
 
 uint16_t lp_load_u16_be(const void* p) {
-  const uint8_t* b = (const uint8_t*)p;
-  return (uint16_t)(((uint16_t)b[0] << 8) | (uint16_t)b[1]);
+  uint16_t v;
+  memcpy(&v, p, sizeof v);
+  return LP__HOST_LE ? lp__bswap16(v) : v;
 }
 
 uint32_t lp_load_u32_le(const void* p) {
-  const uint8_t* b = (const uint8_t*)p;
-  return (uint32_t)b[0]
-      | ((uint32_t)b[1] << 8)
-      | ((uint32_t)b[2] << 16)
-      | ((uint32_t)b[3] << 24);
+  uint32_t v;
+  memcpy(&v, p, sizeof v);
+  return LP__HOST_LE ? v : lp__bswap32(v);
 }
 
 uint32_t lp_load_u32_be(const void* p) {
-  const uint8_t* b = (const uint8_t*)p;
-  return ((uint32_t)b[0] << 24)
-      | ((uint32_t)b[1] << 16)
-      | ((uint32_t)b[2] << 8)
-      |  (uint32_t)b[3];
+  uint32_t v;
+  memcpy(&v, p, sizeof v);
+  return LP__HOST_LE ? lp__bswap32(v) : v;
 }
 
 uint64_t lp_load_u64_le(const void* p) {
-  const uint8_t* b = (const uint8_t*)p;
-  return (uint64_t)b[0]
-      | ((uint64_t)b[1] << 8)
-      | ((uint64_t)b[2] << 16)
-      | ((uint64_t)b[3] << 24)
-      | ((uint64_t)b[4] << 32)
-      | ((uint64_t)b[5] << 40)
-      | ((uint64_t)b[6] << 48)
-      | ((uint64_t)b[7] << 56);
+  uint64_t v;
+  memcpy(&v, p, sizeof v);
+  return LP__HOST_LE ? v : lp__bswap64(v);
 }
 
 uint64_t lp_load_u64_be(const void* p) {
-  const uint8_t* b = (const uint8_t*)p;
-  return ((uint64_t)b[0] << 56)
-      | ((uint64_t)b[1] << 48)
-      | ((uint64_t)b[2] << 40)
-      | ((uint64_t)b[3] << 32)
-      | ((uint64_t)b[4] << 24)
-      | ((uint64_t)b[5] << 16)
-      | ((uint64_t)b[6] << 8)
-      |  (uint64_t)b[7];
+  uint64_t v;
+  memcpy(&v, p, sizeof v);
+  return LP__HOST_LE ? lp__bswap64(v) : v;
 }
 
 void lp_store_u16_le(void* p, uint16_t v) {
-  uint8_t* b = (uint8_t*)p;
-  b[0] = (uint8_t)(v & 0xFFu);
-  b[1] = (uint8_t)((v >> 8) & 0xFFu);
+  if (!LP__HOST_LE) v = lp__bswap16(v);
+  memcpy(p, &v, sizeof v);
 }
 
 void lp_store_u16_be(void* p, uint16_t v) {
-  uint8_t* b = (uint8_t*)p;
-  b[0] = (uint8_t)((v >> 8) & 0xFFu);
-  b[1] = (uint8_t)(v & 0xFFu);
+  if (LP__HOST_LE) v = lp__bswap16(v);
+  memcpy(p, &v, sizeof v);
 }
 
 void lp_store_u32_le(void* p, uint32_t v) {
-  uint8_t* b = (uint8_t*)p;
-  b[0] = (uint8_t)(v & 0xFFu);
-  b[1] = (uint8_t)((v >> 8) & 0xFFu);
-  b[2] = (uint8_t)((v >> 16) & 0xFFu);
-  b[3] = (uint8_t)((v >> 24) & 0xFFu);
+  if (!LP__HOST_LE) v = lp__bswap32(v);
+  memcpy(p, &v, sizeof v);
 }
 
 void lp_store_u32_be(void* p, uint32_t v) {
-  uint8_t* b = (uint8_t*)p;
-  b[0] = (uint8_t)((v >> 24) & 0xFFu);
-  b[1] = (uint8_t)((v >> 16) & 0xFFu);
-  b[2] = (uint8_t)((v >> 8) & 0xFFu);
-  b[3] = (uint8_t)(v & 0xFFu);
+  if (LP__HOST_LE) v = lp__bswap32(v);
+  memcpy(p, &v, sizeof v);
 }
 
 void lp_store_u64_le(void* p, uint64_t v) {
-  uint8_t* b = (uint8_t*)p;
-  b[0] = (uint8_t)(v & 0xFFull);
-  b[1] = (uint8_t)((v >> 8) & 0xFFull);
-  b[2] = (uint8_t)((v >> 16) & 0xFFull);
-  b[3] = (uint8_t)((v >> 24) & 0xFFull);
-  b[4] = (uint8_t)((v >> 32) & 0xFFull);
-  b[5] = (uint8_t)((v >> 40) & 0xFFull);
-  b[6] = (uint8_t)((v >> 48) & 0xFFull);
-  b[7] = (uint8_t)((v >> 56) & 0xFFull);
+  if (!LP__HOST_LE) v = lp__bswap64(v);
+  memcpy(p, &v, sizeof v);
 }
 
 void lp_store_u64_be(void* p, uint64_t v) {
-  uint8_t* b = (uint8_t*)p;
-  b[0] = (uint8_t)((v >> 56) & 0xFFull);
-  b[1] = (uint8_t)((v >> 48) & 0xFFull);
-  b[2] = (uint8_t)((v >> 40) & 0xFFull);
-  b[3] = (uint8_t)((v >> 32) & 0xFFull);
-  b[4] = (uint8_t)((v >> 24) & 0xFFull);
-  b[5] = (uint8_t)((v >> 16) & 0xFFull);
-  b[6] = (uint8_t)((v >> 8) & 0xFFull);
-  b[7] = (uint8_t)(v & 0xFFull);
-}
-
-// Note: bswap helpers retained for future use (hashing etc.)
-LP_UNUSED(lp__bswap16);
-LP_UNUSED(lp__bswap32);
-LP_UNUSED(lp__bswap64);
-LP_UNUSED(lp__is_little_endian);
+  if (LP__HOST_LE) v = lp__bswap64(v);
+  memcpy(p, &v, sizeof v);
+}
+
+// -------------------------
+// Endian arrays
+// -------------------------
+//
+// A load and a store of the same order are the same operation on bytes:
+// either a straight copy (host order matches) or a copy that reverses
+// every width-byte element. Both directions share these two helpers.
+
+static void lp__copy_n(void* dst, const void* src, size_t bytes) {
+  if (bytes && dst != src) memcpy(dst, src, bytes);
+}
+
+#if LP__BYTES_X86
+
+LP__TARGET_SSSE3
+static __m128i lp__bswap_mask_sse(size_t width) {
+  if (width == 2u) return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  if (width == 4u) return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+}
+
+// Both kernels return the bytes handled; every load of a block happens
+// before its store, so dst == src is fine.
+LP__TARGET_SSSE3
+static size_t lp__bswap_ssse3(uint8_t* d, const uint8_t* s, size_t bytes, size_t width) {
+  const __m128i m = lp__bswap_mask_sse(width);
+  size_t i = 0;
+  for (; i + 64u <= bytes; i += 64u) {
+    __m128i a = _mm_loadu_si128((const __m128i*)(s + i));
+    __m128i b = _mm_loadu_si128((const __m128i*)(s + i + 16u));
+    __m128i c = _mm_loadu_si128((const __m128i*)(s + i + 32u));
+    __m128i e = _mm_loadu_si128((const __m128i*)(s + i + 48u));
+    _mm_storeu_si128((__m128i*)(d + i), _mm_shuffle_epi8(a, m));
+    _mm_storeu_si128((__m128i*)(d + i + 16u), _mm_shuffle_epi8(b, m));
+    _mm_storeu_si128((__m128i*)(d + i + 32u), _mm_shuffle_epi8(c, m));
+    _mm_storeu_si128((__m128i*)(d + i + 48u), _mm_shuffle_epi8(e, m));
+  }
+  for (; i + 16u <= bytes; i += 16u) {
+    __m128i a = _mm_loadu_si128((const __m128i*)(s + i));
+    _mm_storeu_si128((__m128i*)(d + i), _mm_shuffle_epi8(a, m));
+  }
+  return i;
+}
+
+LP__TARGET_AVX2
+static size_t lp__bswap_avx2(uint8_t* d, const uint8_t* s, size_t bytes, size_t width) {
+  const __m256i m = _mm256_broadcastsi128_si256(lp__bswap_mask_sse(width));
+  size_t i = 0;
+  for (; i + 128u <= bytes; i += 128u) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)(s + i));
+    __m256i b = _mm256_loadu_si256((const __m256i*)(s + i + 32u));
+    __m256i c = _mm256_loadu_si256((const __m256i*)(s + i + 64u));
+    __m256i e = _mm256_loadu_si256((const __m256i*)(s + i + 96u));
+    _mm256_storeu_si256((__m256i*)(d + i), _mm256_shuffle_epi8(a, m));
+    _mm256_storeu_si256((__m256i*)(d + i + 32u), _mm256_shuffle_epi8(b, m));
+    _mm256_storeu_si256((__m256i*)(d + i + 64u), _mm256_shuffle_epi8(c, m));
+    _mm256_storeu_si256((__m256i*)(d + i + 96u), _mm256_shuffle_epi8(e, m));
+  }
+  for (; i + 32u <= bytes; i += 32u) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)(s + i));
+    _mm256_storeu_si256((__m256i*)(d + i), _mm256_shuffle_epi8(a, m));
+  }
+  return i;
+}
+
+#endif // LP__BYTES_X86
+
+static void lp__bswap_copy(void* dst, const void* src, size_t count, size_t width) {
+  uint8_t* d = (uint8_t*)dst;
+  const uint8_t* s = (const uint8_t*)src;
+  size_t bytes = count * width;
+
+#if LP__BYTES_X86
+  size_t done = 0;
+  if (lp__cpu_has_avx2()) done = lp__bswap_avx2(d, s, bytes, width);
+  else if (lp__cpu_has_ssse3()) done = lp__bswap_ssse3(d, s, bytes, width);
+  d += done;
+  s += done;
+  bytes -= done;
+#endif
+
+  // Scalar: builtin bswap per element (the compiler may vectorize this too).
+  switch (width) {
+    case 2u:
+      for (; bytes; bytes -= 2u, d += 2u, s += 2u) {
+        uint16_t v;
+        memcpy(&v, s, 2u);
+        v = lp__bswap16(v);
+        memcpy(d, &v, 2u);
+      }
+      break;
+    case 4u:
+      for (; bytes; bytes -= 4u, d += 4u, s += 4u) {
+        uint32_t v;
+        memcpy(&v, s, 4u);
+        v = lp__bswap32(v);
+        memcpy(d, &v, 4u);
+      }
+      break;
+    default:
+      for (; bytes; bytes -= 8u, d += 8u, s += 8u) {
+        uint64_t v;
+        memcpy(&v, s, 8u);
+        v = lp__bswap64(v);
+        memcpy(d, &v, 8u);
+      }
+      break;
+  }
+}
+
+static void lp__endian_copy(void* dst, const void* src, size_t count, size_t width, bool little) {
+  LP_ASSERT(count == 0 || (dst && src));
+  if (little == LP__HOST_LE) lp__copy_n(dst, src, count * width);
+  else lp__bswap_copy(dst, src, count, width);
+}
+
+void lp_load_u16_le_n(uint16_t* dst, const void* src, size_t count) { lp__endian_copy(dst, src, count, 2u, true); }
+void lp_load_u16_be_n(uint16_t* dst, const void* src, size_t count) { lp__endian_copy(dst, src, count, 2u, false); }
+void lp_load_u32_le_n(uint32_t* dst, const void* src, size_t count) { lp__endian_copy(dst, src, count, 4u, true); }
+void lp_load_u32_be_n(uint32_t* dst, const void* src, size_t count) { lp__endian_copy(dst, src, count, 4u, false); }
+void lp_load_u64_le_n(uint64_t* dst, const void* src, size_t count) { lp__endian_copy(dst, src, count, 8u, true); }
+void lp_load_u64_be_n(uint64_t* dst, const void* src, size_t count) { lp__endian_copy(dst, src, count, 8u, false); }
 
+void lp_store_u16_le_n(void* dst, const uint16_t* src, size_t count) { lp__endian_copy(dst, src, count, 2u, true); }
+void lp_store_u16_be_n(void* dst, const uint16_t* src, size_t count) { lp__endian_copy(dst, src, count, 2u, false); }
+void lp_store_u32_le_n(void* dst, const uint32_t* src, size_t count) { lp__endian_copy(dst, src, count, 4u, true); }
+void lp_store_u32_be_n(void* dst, const uint32_t* src, size_t count) { lp__endian_copy(dst, src, count, 4u, false); }
+void lp_store_u64_le_n(void* dst, const uint64_t* src, size_t count) { lp__endian_copy(dst, src, count, 8u, true); }
+void lp_store_u64_be_n(void* dst, const uint64_t* src, size_t count) { lp__endian_copy(dst, src, count, 8u, false); }
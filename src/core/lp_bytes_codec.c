@@ -0,0 +1,560 @@
+#include "lp/lp_bytes.h"
+#include "lp/lp_config.h"
+#include "lp_cpu.h"
+
+/*
+  Hex and base64 codecs. Each direction has a portable path (SWAR for hex
+  encode, lookup tables elsewhere) plus SSSE3/AVX2 kernels on x86 that
+  handle the bulk; the portable path finishes the tail.
+*/
+
+#if LP_CFG_ENABLE_SIMD && LP__CPU_X86
+  #define LP__CODEC_X86 1
+  #define LP__TARGET_SSSE3 __attribute__((target("ssse3")))
+  #define LP__TARGET_AVX2  __attribute__((target("avx2")))
+#endif
+
+static const char lp__hex_lower[16] = "0123456789abcdef";
+static const char lp__hex_upper[16] = "0123456789ABCDEF";
+
+static const char lp__b64_std[64] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char lp__b64_url[64] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Character -> value, 0xFF for characters outside the alphabet.
+static const uint8_t lp__b64_dec_std[256] = {
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff, 0xff, 0x3f,
+  0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+  0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+  0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const uint8_t lp__b64_dec_url[256] = {
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3e, 0xff, 0xff,
+  0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+  0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xff, 0xff, 0xff, 0xff, 0x3f,
+  0xff, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+  0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static const uint8_t lp__hex_dec[256] = {
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+// -------------------------
+// Hex: portable
+// -------------------------
+
+// 4 bytes -> 8 chars per step: spread the nybbles into the bytes of a u64,
+// then add '0', plus the letter offset where the nybble is >= 10.
+static void lp__hex_encode_swar(uint8_t* d, const uint8_t* s, size_t n, bool upper) {
+  const uint64_t letters = upper ? (uint64_t)('A' - '0' - 10) : (uint64_t)('a' - '0' - 10);
+  while (n >= 4) {
+    uint64_t x = 0;
+    for (uint32_t i = 0; i < 4; i++) {
+      x |= (uint64_t)(s[i] >> 4) << (16u * i);
+      x |= (uint64_t)(s[i] & 0x0Fu) << (16u * i + 8u);
+    }
+    uint64_t alpha = ((x + 0x0606060606060606ull) >> 4) & 0x0101010101010101ull;
+    x += 0x3030303030303030ull + alpha * letters;
+    lp_store_u64_le(d, x);
+    s += 4;
+    d += 8;
+    n -= 4;
+  }
+
+  const char* digits = upper ? lp__hex_upper : lp__hex_lower;
+  for (; n; n--, s++, d += 2) {
+    d[0] = (uint8_t)digits[*s >> 4];
+    d[1] = (uint8_t)digits[*s & 0x0Fu];
+  }
+}
+
+// Invalid characters map to 0xFF, so one OR across the input catches them.
+static bool lp__hex_decode_tab(uint8_t* d, const uint8_t* s, size_t n_out) {
+  uint8_t bad = 0;
+  for (size_t i = 0; i < n_out; i++) {
+    uint8_t hi = lp__hex_dec[s[2u * i]];
+    uint8_t lo = lp__hex_dec[s[2u * i + 1u]];
+    bad |= (uint8_t)(hi | lo);
+    d[i] = (uint8_t)((hi << 4) | (lo & 0x0Fu));
+  }
+  return (bad & 0x80u) == 0;
+}
+
+// -------------------------
+// Hex: x86
+// -------------------------
+
+#if LP__CODEC_X86
+
+LP__TARGET_SSSE3
+static size_t lp__hex_encode_ssse3(uint8_t* d, const uint8_t* s, size_t n, bool upper) {
+  const __m128i lut = _mm_loadu_si128((const __m128i*)(upper ? lp__hex_upper : lp__hex_lower));
+  const __m128i m = _mm_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 16u <= n; i += 16u) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+    __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), m));
+    __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, m));
+    _mm_storeu_si128((__m128i*)(d + 2u * i), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128((__m128i*)(d + 2u * i + 16u), _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+
+LP__TARGET_AVX2
+static size_t lp__hex_encode_avx2(uint8_t* d, const uint8_t* s, size_t n, bool upper) {
+  const __m256i lut = _mm256_broadcastsi128_si256(
+    _mm_loadu_si128((const __m128i*)(upper ? lp__hex_upper : lp__hex_lower)));
+  const __m256i m = _mm256_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 32u <= n; i += 32u) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)(s + i));
+    __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), m));
+    __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, m));
+    // unpack works per 128-bit lane; stitch the lanes back in order
+    __m256i a = _mm256_unpacklo_epi8(hi, lo);
+    __m256i b = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256((__m256i*)(d + 2u * i), _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256((__m256i*)(d + 2u * i + 32u), _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  return i;
+}
+
+// 16 hex chars -> 16 nybble values; invalid lanes are set in *bad.
+LP__TARGET_SSSE3
+static inline __m128i lp__hex_nybbles_sse(__m128i c, __m128i* bad) {
+  __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+  __m128i dig = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                              _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+  __m128i alp = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                              _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+  *bad = _mm_or_si128(*bad, _mm_xor_si128(_mm_or_si128(dig, alp), _mm_set1_epi8(-1)));
+  return _mm_or_si128(_mm_and_si128(dig, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                      _mm_and_si128(alp, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+// Returns chars consumed, or SIZE_MAX on an invalid character.
+LP__TARGET_SSSE3
+static size_t lp__hex_decode_ssse3(uint8_t* d, const uint8_t* s, size_t n) {
+  const __m128i w = _mm_set1_epi16(0x0110); // hi * 16 + lo per byte pair
+  size_t i = 0;
+  for (; i + 32u <= n; i += 32u) {
+    __m128i bad = _mm_setzero_si128();
+    __m128i a = lp__hex_nybbles_sse(_mm_loadu_si128((const __m128i*)(s + i)), &bad);
+    __m128i b = lp__hex_nybbles_sse(_mm_loadu_si128((const __m128i*)(s + i + 16u)), &bad);
+    if (_mm_movemask_epi8(bad)) return SIZE_MAX;
+    __m128i out = _mm_packus_epi16(_mm_maddubs_epi16(a, w), _mm_maddubs_epi16(b, w));
+    _mm_storeu_si128((__m128i*)(d + i / 2u), out);
+  }
+  return i;
+}
+
+LP__TARGET_AVX2
+static inline __m256i lp__hex_nybbles_avx2(__m256i c, __m256i* bad) {
+  __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+  __m256i dig = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                                 _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+  __m256i alp = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                 _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+  *bad = _mm256_or_si256(*bad, _mm256_xor_si256(_mm256_or_si256(dig, alp), _mm256_set1_epi8(-1)));
+  return _mm256_or_si256(_mm256_and_si256(dig, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))),
+                         _mm256_and_si256(alp, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+}
+
+LP__TARGET_AVX2
+static size_t lp__hex_decode_avx2(uint8_t* d, const uint8_t* s, size_t n) {
+  const __m256i w = _mm256_set1_epi16(0x0110);
+  size_t i = 0;
+  for (; i + 64u <= n; i += 64u) {
+    __m256i bad = _mm256_setzero_si256();
+    __m256i a = lp__hex_nybbles_avx2(_mm256_loadu_si256((const __m256i*)(s + i)), &bad);
+    __m256i b = lp__hex_nybbles_avx2(_mm256_loadu_si256((const __m256i*)(s + i + 32u)), &bad);
+    if (_mm256_movemask_epi8(bad)) return SIZE_MAX;
+    __m256i out = _mm256_packus_epi16(_mm256_maddubs_epi16(a, w), _mm256_maddubs_epi16(b, w));
+    out = _mm256_permute4x64_epi64(out, 0xD8); // packus is per lane
+    _mm256_storeu_si256((__m256i*)(d + i / 2u), out);
+  }
+  return i;
+}
+
+#endif // LP__CODEC_X86
+
+// -------------------------
+// Hex: API
+// -------------------------
+
+lp_status_t lp_hex_encode(lp_span_u8_mut dst, lp_span_u8 src, bool uppercase, size_t* out_len) {
+  if (!out_len) return LP_ERR_INVALID;
+  if ((!src.ptr && src.len) || (!dst.ptr && dst.len)) return LP_ERR_INVALID;
+  if (src.len > SIZE_MAX / 2u) return LP_ERR_OVERFLOW;
+  if (dst.len < lp_hex_encoded_len(src.len)) return LP_ERR_RANGE;
+
+  const uint8_t* s = src.ptr;
+  uint8_t* d = dst.ptr;
+  size_t n = src.len;
+#if LP__CODEC_X86
+  size_t done = 0;
+  if (lp__cpu_has_avx2()) done = lp__hex_encode_avx2(d, s, n, uppercase);
+  else if (lp__cpu_has_ssse3()) done = lp__hex_encode_ssse3(d, s, n, uppercase);
+  s += done;
+  d += 2u * done;
+  n -= done;
+#endif
+  lp__hex_encode_swar(d, s, n, uppercase);
+
+  *out_len = lp_hex_encoded_len(src.len);
+  return LP_OK;
+}
+
+lp_status_t lp_hex_decode(lp_span_u8_mut dst, lp_strview src, size_t* out_len) {
+  if (!out_len) return LP_ERR_INVALID;
+  if ((!src.ptr && src.len) || (!dst.ptr && dst.len)) return LP_ERR_INVALID;
+  if (src.len % 2u) return LP_ERR_INVALID;
+  if (dst.len < lp_hex_decoded_len(src.len)) return LP_ERR_RANGE;
+
+  const uint8_t* s = (const uint8_t*)src.ptr;
+  uint8_t* d = dst.ptr;
+  size_t n = src.len;
+#if LP__CODEC_X86
+  size_t done = 0;
+  if (lp__cpu_has_avx2()) done = lp__hex_decode_avx2(d, s, n);
+  else if (lp__cpu_has_ssse3()) done = lp__hex_decode_ssse3(d, s, n);
+  if (done == SIZE_MAX) return LP_ERR_INVALID;
+  s += done;
+  d += done / 2u;
+  n -= done;
+#endif
+  if (!lp__hex_decode_tab(d, s, n / 2u)) return LP_ERR_INVALID;
+
+  *out_len = lp_hex_decoded_len(src.len);
+  return LP_OK;
+}
+
+// -------------------------
+// Base64: portable
+// -------------------------
+
+static void lp__b64_encode_scalar(uint8_t* d, const uint8_t* s, size_t n, const char* tab, bool pad) {
+  for (; n >= 3u; n -= 3u, s += 3u, d += 4u) {
+    uint32_t v = ((uint32_t)s[0] << 16) | ((uint32_t)s[1] << 8) | s[2];
+    d[0] = (uint8_t)tab[(v >> 18) & 63u];
+    d[1] = (uint8_t)tab[(v >> 12) & 63u];
+    d[2] = (uint8_t)tab[(v >> 6) & 63u];
+    d[3] = (uint8_t)tab[v & 63u];
+  }
+  if (n == 0) return;
+
+  uint32_t v = (uint32_t)s[0] << 16;
+  if (n == 2u) v |= (uint32_t)s[1] << 8;
+  d[0] = (uint8_t)tab[(v >> 18) & 63u];
+  d[1] = (uint8_t)tab[(v >> 12) & 63u];
+  if (n == 2u) d[2] = (uint8_t)tab[(v >> 6) & 63u];
+  if (pad) {
+    if (n == 1u) d[2] = '=';
+    d[3] = '=';
+  }
+}
+
+// Full quads only. Returns false on a character outside the alphabet.
+static bool lp__b64_decode_quads(uint8_t* d, const uint8_t* s, size_t quads, const uint8_t* tab) {
+  uint32_t bad = 0;
+  for (; quads; quads--, s += 4u, d += 3u) {
+    uint32_t a = tab[s[0]], b = tab[s[1]], c = tab[s[2]], e = tab[s[3]];
+    bad |= a | b | c | e;
+    uint32_t v = (a << 18) | (b << 12) | (c << 6) | e;
+    d[0] = (uint8_t)(v >> 16);
+    d[1] = (uint8_t)(v >> 8);
+    d[2] = (uint8_t)v;
+  }
+  return (bad & 0x80u) == 0;
+}
+
+// -------------------------
+// Base64: x86
+// -------------------------
+
+#if LP__CODEC_X86
+
+/*
+  Encode (W. Muła / D. Lemire): shuffle each 3-byte group into a 32-bit
+  lane, split the four sextets out with two multiplies, then turn sextets
+  into ASCII with a 16-entry offset table indexed by range.
+*/
+LP__TARGET_SSSE3
+static inline __m128i lp__b64_sextets_sse(__m128i in) {
+  in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+LP__TARGET_SSSE3
+static inline __m128i lp__b64_ascii_sse(__m128i idx, __m128i shift_lut) {
+  // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+  __m128i r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+  __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), idx);
+  r = _mm_or_si128(r, _mm_and_si128(less, _mm_set1_epi8(13)));
+  return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, r), idx);
+}
+
+#define LP__B64_SHIFT_LUT(c62, c63)                                           \
+  'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,       \
+  '0' - 52, '0' - 52, '0' - 52, '0' - 52, (c62) - 62, (c63) - 63, 'A', 0, 0
+
+// Returns input bytes consumed (a multiple of 12).
+LP__TARGET_SSSE3
+static size_t lp__b64_encode_ssse3(uint8_t* d, const uint8_t* s, size_t n, bool url) {
+  const __m128i lut = url ? _mm_setr_epi8(LP__B64_SHIFT_LUT('-', '_'))
+                          : _mm_setr_epi8(LP__B64_SHIFT_LUT('+', '/'));
+  size_t i = 0;
+  for (; i + 16u <= n; i += 12u, d += 16u) {
+    __m128i idx = lp__b64_sextets_sse(_mm_loadu_si128((const __m128i*)(s + i)));
+    _mm_storeu_si128((__m128i*)d, lp__b64_ascii_sse(idx, lut));
+  }
+  return i;
+}
+
+LP__TARGET_AVX2
+static size_t lp__b64_encode_avx2(uint8_t* d, const uint8_t* s, size_t n, bool url) {
+  const __m256i lut = url ? _mm256_setr_epi8(LP__B64_SHIFT_LUT('-', '_'), LP__B64_SHIFT_LUT('-', '_'))
+                          : _mm256_setr_epi8(LP__B64_SHIFT_LUT('+', '/'), LP__B64_SHIFT_LUT('+', '/'));
+  const __m256i shuf = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                       10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  size_t i = 0;
+  for (; i + 28u <= n; i += 24u, d += 32u) {
+    // 12 input bytes per lane
+    __m256i in = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(s + i))),
+      _mm_loadu_si128((const __m128i*)(s + i + 12u)), 1);
+    in = _mm256_shuffle_epi8(in, shuf);
+    __m256i t1 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)),
+                                    _mm256_set1_epi32(0x04000040));
+    __m256i t3 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)),
+                                    _mm256_set1_epi32(0x01000010));
+    __m256i idx = _mm256_or_si256(t1, t3);
+
+    __m256i r = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+    __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx);
+    r = _mm256_or_si256(r, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    _mm256_storeu_si256((__m256i*)d, _mm256_add_epi8(_mm256_shuffle_epi8(lut, r), idx));
+  }
+  return i;
+}
+
+/*
+  Decode: classify each character by range (A-Z, a-z, 0-9 and the two
+  symbols), add the matching offset, then pack four sextets into three
+  bytes with two multiply-adds and a shuffle.
+*/
+#define LP__B64_RANGE_SSE(c, lo, hi) \
+  _mm_and_si128(_mm_cmpgt_epi8((c), _mm_set1_epi8((lo) - 1)), _mm_cmpgt_epi8(_mm_set1_epi8((hi) + 1), (c)))
+
+LP__TARGET_SSSE3
+static inline __m128i lp__b64_values_sse(__m128i c, char c62, char c63, __m128i* bad) {
+  __m128i up  = LP__B64_RANGE_SSE(c, 'A', 'Z');
+  __m128i lo  = LP__B64_RANGE_SSE(c, 'a', 'z');
+  __m128i dg  = LP__B64_RANGE_SSE(c, '0', '9');
+  __m128i s62 = _mm_cmpeq_epi8(c, _mm_set1_epi8(c62));
+  __m128i s63 = _mm_cmpeq_epi8(c, _mm_set1_epi8(c63));
+  __m128i ok  = _mm_or_si128(_mm_or_si128(_mm_or_si128(up, lo), _mm_or_si128(dg, s62)), s63);
+  *bad = _mm_or_si128(*bad, _mm_xor_si128(ok, _mm_set1_epi8(-1)));
+
+  __m128i off = _mm_and_si128(up, _mm_set1_epi8(-'A'));
+  off = _mm_or_si128(off, _mm_and_si128(lo, _mm_set1_epi8(26 - 'a')));
+  off = _mm_or_si128(off, _mm_and_si128(dg, _mm_set1_epi8(52 - '0')));
+  off = _mm_or_si128(off, _mm_and_si128(s62, _mm_set1_epi8((char)(62 - c62))));
+  off = _mm_or_si128(off, _mm_and_si128(s63, _mm_set1_epi8((char)(63 - c63))));
+  return _mm_add_epi8(c, off);
+}
+
+// Returns chars consumed (a multiple of 16), or SIZE_MAX on a bad character.
+// Writes 16 bytes per 12 produced, never past dcap: pass the decoded
+// length, not the buffer size, so bytes after the output stay untouched.
+LP__TARGET_SSSE3
+static size_t lp__b64_decode_ssse3(uint8_t* d, size_t dcap, const uint8_t* s, size_t n, bool url) {
+  const char c62 = url ? '-' : '+';
+  const char c63 = url ? '_' : '/';
+  const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  size_t i = 0, o = 0;
+  for (; i + 16u <= n && o + 16u <= dcap; i += 16u, o += 12u) {
+    __m128i bad = _mm_setzero_si128();
+    __m128i v = lp__b64_values_sse(_mm_loadu_si128((const __m128i*)(s + i)), c62, c63, &bad);
+    if (_mm_movemask_epi8(bad)) return SIZE_MAX;
+    v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+    v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128((__m128i*)(d + o), _mm_shuffle_epi8(v, pack));
+  }
+  return i;
+}
+
+#define LP__B64_RANGE_AVX2(c, lo, hi) \
+  _mm256_and_si256(_mm256_cmpgt_epi8((c), _mm256_set1_epi8((lo) - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8((hi) + 1), (c)))
+
+LP__TARGET_AVX2
+static size_t lp__b64_decode_avx2(uint8_t* d, size_t dcap, const uint8_t* s, size_t n, bool url) {
+  const char c62 = url ? '-' : '+';
+  const char c63 = url ? '_' : '/';
+  const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+  size_t i = 0, o = 0;
+  for (; i + 32u <= n && o + 32u <= dcap; i += 32u, o += 24u) {
+    __m256i c = _mm256_loadu_si256((const __m256i*)(s + i));
+    __m256i up  = LP__B64_RANGE_AVX2(c, 'A', 'Z');
+    __m256i lo  = LP__B64_RANGE_AVX2(c, 'a', 'z');
+    __m256i dg  = LP__B64_RANGE_AVX2(c, '0', '9');
+    __m256i s62 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(c62));
+    __m256i s63 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(c63));
+    __m256i ok  = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(up, lo), _mm256_or_si256(dg, s62)), s63);
+    if ((uint32_t)_mm256_movemask_epi8(ok) != 0xFFFFFFFFu) return SIZE_MAX;
+
+    __m256i off = _mm256_and_si256(up, _mm256_set1_epi8(-'A'));
+    off = _mm256_or_si256(off, _mm256_and_si256(lo, _mm256_set1_epi8(26 - 'a')));
+    off = _mm256_or_si256(off, _mm256_and_si256(dg, _mm256_set1_epi8(52 - '0')));
+    off = _mm256_or_si256(off, _mm256_and_si256(s62, _mm256_set1_epi8((char)(62 - c62))));
+    off = _mm256_or_si256(off, _mm256_and_si256(s63, _mm256_set1_epi8((char)(63 - c63))));
+    __m256i v = _mm256_add_epi8(c, off);
+
+    v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+    v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+    v = _mm256_shuffle_epi8(v, pack);
+    _mm256_storeu_si256((__m256i*)(d + o), _mm256_permutevar8x32_epi32(v, compact));
+  }
+  return i;
+}
+
+#endif // LP__CODEC_X86
+
+// -------------------------
+// Base64: API
+// -------------------------
+
+size_t lp_base64_encoded_len(size_t n, lp_base64_alphabet alpha) {
+  size_t full = (n / 3u) * 4u;
+  size_t rem = n % 3u;
+  if (rem == 0) return full;
+  return full + ((alpha == LP_BASE64_URL) ? (rem + 1u) : 4u);
+}
+
+lp_status_t lp_base64_encode(lp_span_u8_mut dst, lp_span_u8 src, lp_base64_alphabet alpha, size_t* out_len) {
+  if (!out_len) return LP_ERR_INVALID;
+  if ((!src.ptr && src.len) || (!dst.ptr && dst.len)) return LP_ERR_INVALID;
+  if (alpha != LP_BASE64_STD && alpha != LP_BASE64_URL) return LP_ERR_INVALID;
+  if (src.len / 3u > (SIZE_MAX / 4u) - 1u) return LP_ERR_OVERFLOW;
+
+  size_t need = lp_base64_encoded_len(src.len, alpha);
+  if (dst.len < need) return LP_ERR_RANGE;
+
+  bool url = (alpha == LP_BASE64_URL);
+  const uint8_t* s = src.ptr;
+  uint8_t* d = dst.ptr;
+  size_t n = src.len;
+#if LP__CODEC_X86
+  size_t done = 0;
+  if (lp__cpu_has_avx2()) done = lp__b64_encode_avx2(d, s, n, url);
+  else if (lp__cpu_has_ssse3()) done = lp__b64_encode_ssse3(d, s, n, url);
+  s += done;
+  d += (done / 3u) * 4u;
+  n -= done;
+#endif
+  lp__b64_encode_scalar(d, s, n, url ? lp__b64_url : lp__b64_std, !url);
+
+  *out_len = need;
+  return LP_OK;
+}
+
+lp_status_t lp_base64_decode(lp_span_u8_mut dst, lp_strview src, lp_base64_alphabet alpha, size_t* out_len) {
+  if (!out_len) return LP_ERR_INVALID;
+  if ((!src.ptr && src.len) || (!dst.ptr && dst.len)) return LP_ERR_INVALID;
+  if (alpha != LP_BASE64_STD && alpha != LP_BASE64_URL) return LP_ERR_INVALID;
+
+  const uint8_t* s = (const uint8_t*)src.ptr;
+  size_t body = src.len;
+  if (alpha == LP_BASE64_STD) {
+    if (body % 4u) return LP_ERR_INVALID;
+    if (body && s[body - 1u] == '=') body--;
+    if (body && body == src.len - 1u && s[body - 1u] == '=') body--;
+  }
+  // a lone trailing character can't encode a whole byte; any '=' left in
+  // the body fails the alphabet check below
+  size_t rem = body % 4u;
+  if (rem == 1u) return LP_ERR_INVALID;
+
+  size_t need = (body / 4u) * 3u + (rem ? rem - 1u : 0u);
+  if (dst.len < need) return LP_ERR_RANGE;
+
+  const uint8_t* tab = (alpha == LP_BASE64_URL) ? lp__b64_dec_url : lp__b64_dec_std;
+  uint8_t* d = dst.ptr;
+  size_t quads_len = body - rem;
+  size_t i = 0;
+#if LP__CODEC_X86
+  size_t done = 0;
+  bool url = (alpha == LP_BASE64_URL);
+  if (lp__cpu_has_avx2()) done = lp__b64_decode_avx2(d, need, s, quads_len, url);
+  else if (lp__cpu_has_ssse3()) done = lp__b64_decode_ssse3(d, need, s, quads_len, url);
+  if (done == SIZE_MAX) return LP_ERR_INVALID;
+  i = done;
+  d += (done / 4u) * 3u;
+#endif
+  if (!lp__b64_decode_quads(d, s + i, (quads_len - i) / 4u, tab)) return LP_ERR_INVALID;
+  d += ((quads_len - i) / 4u) * 3u;
+
+  if (rem) {
+    const uint8_t* t = s + quads_len;
+    uint32_t a = tab[t[0]], b = tab[t[1]];
+    uint32_t c = (rem == 3u) ? tab[t[2]] : 0u;
+    if ((a | b | c) & 0x80u) return LP_ERR_INVALID;
+    uint32_t v = (a << 18) | (b << 12) | (c << 6);
+    // unused low bits must be zero (canonical encoding)
+    if (rem == 2u && (v & 0xFFFFu)) return LP_ERR_INVALID;
+    if (rem == 3u && (v & 0xFFu)) return LP_ERR_INVALID;
+    d[0] = (uint8_t)(v >> 16);
+    if (rem == 3u) d[1] = (uint8_t)(v >> 8);
+  }
+
+  *out_len = need;
+  return LP_OK;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "lp/lp_platform.h"
+
+/*
+  Private: x86 feature checks for the SIMD kernels in src/core.
+  Features enabled at compile time (-m...) skip the runtime query.
+*/
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  #define LP__CPU_X86 1
+  #include <immintrin.h>
+
+static LP_INLINE bool lp__cpu_has_ssse3(void) {
+#if defined(__SSSE3__)
+  return true;
+#else
+  return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+static LP_INLINE bool lp__cpu_has_sse42(void) {
+#if defined(__SSE4_2__)
+  return true;
+#else
+  return __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+static LP_INLINE bool lp__cpu_has_clmul(void) {
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+  return true;
+#else
+  return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+static LP_INLINE bool lp__cpu_has_avx2(void) {
+#if defined(__AVX2__)
+  return true;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
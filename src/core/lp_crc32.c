@@ -0,0 +1,223 @@
+#include "lp/lp_crc32.h"
+#include "lp/lp_config.h"
+#include "lp/lp_bytes.h"
+#include <string.h>
+
+#if LP_CFG_CRC32_SLICE8
+  #define LP__CRC32_ROWS 8
+#else
+  #define LP__CRC32_ROWS 1
+#endif
+#include "lp_crc32_tab.h"
+
+#include "lp_cpu.h"
+
+#if LP_CFG_CRC32_HW && LP__CPU_X86
+  #define LP__CRC_X86 1
+#endif
+
+#if LP_CFG_CRC32_HW && defined(__ARM_FEATURE_CRC32) && !defined(__ARM_BIG_ENDIAN)
+  #define LP__CRC_ARM 1
+  #include <arm_acle.h>
+#endif
+
+// -------------------------
+// Portable table path
+// -------------------------
+
+static uint32_t lp__crc_sw(const uint32_t (*t)[256], uint32_t c, const uint8_t* p, size_t n) {
+#if LP__CRC32_ROWS == 8
+  // slicing-by-8: fold 8 input bytes per step, one lookup per byte
+  while (n >= 8) {
+    uint32_t lo = lp_load_u32_le(p) ^ c;
+    uint32_t hi = lp_load_u32_le(p + 4);
+    c = t[7][lo & 0xFFu] ^ t[6][(lo >> 8) & 0xFFu] ^ t[5][(lo >> 16) & 0xFFu] ^ t[4][lo >> 24]
+      ^ t[3][hi & 0xFFu] ^ t[2][(hi >> 8) & 0xFFu] ^ t[1][(hi >> 16) & 0xFFu] ^ t[0][hi >> 24];
+    p += 8;
+    n -= 8;
+  }
+#endif
+  while (n--) c = t[0][(c ^ *p++) & 0xFFu] ^ (c >> 8);
+  return c;
+}
+
+// -------------------------
+// x86: PCLMULQDQ folding (CRC-32), SSE4.2 crc32 (CRC-32C)
+// -------------------------
+
+#if LP__CRC_X86
+
+/*
+  Folding per Intel's "Fast CRC Computation for Generic Polynomials Using
+  PCLMULQDQ" (bit-reflected constants for 0x04C11DB7). Four 128-bit lanes
+  are folded 64 bytes at a time, merged to one lane, then Barrett-reduced.
+  Requires n >= 64 and n % 16 == 0.
+*/
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t lp__crc32_clmul(uint32_t c, const uint8_t* p, size_t n) {
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596ll, 0x0154442bd4ll);
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009ell, 0x01751997d0ll);
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000ll, 0x0163cd6124ll);
+  const __m128i poly = _mm_set_epi64x(0x01f7011641ll, 0x01db710641ll);
+  const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  x1 = _mm_loadu_si128((const __m128i*)(p + 0x00));
+  x2 = _mm_loadu_si128((const __m128i*)(p + 0x10));
+  x3 = _mm_loadu_si128((const __m128i*)(p + 0x20));
+  x4 = _mm_loadu_si128((const __m128i*)(p + 0x30));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)c));
+  p += 64;
+  n -= 64;
+
+  x0 = k1k2;
+  while (n >= 64) {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)(p + 0x00)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*)(p + 0x10)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*)(p + 0x20)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*)(p + 0x30)));
+    p += 64;
+    n -= 64;
+  }
+
+  // fold 4 lanes into 1
+  x0 = k3k4;
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  while (n >= 16) {
+    x2 = _mm_loadu_si128((const __m128i*)p);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    p += 16;
+    n -= 16;
+  }
+
+  // 128 -> 64 bits
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x0 = k5k0;
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask32);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits
+  x0 = poly;
+  x2 = _mm_and_si128(x1, mask32);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+  x2 = _mm_and_si128(x2, mask32);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t lp__crc32c_sse42(uint32_t c, const uint8_t* p, size_t n) {
+#if defined(__x86_64__)
+  uint64_t c64 = c;
+  while (n >= 8) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    c64 = _mm_crc32_u64(c64, v);
+    p += 8;
+    n -= 8;
+  }
+  c = (uint32_t)c64;
+#endif
+  while (n >= 4) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    c = _mm_crc32_u32(c, v);
+    p += 4;
+    n -= 4;
+  }
+  while (n--) c = _mm_crc32_u8(c, *p++);
+  return c;
+}
+
+#endif // LP__CRC_X86
+
+// -------------------------
+// ARMv8 CRC32 extension
+// -------------------------
+
+#if LP__CRC_ARM
+
+#define LP__CRC_ARM_KERNEL(name, op64, op32, op16, op8)           \
+  static uint32_t name(uint32_t c, const uint8_t* p, size_t n) {  \
+    while (n >= 8) {                                              \
+      uint64_t v; memcpy(&v, p, 8); c = op64(c, v);               \
+      p += 8; n -= 8;                                             \
+    }                                                             \
+    if (n >= 4) { uint32_t v; memcpy(&v, p, 4); c = op32(c, v); p += 4; n -= 4; } \
+    if (n >= 2) { uint16_t v; memcpy(&v, p, 2); c = op16(c, v); p += 2; n -= 2; } \
+    if (n)      { c = op8(c, *p); }                               \
+    return c;                                                     \
+  }
+
+LP__CRC_ARM_KERNEL(lp__crc32_arm,  __crc32d,  __crc32w,  __crc32h,  __crc32b)
+LP__CRC_ARM_KERNEL(lp__crc32c_arm, __crc32cd, __crc32cw, __crc32ch, __crc32cb)
+
+#endif // LP__CRC_ARM
+
+// -------------------------
+// Public API
+// -------------------------
+
+uint32_t lp_crc32_update_sw(uint32_t st, const void* data, size_t n) {
+  if (!data) return st;
+  return lp__crc_sw(lp__crc32_tab, st, (const uint8_t*)data, n);
+}
+
+uint32_t lp_crc32c_update_sw(uint32_t st, const void* data, size_t n) {
+  if (!data) return st;
+  return lp__crc_sw(lp__crc32c_tab, st, (const uint8_t*)data, n);
+}
+
+uint32_t lp_crc32_update(uint32_t st, const void* data, size_t n) {
+  const uint8_t* p = (const uint8_t*)data;
+  if (!p || n == 0) return st;
+#if LP__CRC_ARM
+  return lp__crc32_arm(st, p, n);
+#else
+#if LP__CRC_X86
+  if (n >= 64 && lp__cpu_has_clmul()) {
+    size_t blk = n & ~(size_t)15u;
+    st = lp__crc32_clmul(st, p, blk);
+    p += blk;
+    n -= blk;
+  }
+#endif
+  return lp__crc_sw(lp__crc32_tab, st, p, n);
+#endif
+}
+
+uint32_t lp_crc32c_update(uint32_t st, const void* data, size_t n) {
+  const uint8_t* p = (const uint8_t*)data;
+  if (!p || n == 0) return st;
+#if LP__CRC_ARM
+  return lp__crc32c_arm(st, p, n);
+#else
+#if LP__CRC_X86
+  if (lp__cpu_has_sse42()) return lp__crc32c_sse42(st, p, n);
+#endif
+  return lp__crc_sw(lp__crc32c_tab, st, p, n);
+#endif
+}
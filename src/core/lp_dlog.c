@@ -0,0 +1,224 @@
+#include "lp/lp_dlog.h"
+#include "lp/lp_utf8.h"
+#include <string.h>
+
+#if LP_CFG_ENABLE_ATOMICS
+
+/*
+  Record layout (host byte order; producer and consumer share a process):
+
+    lp__dlog_hdr, then per field: kind byte, then
+      scalars   8 bytes (int64 / uint64 / double / pointer as uint64)
+      STR, SV   uint32 length + bytes (STR arrives as SV on the other side)
+*/
+
+typedef struct {
+  uint32_t    size;  // whole record
+  uint8_t     level;
+  uint8_t     nargs; // fields, format excluded
+  uint16_t    reserved;
+  uint64_t    ts;
+  const char* fmt;
+} lp__dlog_hdr;
+
+#define LP__DLOG_MAX_FIELDS 15u
+#define LP__DLOG_SCALAR     (1u + 8u)
+
+#if LP_CFG_DLOG_MAX_RECORD < 256u || LP_CFG_DLOG_MAX_RECORD > 65536u
+  #error "LP_CFG_DLOG_MAX_RECORD must be in [256, 65536]"
+#endif
+
+void lp_dlog_init(lp_dlog* log, lp_dlog_clock_fn clock, lp_log_level_t min_level) {
+  LP_ASSERT(log);
+  for (size_t i = 0; i < LP_CFG_DLOG_MAX_CHANS; i++) lp_port_atomic_store(&log->chans[i], (size_t)0, LP_MO_RELAXED);
+  log->clock = clock;
+  log->min_level = min_level;
+  log->next_chan = 0;
+  lp_port_atomic_store(&log->nchans, (size_t)0, LP_MO_RELEASE);
+}
+
+lp_status_t lp_dlog_chan_init(lp_dlog* log, lp_dlog_chan* ch, void* mem, size_t cap) {
+  if (!log || !ch || !mem) return LP_ERR_INVALID;
+  if (cap < LP_CFG_DLOG_MAX_RECORD) return LP_ERR_INVALID;
+  lp_status_t st = lp_spsc_ring_init(&ch->ring, mem, cap);
+  if (st != LP_OK) return st;
+
+  size_t idx = lp_port_atomic_fetch_add(&log->nchans, (size_t)1, LP_MO_RELAXED);
+  if (idx >= LP_CFG_DLOG_MAX_CHANS) return LP_ERR_FULL;
+  ch->log = log;
+  ch->reported = 0;
+  ch->id = (uint32_t)idx;
+  lp_port_atomic_store(&ch->dropped, (size_t)0, LP_MO_RELAXED);
+  // publish the initialized channel to the consumer
+  lp_port_atomic_store(&log->chans[idx], (size_t)(uintptr_t)ch, LP_MO_RELEASE);
+  return LP_OK;
+}
+
+// NUL-terminated, but read no further than needed to cut it to max bytes
+// (one past, so lp_utf8_truncate can see whether max splits a character).
+static lp_strview lp__dlog_cstr(const char* s, size_t max) {
+  if (!s) return lp_sv_n("(null)", 6);
+  size_t n = 0;
+  while (n <= max && s[n]) n++;
+  return lp_sv_n(s, n);
+}
+
+lp_status_t lp__dlog_write(lp_dlog_chan* ch, lp_log_level_t lvl, const lp_fmt_arg* args, size_t n) {
+  if (!ch || !args || n == 0 || n > LP__DLOG_MAX_FIELDS + 1u) return LP_ERR_INVALID;
+  if (args[0].kind != LP_FMT_ARG_STR || !args[0].v.s) return LP_ERR_INVALID;
+
+  uint8_t rec[LP_CFG_DLOG_MAX_RECORD];
+  size_t off = sizeof(lp__dlog_hdr);
+  for (size_t i = 1; i < n; i++) {
+    const lp_fmt_arg* a = &args[i];
+    rec[off++] = a->kind;
+    switch (a->kind) {
+      case LP_FMT_ARG_STR:
+      case LP_FMT_ARG_SV: {
+        rec[off - 1u] = LP_FMT_ARG_SV;
+        // leave room for the fields still to come
+        size_t room = LP_CFG_DLOG_MAX_RECORD - off - 4u - LP__DLOG_SCALAR * (n - 1u - i);
+        lp_strview sv = (a->kind == LP_FMT_ARG_STR) ? lp__dlog_cstr(a->v.s, room) : a->v.sv;
+        if (!sv.ptr) sv.len = 0;
+        sv = lp_utf8_truncate(sv, room);
+        uint32_t len = (uint32_t)sv.len;
+        memcpy(rec + off, &len, 4);
+        if (len) memcpy(rec + off + 4, sv.ptr, len);
+        off += 4u + len;
+        break;
+      }
+      case LP_FMT_ARG_PTR: {
+        uint64_t v = (uint64_t)(uintptr_t)a->v.p;
+        memcpy(rec + off, &v, 8);
+        off += 8u;
+        break;
+      }
+      case LP_FMT_ARG_F32:
+      case LP_FMT_ARG_F64:
+        memcpy(rec + off, &a->v.f, 8);
+        off += 8u;
+        break;
+      default:
+        memcpy(rec + off, &a->v.u, 8);
+        off += 8u;
+        break;
+    }
+  }
+
+  lp__dlog_hdr h = {
+    .size = (uint32_t)off,
+    .level = (uint8_t)lvl,
+    .nargs = (uint8_t)(n - 1u),
+    .reserved = 0,
+    .ts = ch->log->clock ? ch->log->clock() : 0u,
+    .fmt = args[0].v.s,
+  };
+  memcpy(rec, &h, sizeof h);
+  if (lp_spsc_ring_push(&ch->ring, rec, off) != LP_OK) {
+    lp_port_atomic_fetch_add(&ch->dropped, (size_t)1, LP_MO_RELAXED);
+    return LP_ERR_FULL;
+  }
+  return LP_OK;
+}
+
+static const char* lp__dlog_tag(uint8_t lvl) {
+  switch (lvl) {
+    case LP_LOG_ERROR: return "ERR";
+    case LP_LOG_WARN:  return "WRN";
+    case LP_LOG_INFO:  return "INF";
+    default:           return "DBG";
+  }
+}
+
+static void lp__dlog_prefix(lp_fmtbuf* line, uint64_t ts, uint8_t lvl) {
+  lp_fmt_appendf(line, "{}.{:09} {} ", ts / 1000000000u, ts % 1000000000u, lp__dlog_tag(lvl));
+}
+
+static void lp__dlog_format(lp_dlog* log, lp_fmtbuf* line) {
+  lp__dlog_hdr h;
+  memcpy(&h, log->rec, sizeof h);
+  lp_fmt_arg fields[LP__DLOG_MAX_FIELDS];
+  const uint8_t* p = log->rec + sizeof h;
+  for (size_t i = 0; i < h.nargs; i++) {
+    fields[i].kind = *p++;
+    switch (fields[i].kind) {
+      case LP_FMT_ARG_SV: {
+        uint32_t len;
+        memcpy(&len, p, 4);
+        fields[i].v.sv = lp_sv_n((const char*)p + 4, len);
+        p += 4u + len;
+        break;
+      }
+      case LP_FMT_ARG_PTR: {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        fields[i].v.p = (const void*)(uintptr_t)v;
+        p += 8;
+        break;
+      }
+      case LP_FMT_ARG_F32:
+      case LP_FMT_ARG_F64:
+        memcpy(&fields[i].v.f, p, 8);
+        p += 8;
+        break;
+      default:
+        memcpy(&fields[i].v.u, p, 8);
+        p += 8;
+        break;
+    }
+  }
+  lp__dlog_prefix(line, h.ts, h.level);
+  if (lp_fmt_appendv(line, h.fmt, fields, h.nargs) == LP_ERR_INVALID) {
+    lp_fmt_append_cstr(line, " [bad format]");
+  }
+}
+
+static LP_INLINE size_t lp__dlog_nchans(const lp_dlog* log) {
+  size_t n = lp_port_atomic_load(&log->nchans, LP_MO_ACQUIRE);
+  return (n < LP_CFG_DLOG_MAX_CHANS) ? n : LP_CFG_DLOG_MAX_CHANS;
+}
+
+static LP_INLINE lp_dlog_chan* lp__dlog_chan(const lp_dlog* log, size_t i) {
+  return (lp_dlog_chan*)(uintptr_t)lp_port_atomic_load(&log->chans[i], LP_MO_ACQUIRE);
+}
+
+bool lp_dlog_next(lp_dlog* log, lp_fmtbuf* line) {
+  if (!log || !line) return false;
+  size_t n = lp__dlog_nchans(log);
+  for (size_t k = 0; k < n; k++) {
+    size_t c = (log->next_chan + k) % n;
+    lp_dlog_chan* ch = lp__dlog_chan(log, c);
+    if (!ch) continue; // claimed, not yet published
+
+    size_t dropped = lp_port_atomic_load(&ch->dropped, LP_MO_RELAXED);
+    if (dropped != ch->reported) {
+      lp__dlog_prefix(line, log->clock ? log->clock() : 0u, LP_LOG_WARN);
+      lp_fmt_appendf(line, "dlog: {} records dropped on channel {}", dropped - ch->reported, ch->id);
+      ch->reported = dropped;
+      log->next_chan = c; // its records come next
+      return true;
+    }
+
+    lp__dlog_hdr h;
+    if (lp_spsc_ring_pop(&ch->ring, log->rec, sizeof h) != LP_OK) continue;
+    // the producer pushed the whole record at once: the rest is there
+    memcpy(&h, log->rec, sizeof h);
+    (void)lp_spsc_ring_pop(&ch->ring, log->rec + sizeof h, h.size - sizeof h);
+    lp__dlog_format(log, line);
+    log->next_chan = c + 1u;
+    return true;
+  }
+  return false;
+}
+
+size_t lp_dlog_dropped(const lp_dlog* log) {
+  if (!log) return 0;
+  size_t total = 0, n = lp__dlog_nchans(log);
+  for (size_t i = 0; i < n; i++) {
+    lp_dlog_chan* ch = lp__dlog_chan(log, i);
+    if (ch) total += lp_port_atomic_load(&ch->dropped, LP_MO_RELAXED);
+  }
+  return total;
+}
+
+#endif
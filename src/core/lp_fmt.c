@@ -1,11 +1,7 @@
 #include "lp/lp_fmt.h"
-
-static LP_INLINE void lp__nul_terminate(lp_fmtbuf* fb) {
-  if (fb && fb->dst && fb->cap) {
-    size_t i = (fb->len < fb->cap) ? fb->len : (fb->cap - 1);
-    fb->dst[i] = '\0';
-  }
-}
+#include "lp/lp_config.h"
+#include "lp_fmt_priv.h"
+#include <string.h>
 
 lp_status_t lp_fmt_append_bytes(lp_fmtbuf* fb, const void* data, size_t n) {
   if (!fb || (!fb->dst && fb->cap != 0)) return LP_ERR_INVALID;
@@ -15,10 +11,8 @@ lp_status_t lp_fmt_append_bytes(lp_fmtbuf* fb, const void* data, size_t n) {
   const uint8_t* src = (const uint8_t*)data;
   size_t rem = lp_fmt_remaining(fb);
 
-  size_t to_copy = (n <= rem) ? n : rem;
-  for (size_t i = 0; i < to_copy; i++) {
-    fb->dst[fb->len + i] = (char)src[i];
-  }
+  size_t to_copy = (n <= rem) ? n : lp__utf8_cut((const char*)src, rem);
+  if (to_copy) memcpy(fb->dst + fb->len, src, to_copy);
   fb->len += to_copy;
 
   if (to_copy != n) fb->truncated = true;
@@ -28,10 +22,7 @@ lp_status_t lp_fmt_append_bytes(lp_fmtbuf* fb, const void* data, size_t n) {
 
 lp_status_t lp_fmt_append_cstr(lp_fmtbuf* fb, const char* s) {
   if (!s) s = "(null)";
-  // manual strlen (no libc requirement)
-  size_t n = 0;
-  while (s[n] != '\0') n++;
-  return lp_fmt_append_bytes(fb, s, n);
+  return lp_fmt_append_bytes(fb, s, lp_cstr_len(s));
 }
 
 lp_status_t lp_fmt_append_sv(lp_fmtbuf* fb, lp_strview sv) {
@@ -47,62 +38,64 @@ lp_status_t lp_fmt_append_char(lp_fmtbuf* fb, char c) {
 // Decimal conversion helpers
 // -------------------------
 
-static lp_status_t lp__append_u64_dec(lp_fmtbuf* fb, uint64_t v) {
-  // Max digits for u64 is 20
-  char tmp[20];
-  size_t n = 0;
-
-  if (v == 0) {
-    return lp_fmt_append_char(fb, '0');
-  }
+// "00".."99": two digits per table lookup halves the divisions.
+const char lp__dec_pairs[200] = {
+  '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+  '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+  '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+  '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+  '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+  '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+  '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+  '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+  '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+  '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9',
+};
 
-  while (v != 0) {
-    uint64_t q = v / 10u;
-    uint64_t r = v - (q * 10u);
-    tmp[n++] = (char)('0' + (char)r);
-    v = q;
-  }
+static lp_status_t lp__append_u64_dec(lp_fmtbuf* fb, uint64_t v, bool neg) {
+  size_t n = lp__dec_digits(v) + (neg ? 1u : 0u);
 
-  // reverse
-  for (size_t i = 0; i < n / 2; i++) {
-    char t = tmp[i];
-    tmp[i] = tmp[n - 1 - i];
-    tmp[n - 1 - i] = t;
+  // Fast path: whole number fits, write it in place.
+  if (fb && fb->dst && n <= lp_fmt_remaining(fb)) {
+    char* p = fb->dst + fb->len;
+    if (neg) p[0] = '-';
+    lp__write_dec(p + n, v);
+    fb->len += n;
+    fb->dst[fb->len] = '\0';
+    return LP_OK;
   }
 
-  return lp_fmt_append_bytes(fb, tmp, n);
+  // Slow path: render aside and let append_bytes validate and truncate.
+  char tmp[21]; // '-' + 20 digits
+  lp__write_dec(tmp + sizeof tmp, v);
+  if (neg) tmp[sizeof tmp - n] = '-';
+  return lp_fmt_append_bytes(fb, tmp + sizeof tmp - n, n);
 }
 
 lp_status_t lp_fmt_append_u32(lp_fmtbuf* fb, uint32_t v) {
-  return lp__append_u64_dec(fb, (uint64_t)v);
+  return lp__append_u64_dec(fb, (uint64_t)v, false);
 }
 
 lp_status_t lp_fmt_append_u64(lp_fmtbuf* fb, uint64_t v) {
-  return lp__append_u64_dec(fb, v);
+  return lp__append_u64_dec(fb, v, false);
 }
 
 lp_status_t lp_fmt_append_i32(lp_fmtbuf* fb, int32_t v) {
   int64_t vv = (int64_t)v;
   if (vv < 0) {
-    lp_status_t st = lp_fmt_append_char(fb, '-');
-    if (st != LP_OK) return st;
     // careful: abs(INT32_MIN) overflow avoided by widening
-    uint64_t u = (uint64_t)(-vv);
-    return lp__append_u64_dec(fb, u);
+    return lp__append_u64_dec(fb, (uint64_t)(-vv), true);
   }
-  return lp__append_u64_dec(fb, (uint64_t)vv);
+  return lp__append_u64_dec(fb, (uint64_t)vv, false);
 }
 
 lp_status_t lp_fmt_append_i64(lp_fmtbuf* fb, int64_t v) {
   if (v < 0) {
-    lp_status_t st = lp_fmt_append_char(fb, '-');
-    if (st != LP_OK) return st;
-
     // Handle INT64_MIN safely: -(INT64_MIN) overflows signed, so do it via unsigned.
     uint64_t u = (uint64_t)(~(uint64_t)v) + 1u; // two's complement magnitude
-    return lp__append_u64_dec(fb, u);
+    return lp__append_u64_dec(fb, u, true);
   }
-  return lp__append_u64_dec(fb, (uint64_t)v);
+  return lp__append_u64_dec(fb, (uint64_t)v, false);
 }
 
 // -------------------------
@@ -154,3 +147,266 @@ lp_status_t lp_fmt_append_ptr(lp_fmtbuf* fb, const void* p) {
   }
   return lp_fmt_append_bytes(fb, tmp, n);
 }
+
+// -------------------------
+// Format strings
+// -------------------------
+
+// Parses the literal run at fmt[*pos] and the field after it, if any.
+// Returns LP_ERR_EMPTY at the end of the format.
+static lp_status_t lp__fmt_next(const char* fmt, size_t* pos, lp_fmt_spec* sp) {
+  size_t i = *pos;
+  if (fmt[i] == '\0') return LP_ERR_EMPTY;
+  if (i > UINT16_MAX) return LP_ERR_RANGE;
+
+  sp->lit_off = (uint16_t)i;
+  sp->conv = LP_FMT_CONV_NONE;
+  sp->flags = 0;
+  sp->width = 0;
+  sp->prec = LP_FMT_PREC_NONE;
+
+  while (fmt[i] != '\0' && fmt[i] != '{' && fmt[i] != '}') i++;
+  if (i > UINT16_MAX) return LP_ERR_RANGE;
+  sp->lit_len = (uint16_t)(i - sp->lit_off);
+
+  if (fmt[i] == '\0') { *pos = i; return LP_OK; }
+
+  // "{{" / "}}": keep one brace in the literal, skip the other
+  if (fmt[i + 1] == fmt[i]) {
+    sp->lit_len++;
+    *pos = i + 2;
+    return LP_OK;
+  }
+  if (fmt[i] == '}') return LP_ERR_INVALID;
+
+  i++; // '{'
+  sp->conv = LP_FMT_CONV_DEFAULT;
+  if (fmt[i] == ':') {
+    i++;
+    for (;; i++) {
+      if (fmt[i] == '-') sp->flags |= LP_FMT_F_LEFT;
+      else if (fmt[i] == '0') sp->flags |= LP_FMT_F_ZERO;
+      else if (fmt[i] == '+') sp->flags |= LP_FMT_F_PLUS;
+      else if (fmt[i] == '#') sp->flags |= LP_FMT_F_ALT;
+      else break;
+    }
+    uint32_t w = 0;
+    while (fmt[i] >= '0' && fmt[i] <= '9') {
+      w = w * 10u + (uint32_t)(fmt[i++] - '0');
+      if (w > UINT8_MAX) return LP_ERR_INVALID;
+    }
+    sp->width = (uint8_t)w;
+    if (fmt[i] == '.') {
+      uint32_t p = 0;
+      i++;
+      if (fmt[i] < '0' || fmt[i] > '9') return LP_ERR_INVALID;
+      while (fmt[i] >= '0' && fmt[i] <= '9') {
+        p = p * 10u + (uint32_t)(fmt[i++] - '0');
+        if (p > LP_FMT_MAX_PRECISION) return LP_ERR_INVALID;
+      }
+      sp->prec = (uint8_t)p;
+    }
+    switch (fmt[i]) {
+      case 'd': sp->conv = LP_FMT_CONV_DEC; i++; break;
+      case 'x': sp->conv = LP_FMT_CONV_HEX; i++; break;
+      case 'X': sp->conv = LP_FMT_CONV_HEX_UPPER; i++; break;
+      default: break;
+    }
+  }
+  if (fmt[i] != '}') return LP_ERR_INVALID;
+  if (i + 1u > UINT16_MAX) return LP_ERR_RANGE;
+  *pos = i + 1u;
+  return LP_OK;
+}
+
+static lp_status_t lp__fmt_field_float(lp_fmtbuf* fb, const lp_fmt_spec* sp, const lp_fmt_arg* a) {
+#if LP_CFG_FMT_FLOAT
+  if (sp->conv != LP_FMT_CONV_DEFAULT) return LP_ERR_INVALID;
+
+  lp__flt_dec d;
+  if (a->kind == LP_FMT_ARG_F32) lp__flt_from_f32((float)a->v.f, &d);
+  else lp__flt_from_f64(a->v.f, &d);
+
+  int32_t prec = (sp->prec == LP_FMT_PREC_NONE) ? -1 : (int32_t)sp->prec;
+  char sign = d.neg ? '-' : ((sp->flags & LP_FMT_F_PLUS) && d.kind != LP__FLT_NAN) ? '+' : '\0';
+  size_t pad = 0;
+  if (sp->width) {
+    size_t len = (sign ? 1u : 0u) + lp__flt_emit(NULL, &d, prec);
+    pad = (sp->width > len) ? (sp->width - len) : 0u;
+  }
+  bool left = (sp->flags & LP_FMT_F_LEFT) != 0;
+  bool zero = (sp->flags & LP_FMT_F_ZERO) && d.kind == LP__FLT_FINITE;
+
+  if (pad && !left && !zero) lp__fmt_pad(fb, ' ', pad);
+  if (sign) lp__fmt_put(fb, &sign, 1);
+  if (pad && !left && zero) lp__fmt_pad(fb, '0', pad);
+  lp__flt_emit(fb, &d, prec);
+  if (pad && left) lp__fmt_pad(fb, ' ', pad);
+  return LP_OK;
+#else
+  LP_UNUSED(fb); LP_UNUSED(sp); LP_UNUSED(a);
+  return LP_ERR_UNSUP;
+#endif
+}
+
+static lp_status_t lp__fmt_field(lp_fmtbuf* fb, const lp_fmt_spec* sp, const lp_fmt_arg* a) {
+  if (a->kind == LP_FMT_ARG_F32 || a->kind == LP_FMT_ARG_F64) return lp__fmt_field_float(fb, sp, a);
+  if (sp->prec != LP_FMT_PREC_NONE) return LP_ERR_INVALID;
+
+  char tmp[24];           // sign/prefix + up to 20 digits
+  char* end = tmp + sizeof tmp;
+  const char* body = end; // digits or text
+  size_t body_len = 0;
+  char prefix[3];
+  size_t prefix_len = 0;
+  bool numeric = false;
+
+  switch (a->kind) {
+    case LP_FMT_ARG_I32:
+    case LP_FMT_ARG_I64:
+    case LP_FMT_ARG_U32:
+    case LP_FMT_ARG_U64: {
+      bool is_signed = (a->kind == LP_FMT_ARG_I32 || a->kind == LP_FMT_ARG_I64);
+      bool neg = is_signed && a->v.i < 0;
+      uint64_t u = a->v.u;
+      numeric = true;
+
+      if (sp->conv == LP_FMT_CONV_HEX || sp->conv == LP_FMT_CONV_HEX_UPPER) {
+        // hex shows the two's complement bits at the argument's own width
+        if (a->kind == LP_FMT_ARG_I32) u &= 0xFFFFFFFFu;
+        const char* digits = (sp->conv == LP_FMT_CONV_HEX_UPPER) ? "0123456789ABCDEF" : "0123456789abcdef";
+        char* p = end;
+        do { *--p = digits[u & 0xFu]; u >>= 4; } while (u);
+        body = p;
+        body_len = (size_t)(end - p);
+        if (sp->flags & LP_FMT_F_ALT) { prefix[prefix_len++] = '0'; prefix[prefix_len++] = 'x'; }
+        break;
+      }
+
+      if (neg) u = (uint64_t)(~(uint64_t)a->v.i) + 1u;
+      body_len = lp__dec_digits(u);
+      lp__write_dec(end, u);
+      body = end - body_len;
+      if (neg) prefix[prefix_len++] = '-';
+      else if (sp->flags & LP_FMT_F_PLUS) prefix[prefix_len++] = '+';
+      break;
+    }
+    case LP_FMT_ARG_BOOL:
+      if (sp->conv != LP_FMT_CONV_DEFAULT) return LP_ERR_INVALID;
+      body = a->v.u ? "true" : "false";
+      body_len = a->v.u ? 4u : 5u;
+      break;
+    case LP_FMT_ARG_CHAR:
+      if (sp->conv != LP_FMT_CONV_DEFAULT) return LP_ERR_INVALID;
+      tmp[0] = (char)a->v.u;
+      body = tmp;
+      body_len = 1;
+      break;
+    case LP_FMT_ARG_STR:
+      if (sp->conv != LP_FMT_CONV_DEFAULT) return LP_ERR_INVALID;
+      body = a->v.s ? a->v.s : "(null)";
+      while (body[body_len] != '\0') body_len++;
+      break;
+    case LP_FMT_ARG_SV:
+      if (sp->conv != LP_FMT_CONV_DEFAULT) return LP_ERR_INVALID;
+      if (!a->v.sv.ptr && a->v.sv.len) return LP_ERR_INVALID;
+      body = a->v.sv.ptr;
+      body_len = a->v.sv.len;
+      break;
+    case LP_FMT_ARG_PTR: {
+      if (sp->conv != LP_FMT_CONV_DEFAULT) return LP_ERR_INVALID;
+      // same shape as lp_fmt_append_ptr: 0x + fixed-width hex
+      uintptr_t v = (uintptr_t)a->v.p;
+      char* p = end;
+      for (size_t k = 0; k < sizeof(uintptr_t) * 2u; k++, v >>= 4) *--p = "0123456789abcdef"[v & 0xFu];
+      body = p;
+      body_len = (size_t)(end - p);
+      prefix[prefix_len++] = '0';
+      prefix[prefix_len++] = 'x';
+      break;
+    }
+    default:
+      return LP_ERR_INVALID;
+  }
+
+  size_t len = prefix_len + body_len;
+  size_t pad = (sp->width > len) ? (sp->width - len) : 0u;
+
+  if (pad && !(sp->flags & LP_FMT_F_LEFT)) {
+    if (numeric && (sp->flags & LP_FMT_F_ZERO)) {
+      lp__fmt_put(fb, prefix, prefix_len);
+      lp__fmt_pad(fb, '0', pad);
+      lp__fmt_put(fb, body, body_len);
+      return LP_OK;
+    }
+    lp__fmt_pad(fb, ' ', pad);
+  }
+  if (prefix_len) lp__fmt_put(fb, prefix, prefix_len);
+  lp__fmt_put(fb, body, body_len);
+  if (pad && (sp->flags & LP_FMT_F_LEFT)) lp__fmt_pad(fb, ' ', pad);
+  return LP_OK;
+}
+
+static lp_status_t lp__fmt_exec(lp_fmtbuf* fb, const char* fmt, const lp_fmt_spec* sp,
+                                const lp_fmt_arg* args, size_t nargs, size_t* used) {
+  if (sp->lit_len) lp__fmt_put(fb, fmt + sp->lit_off, sp->lit_len);
+  if (sp->conv == LP_FMT_CONV_NONE) return LP_OK;
+  if (*used >= nargs) return LP_ERR_INVALID;
+  return lp__fmt_field(fb, sp, &args[(*used)++]);
+}
+
+lp_status_t lp_fmt_compile(lp_fmt_compiled* out, const char* fmt, lp_fmt_spec* specs, size_t cap) {
+  if (!out || !fmt || (!specs && cap)) return LP_ERR_INVALID;
+
+  size_t pos = 0, count = 0, nargs = 0;
+  for (;;) {
+    lp_fmt_spec sp;
+    lp_status_t st = lp__fmt_next(fmt, &pos, &sp);
+    if (st == LP_ERR_EMPTY) break;
+    if (st != LP_OK) return st;
+    if (count == cap) return LP_ERR_RANGE;
+    specs[count++] = sp;
+    if (sp.conv != LP_FMT_CONV_NONE) nargs++;
+  }
+
+  out->fmt = fmt;
+  out->specs = specs;
+  out->count = count;
+  out->nargs = nargs;
+  return LP_OK;
+}
+
+lp_status_t lp_fmt_appendc(lp_fmtbuf* fb, const lp_fmt_compiled* c, const lp_fmt_arg* args, size_t nargs) {
+  if (!fb || (!fb->dst && fb->cap != 0) || !c) return LP_ERR_INVALID;
+  if (nargs != c->nargs || (!args && nargs)) return LP_ERR_INVALID;
+
+  size_t used = 0;
+  lp_status_t st = LP_OK;
+  for (size_t i = 0; i < c->count && st == LP_OK; i++) {
+    st = lp__fmt_exec(fb, c->fmt, &c->specs[i], args, nargs, &used);
+  }
+  lp__nul_terminate(fb);
+  return st;
+}
+
+lp_status_t lp_fmt_appendv(lp_fmtbuf* fb, const char* fmt, const lp_fmt_arg* args, size_t nargs) {
+  if (!fb || (!fb->dst && fb->cap != 0) || !fmt) return LP_ERR_INVALID;
+  if (!args && nargs) return LP_ERR_INVALID;
+
+  size_t pos = 0, used = 0;
+  lp_status_t st;
+  for (;;) {
+    lp_fmt_spec sp;
+    st = lp__fmt_next(fmt, &pos, &sp);
+    if (st == LP_ERR_EMPTY) { st = (used == nargs) ? LP_OK : LP_ERR_INVALID; break; }
+    if (st == LP_OK) st = lp__fmt_exec(fb, fmt, &sp, args, nargs, &used);
+    if (st != LP_OK) break;
+  }
+  lp__nul_terminate(fb);
+  return st;
+}
+
+lp_status_t lp__fmt_appendf(lp_fmtbuf* fb, const lp_fmt_arg* args, size_t n) {
+  if (!args || n == 0 || args[0].kind != LP_FMT_ARG_STR) return LP_ERR_INVALID;
+  return lp_fmt_appendv(fb, args[0].v.s, args + 1, n - 1u);
+}
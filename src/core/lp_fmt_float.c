@@ -0,0 +1,400 @@
+#include "lp/lp_fmt.h"
+#include "lp/lp_config.h"
+#include "lp_fmt_priv.h"
+
+/*
+  Float/double -> shortest round-trip decimal, no libc, no heap.
+
+  The conversion is Schubfach (R. Giulietti, "The Schubfach way to render
+  doubles"): scale the rounding interval of the binary value by a 128-bit
+  power of ten, rounded to odd, and pick the shortest decimal inside it.
+  float uses the upper 64 bits of the same table.
+
+  Fixed precision rounds those shortest digits half-to-even and pads
+  with zeros past them. The only differences from printf("%.*f") are:
+  - Places past the shortest digits print as 0 instead of binary-expansion
+    noise.
+  - When the shortest digits end in a 5 exactly at the cut, the result can
+    differ in the last digit. 2.675 is stored as 2.67499999..., so printf
+    gives "2.67" while we give "2.68".
+*/
+
+#if LP_CFG_FMT_FLOAT
+
+#include "lp_pow10_tab.h"
+
+// floor(g * cp / 2^128), with the lowest bit set if anything was dropped.
+static LP_INLINE uint64_t lp__round_to_odd64(const uint64_t g[2], uint64_t cp) {
+  uint64_t x_lo, y_lo;
+  uint64_t x_hi = lp__umul128_hi(g[1], cp, &x_lo);
+  uint64_t y_hi = lp__umul128_hi(g[0], cp, &y_lo);
+  uint64_t z_lo = y_lo + x_hi;
+  uint64_t z_hi = y_hi + (z_lo < y_lo);
+  return z_hi | (z_lo > 1u);
+}
+
+// floor(g * cp / 2^64), rounded to odd the same way.
+static LP_INLINE uint32_t lp__round_to_odd32(uint64_t g, uint32_t cp) {
+  uint64_t b01 = (uint64_t)(uint32_t)g * cp;
+  uint64_t b11 = (g >> 32) * cp;
+  uint64_t hi = b11 + (b01 >> 32);
+  return (uint32_t)(hi >> 32) | ((uint32_t)hi > 1u);
+}
+
+// Exact over the exponent ranges used here (checked when the table was
+// generated). Relies on arithmetic right shift of negative values.
+static LP_INLINE int32_t lp__floor_log2_pow10(int32_t e) { return (e * 1741647) >> 19; }
+static LP_INLINE int32_t lp__floor_log10_pow2(int32_t e) { return (e * 1262611) >> 22; }
+static LP_INLINE int32_t lp__floor_log10_3q_pow2(int32_t e) { return (e * 1262611 - 524031) >> 22; }
+
+// -------------------------
+// Schubfach
+// -------------------------
+
+static void lp__schubfach64(uint64_t ieee_m, uint32_t ieee_e, uint64_t* out, int32_t* exp10) {
+  uint64_t c;
+  int32_t q;
+  if (ieee_e != 0) {
+    c = (1ull << 52) | ieee_m;
+    q = (int32_t)ieee_e - 1075;
+    // small integers are exact
+    if (q <= 0 && q > -53 && (c & ((1ull << -q) - 1u)) == 0) {
+      *out = c >> -q;
+      *exp10 = 0;
+      return;
+    }
+  } else {
+    c = ieee_m;
+    q = 1 - 1075;
+  }
+
+  bool even = (c & 1u) == 0;
+  bool closer = (ieee_m == 0 && ieee_e > 1); // lower neighbour is half as far
+  uint64_t cbl = 4u * c - 2u + (closer ? 1u : 0u);
+  uint64_t cb = 4u * c;
+  uint64_t cbr = 4u * c + 2u;
+
+  int32_t k = closer ? lp__floor_log10_3q_pow2(q) : lp__floor_log10_pow2(q);
+  int32_t h = q + lp__floor_log2_pow10(-k) + 1;
+  const uint64_t* g = lp__pow10_tab[-k - LP__POW10_MIN];
+
+  uint64_t vbl = lp__round_to_odd64(g, cbl << h);
+  uint64_t vb = lp__round_to_odd64(g, cb << h);
+  uint64_t vbr = lp__round_to_odd64(g, cbr << h);
+  uint64_t lower = vbl + (even ? 0u : 1u);
+  uint64_t upper = vbr - (even ? 0u : 1u);
+
+  uint64_t s = vb / 4u;
+  if (s >= 10u) {
+    uint64_t sp = s / 10u;
+    bool up_in = lower <= 40u * sp;
+    bool wp_in = 40u * sp + 40u <= upper;
+    if (up_in != wp_in) {
+      *out = sp + (wp_in ? 1u : 0u);
+      *exp10 = k + 1;
+      return;
+    }
+  }
+  bool u_in = lower <= 4u * s;
+  bool w_in = 4u * s + 4u <= upper;
+  if (u_in != w_in) {
+    *out = s + (w_in ? 1u : 0u);
+    *exp10 = k;
+    return;
+  }
+  uint64_t mid = 4u * s + 2u;
+  bool round_up = vb > mid || (vb == mid && (s & 1u) != 0);
+  *out = s + (round_up ? 1u : 0u);
+  *exp10 = k;
+}
+
+static void lp__schubfach32(uint32_t ieee_m, uint32_t ieee_e, uint32_t* out, int32_t* exp10) {
+  uint32_t c;
+  int32_t q;
+  if (ieee_e != 0) {
+    c = (1u << 23) | ieee_m;
+    q = (int32_t)ieee_e - 150;
+    if (q <= 0 && q > -24 && (c & ((1u << -q) - 1u)) == 0) {
+      *out = c >> -q;
+      *exp10 = 0;
+      return;
+    }
+  } else {
+    c = ieee_m;
+    q = 1 - 150;
+  }
+
+  bool even = (c & 1u) == 0;
+  bool closer = (ieee_m == 0 && ieee_e > 1);
+  uint32_t cbl = 4u * c - 2u + (closer ? 1u : 0u);
+  uint32_t cb = 4u * c;
+  uint32_t cbr = 4u * c + 2u;
+
+  int32_t k = closer ? lp__floor_log10_3q_pow2(q) : lp__floor_log10_pow2(q);
+  int32_t h = q + lp__floor_log2_pow10(-k) + 1;
+  // floor(x * 2^63) + 1 from the 128-bit entry floor(x * 2^127) + 1
+  const uint64_t* g128 = lp__pow10_tab[-k - LP__POW10_MIN];
+  uint64_t g = g128[0] + (g128[1] != 0 ? 1u : 0u);
+
+  uint32_t vbl = lp__round_to_odd32(g, cbl << h);
+  uint32_t vb = lp__round_to_odd32(g, cb << h);
+  uint32_t vbr = lp__round_to_odd32(g, cbr << h);
+  uint32_t lower = vbl + (even ? 0u : 1u);
+  uint32_t upper = vbr - (even ? 0u : 1u);
+
+  uint32_t s = vb / 4u;
+  if (s >= 10u) {
+    uint32_t sp = s / 10u;
+    bool up_in = lower <= 40u * sp;
+    bool wp_in = 40u * sp + 40u <= upper;
+    if (up_in != wp_in) {
+      *out = sp + (wp_in ? 1u : 0u);
+      *exp10 = k + 1;
+      return;
+    }
+  }
+  bool u_in = lower <= 4u * s;
+  bool w_in = 4u * s + 4u <= upper;
+  if (u_in != w_in) {
+    *out = s + (w_in ? 1u : 0u);
+    *exp10 = k;
+    return;
+  }
+  uint32_t mid = 4u * s + 2u;
+  bool round_up = vb > mid || (vb == mid && (s & 1u) != 0);
+  *out = s + (round_up ? 1u : 0u);
+  *exp10 = k;
+}
+
+static LP_INLINE void lp__flt_trim(lp__flt_dec* d) {
+  while (d->digits != 0 && d->digits % 10u == 0) {
+    d->digits /= 10u;
+    d->exp10++;
+  }
+}
+
+void lp__flt_from_f64(double v, lp__flt_dec* out) {
+  uint64_t bits;
+  memcpy(&bits, &v, sizeof bits);
+  uint32_t e = (uint32_t)(bits >> 52) & 0x7FFu;
+  uint64_t m = bits & ((1ull << 52) - 1u);
+
+  out->neg = (bits >> 63) != 0;
+  out->kind = LP__FLT_FINITE;
+  out->digits = 0;
+  out->exp10 = 0;
+  if (e == 0x7FFu) {
+    out->kind = m ? LP__FLT_NAN : LP__FLT_INF;
+    if (m) out->neg = false;
+    return;
+  }
+  if (e == 0 && m == 0) return;
+  lp__schubfach64(m, e, &out->digits, &out->exp10);
+  lp__flt_trim(out);
+}
+
+void lp__flt_from_f32(float v, lp__flt_dec* out) {
+  uint32_t bits;
+  memcpy(&bits, &v, sizeof bits);
+  uint32_t e = (bits >> 23) & 0xFFu;
+  uint32_t m = bits & ((1u << 23) - 1u);
+
+  out->neg = (bits >> 31) != 0;
+  out->kind = LP__FLT_FINITE;
+  out->digits = 0;
+  out->exp10 = 0;
+  if (e == 0xFFu) {
+    out->kind = m ? LP__FLT_NAN : LP__FLT_INF;
+    if (m) out->neg = false;
+    return;
+  }
+  if (e == 0 && m == 0) return;
+  uint32_t digits;
+  lp__schubfach32(m, e, &digits, &out->exp10);
+  out->digits = digits;
+  lp__flt_trim(out);
+}
+
+// -------------------------
+// Text
+// -------------------------
+
+static LP_INLINE void lp__flt_put(lp_fmtbuf* fb, size_t* len, const char* p, size_t n) {
+  if (fb) lp__fmt_put(fb, p, n);
+  *len += n;
+}
+
+static LP_INLINE void lp__flt_zeros(lp_fmtbuf* fb, size_t* len, size_t n) {
+  if (fb && n) lp__fmt_pad(fb, '0', n);
+  *len += n;
+}
+
+// Rounds ds[0..*n) half-to-even so that the last kept digit is at 10^-prec.
+// *e10 is the exponent of ds[0]; *n may become 0 (value rounds to zero).
+static void lp__flt_round(char* ds, uint32_t* n, int32_t* e10, int32_t prec) {
+  int32_t keep = *e10 + 1 + prec;
+  if (keep >= (int32_t)*n) return;
+  if (keep < 0) { *n = 0; return; }
+
+  char r = ds[keep];
+  bool up;
+  if (r != '5') up = r > '5';
+  else if ((uint32_t)keep + 1u < *n) up = true; // no trailing zeros, so a tail is non-zero
+  else up = keep > 0 && ((ds[keep - 1] - '0') & 1) != 0;
+
+  if (keep == 0) {
+    if (up) { ds[0] = '1'; *n = 1; *e10 += 1; }
+    else *n = 0;
+    return;
+  }
+
+  *n = (uint32_t)keep;
+  if (!up) return;
+  int32_t i = keep - 1;
+  while (i >= 0 && ds[i] == '9') ds[i--] = '0';
+  if (i >= 0) {
+    ds[i]++;
+  } else {
+    ds[0] = '1'; // 99.9 -> 100.0: one more integer digit
+    *e10 += 1;
+  }
+}
+
+size_t lp__flt_emit(lp_fmtbuf* fb, const lp__flt_dec* d, int32_t prec) {
+  size_t len = 0;
+  if (d->kind == LP__FLT_NAN) { lp__flt_put(fb, &len, "nan", 3); return len; }
+  if (d->kind == LP__FLT_INF) { lp__flt_put(fb, &len, "inf", 3); return len; }
+
+  char ds[20];
+  uint32_t n = 0;
+  int32_t e10 = 0; // exponent of ds[0]
+  if (d->digits != 0) {
+    n = lp__dec_digits(d->digits);
+    lp__write_dec(ds + n, d->digits);
+    e10 = d->exp10 + (int32_t)n - 1;
+  }
+
+  if (prec < 0) {
+    if (n == 0) { lp__flt_put(fb, &len, "0", 1); return len; }
+
+    if (e10 >= -4 && e10 < 17) {
+      if (e10 >= (int32_t)n - 1) {
+        lp__flt_put(fb, &len, ds, n);
+        lp__flt_zeros(fb, &len, (size_t)(e10 - ((int32_t)n - 1)));
+      } else if (e10 >= 0) {
+        lp__flt_put(fb, &len, ds, (size_t)e10 + 1u);
+        lp__flt_put(fb, &len, ".", 1);
+        lp__flt_put(fb, &len, ds + e10 + 1, n - (uint32_t)e10 - 1u);
+      } else {
+        lp__flt_put(fb, &len, "0.", 2);
+        lp__flt_zeros(fb, &len, (size_t)(-e10 - 1));
+        lp__flt_put(fb, &len, ds, n);
+      }
+      return len;
+    }
+
+    // d.ddde+XX, like %g
+    char ex[6];
+    uint32_t ae = (uint32_t)(e10 < 0 ? -e10 : e10);
+    uint32_t en = (ae >= 100u) ? 3u : 2u;
+    ex[0] = 'e';
+    ex[1] = (e10 < 0) ? '-' : '+';
+    lp__write_dec(ex + 2 + en, ae);
+    if (ae < 10u) ex[2] = '0';
+    lp__flt_put(fb, &len, ds, 1);
+    if (n > 1u) {
+      lp__flt_put(fb, &len, ".", 1);
+      lp__flt_put(fb, &len, ds + 1, n - 1u);
+    }
+    lp__flt_put(fb, &len, ex, 2u + en);
+    return len;
+  }
+
+  lp__flt_round(ds, &n, &e10, prec);
+
+  // integer part
+  if (n == 0 || e10 < 0) {
+    lp__flt_put(fb, &len, "0", 1);
+  } else {
+    uint32_t int_len = (uint32_t)e10 + 1u;
+    uint32_t take = (n < int_len) ? n : int_len;
+    lp__flt_put(fb, &len, ds, take);
+    lp__flt_zeros(fb, &len, int_len - take);
+  }
+  if (prec == 0) return len;
+
+  // fraction: leading zeros, remaining digits, trailing zeros
+  lp__flt_put(fb, &len, ".", 1);
+  uint32_t p = (uint32_t)prec;
+  uint32_t z = (n != 0 && e10 < -1) ? (uint32_t)(-e10 - 1) : 0u;
+  if (z > p) z = p;
+  lp__flt_zeros(fb, &len, z);
+  uint32_t from = (e10 >= 0) ? (uint32_t)e10 + 1u : 0u;
+  uint32_t avail = (n > from) ? n - from : 0u;
+  uint32_t take = (avail < p - z) ? avail : p - z;
+  lp__flt_put(fb, &len, ds + from, take);
+  lp__flt_zeros(fb, &len, p - z - take);
+  return len;
+}
+
+// -------------------------
+// API
+// -------------------------
+
+static lp_status_t lp__append_flt(lp_fmtbuf* fb, const lp__flt_dec* d, int32_t prec) {
+  if (!fb || (!fb->dst && fb->cap != 0)) return LP_ERR_INVALID;
+  if (d->neg) lp__fmt_put(fb, "-", 1);
+  lp__flt_emit(fb, d, prec);
+  lp__nul_terminate(fb);
+  return LP_OK;
+}
+
+lp_status_t lp_fmt_append_f32(lp_fmtbuf* fb, float v) {
+  lp__flt_dec d;
+  lp__flt_from_f32(v, &d);
+  return lp__append_flt(fb, &d, -1);
+}
+
+lp_status_t lp_fmt_append_f64(lp_fmtbuf* fb, double v) {
+  lp__flt_dec d;
+  lp__flt_from_f64(v, &d);
+  return lp__append_flt(fb, &d, -1);
+}
+
+lp_status_t lp_fmt_append_f32_fixed(lp_fmtbuf* fb, float v, uint32_t precision) {
+  if (precision > LP_FMT_MAX_PRECISION) return LP_ERR_RANGE;
+  lp__flt_dec d;
+  lp__flt_from_f32(v, &d);
+  return lp__append_flt(fb, &d, (int32_t)precision);
+}
+
+lp_status_t lp_fmt_append_f64_fixed(lp_fmtbuf* fb, double v, uint32_t precision) {
+  if (precision > LP_FMT_MAX_PRECISION) return LP_ERR_RANGE;
+  lp__flt_dec d;
+  lp__flt_from_f64(v, &d);
+  return lp__append_flt(fb, &d, (int32_t)precision);
+}
+
+#else // !LP_CFG_FMT_FLOAT
+
+lp_status_t lp_fmt_append_f32(lp_fmtbuf* fb, float v) {
+  LP_UNUSED(fb); LP_UNUSED(v);
+  return LP_ERR_UNSUP;
+}
+
+lp_status_t lp_fmt_append_f64(lp_fmtbuf* fb, double v) {
+  LP_UNUSED(fb); LP_UNUSED(v);
+  return LP_ERR_UNSUP;
+}
+
+lp_status_t lp_fmt_append_f32_fixed(lp_fmtbuf* fb, float v, uint32_t precision) {
+  LP_UNUSED(fb); LP_UNUSED(v); LP_UNUSED(precision);
+  return LP_ERR_UNSUP;
+}
+
+lp_status_t lp_fmt_append_f64_fixed(lp_fmtbuf* fb, double v, uint32_t precision) {
+  LP_UNUSED(fb); LP_UNUSED(v); LP_UNUSED(precision);
+  return LP_ERR_UNSUP;
+}
+
+#endif // LP_CFG_FMT_FLOAT
@@ -0,0 +1,96 @@
+#pragma once
+#include "lp/lp_fmt.h"
+#include <string.h>
+
+/*
+  Private: helpers shared by lp_fmt.c and lp_fmt_float.c.
+*/
+
+static LP_INLINE void lp__nul_terminate(lp_fmtbuf* fb) {
+  if (fb && fb->dst && fb->cap) {
+    size_t i = (fb->len < fb->cap) ? fb->len : (fb->cap - 1);
+    fb->dst[i] = '\0';
+  }
+}
+
+// "00".."99", defined in lp_fmt.c.
+extern const char lp__dec_pairs[200];
+
+static LP_INLINE uint32_t lp__dec_digits(uint64_t v) {
+  uint32_t n = 1;
+  for (;;) {
+    if (v < 10u) return n;
+    if (v < 100u) return n + 1u;
+    if (v < 1000u) return n + 2u;
+    if (v < 10000u) return n + 3u;
+    v /= 10000u;
+    n += 4u;
+  }
+}
+
+// Writes the digits of v so that the last one lands at end[-1]. Steps down
+// to 32-bit division as soon as the value fits (cheap on 32-bit targets).
+static LP_INLINE void lp__write_dec(char* end, uint64_t v) {
+  while (v > UINT32_MAX) {
+    uint64_t q = v / 100u;
+    uint32_t r = (uint32_t)(v - q * 100u);
+    end -= 2;
+    memcpy(end, &lp__dec_pairs[2u * r], 2);
+    v = q;
+  }
+  uint32_t w = (uint32_t)v;
+  while (w >= 100u) {
+    uint32_t q = w / 100u;
+    uint32_t r = w - q * 100u;
+    end -= 2;
+    memcpy(end, &lp__dec_pairs[2u * r], 2);
+    w = q;
+  }
+  if (w >= 10u) {
+    end -= 2;
+    memcpy(end, &lp__dec_pairs[2u * w], 2);
+  } else {
+    end[-1] = (char)('0' + w);
+  }
+}
+
+// Unchecked appends: callers validate fb once up front and NUL-terminate
+// once at the end, not per piece.
+static LP_INLINE void lp__fmt_put(lp_fmtbuf* fb, const char* p, size_t n) {
+  size_t rem = lp_fmt_remaining(fb);
+  size_t k = (n <= rem) ? n : lp__utf8_cut(p, rem);
+  if (k) memcpy(fb->dst + fb->len, p, k);
+  fb->len += k;
+  if (k != n) fb->truncated = true;
+}
+
+static LP_INLINE void lp__fmt_pad(lp_fmtbuf* fb, char c, size_t n) {
+  size_t rem = lp_fmt_remaining(fb);
+  size_t k = (n <= rem) ? n : rem;
+  if (k) memset(fb->dst + fb->len, c, k);
+  fb->len += k;
+  if (k != n) fb->truncated = true;
+}
+
+// -------------------------
+// Floating point (lp_fmt_float.c)
+// -------------------------
+
+enum { LP__FLT_FINITE = 0, LP__FLT_INF, LP__FLT_NAN };
+
+// Shortest decimal that round-trips: value = digits * 10^exp10, no
+// trailing zeros in digits (digits == 0 for zero). neg is false for NaN.
+typedef struct {
+  uint64_t digits;
+  int32_t  exp10;
+  uint8_t  kind;
+  bool     neg;
+} lp__flt_dec;
+
+void lp__flt_from_f32(float v, lp__flt_dec* out);
+void lp__flt_from_f64(double v, lp__flt_dec* out);
+
+// Appends the unsigned text: shortest form if prec < 0, else fixed with
+// prec fraction digits. With fb == NULL nothing is written. Returns the
+// full text length either way.
+size_t lp__flt_emit(lp_fmtbuf* fb, const lp__flt_dec* d, int32_t prec);
@@ -0,0 +1,156 @@
+#include "lp/lp_hash.h"
+#include "lp_u128.h"
+#include <string.h>
+
+/*
+  After wyhash, final version 4 (Wang Yi, public domain). Everything
+  reduces to mix(a, b) = lo ^ hi of the 128-bit product a * b: one
+  multiply mixes 128 input bits. The length only enters at the very
+  end, which is what lets the streaming state produce the same value as
+  one-shot hashing.
+*/
+
+static const uint64_t lp__hash_k[4] = {
+  0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull,
+};
+
+static LP_INLINE uint64_t lp__hash_r8(const uint8_t* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof v);
+#if !(defined(LP_LITTLE_ENDIAN) && LP_LITTLE_ENDIAN)
+  v = __builtin_bswap64(v);
+#endif
+  return v;
+}
+
+static LP_INLINE uint64_t lp__hash_r4(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof v);
+#if !(defined(LP_LITTLE_ENDIAN) && LP_LITTLE_ENDIAN)
+  v = __builtin_bswap32(v);
+#endif
+  return v;
+}
+
+static LP_INLINE uint64_t lp__hash_mix(uint64_t a, uint64_t b) {
+  uint64_t lo;
+  uint64_t hi = lp__umul128_hi(a, b, &lo);
+  return lo ^ hi;
+}
+
+// Last step for every length: a, b hold the final 16 input bytes.
+static LP_INLINE uint64_t lp__hash_last(uint64_t a, uint64_t b, uint64_t seed, uint64_t len) {
+  a ^= lp__hash_k[1];
+  b ^= seed;
+  uint64_t lo;
+  uint64_t hi = lp__umul128_hi(a, b, &lo);
+  return lp__hash_mix(lo ^ lp__hash_k[0] ^ len, hi ^ lp__hash_k[1]);
+}
+
+// 0..16 bytes: two (possibly overlapping) loads cover every byte.
+static LP_INLINE uint64_t lp__hash_short(const uint8_t* p, size_t n, uint64_t seed) {
+  uint64_t a = 0, b = 0;
+  if (n >= 4u) {
+    size_t mid = (n >> 3) << 2; // 0 for 4..7 bytes, 4 for 8..16
+    a = (lp__hash_r4(p) << 32) | lp__hash_r4(p + mid);
+    b = (lp__hash_r4(p + n - 4u) << 32) | lp__hash_r4(p + n - 4u - mid);
+  } else if (n > 0) {
+    a = ((uint64_t)p[0] << 16) | ((uint64_t)p[n >> 1] << 8) | p[n - 1u];
+  }
+  return lp__hash_last(a, b, seed, n);
+}
+
+// More than 16 bytes, after the 48-byte blocks: 16 bytes per step while
+// more than 16 remain, then the last 16 (overlapping, so p[-16, 0) must be
+// readable when rem < 16).
+static uint64_t lp__hash_tail(const uint8_t* p, size_t rem, uint64_t seed, uint64_t len) {
+  while (rem > 16u) {
+    seed = lp__hash_mix(lp__hash_r8(p) ^ lp__hash_k[1], lp__hash_r8(p + 8) ^ seed);
+    p += 16;
+    rem -= 16u;
+  }
+  return lp__hash_last(lp__hash_r8(p + rem - 16u), lp__hash_r8(p + rem - 8u), seed, len);
+}
+
+// Folds 48-byte blocks while more than 48 bytes remain (the tail always
+// keeps 1..48). Returns the bytes consumed.
+static size_t lp__hash_blocks(uint64_t lane[3], const uint8_t* p, size_t n) {
+  uint64_t s0 = lane[0], s1 = lane[1], s2 = lane[2];
+  size_t i = 0;
+  for (; n - i > 48u; i += 48u) {
+    const uint8_t* q = p + i;
+    s0 = lp__hash_mix(lp__hash_r8(q) ^ lp__hash_k[1], lp__hash_r8(q + 8) ^ s0);
+    s1 = lp__hash_mix(lp__hash_r8(q + 16) ^ lp__hash_k[2], lp__hash_r8(q + 24) ^ s1);
+    s2 = lp__hash_mix(lp__hash_r8(q + 32) ^ lp__hash_k[3], lp__hash_r8(q + 40) ^ s2);
+  }
+  lane[0] = s0;
+  lane[1] = s1;
+  lane[2] = s2;
+  return i;
+}
+
+static LP_INLINE uint64_t lp__hash_seed(uint64_t seed) {
+  return seed ^ lp__hash_mix(seed ^ lp__hash_k[0], lp__hash_k[1]);
+}
+
+uint64_t lp_hash64(const void* data, size_t n, uint64_t seed) {
+  const uint8_t* p = (const uint8_t*)data;
+  if (!p) n = 0;
+  seed = lp__hash_seed(seed);
+  if (n <= 16u) return lp__hash_short(p, n, seed);
+
+  uint64_t lane[3] = { seed, seed, seed };
+  size_t done = lp__hash_blocks(lane, p, n);
+  // with no blocks folded this is seed ^ seed ^ seed == seed
+  seed = lane[0] ^ lane[1] ^ lane[2];
+  return lp__hash_tail(p + done, n - done, seed, n);
+}
+
+// -------------------------
+// Streaming
+// -------------------------
+//
+// Up to 48 bytes are held back: a full buffer is folded only once more
+// input arrives, since the last 1..48 bytes go through the tail instead.
+// buf[0, 16) keeps the end of the last folded block for the overlapping
+// final load.
+
+void lp_hash64_init(lp_hash64_state* st, uint64_t seed) {
+  if (!st) return;
+  uint64_t s = lp__hash_seed(seed);
+  st->lane[0] = st->lane[1] = st->lane[2] = s;
+  st->total = 0;
+  st->pending = 0;
+  memset(st->buf, 0, sizeof st->buf);
+}
+
+void lp_hash64_update(lp_hash64_state* st, const void* data, size_t n) {
+  if (!st || !data || n == 0) return;
+  const uint8_t* p = (const uint8_t*)data;
+  st->total += n;
+
+  if (st->pending) {
+    size_t k = 48u - st->pending;
+    if (k > n) k = n;
+    memcpy(st->buf + 16 + st->pending, p, k);
+    st->pending += (uint32_t)k;
+    p += k;
+    n -= k;
+    if (n == 0) return;
+    lp__hash_blocks(st->lane, st->buf + 16, 49u); // exactly one block
+    memcpy(st->buf, st->buf + 48, 16);
+    st->pending = 0;
+  }
+
+  size_t done = lp__hash_blocks(st->lane, p, n);
+  if (done) memcpy(st->buf, p + done - 16u, 16);
+  memcpy(st->buf + 16, p + done, n - done);
+  st->pending = (uint32_t)(n - done);
+}
+
+uint64_t lp_hash64_final(const lp_hash64_state* st) {
+  if (!st) return 0;
+  if (st->total <= 16u) return lp__hash_short(st->buf + 16, (size_t)st->total, st->lane[0]);
+  uint64_t seed = st->lane[0] ^ st->lane[1] ^ st->lane[2];
+  return lp__hash_tail(st->buf + 16, st->pending, seed, st->total);
+}
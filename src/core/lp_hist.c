@@ -0,0 +1,312 @@
+#include "lp/lp_hist.h"
+#include "lp/lp_bytes.h"
+#include <string.h>
+
+/*
+  Encoding (version 1), all integers unsigned LEB128 varints:
+
+    u8 version, u8 sub_bits, u8 max_bits,
+    total, min, max, clamped, sum,
+    then per non-empty bucket: gap (empty buckets skipped since the last
+    one written), count.
+*/
+
+#define LP__HIST_VERSION 1u
+
+size_t lp_hist_buckets(uint32_t sub_bits, uint32_t max_bits) {
+  if (sub_bits < 1u || sub_bits > LP_HIST_MAX_SUB_BITS) return 0;
+  if (max_bits <= sub_bits || max_bits > 64u) return 0;
+  return (size_t)(max_bits - sub_bits + 1u) << sub_bits;
+}
+
+static void lp__hist_setup(lp_hist* h, uint64_t* counts, size_t n, uint32_t sub_bits, uint32_t max_bits) {
+  h->counts = counts;
+  h->nbuckets = n;
+  h->highest = (max_bits == 64u) ? UINT64_MAX : (1ull << max_bits) - 1u;
+  h->sub_bits = (uint8_t)sub_bits;
+  h->max_bits = (uint8_t)max_bits;
+  lp_hist_reset(h);
+}
+
+lp_status_t lp_hist_init(lp_hist* h, uint64_t* counts, size_t n, uint32_t sub_bits, uint32_t max_bits) {
+  if (!h || !counts) return LP_ERR_INVALID;
+  size_t need = lp_hist_buckets(sub_bits, max_bits);
+  if (need == 0) return LP_ERR_INVALID;
+  if (n < need) return LP_ERR_NOMEM;
+  lp__hist_setup(h, counts, need, sub_bits, max_bits);
+  return LP_OK;
+}
+
+lp_status_t lp_hist_init_arena(lp_hist* h, lp_arena* a, uint32_t sub_bits, uint32_t max_bits) {
+  if (!h || !a) return LP_ERR_INVALID;
+  size_t need = lp_hist_buckets(sub_bits, max_bits), bytes = 0;
+  if (need == 0) return LP_ERR_INVALID;
+  if (lp_checked_mul_size(need, sizeof(uint64_t), &bytes) != LP_OK) return LP_ERR_OVERFLOW;
+  void* mem = NULL;
+  lp_status_t st = lp_arena_alloc(a, bytes, _Alignof(uint64_t), &mem);
+  if (st != LP_OK) return st;
+  lp__hist_setup(h, (uint64_t*)mem, need, sub_bits, max_bits);
+  return LP_OK;
+}
+
+void lp_hist_reset(lp_hist* h) {
+  if (!h) return;
+  memset(h->counts, 0, h->nbuckets * sizeof(uint64_t));
+  h->total = 0;
+  h->sum = 0;
+  h->min = UINT64_MAX;
+  h->max = 0;
+  h->clamped = 0;
+}
+
+// Largest value that lands in bucket i.
+static uint64_t lp__hist_upper(uint32_t sub_bits, size_t i) {
+  size_t block = i >> sub_bits;
+  uint32_t shift = block ? (uint32_t)block - 1u : 0u;
+  uint64_t lower = (uint64_t)(i - ((size_t)shift << sub_bits)) << shift;
+  return lower + ((1ull << shift) - 1u);
+}
+
+// ceil(p% of total), at least 1.
+static uint64_t lp__hist_rank(uint64_t total, double p) {
+  if (!(p > 0.0)) return 1u; // also NaN
+  if (p >= 100.0) return total;
+  double x = p / 100.0 * (double)total;
+  uint64_t r = (uint64_t)x;
+  if ((double)r < x) r++;
+  return r ? r : 1u;
+}
+
+void lp_hist_percentiles(const lp_hist* h, const double* ps, uint64_t* out, size_t n) {
+  if (!h || !ps || !out) return;
+  if (h->total == 0) {
+    for (size_t k = 0; k < n; k++) out[k] = 0;
+    return;
+  }
+  size_t k = 0;
+  uint64_t cum = 0;
+  for (size_t i = 0; i < h->nbuckets && k < n; i++) {
+    cum += h->counts[i];
+    while (k < n && cum >= lp__hist_rank(h->total, ps[k])) {
+      uint64_t v = lp__hist_upper(h->sub_bits, i);
+      v = (v < h->min) ? h->min : v;
+      out[k++] = (v > h->max) ? h->max : v;
+    }
+  }
+  for (; k < n; k++) out[k] = h->max; // counts short of total: shouldn't happen
+}
+
+uint64_t lp_hist_percentile(const lp_hist* h, double p) {
+  uint64_t v = 0;
+  lp_hist_percentiles(h, &p, &v, 1u);
+  return v;
+}
+
+// Index in dst for a count kept at src bucket i (same sub_bits).
+static LP_INLINE size_t lp__hist_dst_index(const lp_hist* dst, size_t i, bool* over) {
+  *over = i >= dst->nbuckets;
+  return *over ? dst->nbuckets - 1u : i;
+}
+
+static void lp__hist_add_summary(lp_hist* dst, uint64_t total, uint64_t min, uint64_t max, uint64_t clamped,
+                                 uint64_t sum) {
+  if (total == 0) return;
+  dst->total += total;
+  dst->sum += sum;
+  dst->clamped += clamped;
+  if (min > dst->highest) min = dst->highest;
+  if (max > dst->highest) max = dst->highest;
+  if (min < dst->min) dst->min = min;
+  if (max > dst->max) dst->max = max;
+}
+
+lp_status_t lp_hist_merge(lp_hist* dst, const lp_hist* src) {
+  if (!dst || !src) return LP_ERR_INVALID;
+  if (dst->sub_bits != src->sub_bits) return LP_ERR_INVALID;
+  uint64_t extra = 0;
+  for (size_t i = 0; i < src->nbuckets; i++) {
+    if (!src->counts[i]) continue;
+    bool over;
+    dst->counts[lp__hist_dst_index(dst, i, &over)] += src->counts[i];
+    if (over) extra += src->counts[i];
+  }
+  lp__hist_add_summary(dst, src->total, src->min, src->max, src->clamped + extra, src->sum);
+  return LP_OK;
+}
+
+// -------------------------
+// Encoding
+// -------------------------
+
+// Byte sink: a span, or base64 text appended to an lp_fmtbuf a chunk at a
+// time (chunks are a multiple of 3 bytes, so only the last one is short).
+typedef struct {
+  uint8_t*    dst;
+  size_t      cap;
+  size_t      len;
+  bool        measure; // only count
+  lp_fmtbuf*  fb;
+  uint8_t     chunk[48];
+  size_t      n;
+  lp_status_t st;
+} lp__hist_out;
+
+static void lp__hist_flush(lp__hist_out* o) {
+  char txt[64];
+  size_t tl = 0;
+  if (o->n == 0) return;
+  lp_status_t st = lp_base64_encode((lp_span_u8_mut){ (uint8_t*)txt, sizeof txt },
+                                    (lp_span_u8){ o->chunk, o->n }, LP_BASE64_URL, &tl);
+  if (st == LP_OK) st = lp_fmt_append_bytes(o->fb, txt, tl);
+  if (st != LP_OK && o->st == LP_OK) o->st = st;
+  o->n = 0;
+}
+
+static void lp__hist_put(lp__hist_out* o, uint8_t b) {
+  if (o->fb) {
+    o->chunk[o->n++] = b;
+    if (o->n == sizeof o->chunk) lp__hist_flush(o);
+    return;
+  }
+  if (o->len < o->cap) o->dst[o->len] = b;
+  else if (!o->measure) o->st = LP_ERR_RANGE;
+  o->len++;
+}
+
+static void lp__hist_put_varint(lp__hist_out* o, uint64_t v) {
+  while (v >= 0x80u) {
+    lp__hist_put(o, (uint8_t)(v | 0x80u));
+    v >>= 7;
+  }
+  lp__hist_put(o, (uint8_t)v);
+}
+
+static void lp__hist_write(const lp_hist* h, lp__hist_out* o) {
+  lp__hist_put(o, LP__HIST_VERSION);
+  lp__hist_put(o, h->sub_bits);
+  lp__hist_put(o, h->max_bits);
+  lp__hist_put_varint(o, h->total);
+  lp__hist_put_varint(o, h->total ? h->min : 0u);
+  lp__hist_put_varint(o, h->max);
+  lp__hist_put_varint(o, h->clamped);
+  lp__hist_put_varint(o, h->sum);
+  size_t next = 0;
+  for (size_t i = 0; i < h->nbuckets; i++) {
+    if (!h->counts[i]) continue;
+    lp__hist_put_varint(o, (uint64_t)(i - next));
+    lp__hist_put_varint(o, h->counts[i]);
+    next = i + 1u;
+  }
+}
+
+size_t lp_hist_encoded_len(const lp_hist* h) {
+  if (!h) return 0;
+  lp__hist_out o = { .measure = true, .st = LP_OK };
+  lp__hist_write(h, &o);
+  return o.len;
+}
+
+lp_status_t lp_hist_encode(const lp_hist* h, lp_span_u8_mut dst, size_t* out_len) {
+  if (!h || !out_len || (!dst.ptr && dst.len)) return LP_ERR_INVALID;
+  lp__hist_out o = { .dst = dst.ptr, .cap = dst.len, .st = LP_OK };
+  lp__hist_write(h, &o);
+  *out_len = (o.st == LP_OK) ? o.len : 0u;
+  return o.st;
+}
+
+lp_status_t lp_hist_dump_encoded(lp_fmtbuf* fb, const lp_hist* h) {
+  if (!fb || !h) return LP_ERR_INVALID;
+  lp__hist_out o = { .fb = fb, .st = LP_OK };
+  lp__hist_write(h, &o);
+  lp__hist_flush(&o);
+  return o.st;
+}
+
+typedef struct {
+  const uint8_t* p;
+  const uint8_t* end;
+} lp__hist_in;
+
+static bool lp__hist_get_varint(lp__hist_in* in, uint64_t* out) {
+  uint64_t v = 0;
+  for (uint32_t shift = 0; shift < 64u; shift += 7u) {
+    if (in->p == in->end) return false;
+    uint8_t b = *in->p++;
+    uint64_t bits = (uint64_t)(b & 0x7Fu);
+    if (shift == 63u && bits > 1u) return false; // past 64 bits
+    v |= bits << shift;
+    if (!(b & 0x80u)) {
+      *out = v;
+      return true;
+    }
+  }
+  return false;
+}
+
+typedef struct {
+  uint32_t sub_bits;
+  uint32_t max_bits;
+  uint64_t total, min, max, clamped, sum;
+} lp__hist_hdr;
+
+static bool lp__hist_read_hdr(lp__hist_in* in, lp__hist_hdr* hd) {
+  if (in->end - in->p < 3) return false;
+  if (in->p[0] != LP__HIST_VERSION) return false;
+  hd->sub_bits = in->p[1];
+  hd->max_bits = in->p[2];
+  in->p += 3;
+  if (lp_hist_buckets(hd->sub_bits, hd->max_bits) == 0) return false;
+  return lp__hist_get_varint(in, &hd->total) && lp__hist_get_varint(in, &hd->min) &&
+         lp__hist_get_varint(in, &hd->max) && lp__hist_get_varint(in, &hd->clamped) &&
+         lp__hist_get_varint(in, &hd->sum);
+}
+
+// Walks the bucket runs; with h set, adds them in. Checks that every
+// index is in range, counts are non-zero and they add up to total.
+static bool lp__hist_read_runs(lp__hist_in in, const lp__hist_hdr* hd, lp_hist* h, uint64_t* extra) {
+  size_t n = lp_hist_buckets(hd->sub_bits, hd->max_bits);
+  uint64_t next = 0, seen = 0;
+  while (in.p != in.end) {
+    uint64_t gap, count;
+    if (!lp__hist_get_varint(&in, &gap) || !lp__hist_get_varint(&in, &count)) return false;
+    if (gap >= (uint64_t)n - next || count == 0 || count > hd->total - seen) return false;
+    size_t i = (size_t)(next + gap);
+    if (h) {
+      bool over;
+      h->counts[lp__hist_dst_index(h, i, &over)] += count;
+      if (over) *extra += count;
+    }
+    seen += count;
+    next = (uint64_t)i + 1u;
+  }
+  return seen == hd->total;
+}
+
+lp_status_t lp_hist_decode_add(lp_hist* h, lp_span_u8 src) {
+  if (!h || (!src.ptr && src.len)) return LP_ERR_INVALID;
+  lp__hist_in in = { src.ptr, src.ptr + src.len };
+  lp__hist_hdr hd;
+  if (!lp__hist_read_hdr(&in, &hd)) return LP_ERR_INVALID;
+  if (hd.sub_bits != h->sub_bits) return LP_ERR_INVALID;
+  if (hd.total && (hd.min > hd.max || hd.clamped > hd.total)) return LP_ERR_INVALID;
+  if (!lp__hist_read_runs(in, &hd, NULL, NULL)) return LP_ERR_INVALID;
+
+  uint64_t extra = 0;
+  (void)lp__hist_read_runs(in, &hd, h, &extra);
+  lp__hist_add_summary(h, hd.total, hd.min, hd.max, hd.clamped + extra, hd.sum);
+  return LP_OK;
+}
+
+// -------------------------
+// Text
+// -------------------------
+
+lp_status_t lp_hist_dump(lp_fmtbuf* fb, const char* name, const lp_hist* h) {
+  if (!fb || !h) return LP_ERR_INVALID;
+  static const double ps[4] = { 50.0, 90.0, 99.0, 99.9 };
+  uint64_t v[4];
+  lp_hist_percentiles(h, ps, v, 4u);
+  return lp_fmt_appendf(fb, "{}: n={} min={} p50={} p90={} p99={} p999={} max={} mean={} clamped={}",
+                        name ? name : "hist", h->total, h->total ? h->min : 0u, v[0], v[1], v[2], v[3],
+                        h->max, lp_hist_mean(h), h->clamped);
+}
@@ -0,0 +1,167 @@
+#include "lp/lp_intern.h"
+#include "lp/lp_hash.h"
+#include "lp/lp_strview.h"
+#include "lp/lp_bytes.h"
+#include <string.h>
+
+/*
+  Publication order for a new string (under the writer lock): bytes and
+  strs[id] are written first, then count, then the index slot with release
+  semantics. A reader that acquires the slot therefore sees a complete
+  strs[id], and lp_intern_str never hands out an id past count.
+*/
+
+#if LP_CFG_ENABLE_ATOMICS
+  #define lp__intern_load(p)     lp_port_atomic_load((p), LP_MO_ACQUIRE)
+  #define lp__intern_store(p, v) lp_port_atomic_store((p), (v), LP_MO_RELEASE)
+#else
+  #define lp__intern_load(p)     (*(p))
+  #define lp__intern_store(p, v) (*(p) = (v))
+#endif
+
+#define LP__INTERN_ID_BITS 24u
+#define LP__INTERN_ID_MASK ((size_t)LP_INTERN_MAX_IDS)
+
+// Index slots: at least twice max_ids, so probes stay short.
+static size_t lp__intern_index_cap(uint32_t max_ids) {
+  size_t cap = 16u;
+  while (cap < 2u * (size_t)max_ids) cap *= 2u;
+  return cap;
+}
+
+static LP_INLINE size_t lp__intern_tag(uint64_t h) {
+  return (size_t)(h >> 40) & (SIZE_MAX >> LP__INTERN_ID_BITS);
+}
+
+// Slot where s is, or the empty slot ending its probe.
+static size_t lp__intern_probe(const lp_interner* in, lp_strview s, uint64_t h, lp_intern_id* id) {
+  size_t tag = lp__intern_tag(h);
+  size_t i = (size_t)h & in->index_mask;
+  for (;;) {
+    size_t w = lp__intern_load(&in->index[i]);
+    if (w == 0) {
+      *id = LP_INTERN_NONE;
+      return i;
+    }
+    if ((w >> LP__INTERN_ID_BITS) == tag) {
+      lp_intern_id k = (lp_intern_id)((w & LP__INTERN_ID_MASK) - 1u);
+      if (lp_sv_eq(in->strs[k], s)) {
+        *id = k;
+        return i;
+      }
+    }
+    i = (i + 1u) & in->index_mask;
+  }
+}
+
+static void lp__intern_lock(lp_interner* in) {
+#if LP_CFG_ENABLE_ATOMICS
+  if (!(in->flags & LP_INTERN_CONCURRENT)) return;
+  for (;;) {
+    size_t expected = 0;
+    if (lp_port_atomic_cas_weak(&in->lock, &expected, (size_t)1, LP_MO_ACQUIRE, LP_MO_RELAXED)) return;
+    while (lp_port_atomic_load(&in->lock, LP_MO_RELAXED) != 0) {
+    }
+  }
+#else
+  (void)in;
+#endif
+}
+
+static void lp__intern_unlock(lp_interner* in) {
+#if LP_CFG_ENABLE_ATOMICS
+  if (in->flags & LP_INTERN_CONCURRENT) lp_port_atomic_store(&in->lock, (size_t)0, LP_MO_RELEASE);
+#else
+  (void)in;
+#endif
+}
+
+size_t lp_intern_table_size(uint32_t max_ids) {
+  if (max_ids == 0 || max_ids > LP_INTERN_MAX_IDS) return 0;
+  // each part aligned by lp_arena_alloc; allow for that padding
+  return (size_t)max_ids * sizeof(lp_strview) + lp__intern_index_cap(max_ids) * sizeof(lp__intern_word)
+       + 2u * sizeof(void*);
+}
+
+lp_status_t lp_intern_init(lp_interner* in, lp_arena* a, uint32_t max_ids, uint32_t flags) {
+  if (!in || !a || max_ids == 0 || max_ids > LP_INTERN_MAX_IDS) return LP_ERR_INVALID;
+  if (flags & ~(uint32_t)LP_INTERN_CONCURRENT) return LP_ERR_INVALID;
+#if !LP_CFG_ENABLE_ATOMICS
+  if (flags & LP_INTERN_CONCURRENT) return LP_ERR_UNSUP;
+#endif
+
+  size_t icap = lp__intern_index_cap(max_ids);
+  void* strs = NULL;
+  void* index = NULL;
+  lp_arena_pos pos = lp_arena_mark(a);
+  lp_status_t st = lp_arena_alloc(a, (size_t)max_ids * sizeof(lp_strview), sizeof(void*), &strs);
+  if (st == LP_OK) st = lp_arena_alloc(a, icap * sizeof(lp__intern_word), sizeof(lp__intern_word), &index);
+  if (st != LP_OK) {
+    lp_arena_rewind(a, pos);
+    return st;
+  }
+  memset(index, 0, icap * sizeof(lp__intern_word));
+
+  in->arena = a;
+  in->strs = (lp_strview*)strs;
+  in->index = (lp__intern_word*)index;
+  in->index_mask = icap - 1u;
+  in->seed = 0;
+  in->max_ids = max_ids;
+  in->flags = flags;
+  in->count = 0;
+  in->lock = 0;
+  return LP_OK;
+}
+
+lp_intern_id lp_intern_find(const lp_interner* in, lp_strview s) {
+  if (!in || !in->index || (!s.ptr && s.len)) return LP_INTERN_NONE;
+  lp_intern_id id;
+  (void)lp__intern_probe(in, s, lp_hash_sv(s, in->seed), &id);
+  return id;
+}
+
+lp_status_t lp_intern(lp_interner* in, lp_strview s, lp_intern_id* id, lp_strview* canon) {
+  if (!in || !in->index || (!s.ptr && s.len)) return LP_ERR_INVALID;
+  uint64_t h = lp_hash_sv(s, in->seed);
+  lp_intern_id k;
+  (void)lp__intern_probe(in, s, h, &k);
+
+  lp_status_t st = LP_OK;
+  if (k == LP_INTERN_NONE) {
+    lp__intern_lock(in);
+    // another writer may have added it since the lock-free probe
+    size_t slot = lp__intern_probe(in, s, h, &k);
+    if (k == LP_INTERN_NONE) {
+      size_t n = lp__intern_load(&in->count);
+      void* mem = NULL;
+      if (n >= in->max_ids) st = LP_ERR_FULL;
+      else if (s.len == SIZE_MAX) st = LP_ERR_OVERFLOW;
+      else st = lp_arena_alloc(in->arena, s.len + 1u, 1u, &mem);
+      if (st == LP_OK) {
+        char* p = (char*)mem;
+        if (s.len) memcpy(p, s.ptr, s.len);
+        p[s.len] = '\0';
+        k = (lp_intern_id)n;
+        in->strs[k] = (lp_strview){ .ptr = p, .len = s.len };
+        lp__intern_store(&in->count, n + 1u);
+        lp__intern_store(&in->index[slot], (lp__intern_tag(h) << LP__INTERN_ID_BITS) | (n + 1u));
+      }
+    }
+    lp__intern_unlock(in);
+    if (st != LP_OK) return st;
+  }
+
+  if (id) *id = k;
+  if (canon) *canon = in->strs[k];
+  return LP_OK;
+}
+
+lp_strview lp_intern_str(const lp_interner* in, lp_intern_id id) {
+  if (!in || (size_t)id >= lp__intern_load(&in->count)) return (lp_strview){ .ptr = "", .len = 0 };
+  return in->strs[id];
+}
+
+size_t lp_intern_count(const lp_interner* in) {
+  return in ? lp__intern_load(&in->count) : 0u;
+}
@@ -0,0 +1,601 @@
+#include "lp/lp_map.h"
+#include "lp/lp_hash.h"
+#include "lp/lp_bytes.h"
+#include "lp/lp_port.h"
+#include "lp_cpu.h"
+#include <string.h>
+
+/*
+  Slots are probed a group of 16 at a time. A key's hash picks the first
+  group (h1 = hash >> 7) and its control byte (h2 = hash & 0x7F); groups
+  are visited in triangular order (+1, +2, +3, ...), which reaches every
+  group of a power-of-two table. A lookup ends at the first group holding
+  an EMPTY byte, so the load limit of 7/8 keeps probes short and
+  guarantees EMPTY bytes exist.
+
+  Removing leaves EMPTY when the group still has an EMPTY byte (no probe
+  ever went past that group, see lp__map_erase) and a DELETED tombstone
+  otherwise. Tombstones count against growth_left until the table is
+  rebuilt.
+*/
+
+#if LP_CFG_ENABLE_SIMD && LP__CPU_X86 && defined(__SSE2__)
+  #define LP__MAP_SSE2 1
+#endif
+
+#define LP__MAP_EMPTY   0x80u
+#define LP__MAP_DELETED 0xFEu
+#define LP__MAP_GROUP   16u
+#define LP__MAP_NONE    ((size_t)-1)
+
+typedef struct {
+  uint64_t   u;
+  lp_strview s;
+  uint64_t   hash;
+} lp__map_key;
+
+static LP_INLINE uint32_t lp__map_ctz(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (uint32_t)__builtin_ctz(x);
+#else
+  uint32_t n = 0;
+  while (!(x & 1u)) { x >>= 1; n++; }
+  return n;
+#endif
+}
+
+// -------------------------
+// Group scans: bit i set for control byte i of the 16
+// -------------------------
+
+#if LP__MAP_SSE2
+
+static LP_INLINE uint32_t lp__grp_match(const uint8_t* g, uint8_t h2) {
+  __m128i c = _mm_loadu_si128((const __m128i*)g);
+  return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8((char)h2)));
+}
+
+static LP_INLINE uint32_t lp__grp_empty(const uint8_t* g) {
+  __m128i c = _mm_loadu_si128((const __m128i*)g);
+  return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8((char)LP__MAP_EMPTY)));
+}
+
+// EMPTY or DELETED: the only control bytes with the top bit set.
+static LP_INLINE uint32_t lp__grp_free(const uint8_t* g) {
+  return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)g));
+}
+
+#else
+
+#define LP__ONES  0x0101010101010101ull
+#define LP__HIGHS 0x8080808080808080ull
+#define LP__LOWS7 0x7F7F7F7F7F7F7F7Full
+
+static LP_INLINE uint64_t lp__grp_load(const uint8_t* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof v);
+#if !(defined(LP_LITTLE_ENDIAN) && LP_LITTLE_ENDIAN)
+  v = __builtin_bswap64(v);
+#endif
+  return v;
+}
+
+// 0x80 in some bytes -> one bit per byte: the multiply gathers bit 8k
+// into bit 56 + k without carries.
+static LP_INLINE uint32_t lp__grp_pack(uint64_t highs) {
+  return (uint32_t)(((highs >> 7) * 0x0102040810204080ull) >> 56);
+}
+
+static LP_INLINE uint64_t lp__grp_zero(uint64_t v) {
+  return ~(((v & LP__LOWS7) + LP__LOWS7) | v | LP__LOWS7);
+}
+
+static LP_INLINE uint32_t lp__grp_match(const uint8_t* g, uint8_t h2) {
+  uint64_t pat = LP__ONES * h2;
+  return lp__grp_pack(lp__grp_zero(lp__grp_load(g) ^ pat))
+       | (lp__grp_pack(lp__grp_zero(lp__grp_load(g + 8) ^ pat)) << 8);
+}
+
+// EMPTY (0x80) has bit 1 clear, DELETED (0xFE) has it set.
+static LP_INLINE uint32_t lp__grp_empty(const uint8_t* g) {
+  uint64_t a = lp__grp_load(g), b = lp__grp_load(g + 8);
+  return lp__grp_pack(a & ~(a << 6) & LP__HIGHS) | (lp__grp_pack(b & ~(b << 6) & LP__HIGHS) << 8);
+}
+
+static LP_INLINE uint32_t lp__grp_free(const uint8_t* g) {
+  return lp__grp_pack(lp__grp_load(g) & LP__HIGHS) | (lp__grp_pack(lp__grp_load(g + 8) & LP__HIGHS) << 8);
+}
+
+#endif
+
+// -------------------------
+// Keys and slots
+// -------------------------
+
+static LP_INLINE uint8_t* lp__map_slot(const lp_map* m, const lp_map_table* t, size_t i) {
+  return t->slots + i * m->stride;
+}
+
+static LP_INLINE bool lp__map_key_eq(const lp_map* m, const uint8_t* slot, const lp__map_key* k) {
+  if (m->kind == LP_MAP_KEY_U64) {
+    uint64_t v;
+    memcpy(&v, slot, sizeof v);
+    return v == k->u;
+  }
+  lp_strview s;
+  memcpy(&s, slot, sizeof s);
+  return s.len == k->s.len && (s.len == 0 || memcmp(s.ptr, k->s.ptr, s.len) == 0);
+}
+
+static LP_INLINE void lp__map_key_store(const lp_map* m, uint8_t* slot, const lp__map_key* k) {
+  if (m->kind == LP_MAP_KEY_U64) memcpy(slot, &k->u, sizeof k->u);
+  else memcpy(slot, &k->s, sizeof k->s);
+}
+
+static LP_INLINE lp__map_key lp__map_key_u64(const lp_map* m, uint64_t key) {
+  lp__map_key k = { .u = key, .s = { NULL, 0 }, .hash = lp_hash_u64(key, m->seed) };
+  return k;
+}
+
+static LP_INLINE lp__map_key lp__map_key_sv(const lp_map* m, lp_strview key) {
+  lp__map_key k = { .u = 0, .s = key, .hash = lp_hash_sv(key, m->seed) };
+  return k;
+}
+
+static uint64_t lp__map_slot_hash(const lp_map* m, const uint8_t* slot) {
+  if (m->kind == LP_MAP_KEY_U64) {
+    uint64_t v;
+    memcpy(&v, slot, sizeof v);
+    return lp_hash_u64(v, m->seed);
+  }
+  lp_strview s;
+  memcpy(&s, slot, sizeof s);
+  return lp_hash_sv(s, m->seed);
+}
+
+// -------------------------
+// Table primitives
+// -------------------------
+
+static LP_INLINE size_t lp__map_max_load(size_t cap) {
+  return cap - cap / 8u;
+}
+
+// Smallest table (>= one group) that holds `entries`.
+static lp_status_t lp__map_cap_for(size_t entries, size_t* cap) {
+  size_t c = LP__MAP_GROUP;
+  while (lp__map_max_load(c) < entries) {
+    if (c > SIZE_MAX / 2u) return LP_ERR_OVERFLOW;
+    c *= 2u;
+  }
+  *cap = c;
+  return LP_OK;
+}
+
+static lp_status_t lp__map_table_bytes(const lp_map* m, size_t cap, size_t* out) {
+  return lp_checked_mul_size(cap, m->stride + 1u, out);
+}
+
+// Control bytes first, then the slots; cap is a multiple of 8, so slots
+// keep mem's 8-byte alignment.
+static void lp__map_table_setup(lp_map_table* t, uint8_t* mem, size_t cap) {
+  t->ctrl = mem;
+  t->slots = mem + cap;
+  t->cap = cap;
+  t->used = 0;
+  t->growth_left = lp__map_max_load(cap);
+  memset(mem, LP__MAP_EMPTY, cap);
+}
+
+static size_t lp__map_find(const lp_map* m, const lp_map_table* t, const lp__map_key* k) {
+  if (t->used == 0) return LP__MAP_NONE;
+  size_t gmask = t->cap / LP__MAP_GROUP - 1u;
+  size_t g = (size_t)(k->hash >> 7) & gmask;
+  uint8_t h2 = (uint8_t)(k->hash & 0x7Fu);
+  for (size_t step = 1; step <= gmask + 1u; step++) {
+    const uint8_t* c = t->ctrl + g * LP__MAP_GROUP;
+    uint32_t hit = lp__grp_match(c, h2);
+    while (hit) {
+      size_t i = g * LP__MAP_GROUP + lp__map_ctz(hit);
+      if (lp__map_key_eq(m, lp__map_slot(m, t, i), k)) return i;
+      hit &= hit - 1u;
+    }
+    if (lp__grp_empty(c)) return LP__MAP_NONE;
+    g = (g + step) & gmask;
+  }
+  return LP__MAP_NONE;
+}
+
+// First EMPTY or DELETED slot on the probe path (one always exists).
+static size_t lp__map_find_free(const lp_map_table* t, uint64_t hash) {
+  size_t gmask = t->cap / LP__MAP_GROUP - 1u;
+  size_t g = (size_t)(hash >> 7) & gmask;
+  for (size_t step = 1;; step++) {
+    uint32_t f = lp__grp_free(t->ctrl + g * LP__MAP_GROUP);
+    if (f) return g * LP__MAP_GROUP + lp__map_ctz(f);
+    g = (g + step) & gmask;
+  }
+}
+
+// Claims slot i (from lp__map_find_free) for a key with this hash.
+static LP_INLINE void lp__map_claim(lp_map_table* t, size_t i, uint64_t hash) {
+  if (t->ctrl[i] == LP__MAP_EMPTY) t->growth_left--;
+  t->ctrl[i] = (uint8_t)(hash & 0x7Fu);
+  t->used++;
+}
+
+// A group that still has an EMPTY byte has never been full since the last
+// rebuild (EMPTY bytes are only created here, where one already exists),
+// so no probe has passed it and the slot can go straight back to EMPTY.
+static void lp__map_erase(lp_map_table* t, size_t i) {
+  if (lp__grp_empty(t->ctrl + (i & ~(size_t)(LP__MAP_GROUP - 1u)))) {
+    t->ctrl[i] = LP__MAP_EMPTY;
+    t->growth_left++;
+  } else {
+    t->ctrl[i] = LP__MAP_DELETED;
+  }
+  t->used--;
+}
+
+static void lp__map_swap(uint8_t* a, uint8_t* b, size_t n) {
+  uint8_t tmp[64];
+  while (n) {
+    size_t k = (n < sizeof tmp) ? n : sizeof tmp;
+    memcpy(tmp, a, k);
+    memcpy(a, b, k);
+    memcpy(b, tmp, k);
+    a += k;
+    b += k;
+    n -= k;
+  }
+}
+
+// Drops tombstones without extra memory. Live slots are marked DELETED
+// ("not yet placed") and free ones EMPTY; each unplaced entry then goes
+// to the first free slot on its probe path, swapping with an unplaced
+// entry when that is where it lands. Entries already in the right group
+// stay put.
+static void lp__map_rehash_in_place(lp_map* m, lp_map_table* t) {
+  uint8_t* ctrl = t->ctrl;
+  for (size_t i = 0; i < t->cap; i++) ctrl[i] = (ctrl[i] & 0x80u) ? LP__MAP_EMPTY : LP__MAP_DELETED;
+
+  for (size_t i = 0; i < t->cap;) {
+    if (ctrl[i] != LP__MAP_DELETED) { i++; continue; }
+    uint8_t* si = lp__map_slot(m, t, i);
+    uint64_t h = lp__map_slot_hash(m, si);
+    uint8_t h2 = (uint8_t)(h & 0x7Fu);
+    size_t j = lp__map_find_free(t, h);
+    if (j / LP__MAP_GROUP == i / LP__MAP_GROUP) {
+      ctrl[i] = h2;
+      i++;
+    } else if (ctrl[j] == LP__MAP_EMPTY) {
+      memcpy(lp__map_slot(m, t, j), si, m->stride);
+      ctrl[j] = h2;
+      ctrl[i] = LP__MAP_EMPTY;
+      i++;
+    } else {
+      // j holds an unplaced entry: trade places and place that one next
+      lp__map_swap(lp__map_slot(m, t, j), si, m->stride);
+      ctrl[j] = h2;
+    }
+  }
+  t->growth_left = lp__map_max_load(t->cap) - t->used;
+}
+
+// -------------------------
+// Heap tables and incremental migration
+// -------------------------
+
+#if LP_CFG_ENABLE_ALLOC
+
+static void lp__map_table_free(lp_map_table* t) {
+  if (t->ctrl) lp_port_free(t->ctrl);
+  *t = (lp_map_table){ 0 };
+}
+
+// Moves up to `slots` slots of the old table into the current one.
+static void lp__map_migrate(lp_map* m, size_t slots) {
+  lp_map_table* o = &m->old;
+  size_t end = (slots > o->cap - m->migrate_pos) ? o->cap : m->migrate_pos + slots;
+  for (size_t i = m->migrate_pos; i < end && o->used; i++) {
+    if (o->ctrl[i] & 0x80u) continue;
+    const uint8_t* s = lp__map_slot(m, o, i);
+    uint64_t h = lp__map_slot_hash(m, s);
+    size_t j = lp__map_find_free(&m->t, h);
+    LP_ASSERT(m->t.ctrl[j] == LP__MAP_DELETED || m->t.growth_left > 0);
+    lp__map_claim(&m->t, j, h);
+    memcpy(lp__map_slot(m, &m->t, j), s, m->stride);
+    // DELETED, not EMPTY: lookups of entries not yet moved may probe past
+    o->ctrl[i] = LP__MAP_DELETED;
+    o->used--;
+  }
+  m->migrate_pos = end;
+  if (o->used == 0) {
+    lp__map_table_free(o);
+    m->migrate_pos = 0;
+  }
+}
+
+// Current table becomes the old one; inserts go to a fresh table. Twice
+// the size unless tombstones are most of the load. The new table absorbs
+// the old entries plus the inserts made while they move (one group per
+// call), well within its own load limit.
+static lp_status_t lp__map_grow(lp_map* m) {
+  if (m->old.cap) lp__map_migrate(m, SIZE_MAX);
+  size_t cap = m->t.cap ? m->t.cap : LP__MAP_GROUP;
+  if (m->t.cap && m->t.used >= lp__map_max_load(m->t.cap) / 2u) {
+    if (cap > SIZE_MAX / 2u) return LP_ERR_NOMEM;
+    cap *= 2u;
+  }
+  size_t bytes = 0;
+  if (lp__map_table_bytes(m, cap, &bytes) != LP_OK) return LP_ERR_NOMEM;
+  uint8_t* mem = (uint8_t*)lp_port_malloc(bytes);
+  if (!mem) return LP_ERR_NOMEM;
+
+  lp_map_table fresh;
+  lp__map_table_setup(&fresh, mem, cap);
+  if (m->t.used) {
+    m->old = m->t;
+    m->migrate_pos = 0;
+  } else {
+    lp__map_table_free(&m->t);
+  }
+  m->t = fresh;
+  return LP_OK;
+}
+
+#endif // LP_CFG_ENABLE_ALLOC
+
+// Current table has no EMPTY slot left to fill.
+static lp_status_t lp__map_make_room(lp_map* m) {
+#if LP_CFG_ENABLE_ALLOC
+  if (m->heap) return lp__map_grow(m);
+#endif
+  if (m->t.cap == 0 || m->t.used >= lp__map_max_load(m->t.cap)) return LP_ERR_FULL;
+  lp__map_rehash_in_place(m, &m->t);
+  return LP_OK;
+}
+
+// -------------------------
+// Init
+// -------------------------
+
+static lp_status_t lp__map_setup(lp_map* m, lp_map_key_kind kind, size_t val_size) {
+  if (!m || (kind != LP_MAP_KEY_U64 && kind != LP_MAP_KEY_SV)) return LP_ERR_INVALID;
+  size_t key_size = (kind == LP_MAP_KEY_U64) ? sizeof(uint64_t) : sizeof(lp_strview);
+  size_t val_off = lp_align_up_size(key_size, 8u);
+  if (val_size > SIZE_MAX - val_off - 8u) return LP_ERR_OVERFLOW;
+  *m = (lp_map){ 0 };
+  m->kind = (uint8_t)kind;
+  m->val_size = val_size;
+  m->val_off = val_off;
+  m->stride = lp_align_up_size(val_off + val_size, 8u);
+  return LP_OK;
+}
+
+size_t lp_map_mem_size(lp_map_key_kind kind, size_t val_size, size_t entries) {
+  lp_map m;
+  size_t cap = 0, bytes = 0;
+  if (lp__map_setup(&m, kind, val_size) != LP_OK) return 0;
+  if (lp__map_cap_for(entries, &cap) != LP_OK) return 0;
+  if (lp__map_table_bytes(&m, cap, &bytes) != LP_OK || bytes > SIZE_MAX - 7u) return 0;
+  return bytes + 7u; // start alignment
+}
+
+lp_status_t lp_map_init(lp_map* m, lp_map_key_kind kind, size_t val_size, void* mem, size_t mem_size) {
+  if (!mem && mem_size) return LP_ERR_INVALID;
+  lp_status_t st = lp__map_setup(m, kind, val_size);
+  if (st != LP_OK) return st;
+
+  size_t pad = (size_t)(0u - (uintptr_t)mem) & 7u;
+  if (!mem || pad >= mem_size) return LP_ERR_NOMEM;
+  size_t avail = mem_size - pad;
+  // largest power-of-two table that fits
+  if (avail / (m->stride + 1u) < LP__MAP_GROUP) return LP_ERR_NOMEM;
+  size_t cap = LP__MAP_GROUP;
+  while (cap <= SIZE_MAX / 2u && avail / (m->stride + 1u) >= cap * 2u) cap *= 2u;
+  lp__map_table_setup(&m->t, (uint8_t*)mem + pad, cap);
+  return LP_OK;
+}
+
+lp_status_t lp_map_init_arena(lp_map* m, lp_map_key_kind kind, size_t val_size, lp_arena* a, size_t entries) {
+  if (!a) return LP_ERR_INVALID;
+  lp_status_t st = lp__map_setup(m, kind, val_size);
+  if (st != LP_OK) return st;
+  size_t cap = 0, bytes = 0;
+  if ((st = lp__map_cap_for(entries, &cap)) != LP_OK) return st;
+  if ((st = lp__map_table_bytes(m, cap, &bytes)) != LP_OK) return st;
+  void* mem = NULL;
+  if ((st = lp_arena_alloc(a, bytes, 8u, &mem)) != LP_OK) return st;
+  lp__map_table_setup(&m->t, (uint8_t*)mem, cap);
+  return LP_OK;
+}
+
+#if LP_CFG_ENABLE_ALLOC
+lp_status_t lp_map_init_heap(lp_map* m, lp_map_key_kind kind, size_t val_size, size_t entries) {
+  lp_status_t st = lp__map_setup(m, kind, val_size);
+  if (st != LP_OK) return st;
+  m->heap = true;
+  if (entries == 0) return LP_OK;
+  size_t cap = 0, bytes = 0;
+  if ((st = lp__map_cap_for(entries, &cap)) != LP_OK) return st;
+  if ((st = lp__map_table_bytes(m, cap, &bytes)) != LP_OK) return st;
+  uint8_t* mem = (uint8_t*)lp_port_malloc(bytes);
+  if (!mem) return LP_ERR_NOMEM;
+  lp__map_table_setup(&m->t, mem, cap);
+  return LP_OK;
+}
+#endif
+
+void lp_map_destroy(lp_map* m) {
+  if (!m) return;
+#if LP_CFG_ENABLE_ALLOC
+  if (m->heap) {
+    lp__map_table_free(&m->t);
+    lp__map_table_free(&m->old);
+    m->migrate_pos = 0;
+    return;
+  }
+#endif
+  m->t = (lp_map_table){ 0 };
+}
+
+void lp_map_clear(lp_map* m) {
+  if (!m) return;
+#if LP_CFG_ENABLE_ALLOC
+  if (m->old.cap) {
+    lp__map_table_free(&m->old);
+    m->migrate_pos = 0;
+  }
+#endif
+  if (m->t.cap) lp__map_table_setup(&m->t, m->t.ctrl, m->t.cap);
+}
+
+// -------------------------
+// Operations
+// -------------------------
+
+static void* lp__map_get(const lp_map* m, const lp__map_key* k) {
+  size_t i = lp__map_find(m, &m->t, k);
+  if (i != LP__MAP_NONE) return lp__map_slot(m, &m->t, i) + m->val_off;
+  if (m->old.cap) {
+    i = lp__map_find(m, &m->old, k);
+    if (i != LP__MAP_NONE) return lp__map_slot(m, &m->old, i) + m->val_off;
+  }
+  return NULL;
+}
+
+static lp_status_t lp__map_emplace(lp_map* m, const lp__map_key* k, void** val, bool* inserted) {
+#if LP_CFG_ENABLE_ALLOC
+  if (m->old.cap) lp__map_migrate(m, LP__MAP_GROUP);
+#endif
+  size_t i = lp__map_find(m, &m->t, k);
+  size_t oi = (i == LP__MAP_NONE && m->old.cap) ? lp__map_find(m, &m->old, k) : LP__MAP_NONE;
+  size_t j = LP__MAP_NONE;
+  if (i == LP__MAP_NONE) {
+    if (m->t.cap) j = lp__map_find_free(&m->t, k->hash);
+    if (j == LP__MAP_NONE || (m->t.ctrl[j] == LP__MAP_EMPTY && m->t.growth_left == 0)) {
+      lp_status_t st = lp__map_make_room(m);
+      if (st != LP_OK) return st;
+      // tables may have changed under us: look again
+      i = lp__map_find(m, &m->t, k);
+      oi = (i == LP__MAP_NONE && m->old.cap) ? lp__map_find(m, &m->old, k) : LP__MAP_NONE;
+      j = lp__map_find_free(&m->t, k->hash);
+    }
+  }
+  if (i != LP__MAP_NONE) {
+    *val = lp__map_slot(m, &m->t, i) + m->val_off;
+    if (inserted) *inserted = false;
+    return LP_OK;
+  }
+
+  lp__map_claim(&m->t, j, k->hash);
+  uint8_t* s = lp__map_slot(m, &m->t, j);
+  if (oi != LP__MAP_NONE) {
+    // still in the old table: move it over now
+    memcpy(s, lp__map_slot(m, &m->old, oi), m->stride);
+    m->old.ctrl[oi] = LP__MAP_DELETED;
+    m->old.used--;
+    if (inserted) *inserted = false;
+  } else {
+    lp__map_key_store(m, s, k);
+    memset(s + m->val_off, 0, m->stride - m->val_off);
+    if (inserted) *inserted = true;
+  }
+  *val = s + m->val_off;
+  return LP_OK;
+}
+
+static lp_status_t lp__map_put(lp_map* m, const lp__map_key* k, const void* val) {
+  void* slot = NULL;
+  lp_status_t st = lp__map_emplace(m, k, &slot, NULL);
+  if (st == LP_OK && m->val_size) memcpy(slot, val, m->val_size);
+  return st;
+}
+
+static bool lp__map_remove(lp_map* m, const lp__map_key* k) {
+#if LP_CFG_ENABLE_ALLOC
+  if (m->old.cap) lp__map_migrate(m, LP__MAP_GROUP);
+#endif
+  size_t i = lp__map_find(m, &m->t, k);
+  if (i != LP__MAP_NONE) {
+    lp__map_erase(&m->t, i);
+    return true;
+  }
+  if (m->old.cap) {
+    i = lp__map_find(m, &m->old, k);
+    if (i != LP__MAP_NONE) {
+      m->old.ctrl[i] = LP__MAP_DELETED;
+      m->old.used--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void* lp_map_get_u64(const lp_map* m, uint64_t key) {
+  if (!m || m->kind != LP_MAP_KEY_U64) return NULL;
+  lp__map_key k = lp__map_key_u64(m, key);
+  return lp__map_get(m, &k);
+}
+
+void* lp_map_get_sv(const lp_map* m, lp_strview key) {
+  if (!m || m->kind != LP_MAP_KEY_SV) return NULL;
+  lp__map_key k = lp__map_key_sv(m, key);
+  return lp__map_get(m, &k);
+}
+
+lp_status_t lp_map_emplace_u64(lp_map* m, uint64_t key, void** val, bool* inserted) {
+  if (!m || !val || m->kind != LP_MAP_KEY_U64) return LP_ERR_INVALID;
+  lp__map_key k = lp__map_key_u64(m, key);
+  return lp__map_emplace(m, &k, val, inserted);
+}
+
+lp_status_t lp_map_emplace_sv(lp_map* m, lp_strview key, void** val, bool* inserted) {
+  if (!m || !val || m->kind != LP_MAP_KEY_SV || (!key.ptr && key.len)) return LP_ERR_INVALID;
+  lp__map_key k = lp__map_key_sv(m, key);
+  return lp__map_emplace(m, &k, val, inserted);
+}
+
+lp_status_t lp_map_put_u64(lp_map* m, uint64_t key, const void* val) {
+  if (!m || m->kind != LP_MAP_KEY_U64 || (!val && m->val_size)) return LP_ERR_INVALID;
+  lp__map_key k = lp__map_key_u64(m, key);
+  return lp__map_put(m, &k, val);
+}
+
+lp_status_t lp_map_put_sv(lp_map* m, lp_strview key, const void* val) {
+  if (!m || m->kind != LP_MAP_KEY_SV || (!val && m->val_size) || (!key.ptr && key.len)) return LP_ERR_INVALID;
+  lp__map_key k = lp__map_key_sv(m, key);
+  return lp__map_put(m, &k, val);
+}
+
+bool lp_map_remove_u64(lp_map* m, uint64_t key) {
+  if (!m || m->kind != LP_MAP_KEY_U64) return false;
+  lp__map_key k = lp__map_key_u64(m, key);
+  return lp__map_remove(m, &k);
+}
+
+bool lp_map_remove_sv(lp_map* m, lp_strview key) {
+  if (!m || m->kind != LP_MAP_KEY_SV) return false;
+  lp__map_key k = lp__map_key_sv(m, key);
+  return lp__map_remove(m, &k);
+}
+
+bool lp_map_next(const lp_map* m, size_t* it, lp_map_entry* e) {
+  if (!m || !it || !e) return false;
+  for (size_t i = *it; i < m->t.cap + m->old.cap; i++) {
+    const lp_map_table* t = (i < m->t.cap) ? &m->t : &m->old;
+    size_t si = (i < m->t.cap) ? i : i - m->t.cap;
+    if (t->ctrl[si] & 0x80u) continue;
+    uint8_t* s = lp__map_slot(m, t, si);
+    e->key_u64 = 0;
+    e->key_sv = (lp_strview){ NULL, 0 };
+    if (m->kind == LP_MAP_KEY_U64) memcpy(&e->key_u64, s, sizeof e->key_u64);
+    else memcpy(&e->key_sv, s, sizeof e->key_sv);
+    e->val = s + m->val_off;
+    *it = i + 1u;
+    return true;
+  }
+  *it = m->t.cap + m->old.cap;
+  return false;
+}
@@ -0,0 +1,84 @@
+#include "lp/lp_mirror_ring.h"
+#include "lp/lp_port.h"
+#include <string.h>
+
+lp_status_t lp_mirror_ring_create(lp_mirror_ring* r, size_t min_cap) {
+  if (!r || min_cap == 0) return LP_ERR_INVALID;
+
+  void* base = NULL;
+  size_t cap = 0;
+  lp_status_t st = lp_port_vm_mirror_alloc(min_cap, &base, &cap);
+  if (st != LP_OK) return st;
+
+  r->buf  = (uint8_t*)base;
+  r->cap  = cap;
+  r->tail = 0;
+  r->len  = 0;
+  return LP_OK;
+}
+
+void lp_mirror_ring_destroy(lp_mirror_ring* r) {
+  if (!r) return;
+  lp_port_vm_mirror_free(r->buf, r->cap);
+  r->buf = NULL;
+  r->cap = 0;
+  r->tail = 0;
+  r->len = 0;
+}
+
+static LP_INLINE size_t lp__mirror_head(const lp_mirror_ring* r) {
+  size_t h = r->tail + r->len;
+  return (h >= r->cap) ? (h - r->cap) : h;
+}
+
+lp_status_t lp_mirror_ring_reserve(lp_mirror_ring* r, size_t n, lp_span_u8_mut* out) {
+  if (!r || !out || !r->buf) return LP_ERR_INVALID;
+  if (n > lp_mirror_ring_free(r)) return LP_ERR_FULL;
+  *out = (lp_span_u8_mut){ .ptr = r->buf + lp__mirror_head(r), .len = n };
+  return LP_OK;
+}
+
+lp_status_t lp_mirror_ring_commit(lp_mirror_ring* r, size_t n) {
+  if (!r) return LP_ERR_INVALID;
+  if (n > lp_mirror_ring_free(r)) return LP_ERR_RANGE;
+  r->len += n;
+  return LP_OK;
+}
+
+lp_status_t lp_mirror_ring_peek(const lp_mirror_ring* r, size_t n, lp_span_u8* out) {
+  if (!r || !out || !r->buf) return LP_ERR_INVALID;
+  if (n > r->len) return LP_ERR_EMPTY;
+  *out = (lp_span_u8){ .ptr = r->buf + r->tail, .len = n };
+  return LP_OK;
+}
+
+lp_status_t lp_mirror_ring_consume(lp_mirror_ring* r, size_t n) {
+  if (!r) return LP_ERR_INVALID;
+  if (n > r->len) return LP_ERR_RANGE;
+  size_t t = r->tail + n;
+  r->tail = (t >= r->cap) ? (t - r->cap) : t;
+  r->len -= n;
+  return LP_OK;
+}
+
+lp_status_t lp_mirror_ring_push(lp_mirror_ring* r, const void* data, size_t n) {
+  if (!r || !data) return LP_ERR_INVALID;
+  if (n == 0) return LP_OK;
+
+  lp_span_u8_mut w;
+  lp_status_t st = lp_mirror_ring_reserve(r, n, &w);
+  if (st != LP_OK) return st;
+  memcpy(w.ptr, data, n);
+  return lp_mirror_ring_commit(r, n);
+}
+
+lp_status_t lp_mirror_ring_pop(lp_mirror_ring* r, void* out, size_t n) {
+  if (!r || !out) return LP_ERR_INVALID;
+  if (n == 0) return LP_OK;
+
+  lp_span_u8 rd;
+  lp_status_t st = lp_mirror_ring_peek(r, n, &rd);
+  if (st != LP_OK) return st;
+  memcpy(out, rd.ptr, n);
+  return lp_mirror_ring_consume(r, n);
+}
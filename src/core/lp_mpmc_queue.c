@@ -0,0 +1,104 @@
+#include "lp/lp_mpmc_queue.h"
+#include "lp/lp_bytes.h"
+#include <string.h>
+
+#if LP_CFG_ENABLE_ATOMICS
+
+#define LP__MPMC_HDR sizeof(lp_atomic_size)
+
+static lp_status_t lp__mpmc_stride(size_t elem_size, size_t* out) {
+  size_t n = 0;
+  lp_status_t st = lp_checked_add_size(LP__MPMC_HDR, elem_size, &n);
+  if (st != LP_OK) return st;
+  if (n > SIZE_MAX - LP__MPMC_HDR) return LP_ERR_OVERFLOW;
+  *out = lp_align_up_size(n, LP__MPMC_HDR);
+  return LP_OK;
+}
+
+static LP_INLINE lp_atomic_size* lp__mpmc_seq(const lp_mpmc_queue* q, size_t pos) {
+  return (lp_atomic_size*)(q->slots + (pos & q->mask) * q->stride);
+}
+
+lp_status_t lp_mpmc_queue_mem_size(size_t cap, size_t elem_size, size_t* out) {
+  if (!out || elem_size == 0) return LP_ERR_INVALID;
+  if (!lp_is_pow2_size(cap)) return LP_ERR_INVALID;
+
+  size_t stride = 0;
+  lp_status_t st = lp__mpmc_stride(elem_size, &stride);
+  if (st != LP_OK) return st;
+  return lp_checked_mul_size(cap, stride, out);
+}
+
+lp_status_t lp_mpmc_queue_init(lp_mpmc_queue* q, void* mem, size_t mem_size,
+                               size_t cap, size_t elem_size) {
+  if (!q || !mem) return LP_ERR_INVALID;
+  if (((uintptr_t)mem & (LP__MPMC_HDR - 1u)) != 0) return LP_ERR_INVALID;
+
+  size_t need = 0;
+  lp_status_t st = lp_mpmc_queue_mem_size(cap, elem_size, &need);
+  if (st != LP_OK) return st;
+  if (mem_size < need) return LP_ERR_NOMEM;
+
+  q->slots = (uint8_t*)mem;
+  q->elem_size = elem_size;
+  q->mask = cap - 1u;
+  (void)lp__mpmc_stride(elem_size, &q->stride);
+
+  for (size_t i = 0; i < cap; i++) {
+    lp_port_atomic_store(lp__mpmc_seq(q, i), i, LP_MO_RELAXED);
+  }
+  lp_port_atomic_store(&q->enq, (size_t)0, LP_MO_RELAXED);
+  lp_port_atomic_store(&q->deq, (size_t)0, LP_MO_RELEASE);
+  return LP_OK;
+}
+
+lp_status_t lp_mpmc_queue_push(lp_mpmc_queue* q, const void* item) {
+  if (!q || !item) return LP_ERR_INVALID;
+
+  lp_atomic_size* seq;
+  size_t pos = lp_port_atomic_load(&q->enq, LP_MO_RELAXED);
+  for (;;) {
+    seq = lp__mpmc_seq(q, pos);
+    size_t s = lp_port_atomic_load(seq, LP_MO_ACQUIRE);
+    intptr_t diff = (intptr_t)(s - pos);
+    if (diff == 0) {
+      // slot is free for this lap; claim the position
+      if (lp_port_atomic_cas_weak(&q->enq, &pos, pos + 1u, LP_MO_RELAXED, LP_MO_RELAXED)) break;
+    } else if (diff < 0) {
+      // slot still holds last lap's item
+      return LP_ERR_FULL;
+    } else {
+      pos = lp_port_atomic_load(&q->enq, LP_MO_RELAXED);
+    }
+  }
+
+  memcpy((uint8_t*)seq + LP__MPMC_HDR, item, q->elem_size);
+  lp_port_atomic_store(seq, pos + 1u, LP_MO_RELEASE);
+  return LP_OK;
+}
+
+lp_status_t lp_mpmc_queue_pop(lp_mpmc_queue* q, void* out) {
+  if (!q || !out) return LP_ERR_INVALID;
+
+  lp_atomic_size* seq;
+  size_t pos = lp_port_atomic_load(&q->deq, LP_MO_RELAXED);
+  for (;;) {
+    seq = lp__mpmc_seq(q, pos);
+    size_t s = lp_port_atomic_load(seq, LP_MO_ACQUIRE);
+    intptr_t diff = (intptr_t)(s - (pos + 1u));
+    if (diff == 0) {
+      if (lp_port_atomic_cas_weak(&q->deq, &pos, pos + 1u, LP_MO_RELAXED, LP_MO_RELAXED)) break;
+    } else if (diff < 0) {
+      return LP_ERR_EMPTY;
+    } else {
+      pos = lp_port_atomic_load(&q->deq, LP_MO_RELAXED);
+    }
+  }
+
+  memcpy(out, (const uint8_t*)seq + LP__MPMC_HDR, q->elem_size);
+  // free the slot for the producer one lap ahead
+  lp_port_atomic_store(seq, pos + q->mask + 1u, LP_MO_RELEASE);
+  return LP_OK;
+}
+
+#endif
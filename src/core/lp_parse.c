@@ -0,0 +1,534 @@
+#include "lp/lp_parse.h"
+#include "lp/lp_config.h"
+#include <string.h>
+
+/*
+  Integers: 8 digits per step (SWAR) while the value cannot overflow, then
+  one digit at a time with an exact overflow check.
+
+  Floats: the first 19 significant digits go into w, and the value is
+  w * 10^q. Three tiers:
+  1. Clinger: w <= 2^53 and |q| <= 22 need only one exact FP multiply or
+     divide.
+  2. Eisel-Lemire (D. Lemire, "Number Parsing at a Gigabyte per Second"):
+     multiply w by a 128-bit 10^q from the table shared with
+     lp_fmt_float.c. For inputs with at most 19 digits the result is always
+     correct (Mushtak & Lemire, "Fast Number Parsing Without Fallback").
+     Longer inputs are accepted when w and w + 1 round to the same double.
+  3. Otherwise: exact decimal shifting (N. Tao, "Simple Decimal
+     Conversion") over at most 800 digits. Digits beyond that only matter
+     as "nonzero tail". This tier uses ~1 KiB of stack and is only reached
+     for long inputs close to a halfway point or for tiny exponents below
+     the table.
+*/
+
+// -------------------------
+// Shared helpers
+// -------------------------
+
+static LP_INLINE lp_status_t lp__parse_done(size_t n, size_t len, size_t* consumed) {
+  if (n == 0 || (!consumed && n != len)) {
+    if (consumed) *consumed = 0;
+    return LP_ERR_INVALID;
+  }
+  if (consumed) *consumed = n;
+  return LP_OK;
+}
+
+static LP_INLINE uint64_t lp__load8_le(const char* p) {
+#if defined(LP_LITTLE_ENDIAN) && LP_LITTLE_ENDIAN
+  uint64_t v;
+  memcpy(&v, p, sizeof v);
+  return v;
+#else
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; i--) v = (v << 8) | (uint8_t)p[i];
+  return v;
+#endif
+}
+
+// All eight bytes in '0'..'9'.
+static LP_INLINE bool lp__is_8digits(uint64_t v) {
+  return (((v + 0x4646464646464646ull) | (v - 0x3030303030303030ull)) & 0x8080808080808080ull) == 0;
+}
+
+// Eight ASCII digits (first digit in the low byte) -> 0..99999999.
+static LP_INLINE uint32_t lp__parse_8digits(uint64_t v) {
+  v -= 0x3030303030303030ull;
+  v = (v * 10u) + (v >> 8);                       // pairs
+  v = (((v & 0x000000FF000000FFull) * 0x000F424000000064ull) +
+       (((v >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+  return (uint32_t)v;
+}
+
+static LP_INLINE uint32_t lp__digit(char c) { return (uint32_t)(uint8_t)c - (uint32_t)'0'; }
+
+// Largest x with x * 10^8 + 99999999 <= UINT64_MAX.
+#define LP__U64_SWAR_MAX 184467440736ull
+
+// Decimal digits at p[0..n) into *v. Returns how many digits there were;
+// *ovf is set (and *v saturated) if the value does not fit.
+static size_t lp__scan_u64(const char* p, size_t n, uint64_t* v, bool* ovf) {
+  uint64_t x = 0;
+  size_t i = 0;
+  while (n - i >= 8u && x <= LP__U64_SWAR_MAX) {
+    uint64_t c = lp__load8_le(p + i);
+    if (!lp__is_8digits(c)) break;
+    x = x * 100000000u + lp__parse_8digits(c);
+    i += 8u;
+  }
+  for (; i < n; i++) {
+    uint32_t d = lp__digit(p[i]);
+    if (d > 9u) break;
+    if (x > UINT64_MAX / 10u || (x == UINT64_MAX / 10u && d > UINT64_MAX % 10u)) {
+      while (i < n && lp__digit(p[i]) <= 9u) i++;
+      *v = UINT64_MAX;
+      *ovf = true;
+      return i;
+    }
+    x = x * 10u + d;
+  }
+  *v = x;
+  *ovf = false;
+  return i;
+}
+
+// -------------------------
+// Integers
+// -------------------------
+
+lp_status_t lp_parse_u64(lp_strview s, uint64_t* out, size_t* consumed) {
+  if (!out || (!s.ptr && s.len)) return LP_ERR_INVALID;
+  uint64_t v;
+  bool ovf;
+  size_t n = lp__scan_u64(s.ptr, s.len, &v, &ovf);
+  lp_status_t st = lp__parse_done(n, s.len, consumed);
+  if (st != LP_OK) return st;
+  *out = v;
+  return ovf ? LP_ERR_OVERFLOW : LP_OK;
+}
+
+lp_status_t lp_parse_i64(lp_strview s, int64_t* out, size_t* consumed) {
+  if (!out || (!s.ptr && s.len)) return LP_ERR_INVALID;
+  size_t i = 0;
+  bool neg = false;
+  if (s.len && (s.ptr[0] == '-' || s.ptr[0] == '+')) {
+    neg = s.ptr[0] == '-';
+    i = 1;
+  }
+  uint64_t mag;
+  bool ovf;
+  size_t n = lp__scan_u64(s.ptr + i, s.len - i, &mag, &ovf);
+  lp_status_t st = lp__parse_done(n ? i + n : 0, s.len, consumed);
+  if (st != LP_OK) return st;
+
+  uint64_t limit = neg ? (uint64_t)INT64_MAX + 1u : (uint64_t)INT64_MAX;
+  if (ovf || mag > limit) {
+    *out = neg ? INT64_MIN : INT64_MAX;
+    return LP_ERR_OVERFLOW;
+  }
+  if (neg) *out = (mag == limit) ? INT64_MIN : -(int64_t)mag;
+  else *out = (int64_t)mag;
+  return LP_OK;
+}
+
+// -------------------------
+// Floats
+// -------------------------
+
+#if LP_CFG_PARSE_FLOAT
+
+#include "lp_pow10_tab.h"
+#include <float.h>
+
+#define LP__F64_INF 0x7FF0000000000000ull
+#define LP__F64_NAN 0x7FF8000000000000ull
+
+static LP_INLINE uint32_t lp__clz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (uint32_t)__builtin_clzll(x);
+#else
+  uint32_t n = 0;
+  while (!(x & (1ull << 63))) { x <<= 1; n++; }
+  return n;
+#endif
+}
+
+// Case-insensitive match of a lowercase word at the start of p[0..n).
+static LP_INLINE bool lp__match_word(const char* p, size_t n, const char* word, size_t wn) {
+  if (n < wn) return false;
+  for (size_t i = 0; i < wn; i++) {
+    if ((p[i] | 0x20) != word[i]) return false;
+  }
+  return true;
+}
+
+// Counts a run of digits starting at p[0..n) and folds them into *w
+// (wrapping; only used when the total stays within 19 digits).
+static size_t lp__scan_digits(const char* p, size_t n, uint64_t* w) {
+  uint64_t x = *w;
+  size_t i = 0;
+  while (n - i >= 8u) {
+    uint64_t c = lp__load8_le(p + i);
+    if (!lp__is_8digits(c)) break;
+    x = x * 100000000u + lp__parse_8digits(c);
+    i += 8u;
+  }
+  for (; i < n; i++) {
+    uint32_t d = lp__digit(p[i]);
+    if (d > 9u) break;
+    x = x * 10u + d;
+  }
+  *w = x;
+  return i;
+}
+
+// Returns the IEEE bits (no sign) of w * 10^q for w != 0 and
+// LP__POW10_MIN <= q <= 308. The result is never below 1e-292, so the
+// subnormal case of the original method is not needed here.
+static uint64_t lp__eisel_lemire(uint64_t w, int32_t q) {
+  // The method's error bound assumes 10^q truncated to 128 bits, except
+  // floor + 1 for -27 <= q < 0. The shared table is floor + 1 throughout.
+  const uint64_t* g = lp__pow10_tab[q - LP__POW10_MIN];
+  uint64_t t_hi = g[0], t_lo = g[1];
+  if (q < -27 || q >= 0) {
+    t_hi -= (t_lo == 0) ? 1u : 0u;
+    t_lo -= 1u;
+  }
+
+  uint32_t lz = lp__clz64(w);
+  w <<= lz;
+  uint64_t lo;
+  uint64_t hi = lp__umul128_hi(w, t_hi, &lo);
+  if ((hi & 0x1FFu) == 0x1FFu) {
+    // the low bits might still carry into the 55 we keep
+    uint64_t lo2;
+    uint64_t hi2 = lp__umul128_hi(w, t_lo, &lo2);
+    lo += hi2;
+    if (hi2 > lo) hi++;
+  }
+
+  uint32_t upper = (uint32_t)(hi >> 63);
+  uint32_t shift = upper + 9u;
+  uint64_t m = hi >> shift;
+  // floor(q * log2(10)) + 63, rebased to the IEEE exponent bias
+  int32_t p2 = ((217706 * q) >> 16) + 63 + (int32_t)upper - (int32_t)lz + 1023;
+
+  // exact halfway in the representable range: round to even, not up
+  if (lo <= 1u && q >= -4 && q <= 23 && (m & 3u) == 1u && (m << shift) == hi) {
+    m &= ~1ull;
+  }
+  m += m & 1u;
+  m >>= 1;
+  if (m >= (2ull << 52)) {
+    m = 1ull << 52;
+    p2++;
+  }
+  if (p2 >= 0x7FF) return LP__F64_INF;
+  return (m & ((1ull << 52) - 1u)) | ((uint64_t)p2 << 52);
+}
+
+// ---- slow path: simple decimal conversion ----
+
+#define LP__DEC_CAP 800
+#define LP__DEC_MAX_SHIFT 60u
+
+typedef struct {
+  uint8_t d[LP__DEC_CAP + 20]; // digit values; slack for lp__dec_shl
+  int32_t nd;                  // digits in use
+  int32_t dp;                  // value = 0.d[0]d[1]... * 10^dp
+  bool    trunc;               // nonzero digits were dropped past LP__DEC_CAP
+} lp__decimal;
+
+static LP_INLINE void lp__dec_trim(lp__decimal* a) {
+  while (a->nd > 0 && a->d[a->nd - 1] == 0) a->nd--;
+  if (a->nd == 0) a->dp = 0;
+}
+
+static void lp__dec_shr(lp__decimal* a, uint32_t k) {
+  int32_t r = 0, w = 0;
+  uint64_t n = 0;
+  while ((n >> k) == 0) {
+    if (r >= a->nd) {
+      if (n == 0) { a->nd = 0; return; }
+      while ((n >> k) == 0) { n *= 10u; r++; }
+      break;
+    }
+    n = n * 10u + a->d[r++];
+  }
+  a->dp -= r - 1;
+
+  uint64_t mask = (1ull << k) - 1u;
+  for (; r < a->nd; r++) {
+    uint8_t c = a->d[r];
+    a->d[w++] = (uint8_t)(n >> k);
+    n = (n & mask) * 10u + c;
+  }
+  while (n > 0) {
+    uint8_t dig = (uint8_t)(n >> k);
+    n = (n & mask) * 10u;
+    if (w < LP__DEC_CAP) a->d[w++] = dig;
+    else if (dig > 0) a->trunc = true;
+  }
+  a->nd = w;
+  lp__dec_trim(a);
+}
+
+static void lp__dec_shl(lp__decimal* a, uint32_t k) {
+  // k bits add at most floor(k * log10(2)) + 1 digits; write that far out
+  // and slide back over the ones that were not needed
+  int32_t delta = (int32_t)((k * 78u) >> 8) + 1;
+  int32_t r = a->nd, w = a->nd + delta;
+  uint64_t n = 0;
+  while (r > 0) {
+    n += (uint64_t)a->d[--r] << k;
+    uint64_t quo = n / 10u;
+    a->d[--w] = (uint8_t)(n - 10u * quo);
+    n = quo;
+  }
+  while (n > 0) {
+    uint64_t quo = n / 10u;
+    a->d[--w] = (uint8_t)(n - 10u * quo);
+    n = quo;
+  }
+  int32_t nd = a->nd + delta - w;
+  memmove(a->d, a->d + w, (size_t)nd);
+  a->dp += delta - w;
+  if (nd > LP__DEC_CAP) {
+    for (int32_t i = LP__DEC_CAP; i < nd; i++) {
+      if (a->d[i]) a->trunc = true;
+    }
+    nd = LP__DEC_CAP;
+  }
+  a->nd = nd;
+  lp__dec_trim(a);
+}
+
+static void lp__dec_shift(lp__decimal* a, int32_t k) {
+  if (a->nd == 0) return;
+  if (k > 0) {
+    while (k > (int32_t)LP__DEC_MAX_SHIFT) { lp__dec_shl(a, LP__DEC_MAX_SHIFT); k -= (int32_t)LP__DEC_MAX_SHIFT; }
+    lp__dec_shl(a, (uint32_t)k);
+  } else if (k < 0) {
+    while (k < -(int32_t)LP__DEC_MAX_SHIFT) { lp__dec_shr(a, LP__DEC_MAX_SHIFT); k += (int32_t)LP__DEC_MAX_SHIFT; }
+    lp__dec_shr(a, (uint32_t)-k);
+  }
+}
+
+// Integer part rounded half-to-even (the dropped tail counts as above half
+// when trunc is set). Callers keep dp <= 20.
+static uint64_t lp__dec_round(const lp__decimal* a) {
+  uint64_t n = 0;
+  int32_t i = 0;
+  for (; i < a->dp && i < a->nd; i++) n = n * 10u + a->d[i];
+  for (; i < a->dp; i++) n *= 10u;
+  int32_t at = a->dp;
+  if (at >= 0 && at < a->nd) {
+    bool up;
+    if (a->d[at] == 5 && at + 1 == a->nd) {
+      up = a->trunc || (at > 0 && (a->d[at - 1] & 1u));
+    } else {
+      up = a->d[at] >= 5;
+    }
+    if (up) n++;
+  }
+  return n;
+}
+
+// Returns IEEE bits (no sign). Consumes a.
+static uint64_t lp__dec_to_f64(lp__decimal* a) {
+  static const uint8_t k_pow2_steps[9] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+  if (a->nd == 0 || a->dp < -330) return 0;
+  if (a->dp > 310) return LP__F64_INF;
+
+  // scale into [1/2, 1) by powers of two, tracking the binary exponent
+  int32_t e2 = 0;
+  while (a->dp > 0) {
+    int32_t n = (a->dp >= 9) ? 27 : k_pow2_steps[a->dp];
+    lp__dec_shift(a, -n);
+    e2 += n;
+  }
+  while (a->dp < 0 || (a->dp == 0 && a->d[0] < 5)) {
+    int32_t n = (-a->dp >= 9) ? 27 : k_pow2_steps[-a->dp];
+    lp__dec_shift(a, n);
+    e2 -= n;
+  }
+  e2--; // now [1, 2)
+
+  if (e2 < -1022) {
+    // subnormal: denormalize so the mantissa lines up with 2^-1074
+    int32_t n = -1022 - e2;
+    lp__dec_shift(a, -n);
+    e2 += n;
+  }
+  if (e2 + 1023 >= 0x7FF) return LP__F64_INF;
+
+  lp__dec_shift(a, 53);
+  uint64_t m = lp__dec_round(a);
+  if (m == (2ull << 52)) {
+    m >>= 1;
+    e2++;
+    if (e2 + 1023 >= 0x7FF) return LP__F64_INF;
+  }
+  if ((m & (1ull << 52)) == 0) e2 = -1023;
+  return (m & ((1ull << 52) - 1u)) | ((uint64_t)(e2 + 1023) << 52);
+}
+
+// ---- front end ----
+
+typedef struct {
+  const char* ip; size_t in; // integer digits
+  const char* fp; size_t fn; // fraction digits
+  int64_t exp;               // explicit exponent, clamped
+} lp__fnum;
+
+static uint64_t lp__slow_f64(const lp__fnum* f) {
+  lp__decimal a;
+  a.nd = 0;
+  a.trunc = false;
+  int64_t dp = (int64_t)f->in + f->exp;
+  for (size_t part = 0; part < 2; part++) {
+    const char* p = part ? f->fp : f->ip;
+    size_t n = part ? f->fn : f->in;
+    for (size_t i = 0; i < n; i++) {
+      uint8_t c = (uint8_t)lp__digit(p[i]);
+      if (c == 0 && a.nd == 0) { dp--; continue; }
+      if (a.nd < LP__DEC_CAP) a.d[a.nd++] = c;
+      else if (c) a.trunc = true;
+    }
+  }
+  if (a.nd == 0 || dp < -100000) return 0;
+  if (dp > 100000) return LP__F64_INF;
+  a.dp = (int32_t)dp;
+  lp__dec_trim(&a);
+  return lp__dec_to_f64(&a);
+}
+
+static const double lp__exact_pow10[23] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+lp_status_t lp_parse_f64(lp_strview s, double* out, size_t* consumed) {
+  if (!out || (!s.ptr && s.len)) return LP_ERR_INVALID;
+  const char* p = s.ptr;
+  size_t len = s.len, i = 0;
+  bool neg = false;
+  if (i < len && (p[i] == '-' || p[i] == '+')) {
+    neg = p[i] == '-';
+    i++;
+  }
+
+  uint64_t bits = 0;
+  lp__fnum f;
+  uint64_t w = 0;
+  f.ip = p + i;
+  f.in = lp__scan_digits(f.ip, len - i, &w);
+  i += f.in;
+  f.fp = p + i;
+  f.fn = 0;
+  if (i < len && p[i] == '.') {
+    f.fp = p + i + 1;
+    f.fn = lp__scan_digits(f.fp, len - i - 1, &w);
+    if (f.in + f.fn != 0) i += 1 + f.fn;
+  }
+
+  if (f.in + f.fn == 0) {
+    // no mantissa digits: only the special values remain
+    size_t n = 0;
+    if (lp__match_word(p + i, len - i, "infinity", 8)) {
+      n = 8; bits = LP__F64_INF;
+    } else if (lp__match_word(p + i, len - i, "inf", 3)) {
+      n = 3; bits = LP__F64_INF;
+    } else if (lp__match_word(p + i, len - i, "nan", 3)) {
+      n = 3; bits = LP__F64_NAN;
+    }
+    lp_status_t st = lp__parse_done(n ? i + n : 0, len, consumed);
+    if (st != LP_OK) return st;
+    bits |= (uint64_t)neg << 63;
+    memcpy(out, &bits, sizeof *out);
+    return LP_OK;
+  }
+
+  f.exp = 0;
+  if (i < len && (p[i] | 0x20) == 'e') {
+    size_t j = i + 1;
+    bool eneg = false;
+    if (j < len && (p[j] == '-' || p[j] == '+')) {
+      eneg = p[j] == '-';
+      j++;
+    }
+    if (j < len && lp__digit(p[j]) <= 9u) {
+      int64_t e = 0;
+      for (; j < len && lp__digit(p[j]) <= 9u; j++) {
+        if (e < 100000000) e = e * 10 + (int64_t)lp__digit(p[j]);
+      }
+      f.exp = eneg ? -e : e;
+      i = j;
+    }
+  }
+  lp_status_t st = lp__parse_done(i, len, consumed);
+  if (st != LP_OK) return st;
+
+  // significant digits, ignoring leading zeros
+  size_t lead = 0;
+  while (lead < f.in && f.ip[lead] == '0') lead++;
+  if (lead == f.in) {
+    size_t z = 0;
+    while (z < f.fn && f.fp[z] == '0') z++;
+    lead += z;
+  }
+  int64_t q = f.exp - (int64_t)f.fn;
+  bool many = f.in + f.fn - lead > 19u;
+  if (many) {
+    // keep the first 19 significant digits, exponent adjusted for the rest
+    w = 0;
+    size_t k = 0;
+    while (w < 1000000000000000000ull && k < f.in) w = w * 10u + lp__digit(f.ip[k++]);
+    if (w >= 1000000000000000000ull) {
+      q = f.exp + (int64_t)(f.in - k);
+    } else {
+      k = 0;
+      while (w < 1000000000000000000ull && k < f.fn) w = w * 10u + lp__digit(f.fp[k++]);
+      q = f.exp - (int64_t)k;
+    }
+  }
+
+  if (w == 0 || q < LP__POW10_MIN - 50) {
+    // below half the smallest subnormal even with 19 digits (or zero)
+    bits = 0;
+  } else if (q > 308) {
+    bits = LP__F64_INF;
+  } else {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    if (!many && q >= -22 && q <= 22 && w <= (1ull << 53)) {
+      double d = (double)w;
+      d = (q < 0) ? d / lp__exact_pow10[-q] : d * lp__exact_pow10[q];
+      if (neg) d = -d;
+      *out = d;
+      return LP_OK;
+    }
+#endif
+    if (q < LP__POW10_MIN) {
+      bits = lp__slow_f64(&f);
+    } else {
+      bits = lp__eisel_lemire(w, (int32_t)q);
+      if (many && bits != lp__eisel_lemire(w + 1u, (int32_t)q)) bits = lp__slow_f64(&f);
+    }
+  }
+
+  bits |= (uint64_t)neg << 63;
+  memcpy(out, &bits, sizeof *out);
+  return ((bits & LP__F64_INF) == LP__F64_INF) ? LP_ERR_OVERFLOW : LP_OK;
+}
+
+#else // !LP_CFG_PARSE_FLOAT
+
+lp_status_t lp_parse_f64(lp_strview s, double* out, size_t* consumed) {
+  LP_UNUSED(s);
+  LP_UNUSED(out);
+  if (consumed) *consumed = 0;
+  return LP_ERR_UNSUP;
+}
+
+#endif // LP_CFG_PARSE_FLOAT
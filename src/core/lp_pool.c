@@ -0,0 +1,240 @@
+#include "lp/lp_pool.h"
+#include "lp/lp_bytes.h"
+#include <string.h>
+
+#define LP__POOL_FREE_TAG ((uintptr_t)0x5AFEF4EEu)
+#define LP__POOL_POISON   0xDDu
+#define LP__POOL_FRESH    0xCDu
+
+// Round obj_size up so every slot can hold `min` bytes and stays aligned.
+// *align is raised to at least pointer alignment.
+static lp_status_t lp__pool_stride(size_t obj_size, size_t* align, size_t min, size_t* out) {
+  if (obj_size == 0) return LP_ERR_INVALID;
+  if (*align == 0) *align = 1;
+  if (!lp_is_pow2_size(*align)) return LP_ERR_INVALID;
+  if (*align < _Alignof(void*)) *align = _Alignof(void*);
+
+  size_t n = (obj_size < min) ? min : obj_size;
+  if (n > SIZE_MAX - *align) return LP_ERR_OVERFLOW;
+  *out = lp_align_up_size(n, *align);
+  return LP_OK;
+}
+
+// Objects that fit in [mem, mem + mem_size) once the start is aligned.
+static lp_status_t lp__pool_carve(void* mem, size_t mem_size, size_t stride, size_t align,
+                                  uint8_t** base, size_t* count) {
+  size_t pad = (size_t)(0u - (uintptr_t)mem) & (align - 1u);
+  if (pad >= mem_size) return LP_ERR_NOMEM;
+  *count = (mem_size - pad) / stride;
+  if (*count == 0) return LP_ERR_NOMEM;
+  *base = (uint8_t*)mem + pad;
+  return LP_OK;
+}
+
+// -------------------------
+// Single-threaded pool
+// -------------------------
+
+static void lp__pool_setup(lp_pool* p, uint8_t* mem, size_t stride, size_t count) {
+  p->mem = mem;
+  p->stride = stride;
+  p->count = count;
+  p->free_list = NULL;
+  p->live = 0;
+  p->high_water = 0;
+#if LP_CFG_ALLOC_STATS
+  p->stats = (lp_alloc_stats){ 0 };
+#endif
+
+  // link back to front so allocation walks memory in address order
+  for (size_t i = count; i-- > 0;) {
+    lp_pool_node* n = (lp_pool_node*)(mem + i * stride);
+    n->next = p->free_list;
+#if LP_CFG_DEBUG
+    n->tag = (uintptr_t)n->next ^ LP__POOL_FREE_TAG;
+    memset(n + 1, LP__POOL_POISON, stride - sizeof(*n));
+#endif
+    p->free_list = n;
+  }
+}
+
+lp_status_t lp_pool_init(lp_pool* p, void* mem, size_t mem_size, size_t obj_size, size_t align) {
+  if (!p || !mem) return LP_ERR_INVALID;
+
+  size_t stride = 0;
+  lp_status_t st = lp__pool_stride(obj_size, &align, sizeof(lp_pool_node), &stride);
+  if (st != LP_OK) return st;
+
+  uint8_t* base = NULL;
+  size_t count = 0;
+  st = lp__pool_carve(mem, mem_size, stride, align, &base, &count);
+  if (st != LP_OK) return st;
+
+  lp__pool_setup(p, base, stride, count);
+#if LP_CFG_ALLOC_STATS
+  p->obj_size = obj_size;
+#endif
+  return LP_OK;
+}
+
+lp_status_t lp_pool_init_arena(lp_pool* p, lp_arena* a, size_t count, size_t obj_size, size_t align) {
+  if (!p || !a || count == 0) return LP_ERR_INVALID;
+
+  size_t stride = 0;
+  lp_status_t st = lp__pool_stride(obj_size, &align, sizeof(lp_pool_node), &stride);
+  if (st != LP_OK) return st;
+
+  size_t bytes = 0;
+  st = lp_checked_mul_size(count, stride, &bytes);
+  if (st != LP_OK) return st;
+
+  void* mem = NULL;
+  st = lp_arena_alloc(a, bytes, align, &mem);
+  if (st != LP_OK) return st;
+
+  lp__pool_setup(p, (uint8_t*)mem, stride, count);
+#if LP_CFG_ALLOC_STATS
+  p->obj_size = obj_size;
+#endif
+  return LP_OK;
+}
+
+lp_status_t lp_pool_alloc(lp_pool* p, void** out) {
+  if (!p || !out) return LP_ERR_INVALID;
+
+  lp_pool_node* n = p->free_list;
+  if (!n) {
+#if LP_CFG_ALLOC_STATS
+    lp_alloc_stats_miss(&p->stats);
+#endif
+    return LP_ERR_NOMEM;
+  }
+  p->free_list = n->next;
+
+#if LP_CFG_DEBUG
+  // a write after free shows up as a damaged tag or poison
+  LP_ASSERT(n->tag == ((uintptr_t)n->next ^ LP__POOL_FREE_TAG));
+  const uint8_t* body = (const uint8_t*)(n + 1);
+  for (size_t i = 0; i < p->stride - sizeof(*n); i++) LP_ASSERT(body[i] == LP__POOL_POISON);
+  memset(n, LP__POOL_FRESH, p->stride);
+#endif
+
+  if (++p->live > p->high_water) p->high_water = p->live;
+#if LP_CFG_ALLOC_STATS
+  lp_alloc_stats_hit(&p->stats, p->obj_size, p->stride - p->obj_size, p->live * p->stride);
+#endif
+  *out = n;
+  return LP_OK;
+}
+
+#if LP_CFG_DEBUG
+static bool lp__pool_on_free_list(const lp_pool* p, const lp_pool_node* n) {
+  for (const lp_pool_node* it = p->free_list; it; it = it->next) {
+    if (it == n) return true;
+  }
+  return false;
+}
+#endif
+
+lp_status_t lp_pool_free(lp_pool* p, void* obj) {
+  if (!p || !obj) return LP_ERR_INVALID;
+
+  uint8_t* b = (uint8_t*)obj;
+  if (b < p->mem || b >= p->mem + p->count * p->stride) return LP_ERR_INVALID;
+
+  lp_pool_node* n = (lp_pool_node*)obj;
+#if LP_CFG_DEBUG
+  if ((size_t)(b - p->mem) % p->stride != 0) return LP_ERR_INVALID;
+  // tag match is only a hint (user data may collide); confirm by walking
+  if (n->tag == ((uintptr_t)n->next ^ LP__POOL_FREE_TAG) && lp__pool_on_free_list(p, n)) {
+    return LP_ERR_INVALID;
+  }
+#endif
+
+  LP_ASSERT(p->live > 0);
+  n->next = p->free_list;
+#if LP_CFG_DEBUG
+  n->tag = (uintptr_t)n->next ^ LP__POOL_FREE_TAG;
+  memset(n + 1, LP__POOL_POISON, p->stride - sizeof(*n));
+#endif
+  p->free_list = n;
+  p->live--;
+  return LP_OK;
+}
+
+// -------------------------
+// Thread-safe pool
+// -------------------------
+
+#if LP_CFG_ENABLE_ATOMICS
+
+// Free objects store the 1-based index of the next free object (0 = end).
+static LP_INLINE uint32_t* lp__pool_mt_link(const lp_pool_mt* p, uint32_t idx) {
+  return (uint32_t*)(p->mem + (size_t)idx * p->stride);
+}
+
+lp_status_t lp_pool_mt_init(lp_pool_mt* p, void* mem, size_t mem_size, size_t obj_size, size_t align) {
+  if (!p || !mem) return LP_ERR_INVALID;
+
+  size_t stride = 0;
+  lp_status_t st = lp__pool_stride(obj_size, &align, sizeof(uint32_t), &stride);
+  if (st != LP_OK) return st;
+
+  uint8_t* base = NULL;
+  size_t count = 0;
+  st = lp__pool_carve(mem, mem_size, stride, align, &base, &count);
+  if (st != LP_OK) return st;
+  if (count > UINT32_MAX - 1u) count = UINT32_MAX - 1u;
+
+  p->mem = base;
+  p->stride = stride;
+  p->count = (uint32_t)count;
+  for (uint32_t i = 0; i < p->count; i++) {
+    uint32_t next = (i + 1u < p->count) ? (i + 2u) : 0u;
+    lp_port_atomic_store(lp__pool_mt_link(p, i), next, LP_MO_RELAXED);
+  }
+  lp_port_atomic_store(&p->head, (uint64_t)1u, LP_MO_RELEASE);
+  return LP_OK;
+}
+
+lp_status_t lp_pool_mt_alloc(lp_pool_mt* p, void** out) {
+  if (!p || !out) return LP_ERR_INVALID;
+
+  uint64_t head = lp_port_atomic_load(&p->head, LP_MO_ACQUIRE);
+  for (;;) {
+    uint32_t top = (uint32_t)head;
+    if (top == 0) return LP_ERR_NOMEM;
+
+    // may read a link that another thread is rewriting; the tag makes the
+    // CAS below fail in that case
+    uint32_t next = lp_port_atomic_load(lp__pool_mt_link(p, top - 1u), LP_MO_RELAXED);
+    uint64_t tag = (head >> 32) + 1u;
+    uint64_t want = (tag << 32) | next;
+    if (lp_port_atomic_cas_weak(&p->head, &head, want, LP_MO_ACQUIRE, LP_MO_ACQUIRE)) {
+      *out = lp__pool_mt_link(p, top - 1u);
+      return LP_OK;
+    }
+  }
+}
+
+lp_status_t lp_pool_mt_free(lp_pool_mt* p, void* obj) {
+  if (!p || !obj) return LP_ERR_INVALID;
+
+  uint8_t* b = (uint8_t*)obj;
+  if (b < p->mem || b >= p->mem + (size_t)p->count * p->stride) return LP_ERR_INVALID;
+  size_t idx = (size_t)(b - p->mem) / p->stride;
+#if LP_CFG_DEBUG
+  if (idx * p->stride != (size_t)(b - p->mem)) return LP_ERR_INVALID;
+#endif
+
+  uint64_t head = lp_port_atomic_load(&p->head, LP_MO_RELAXED);
+  for (;;) {
+    lp_port_atomic_store((uint32_t*)obj, (uint32_t)head, LP_MO_RELAXED);
+    uint64_t want = (head & 0xFFFFFFFF00000000ull) | (uint64_t)(idx + 1u);
+    if (lp_port_atomic_cas_weak(&p->head, &head, want, LP_MO_RELEASE, LP_MO_RELAXED)) {
+      return LP_OK;
+    }
+  }
+}
+
+#endif // LP_CFG_ENABLE_ATOMICS
@@ -0,0 +1,17 @@
+#pragma once
+#include "lp/lp_platform.h"
+#include "lp_u128.h"
+
+/*
+  Private: 128-bit powers of ten shared by float formatting (Schubfach)
+  and float parsing (Eisel-Lemire).
+
+  Entry k - LP__POW10_MIN is g = floor(10^k * 2^(127 - e)) + 1 with
+  e = floor(log2(10^k)), stored as { hi, lo } (2^127 <= g < 2^128).
+  Only linked in when one of the users references it.
+*/
+
+#define LP__POW10_MIN (-292)
+#define LP__POW10_MAX 324
+
+extern const uint64_t lp__pow10_tab[LP__POW10_MAX - LP__POW10_MIN + 1][2];
@@ -0,0 +1,82 @@
+#include "lp/lp_prof.h"
+
+#if LP_CFG_ENABLE_PROF
+
+static lp_prof_thread lp__prof_threads[LP_CFG_PROF_MAX_THREADS];
+static lp_prof_thread lp__prof_spare; // shared by threads past the limit, never reported
+static lp_atomic_size lp__prof_names[LP_CFG_PROF_MAX_PROBES]; // const char*, 0 until published
+static lp_atomic_size lp__prof_nprobes;  // slots claimed (may overshoot)
+static lp_atomic_size lp__prof_nthreads; // same
+static lp_atomic_size lp__prof_lost_probes;
+static lp_atomic_size lp__prof_lost_threads;
+
+LP_PORT_THREAD_LOCAL lp_prof_thread* lp__prof_self;
+
+static size_t lp__prof_register(lp_prof_probe* p) {
+  size_t idx = lp_port_atomic_fetch_add(&lp__prof_nprobes, (size_t)1, LP_MO_RELAXED);
+  size_t id = (idx < LP_CFG_PROF_MAX_PROBES) ? idx + 1u : LP__PROF_FULL;
+  size_t expected = 0;
+  while (!lp_port_atomic_cas_weak(&p->id, &expected, id, LP_MO_RELAXED, LP_MO_RELAXED)) {
+    // another thread registered the same site first: its id wins, and the
+    // slot claimed here stays unnamed
+    if (expected != 0) return expected;
+  }
+  if (id == LP__PROF_FULL) {
+    lp_port_atomic_fetch_add(&lp__prof_lost_probes, (size_t)1, LP_MO_RELAXED);
+  } else {
+    lp_port_atomic_store(&lp__prof_names[idx], (size_t)(uintptr_t)p->name, LP_MO_RELEASE);
+  }
+  return id;
+}
+
+static lp_prof_thread* lp__prof_attach(void) {
+  size_t idx = lp_port_atomic_fetch_add(&lp__prof_nthreads, (size_t)1, LP_MO_RELAXED);
+  if (idx < LP_CFG_PROF_MAX_THREADS) {
+    lp__prof_self = &lp__prof_threads[idx];
+  } else {
+    lp_port_atomic_fetch_add(&lp__prof_lost_threads, (size_t)1, LP_MO_RELAXED);
+    lp__prof_self = &lp__prof_spare;
+  }
+  return lp__prof_self;
+}
+
+void lp__prof_add_slow(lp_prof_probe* p, uint64_t dt) {
+  size_t id = lp_port_atomic_load(&p->id, LP_MO_RELAXED);
+  if (id == 0) id = lp__prof_register(p);
+  if (id == LP__PROF_FULL) return;
+  if (!lp__prof_self) (void)lp__prof_attach();
+  lp__prof_add(p, dt); // both registered now: the fast path
+}
+
+static LP_INLINE size_t lp__prof_min(size_t a, size_t b) { return a < b ? a : b; }
+
+size_t lp_prof_snapshot(lp_prof_stat* out, size_t cap) {
+  if (!out) return 0;
+  size_t np = lp__prof_min(lp_port_atomic_load(&lp__prof_nprobes, LP_MO_ACQUIRE), LP_CFG_PROF_MAX_PROBES);
+  size_t nt = lp__prof_min(lp_port_atomic_load(&lp__prof_nthreads, LP_MO_ACQUIRE), LP_CFG_PROF_MAX_THREADS);
+  size_t n = 0;
+  for (size_t i = 0; i < np && n < cap; i++) {
+    const char* name = (const char*)(uintptr_t)lp_port_atomic_load(&lp__prof_names[i], LP_MO_ACQUIRE);
+    if (!name) continue;
+    lp_prof_stat st = { name, 0, 0, 0 };
+    for (size_t t = 0; t < nt; t++) {
+      const lp_prof_counter* c = &lp__prof_threads[t].c[i];
+      st.calls += lp_port_atomic_load(&c->calls, LP_MO_RELAXED);
+      st.cycles += lp_port_atomic_load(&c->cycles, LP_MO_RELAXED);
+      uint64_t m = lp_port_atomic_load(&c->max, LP_MO_RELAXED);
+      if (m > st.max_cycles) st.max_cycles = m;
+    }
+    if (st.calls) out[n++] = st;
+  }
+  return n;
+}
+
+size_t lp_prof_dropped_threads(void) {
+  return lp_port_atomic_load(&lp__prof_lost_threads, LP_MO_RELAXED);
+}
+
+size_t lp_prof_dropped_probes(void) {
+  return lp_port_atomic_load(&lp__prof_lost_probes, LP_MO_RELAXED);
+}
+
+#endif
@@ -2,41 +2,83 @@
 #include <string.h>
 
 static void lp__ring_advance(lp_ring* r, size_t* idx, size_t n) {
-  *idx = (*idx + n) % r->cap;
+  // n <= cap, so one conditional subtract replaces the modulo
+  size_t i = *idx + n;
+  if (i >= r->cap) i -= r->cap;
+  *idx = i;
 }
 
-lp_status_t lp_ring_push(lp_ring* r, const void* data, size_t n) {
-  if (!r || !data) return LP_ERR_INVALID;
-  if (n == 0) return LP_OK;
-  if (r->cap == 0) return LP_ERR_RANGE;
+// Split [idx, idx + n) into the part before the end and the wrapped rest.
+static LP_INLINE size_t lp__ring_first(const lp_ring* r, size_t idx, size_t n) {
+  size_t first = r->cap - idx;
+  return (first > n) ? n : first;
+}
+
+lp_status_t lp_ring_reserve(lp_ring* r, size_t n, lp_span_u8_mut seg[2]) {
+  if (!r || !seg) return LP_ERR_INVALID;
   if (n > lp_ring_free(r)) return LP_ERR_FULL;
 
-  const uint8_t* src = (const uint8_t*)data;
-  size_t first = r->cap - r->head;
-  if (first > n) first = n;
+  size_t first = lp__ring_first(r, r->head, n);
+  seg[0] = (lp_span_u8_mut){ .ptr = r->buf + r->head, .len = first };
+  seg[1] = (lp_span_u8_mut){ .ptr = r->buf,           .len = n - first };
+  return LP_OK;
+}
 
-  memcpy(&r->buf[r->head], src, first);
-  memcpy(&r->buf[0], src + first, n - first);
+lp_status_t lp_ring_commit(lp_ring* r, size_t n) {
+  if (!r) return LP_ERR_INVALID;
+  if (n == 0) return LP_OK;
+  if (n > lp_ring_free(r)) return LP_ERR_RANGE;
 
   lp__ring_advance(r, &r->head, n);
   r->full = (r->head == r->tail);
   return LP_OK;
 }
 
-lp_status_t lp_ring_pop(lp_ring* r, void* out, size_t n) {
-  if (!r || !out) return LP_ERR_INVALID;
-  if (n == 0) return LP_OK;
+lp_status_t lp_ring_peek(const lp_ring* r, size_t n, lp_span_u8 seg[2]) {
+  if (!r || !seg) return LP_ERR_INVALID;
   if (n > lp_ring_len(r)) return LP_ERR_EMPTY;
 
-  uint8_t* dst = (uint8_t*)out;
-  size_t first = r->cap - r->tail;
-  if (first > n) first = n;
+  size_t first = lp__ring_first(r, r->tail, n);
+  seg[0] = (lp_span_u8){ .ptr = r->buf + r->tail, .len = first };
+  seg[1] = (lp_span_u8){ .ptr = r->buf,           .len = n - first };
+  return LP_OK;
+}
 
-  memcpy(dst, &r->buf[r->tail], first);
-  memcpy(dst + first, &r->buf[0], n - first);
+lp_status_t lp_ring_consume(lp_ring* r, size_t n) {
+  if (!r) return LP_ERR_INVALID;
+  if (n == 0) return LP_OK;
+  if (n > lp_ring_len(r)) return LP_ERR_RANGE;
 
   lp__ring_advance(r, &r->tail, n);
   r->full = false;
   return LP_OK;
 }
 
+lp_status_t lp_ring_push(lp_ring* r, const void* data, size_t n) {
+  if (!r || !data) return LP_ERR_INVALID;
+  if (n == 0) return LP_OK;
+  if (r->cap == 0) return LP_ERR_RANGE;
+
+  lp_span_u8_mut seg[2];
+  lp_status_t st = lp_ring_reserve(r, n, seg);
+  if (st != LP_OK) return st;
+
+  const uint8_t* src = (const uint8_t*)data;
+  memcpy(seg[0].ptr, src, seg[0].len);
+  memcpy(seg[1].ptr, src + seg[0].len, seg[1].len);
+  return lp_ring_commit(r, n);
+}
+
+lp_status_t lp_ring_pop(lp_ring* r, void* out, size_t n) {
+  if (!r || !out) return LP_ERR_INVALID;
+  if (n == 0) return LP_OK;
+
+  lp_span_u8 seg[2];
+  lp_status_t st = lp_ring_peek(r, n, seg);
+  if (st != LP_OK) return st;
+
+  uint8_t* dst = (uint8_t*)out;
+  memcpy(dst, seg[0].ptr, seg[0].len);
+  memcpy(dst + seg[0].len, seg[1].ptr, seg[1].len);
+  return lp_ring_consume(r, n);
+}
@@ -0,0 +1,146 @@
+#include "lp/lp_scratch.h"
+#include "lp/lp_bytes.h"
+
+#if LP_CFG_ENABLE_ATOMICS
+
+// Each block starts with a link to the next block this thread owns.
+typedef struct lp__scratch_blk lp__scratch_blk;
+struct lp__scratch_blk {
+  lp__scratch_blk* next;
+};
+
+typedef struct {
+  const lp_scratch* owner;
+  size_t            epoch;
+  lp__scratch_blk*  head; // first block this thread claimed
+  lp__scratch_blk*  cur;  // NULL until the first claim
+  size_t            off;  // bytes used in cur (after the header)
+} lp__scratch_tls;
+
+static LP_PORT_THREAD_LOCAL lp__scratch_tls lp__scratch_self;
+
+// Epochs come from one process-wide counter, so re-initialising a scratch
+// (even at the same address) never matches state cached for an older one.
+static lp_atomic_size lp__scratch_gen;
+
+static LP_INLINE size_t lp__scratch_new_epoch(void) {
+  return lp_port_atomic_fetch_add(&lp__scratch_gen, (size_t)1, LP_MO_RELAXED) + 1u;
+}
+
+lp_status_t lp_scratch_init(lp_scratch* s, void* mem, size_t cap, size_t block) {
+  if (!s || !mem) return LP_ERR_INVALID;
+  if (block <= sizeof(lp__scratch_blk)) return LP_ERR_INVALID;
+
+  // keep block headers pointer-aligned
+  uint8_t* base = (uint8_t*)mem;
+  size_t pad = (size_t)(0u - (uintptr_t)base) & (_Alignof(lp__scratch_blk) - 1u);
+  if (pad >= cap) return LP_ERR_NOMEM;
+  block = lp_align_up_size(block, _Alignof(lp__scratch_blk));
+
+  s->mem = base + pad;
+  s->cap = cap - pad;
+  s->block = block;
+  lp_port_atomic_store(&s->next, (size_t)0, LP_MO_RELAXED);
+  lp_port_atomic_store(&s->epoch, lp__scratch_new_epoch(), LP_MO_RELEASE);
+  return LP_OK;
+}
+
+void lp_scratch_reset(lp_scratch* s) {
+  if (!s) return;
+  lp_port_atomic_store(&s->next, (size_t)0, LP_MO_RELAXED);
+  lp_port_atomic_store(&s->epoch, lp__scratch_new_epoch(), LP_MO_RELEASE);
+}
+
+static LP_INLINE lp__scratch_tls* lp__scratch_bind(lp_scratch* s) {
+  lp__scratch_tls* t = &lp__scratch_self;
+  size_t epoch = lp_port_atomic_load(&s->epoch, LP_MO_RELAXED);
+  if (LP_UNLIKELY(t->owner != s || t->epoch != epoch)) {
+    t->owner = s;
+    t->epoch = epoch;
+    t->head = NULL;
+    t->cur = NULL;
+    t->off = 0;
+  }
+  return t;
+}
+
+static LP_INLINE size_t lp__scratch_usable(const lp_scratch* s) {
+  return s->block - sizeof(lp__scratch_blk);
+}
+
+// Same rule as lp_arena: align the address, not the offset.
+static LP_INLINE bool lp__scratch_fit(const lp_scratch* s, lp__scratch_tls* t,
+                                      size_t size, size_t align, void** out) {
+  uint8_t* data = (uint8_t*)(t->cur + 1);
+  size_t usable = lp__scratch_usable(s);
+  size_t pad = (size_t)(0u - (uintptr_t)(data + t->off)) & (align - 1u);
+  if (pad > usable - t->off || size > usable - t->off - pad) return false;
+  *out = data + t->off + pad;
+  t->off += pad + size;
+  return true;
+}
+
+// Move to this thread's next block, claiming a new one if it has none.
+static lp_status_t lp__scratch_next_block(lp_scratch* s, lp__scratch_tls* t) {
+  if (t->cur && t->cur->next) {
+    t->cur = t->cur->next;
+    t->off = 0;
+    return LP_OK;
+  }
+
+  // CAS rather than fetch-add: failed claims must not push `next` on
+  // past cap, where a 32-bit size_t would eventually wrap.
+  size_t at = lp_port_atomic_load(&s->next, LP_MO_RELAXED);
+  do {
+    if (at > s->cap || s->block > s->cap - at) return LP_ERR_NOMEM;
+  } while (!lp_port_atomic_cas_weak(&s->next, &at, at + s->block, LP_MO_RELAXED, LP_MO_RELAXED));
+
+  lp__scratch_blk* b = (lp__scratch_blk*)(s->mem + at);
+  b->next = NULL;
+  if (t->cur) t->cur->next = b;
+  else t->head = b;
+  t->cur = b;
+  t->off = 0;
+  return LP_OK;
+}
+
+lp_status_t lp_scratch_alloc(lp_scratch* s, size_t size, size_t align, void** out) {
+  if (!s || !out) return LP_ERR_INVALID;
+  if (size == 0) { *out = NULL; return LP_OK; }
+  if (align == 0) align = 1;
+  if (!lp_is_pow2_size(align)) return LP_ERR_INVALID;
+
+  lp__scratch_tls* t = lp__scratch_bind(s);
+  if (LP_LIKELY(t->cur != NULL) && lp__scratch_fit(s, t, size, align, out)) return LP_OK;
+
+  // worst-case padding must still fit in an empty block
+  if (size > lp__scratch_usable(s) || align - 1u > lp__scratch_usable(s) - size) return LP_ERR_RANGE;
+
+  for (;;) {
+    lp_status_t st = lp__scratch_next_block(s, t);
+    if (st != LP_OK) return st;
+    if (lp__scratch_fit(s, t, size, align, out)) return LP_OK;
+  }
+}
+
+lp_arena_pos lp_scratch_mark(lp_scratch* s) {
+  LP_ASSERT(s);
+  lp__scratch_tls* t = lp__scratch_bind(s);
+  return (lp_arena_pos){ .block = t->cur, .off = t->off };
+}
+
+void lp_scratch_rewind(lp_scratch* s, lp_arena_pos pos) {
+  LP_ASSERT(s);
+  lp__scratch_tls* t = lp__scratch_bind(s);
+  if (!pos.block) {
+    // marked before the first claim: restart at the head block, if any
+    t->cur = t->head;
+    t->off = 0;
+    return;
+  }
+  LP_ASSERT(pos.off <= lp__scratch_usable(s));
+  t->cur = (lp__scratch_blk*)pos.block;
+  t->off = pos.off;
+}
+
+#endif // LP_CFG_ENABLE_ATOMICS
@@ -0,0 +1,67 @@
+#include "lp/lp_spsc_ring.h"
+#include "lp/lp_bytes.h"
+#include <string.h>
+
+#if LP_CFG_ENABLE_ATOMICS
+
+lp_status_t lp_spsc_ring_init(lp_spsc_ring* r, void* mem, size_t cap) {
+  if (!r || !mem) return LP_ERR_INVALID;
+  if (!lp_is_pow2_size(cap)) return LP_ERR_INVALID;
+
+  r->buf  = (uint8_t*)mem;
+  r->cap  = cap;
+  r->mask = cap - 1u;
+  r->tail_cache = 0;
+  r->head_cache = 0;
+  lp_port_atomic_store(&r->head, (size_t)0, LP_MO_RELAXED);
+  lp_port_atomic_store(&r->tail, (size_t)0, LP_MO_RELAXED);
+  return LP_OK;
+}
+
+lp_status_t lp_spsc_ring_push(lp_spsc_ring* r, const void* data, size_t n) {
+  if (!r || !data) return LP_ERR_INVALID;
+  if (n == 0) return LP_OK;
+
+  size_t head = lp_port_atomic_load(&r->head, LP_MO_RELAXED);
+  if (r->cap - (head - r->tail_cache) < n) {
+    r->tail_cache = lp_port_atomic_load(&r->tail, LP_MO_ACQUIRE);
+    if (r->cap - (head - r->tail_cache) < n) return LP_ERR_FULL;
+  }
+
+  const uint8_t* src = (const uint8_t*)data;
+  size_t idx = head & r->mask;
+  size_t first = r->cap - idx;
+  if (first > n) first = n;
+
+  memcpy(&r->buf[idx], src, first);
+  memcpy(&r->buf[0], src + first, n - first);
+
+  // publish the bytes before the new head
+  lp_port_atomic_store(&r->head, head + n, LP_MO_RELEASE);
+  return LP_OK;
+}
+
+lp_status_t lp_spsc_ring_pop(lp_spsc_ring* r, void* out, size_t n) {
+  if (!r || !out) return LP_ERR_INVALID;
+  if (n == 0) return LP_OK;
+
+  size_t tail = lp_port_atomic_load(&r->tail, LP_MO_RELAXED);
+  if (r->head_cache - tail < n) {
+    r->head_cache = lp_port_atomic_load(&r->head, LP_MO_ACQUIRE);
+    if (r->head_cache - tail < n) return LP_ERR_EMPTY;
+  }
+
+  uint8_t* dst = (uint8_t*)out;
+  size_t idx = tail & r->mask;
+  size_t first = r->cap - idx;
+  if (first > n) first = n;
+
+  memcpy(dst, &r->buf[idx], first);
+  memcpy(dst + first, &r->buf[0], n - first);
+
+  // hand the slots back only after the copy-out is done
+  lp_port_atomic_store(&r->tail, tail + n, LP_MO_RELEASE);
+  return LP_OK;
+}
+
+#endif
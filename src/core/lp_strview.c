@@ -0,0 +1,457 @@
+#include "lp/lp_strview.h"
+#include "lp/lp_config.h"
+#include "lp_cpu.h"
+#include <string.h>
+
+/*
+  Search and compare over views. Every function has a SWAR path (8 bytes
+  per step, any target) and, on x86, SSE2 kernels (baseline on x86-64, so
+  no dispatch) plus AVX2 kernels for long inputs, picked at runtime. The
+  SIMD kernels take the whole input when it is at least one vector wide
+  and finish with an overlapping last load instead of a scalar tail.
+*/
+
+#if LP_CFG_ENABLE_SIMD && LP__CPU_X86 && defined(__SSE2__)
+  #define LP__SV_X86 1
+  #define LP__TARGET_SSSE3 __attribute__((target("ssse3")))
+  #define LP__TARGET_AVX2  __attribute__((target("avx2")))
+  // below this the AVX2 setup costs more than it saves
+  #define LP__SV_AVX2_MIN 64u
+#endif
+
+#if defined(__has_feature)
+  #if __has_feature(address_sanitizer)
+    #define LP__SV_ASAN 1
+  #endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(LP__SV_ASAN)
+  // lp_cstr_len reads the whole aligned word that holds the NUL
+  #define LP__NO_ASAN __attribute__((no_sanitize_address))
+#else
+  #define LP__NO_ASAN
+#endif
+
+#define LP__ONES  0x0101010101010101ull
+#define LP__HIGHS 0x8080808080808080ull
+#define LP__LOWS7 0x7F7F7F7F7F7F7F7Full
+
+static LP_INLINE uint64_t lp__load8_le(const uint8_t* p) {
+#if defined(LP_LITTLE_ENDIAN) && LP_LITTLE_ENDIAN
+  uint64_t v;
+  memcpy(&v, p, sizeof v);
+  return v;
+#else
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+  return v;
+#endif
+}
+
+static LP_INLINE uint32_t lp__ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (uint32_t)__builtin_ctzll(x);
+#else
+  uint32_t n = 0;
+  while (!(x & 1u)) { x >>= 1; n++; }
+  return n;
+#endif
+}
+
+// 0x80 in exactly the bytes of v that are zero.
+static LP_INLINE uint64_t lp__zero_bytes(uint64_t v) {
+  return ~(((v & LP__LOWS7) + LP__LOWS7) | v | LP__LOWS7);
+}
+
+// ASCII 'A'..'Z' -> 'a'..'z' in all eight bytes.
+static LP_INLINE uint64_t lp__fold8(uint64_t v) {
+  uint64_t h = v & LP__LOWS7;
+  uint64_t ge_a = h + (0x80u - 'A') * LP__ONES;
+  uint64_t gt_z = h + (0x80u - 'Z' - 1u) * LP__ONES;
+  uint64_t upper = (ge_a ^ gt_z) & ~v & LP__HIGHS;
+  return v | (upper >> 2);
+}
+
+static LP_INLINE uint8_t lp__fold1(uint8_t c) {
+  return (uint8_t)((c >= 'A' && c <= 'Z') ? c | 0x20u : c);
+}
+
+// -------------------------
+// Kernels: x86
+// -------------------------
+
+#if LP__SV_X86
+
+static LP_INLINE uint32_t lp__ctz32(uint32_t x) { return (uint32_t)__builtin_ctz(x); }
+
+static size_t lp__find_char_sse2(const uint8_t* p, size_t n, uint8_t c) {
+  const __m128i vc = _mm_set1_epi8((char)c);
+  size_t i = 0;
+  for (; i + 16u <= n; i += 16u) {
+    uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + i)), vc));
+    if (m) return i + lp__ctz32(m);
+  }
+  if (i < n) {
+    i = n - 16u;
+    uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + i)), vc));
+    if (m) return i + lp__ctz32(m);
+  }
+  return LP_SV_NPOS;
+}
+
+LP__TARGET_AVX2
+static size_t lp__find_char_avx2(const uint8_t* p, size_t n, uint8_t c) {
+  const __m256i vc = _mm256_set1_epi8((char)c);
+  size_t i = 0;
+  for (; i + 64u <= n; i += 64u) {
+    __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i)), vc);
+    __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i + 32u)), vc);
+    if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+      uint64_t m = (uint32_t)_mm256_movemask_epi8(a) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(b) << 32);
+      return i + lp__ctz64(m);
+    }
+  }
+  for (; i + 32u <= n; i += 32u) {
+    uint32_t m = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i)), vc));
+    if (m) return i + lp__ctz32(m);
+  }
+  if (i < n) {
+    i = n - 32u;
+    uint32_t m = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i)), vc));
+    if (m) return i + lp__ctz32(m);
+  }
+  return LP_SV_NPOS;
+}
+
+// Bytes of v in the set: nib holds bit (c >> 4) at index (c & 15); high
+// nibbles 8..15 map to 0, so non-ASCII bytes never match.
+LP__TARGET_SSSE3
+static inline uint32_t lp__any_mask_ssse3(__m128i v, __m128i nib, __m128i hibit) {
+  const __m128i m4 = _mm_set1_epi8(0x0F);
+  __m128i lo = _mm_shuffle_epi8(nib, _mm_and_si128(v, m4));
+  __m128i hi = _mm_shuffle_epi8(hibit, _mm_and_si128(_mm_srli_epi16(v, 4), m4));
+  __m128i hit = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+  return (uint32_t)_mm_movemask_epi8(hit) ^ 0xFFFFu;
+}
+
+static const uint8_t lp__hibit[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+LP__TARGET_SSSE3
+static size_t lp__find_any_ssse3(const uint8_t* p, size_t n, const lp_sv_charset* cs) {
+  const __m128i nib = _mm_loadu_si128((const __m128i*)cs->nib);
+  const __m128i hibit = _mm_loadu_si128((const __m128i*)lp__hibit);
+  size_t i = 0;
+  for (; i + 16u <= n; i += 16u) {
+    uint32_t m = lp__any_mask_ssse3(_mm_loadu_si128((const __m128i*)(p + i)), nib, hibit);
+    if (m) return i + lp__ctz32(m);
+  }
+  if (i < n) {
+    i = n - 16u;
+    uint32_t m = lp__any_mask_ssse3(_mm_loadu_si128((const __m128i*)(p + i)), nib, hibit);
+    if (m) return i + lp__ctz32(m);
+  }
+  return LP_SV_NPOS;
+}
+
+LP__TARGET_AVX2
+static inline uint32_t lp__any_mask_avx2(__m256i v, __m256i nib, __m256i hibit) {
+  const __m256i m4 = _mm256_set1_epi8(0x0F);
+  __m256i lo = _mm256_shuffle_epi8(nib, _mm256_and_si256(v, m4));
+  __m256i hi = _mm256_shuffle_epi8(hibit, _mm256_and_si256(_mm256_srli_epi16(v, 4), m4));
+  __m256i hit = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+  return ~(uint32_t)_mm256_movemask_epi8(hit);
+}
+
+LP__TARGET_AVX2
+static size_t lp__find_any_avx2(const uint8_t* p, size_t n, const lp_sv_charset* cs) {
+  const __m256i nib = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)cs->nib));
+  const __m256i hibit = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lp__hibit));
+  size_t i = 0;
+  for (; i + 32u <= n; i += 32u) {
+    uint32_t m = lp__any_mask_avx2(_mm256_loadu_si256((const __m256i*)(p + i)), nib, hibit);
+    if (m) return i + lp__ctz32(m);
+  }
+  if (i < n) {
+    i = n - 32u;
+    uint32_t m = lp__any_mask_avx2(_mm256_loadu_si256((const __m256i*)(p + i)), nib, hibit);
+    if (m) return i + lp__ctz32(m);
+  }
+  return LP_SV_NPOS;
+}
+
+// Candidate positions i in [0, npos) with p[i] == first and
+// p[i + m - 1] == last, 16 at a time; verified with memcmp. Returns the
+// first match, or how far it got (a multiple of 16) via *done.
+static size_t lp__find_sse2(const uint8_t* p, size_t npos, const uint8_t* nd, size_t m, size_t* done) {
+  const __m128i first = _mm_set1_epi8((char)nd[0]);
+  const __m128i last = _mm_set1_epi8((char)nd[m - 1u]);
+  size_t i = 0;
+  for (; i + 16u <= npos; i += 16u) {
+    __m128i a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + i)), first);
+    __m128i b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(p + i + m - 1u)), last);
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(a, b));
+    while (mask) {
+      size_t j = i + lp__ctz32(mask);
+      if (memcmp(p + j + 1u, nd + 1u, m - 2u) == 0) return j;
+      mask &= mask - 1u;
+    }
+  }
+  *done = i;
+  return LP_SV_NPOS;
+}
+
+LP__TARGET_AVX2
+static size_t lp__find_avx2(const uint8_t* p, size_t npos, const uint8_t* nd, size_t m, size_t* done) {
+  const __m256i first = _mm256_set1_epi8((char)nd[0]);
+  const __m256i last = _mm256_set1_epi8((char)nd[m - 1u]);
+  size_t i = 0;
+  for (; i + 32u <= npos; i += 32u) {
+    __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i)), first);
+    __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(p + i + m - 1u)), last);
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(a, b));
+    while (mask) {
+      size_t j = i + lp__ctz32(mask);
+      if (memcmp(p + j + 1u, nd + 1u, m - 2u) == 0) return j;
+      mask &= mask - 1u;
+    }
+  }
+  *done = i;
+  return LP_SV_NPOS;
+}
+
+static inline uint32_t lp__neq_mask_sse2(__m128i x, __m128i y, bool ci) {
+  uint32_t eq = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+  if (eq != 0xFFFFu && ci) {
+    // 'A'..'Z' are the only bytes that land on the lowest 26 signed
+    // values after the bias
+    const __m128i bias = _mm_set1_epi8((char)(0x80 - 'A'));
+    const __m128i lim = _mm_set1_epi8((char)(-0x80 + 26));
+    const __m128i bit = _mm_set1_epi8(0x20);
+    x = _mm_or_si128(x, _mm_and_si128(_mm_cmplt_epi8(_mm_add_epi8(x, bias), lim), bit));
+    y = _mm_or_si128(y, _mm_and_si128(_mm_cmplt_epi8(_mm_add_epi8(y, bias), lim), bit));
+    eq = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+  }
+  return eq ^ 0xFFFFu;
+}
+
+// First index < n where a and b differ (after ASCII folding if ci), or n.
+// Needs n >= 16; the last block overlaps the one before it.
+static size_t lp__mismatch_sse2(const uint8_t* a, const uint8_t* b, size_t n, bool ci) {
+  size_t i = 0;
+  for (;;) {
+    if (i + 16u > n) {
+      if (i == n) return n;
+      i = n - 16u;
+    }
+    uint32_t ne = lp__neq_mask_sse2(_mm_loadu_si128((const __m128i*)(a + i)),
+                                    _mm_loadu_si128((const __m128i*)(b + i)), ci);
+    if (ne) return i + lp__ctz32(ne);
+    if (i + 16u == n) return n;
+    i += 16u;
+  }
+}
+
+#endif // LP__SV_X86
+
+// -------------------------
+// Kernels: portable
+// -------------------------
+
+static size_t lp__find_char_swar(const uint8_t* p, size_t n, uint8_t c) {
+  const uint64_t vc = LP__ONES * c;
+  size_t i = 0;
+  for (; i + 8u <= n; i += 8u) {
+    uint64_t m = lp__zero_bytes(lp__load8_le(p + i) ^ vc);
+    if (m) return i + lp__ctz64(m) / 8u;
+  }
+  for (; i < n; i++) {
+    if (p[i] == c) return i;
+  }
+  return LP_SV_NPOS;
+}
+
+static size_t lp__find_any_scalar(const uint8_t* p, size_t n, const lp_sv_charset* cs) {
+  for (size_t i = 0; i < n; i++) {
+    if (lp_sv_charset_has(cs, (char)p[i])) return i;
+  }
+  return LP_SV_NPOS;
+}
+
+// Same contract as lp__find_sse2, 8 candidates per step.
+static size_t lp__find_swar(const uint8_t* p, size_t npos, const uint8_t* nd, size_t m, size_t* done) {
+  const uint64_t first = LP__ONES * nd[0];
+  const uint64_t last = LP__ONES * nd[m - 1u];
+  size_t i = 0;
+  for (; i + 8u <= npos; i += 8u) {
+    uint64_t mask = lp__zero_bytes(lp__load8_le(p + i) ^ first) &
+                    lp__zero_bytes(lp__load8_le(p + i + m - 1u) ^ last);
+    while (mask) {
+      size_t j = i + lp__ctz64(mask) / 8u;
+      if (memcmp(p + j + 1u, nd + 1u, m - 2u) == 0) return j;
+      mask &= mask - 1u;
+    }
+  }
+  *done = i;
+  return LP_SV_NPOS;
+}
+
+static size_t lp__mismatch_swar(const uint8_t* a, const uint8_t* b, size_t n, bool ci) {
+  if (n >= 8u) {
+    // whole words; the last one overlaps the one before it
+    size_t i = 0;
+    for (;;) {
+      if (i + 8u > n) {
+        if (i == n) return n;
+        i = n - 8u;
+      }
+      uint64_t x = lp__load8_le(a + i), y = lp__load8_le(b + i);
+      if (x != y && ci) {
+        x = lp__fold8(x);
+        y = lp__fold8(y);
+      }
+      if (x != y) return i + lp__ctz64(x ^ y) / 8u;
+      if (i + 8u == n) return n;
+      i += 8u;
+    }
+  }
+  for (size_t i = 0; i < n; i++) {
+    uint8_t x = a[i], y = b[i];
+    if (ci) { x = lp__fold1(x); y = lp__fold1(y); }
+    if (x != y) return i;
+  }
+  return n;
+}
+
+// -------------------------
+// Public
+// -------------------------
+
+// Starts at the aligned block holding s, with the bytes before s masked
+// off; aligned reads never cross into the next page.
+LP__NO_ASAN
+size_t lp_cstr_len(const char* s) {
+#if LP__SV_X86
+  const __m128i zero = _mm_setzero_si128();
+  size_t mis = (uintptr_t)s & 15u;
+  const char* p = s - mis;
+  uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero)) >> mis;
+  if (m) return lp__ctz32(m);
+  for (;;) {
+    p += 16;
+    m = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero));
+    if (m) return (size_t)(p - s) + lp__ctz32(m);
+  }
+#else
+  size_t mis = (uintptr_t)s & 7u;
+  const uint8_t* p = (const uint8_t*)s - mis;
+  uint64_t v = lp__load8_le(p) | ((1ull << (mis * 8u)) - 1u);
+  for (;;) {
+    uint64_t z = lp__zero_bytes(v);
+    if (z) return (size_t)(p - (const uint8_t*)s) + lp__ctz64(z) / 8u;
+    p += 8;
+    v = lp__load8_le(p);
+  }
+#endif
+}
+
+// First index < n where a and b differ, or n.
+static size_t lp__mismatch(const uint8_t* a, const uint8_t* b, size_t n, bool ci) {
+#if LP__SV_X86
+  if (n >= 16u) return lp__mismatch_sse2(a, b, n, ci);
+#endif
+  return lp__mismatch_swar(a, b, n, ci);
+}
+
+static int lp__sv_cmp(lp_strview a, lp_strview b, bool ci) {
+  size_t n = (a.len < b.len) ? a.len : b.len;
+  const uint8_t* x = (const uint8_t*)a.ptr;
+  const uint8_t* y = (const uint8_t*)b.ptr;
+  size_t i = (x == y) ? n : lp__mismatch(x, y, n, ci);
+  if (i < n) {
+    uint8_t cx = x[i], cy = y[i];
+    if (ci) { cx = lp__fold1(cx); cy = lp__fold1(cy); }
+    return (cx < cy) ? -1 : 1;
+  }
+  return (a.len < b.len) ? -1 : (a.len > b.len) ? 1 : 0;
+}
+
+int lp_sv_cmp(lp_strview a, lp_strview b) { return lp__sv_cmp(a, b, false); }
+int lp_sv_cmp_ci(lp_strview a, lp_strview b) { return lp__sv_cmp(a, b, true); }
+
+bool lp_sv_eq_ci(lp_strview a, lp_strview b) {
+  return a.len == b.len && lp__sv_cmp(a, b, true) == 0;
+}
+
+size_t lp_sv_find_char(lp_strview s, char c) {
+  const uint8_t* p = (const uint8_t*)s.ptr;
+#if LP__SV_X86
+  if (s.len >= LP__SV_AVX2_MIN && lp__cpu_has_avx2()) return lp__find_char_avx2(p, s.len, (uint8_t)c);
+  if (s.len >= 16u) return lp__find_char_sse2(p, s.len, (uint8_t)c);
+#endif
+  return lp__find_char_swar(p, s.len, (uint8_t)c);
+}
+
+void lp_sv_charset_init(lp_sv_charset* cs, lp_strview chars) {
+  memset(cs, 0, sizeof *cs);
+  cs->ascii = true;
+  for (size_t i = 0; i < chars.len; i++) {
+    uint8_t b = (uint8_t)chars.ptr[i];
+    cs->bits[b >> 6] |= 1ull << (b & 63u);
+    if (b < 0x80u) cs->nib[b & 15u] |= (uint8_t)(1u << (b >> 4));
+    else cs->ascii = false;
+  }
+}
+
+size_t lp_sv_find_any(lp_strview s, const lp_sv_charset* set) {
+  const uint8_t* p = (const uint8_t*)s.ptr;
+#if LP__SV_X86
+  if (set->ascii && s.len >= 16u) {
+    if (s.len >= LP__SV_AVX2_MIN && lp__cpu_has_avx2()) return lp__find_any_avx2(p, s.len, set);
+    if (lp__cpu_has_ssse3()) return lp__find_any_ssse3(p, s.len, set);
+  }
+#endif
+  return lp__find_any_scalar(p, s.len, set);
+}
+
+size_t lp_sv_find(lp_strview s, lp_strview needle) {
+  size_t m = needle.len;
+  if (m == 0) return 0;
+  if (m > s.len) return LP_SV_NPOS;
+  if (m == 1) return lp_sv_find_char(s, needle.ptr[0]);
+
+  const uint8_t* p = (const uint8_t*)s.ptr;
+  const uint8_t* nd = (const uint8_t*)needle.ptr;
+  size_t npos = s.len - m + 1u; // candidate start positions
+  size_t i = 0, done = 0, r;
+#if LP__SV_X86
+  if (npos >= LP__SV_AVX2_MIN && lp__cpu_has_avx2()) r = lp__find_avx2(p, npos, nd, m, &done);
+  else r = lp__find_sse2(p, npos, nd, m, &done);
+  if (r != LP_SV_NPOS) return r;
+  i = done;
+#endif
+  r = lp__find_swar(p + i, npos - i, nd, m, &done);
+  if (r != LP_SV_NPOS) return i + r;
+  for (i += done; i < npos; i++) {
+    if (p[i] == nd[0] && memcmp(p + i + 1u, nd + 1u, m - 1u) == 0) return i;
+  }
+  return LP_SV_NPOS;
+}
+
+bool lp_sv_split_next(lp_sv_split* it, lp_strview* tok) {
+  while (!it->done) {
+    size_t i = it->set ? lp_sv_find_any(it->rest, it->set) : lp_sv_find_char(it->rest, it->delim);
+    lp_strview t = it->rest;
+    if (i == LP_SV_NPOS) {
+      it->rest.ptr += it->rest.len;
+      it->rest.len = 0;
+      it->done = true;
+    } else {
+      t.len = i;
+      it->rest.ptr += i + 1u;
+      it->rest.len -= i + 1u;
+    }
+    if (t.len == 0 && (it->flags & LP_SV_SPLIT_SKIP_EMPTY)) continue;
+    *tok = t;
+    return true;
+  }
+  return false;
+}
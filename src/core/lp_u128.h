@@ -0,0 +1,28 @@
+#pragma once
+#include "lp/lp_platform.h"
+
+/*
+  Private: 64x64 -> 128-bit multiply, used by the float conversions and
+  the hash. Native __int128 where the compiler has it, 32-bit halves
+  elsewhere.
+*/
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 lp__u128;
+#endif
+
+// Full 64x64 -> 128 product: returns the high half, *lo gets the low half.
+static LP_INLINE uint64_t lp__umul128_hi(uint64_t a, uint64_t b, uint64_t* lo) {
+#if defined(__SIZEOF_INT128__)
+  lp__u128 p = (lp__u128)a * b;
+  *lo = (uint64_t)p;
+  return (uint64_t)(p >> 64);
+#else
+  uint64_t a0 = (uint32_t)a, a1 = a >> 32;
+  uint64_t b0 = (uint32_t)b, b1 = b >> 32;
+  uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+  uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+  *lo = (mid << 32) | (uint32_t)p00;
+  return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+}
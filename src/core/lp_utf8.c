@@ -0,0 +1,470 @@
+#include "lp/lp_utf8.h"
+#include "lp/lp_config.h"
+#include "lp_cpu.h"
+#include <string.h>
+
+/*
+  Validation has two halves. The scalar scan walks sequences by their
+  lead byte and reports where the first bad one starts. The block
+  validators only answer "valid or not", 16/32 bytes per step with no
+  branches on the data: each byte is checked against the byte before it
+  by three 16-entry table lookups (high nibble of the previous byte, low
+  nibble of the previous byte, high nibble of the current one) whose AND
+  is nonzero exactly where the pair can't occur, plus a check that the
+  third and fourth bytes of 3/4-byte sequences are continuations. This is
+  the Keiser-Lemire "lookup" algorithm (as used by simdjson).
+*/
+
+#if LP_CFG_ENABLE_SIMD && LP__CPU_X86 && defined(__SSE2__)
+  #define LP__U8_X86 1
+  #define LP__TARGET_SSSE3 __attribute__((target("ssse3")))
+  #define LP__TARGET_AVX2  __attribute__((target("avx2")))
+#endif
+
+#if LP_CFG_ENABLE_SIMD && defined(__aarch64__) && defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+  #define LP__U8_NEON 1
+  #include <arm_neon.h>
+#endif
+
+#define LP__HIGHS 0x8080808080808080ull
+#define LP__ONES  0x0101010101010101ull
+
+static LP_INLINE uint64_t lp__load8(const uint8_t* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof v);
+  return v;
+}
+
+// -------------------------
+// Scalar
+// -------------------------
+
+// Offset of the first ill-formed sequence in p[0, n), or n.
+static size_t lp__utf8_scan(const uint8_t* p, size_t n) {
+  size_t i = 0;
+  while (i < n) {
+    if (n - i >= 8u && (lp__load8(p + i) & LP__HIGHS) == 0) {
+      i += 8u;
+      continue;
+    }
+    uint8_t b = p[i];
+    if (b < 0x80u) {
+      i++;
+      continue;
+    }
+    // Table 3-7: only the second byte has a lead-dependent range.
+    size_t len;
+    uint8_t lo = 0x80u, hi = 0xBFu;
+    if (b >= 0xC2u && b <= 0xDFu) {
+      len = 2;
+    } else if (b >= 0xE0u && b <= 0xEFu) {
+      len = 3;
+      if (b == 0xE0u) lo = 0xA0u;      // overlong
+      else if (b == 0xEDu) hi = 0x9Fu; // surrogates
+    } else if (b >= 0xF0u && b <= 0xF4u) {
+      len = 4;
+      if (b == 0xF0u) lo = 0x90u;      // overlong
+      else if (b == 0xF4u) hi = 0x8Fu; // > U+10FFFF
+    } else {
+      return i;
+    }
+    if (n - i < len) return i;
+    if (p[i + 1] < lo || p[i + 1] > hi) return i;
+    for (size_t k = 2; k < len; k++) {
+      if ((p[i + k] & 0xC0u) != 0x80u) return i;
+    }
+    i += len;
+  }
+  return n;
+}
+
+// Continuation bytes (10xxxxxx) in p[0, n).
+static size_t lp__utf8_conts(const uint8_t* p, size_t n) {
+  size_t c = 0, i = 0;
+  for (; n - i >= 8u; i += 8u) {
+    uint64_t v = lp__load8(p + i);
+    uint64_t m = (v & ~(v << 1) & LP__HIGHS) >> 7; // bit 7 set, bit 6 clear
+    c += (size_t)((m * LP__ONES) >> 56);
+  }
+  for (; i < n; i++) c += ((p[i] & 0xC0u) == 0x80u);
+  return c;
+}
+
+// -------------------------
+// Lookup tables (block validators)
+// -------------------------
+
+#if LP__U8_X86 || LP__U8_NEON
+
+// Error classes for a (previous byte, current byte) pair.
+enum {
+  LP__U8_TOO_SHORT  = 1u << 0, // lead, then a non-continuation
+  LP__U8_TOO_LONG   = 1u << 1, // ASCII, then a continuation
+  LP__U8_OVERLONG_3 = 1u << 2, // E0 80..9F
+  LP__U8_TOO_LARGE  = 1u << 3, // F4 90..BF
+  LP__U8_SURROGATE  = 1u << 4, // ED A0..BF
+  LP__U8_OVERLONG_2 = 1u << 5, // C0/C1 xx
+  LP__U8_LARGE_1000 = 1u << 6, // F5..FF 80..8F
+  LP__U8_OVERLONG_4 = 1u << 6, // F0 80..8F
+  LP__U8_TWO_CONTS  = 1u << 7, // continuation, continuation
+  LP__U8_CARRY      = LP__U8_TOO_SHORT | LP__U8_TOO_LONG | LP__U8_TWO_CONTS,
+};
+
+// Indexed by the previous byte's high nibble.
+static const uint8_t lp__u8_prev_hi[16] = {
+  LP__U8_TOO_LONG, LP__U8_TOO_LONG, LP__U8_TOO_LONG, LP__U8_TOO_LONG,
+  LP__U8_TOO_LONG, LP__U8_TOO_LONG, LP__U8_TOO_LONG, LP__U8_TOO_LONG,
+  LP__U8_TWO_CONTS, LP__U8_TWO_CONTS, LP__U8_TWO_CONTS, LP__U8_TWO_CONTS,
+  LP__U8_TOO_SHORT | LP__U8_OVERLONG_2,
+  LP__U8_TOO_SHORT,
+  LP__U8_TOO_SHORT | LP__U8_OVERLONG_3 | LP__U8_SURROGATE,
+  LP__U8_TOO_SHORT | LP__U8_TOO_LARGE | LP__U8_LARGE_1000 | LP__U8_OVERLONG_4,
+};
+
+// Indexed by the previous byte's low nibble.
+static const uint8_t lp__u8_prev_lo[16] = {
+  LP__U8_CARRY | LP__U8_OVERLONG_3 | LP__U8_OVERLONG_2 | LP__U8_OVERLONG_4,
+  LP__U8_CARRY | LP__U8_OVERLONG_2,
+  LP__U8_CARRY,
+  LP__U8_CARRY,
+  LP__U8_CARRY | LP__U8_TOO_LARGE,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000 | LP__U8_SURROGATE,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+  LP__U8_CARRY | LP__U8_TOO_LARGE | LP__U8_LARGE_1000,
+};
+
+// Indexed by the current byte's high nibble.
+static const uint8_t lp__u8_cur_hi[16] = {
+  LP__U8_TOO_SHORT, LP__U8_TOO_SHORT, LP__U8_TOO_SHORT, LP__U8_TOO_SHORT,
+  LP__U8_TOO_SHORT, LP__U8_TOO_SHORT, LP__U8_TOO_SHORT, LP__U8_TOO_SHORT,
+  LP__U8_TOO_LONG | LP__U8_OVERLONG_2 | LP__U8_TWO_CONTS | LP__U8_OVERLONG_3 | LP__U8_LARGE_1000 | LP__U8_OVERLONG_4,
+  LP__U8_TOO_LONG | LP__U8_OVERLONG_2 | LP__U8_TWO_CONTS | LP__U8_OVERLONG_3 | LP__U8_TOO_LARGE,
+  LP__U8_TOO_LONG | LP__U8_OVERLONG_2 | LP__U8_TWO_CONTS | LP__U8_SURROGATE | LP__U8_TOO_LARGE,
+  LP__U8_TOO_LONG | LP__U8_OVERLONG_2 | LP__U8_TWO_CONTS | LP__U8_SURROGATE | LP__U8_TOO_LARGE,
+  LP__U8_TOO_SHORT, LP__U8_TOO_SHORT, LP__U8_TOO_SHORT, LP__U8_TOO_SHORT,
+};
+
+// A block ends inside a sequence when a byte exceeds its entry here: a
+// 4-byte lead in the last 3, a 3-byte lead in the last 2, any lead last.
+// 32 bytes for AVX2; SSE/NEON use the last 16.
+static const uint8_t lp__u8_incomplete[32] = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+
+#endif
+
+// -------------------------
+// x86
+// -------------------------
+
+#if LP__U8_X86
+
+typedef struct {
+  __m128i err;        // any nonzero byte: invalid
+  __m128i prev;       // previous block
+  __m128i incomplete; // previous block ended mid-sequence
+  __m128i t_prev_hi, t_prev_lo, t_cur_hi, t_max;
+} lp__u8_sse;
+
+LP__TARGET_SSSE3 static inline void lp__u8_block_ssse3(lp__u8_sse* st, __m128i in) {
+  if (_mm_movemask_epi8(in) == 0) {
+    st->err = _mm_or_si128(st->err, st->incomplete);
+    st->incomplete = _mm_setzero_si128();
+    st->prev = in;
+    return;
+  }
+  const __m128i nib = _mm_set1_epi8(0x0F);
+  __m128i prev1 = _mm_alignr_epi8(in, st->prev, 15);
+  __m128i a = _mm_shuffle_epi8(st->t_prev_hi, _mm_and_si128(_mm_srli_epi16(prev1, 4), nib));
+  __m128i b = _mm_shuffle_epi8(st->t_prev_lo, _mm_and_si128(prev1, nib));
+  __m128i c = _mm_shuffle_epi8(st->t_cur_hi, _mm_and_si128(_mm_srli_epi16(in, 4), nib));
+  __m128i special = _mm_and_si128(_mm_and_si128(a, b), c);
+
+  // 0x80 where a continuation is required as byte 3 or 4 of a sequence
+  __m128i prev2 = _mm_alignr_epi8(in, st->prev, 14);
+  __m128i prev3 = _mm_alignr_epi8(in, st->prev, 13);
+  __m128i third = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0u - 0x80u)));
+  __m128i fourth = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0u - 0x80u)));
+  __m128i must = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8((char)0x80));
+
+  st->err = _mm_or_si128(st->err, _mm_xor_si128(must, special));
+  st->incomplete = _mm_subs_epu8(in, st->t_max);
+  st->prev = in;
+}
+
+LP__TARGET_SSSE3 static bool lp__utf8_ok_ssse3(const uint8_t* p, size_t n) {
+  lp__u8_sse st;
+  st.err = st.prev = st.incomplete = _mm_setzero_si128();
+  st.t_prev_hi = _mm_loadu_si128((const __m128i*)lp__u8_prev_hi);
+  st.t_prev_lo = _mm_loadu_si128((const __m128i*)lp__u8_prev_lo);
+  st.t_cur_hi = _mm_loadu_si128((const __m128i*)lp__u8_cur_hi);
+  st.t_max = _mm_loadu_si128((const __m128i*)(lp__u8_incomplete + 16));
+
+  size_t i = 0;
+  for (; n - i >= 64u; i += 64u) {
+    __m128i v0 = _mm_loadu_si128((const __m128i*)(p + i));
+    __m128i v1 = _mm_loadu_si128((const __m128i*)(p + i + 16));
+    __m128i v2 = _mm_loadu_si128((const __m128i*)(p + i + 32));
+    __m128i v3 = _mm_loadu_si128((const __m128i*)(p + i + 48));
+    if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3))) == 0) {
+      st.err = _mm_or_si128(st.err, st.incomplete);
+      st.incomplete = _mm_setzero_si128();
+      st.prev = v3;
+      continue;
+    }
+    lp__u8_block_ssse3(&st, v0);
+    lp__u8_block_ssse3(&st, v1);
+    lp__u8_block_ssse3(&st, v2);
+    lp__u8_block_ssse3(&st, v3);
+  }
+  for (; n - i >= 16u; i += 16u) lp__u8_block_ssse3(&st, _mm_loadu_si128((const __m128i*)(p + i)));
+  if (i < n) {
+    // zero padding is ASCII: a sequence cut off by the end shows up as TOO_SHORT
+    uint8_t tail[16] = { 0 };
+    memcpy(tail, p + i, n - i);
+    lp__u8_block_ssse3(&st, _mm_loadu_si128((const __m128i*)tail));
+  }
+  st.err = _mm_or_si128(st.err, st.incomplete);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(st.err, _mm_setzero_si128())) == 0xFFFF;
+}
+
+typedef struct {
+  __m256i err, prev, incomplete;
+  __m256i t_prev_hi, t_prev_lo, t_cur_hi, t_max;
+} lp__u8_avx2;
+
+LP__TARGET_AVX2 static inline void lp__u8_block_avx2(lp__u8_avx2* st, __m256i in) {
+  if (_mm256_movemask_epi8(in) == 0) {
+    st->err = _mm256_or_si256(st->err, st->incomplete);
+    st->incomplete = _mm256_setzero_si256();
+    st->prev = in;
+    return;
+  }
+  const __m256i nib = _mm256_set1_epi8(0x0F);
+  // alignr works per 128-bit lane; feed it the block shifted by one lane
+  __m256i shifted = _mm256_permute2x128_si256(st->prev, in, 0x21);
+  __m256i prev1 = _mm256_alignr_epi8(in, shifted, 15);
+  __m256i a = _mm256_shuffle_epi8(st->t_prev_hi, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nib));
+  __m256i b = _mm256_shuffle_epi8(st->t_prev_lo, _mm256_and_si256(prev1, nib));
+  __m256i c = _mm256_shuffle_epi8(st->t_cur_hi, _mm256_and_si256(_mm256_srli_epi16(in, 4), nib));
+  __m256i special = _mm256_and_si256(_mm256_and_si256(a, b), c);
+
+  __m256i prev2 = _mm256_alignr_epi8(in, shifted, 14);
+  __m256i prev3 = _mm256_alignr_epi8(in, shifted, 13);
+  __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0u - 0x80u)));
+  __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0u - 0x80u)));
+  __m256i must = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+
+  st->err = _mm256_or_si256(st->err, _mm256_xor_si256(must, special));
+  st->incomplete = _mm256_subs_epu8(in, st->t_max);
+  st->prev = in;
+}
+
+LP__TARGET_AVX2 static bool lp__utf8_ok_avx2(const uint8_t* p, size_t n) {
+  lp__u8_avx2 st;
+  st.err = st.prev = st.incomplete = _mm256_setzero_si256();
+  st.t_prev_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lp__u8_prev_hi));
+  st.t_prev_lo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lp__u8_prev_lo));
+  st.t_cur_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lp__u8_cur_hi));
+  st.t_max = _mm256_loadu_si256((const __m256i*)lp__u8_incomplete);
+
+  size_t i = 0;
+  for (; n - i >= 64u; i += 64u) {
+    __m256i v0 = _mm256_loadu_si256((const __m256i*)(p + i));
+    __m256i v1 = _mm256_loadu_si256((const __m256i*)(p + i + 32));
+    if (_mm256_movemask_epi8(_mm256_or_si256(v0, v1)) == 0) {
+      st.err = _mm256_or_si256(st.err, st.incomplete);
+      st.incomplete = _mm256_setzero_si256();
+      st.prev = v1;
+      continue;
+    }
+    lp__u8_block_avx2(&st, v0);
+    lp__u8_block_avx2(&st, v1);
+  }
+  for (; n - i >= 32u; i += 32u) lp__u8_block_avx2(&st, _mm256_loadu_si256((const __m256i*)(p + i)));
+  if (i < n) {
+    uint8_t tail[32] = { 0 };
+    memcpy(tail, p + i, n - i);
+    lp__u8_block_avx2(&st, _mm256_loadu_si256((const __m256i*)tail));
+  }
+  st.err = _mm256_or_si256(st.err, st.incomplete);
+  return _mm256_testz_si256(st.err, st.err) != 0;
+}
+
+// Continuation bytes in p[0, n & ~15): a byte is one when, read as
+// signed, it is below -64 (0x80..0xBF). Per-byte counters are flushed
+// through psadbw before they can wrap.
+static size_t lp__utf8_conts_sse2(const uint8_t* p, size_t n) {
+  const __m128i lim = _mm_set1_epi8(-64);
+  size_t c = 0, i = 0;
+  while (n - i >= 16u) {
+    __m128i acc = _mm_setzero_si128();
+    for (uint32_t k = 0; k < 255u && n - i >= 16u; k++, i += 16u) {
+      __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+      acc = _mm_sub_epi8(acc, _mm_cmplt_epi8(v, lim));
+    }
+    __m128i s = _mm_sad_epu8(acc, _mm_setzero_si128());
+    c += (size_t)(uint32_t)_mm_cvtsi128_si32(s) + (size_t)(uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(s, 8));
+  }
+  return c;
+}
+
+LP__TARGET_AVX2 static size_t lp__utf8_conts_avx2(const uint8_t* p, size_t n) {
+  const __m256i lim = _mm256_set1_epi8(-64);
+  size_t c = 0, i = 0;
+  while (n - i >= 32u) {
+    __m256i acc = _mm256_setzero_si256();
+    for (uint32_t k = 0; k < 255u && n - i >= 32u; k++, i += 32u) {
+      __m256i v = _mm256_loadu_si256((const __m256i*)(p + i));
+      acc = _mm256_sub_epi8(acc, _mm256_cmpgt_epi8(lim, v));
+    }
+    __m256i s = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+    __m128i h = _mm_add_epi64(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+    c += (size_t)(uint32_t)_mm_cvtsi128_si32(h) + (size_t)(uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(h, 8));
+  }
+  return c;
+}
+
+#endif // LP__U8_X86
+
+// -------------------------
+// AArch64
+// -------------------------
+
+#if LP__U8_NEON
+
+typedef struct {
+  uint8x16_t err, prev, incomplete;
+  uint8x16_t t_prev_hi, t_prev_lo, t_cur_hi, t_max;
+} lp__u8_neon;
+
+static LP_INLINE void lp__u8_block_neon(lp__u8_neon* st, uint8x16_t in) {
+  if (vmaxvq_u8(in) < 0x80u) {
+    st->err = vorrq_u8(st->err, st->incomplete);
+    st->incomplete = vdupq_n_u8(0);
+    st->prev = in;
+    return;
+  }
+  uint8x16_t prev1 = vextq_u8(st->prev, in, 15);
+  uint8x16_t a = vqtbl1q_u8(st->t_prev_hi, vshrq_n_u8(prev1, 4));
+  uint8x16_t b = vqtbl1q_u8(st->t_prev_lo, vandq_u8(prev1, vdupq_n_u8(0x0F)));
+  uint8x16_t c = vqtbl1q_u8(st->t_cur_hi, vshrq_n_u8(in, 4));
+  uint8x16_t special = vandq_u8(vandq_u8(a, b), c);
+
+  uint8x16_t prev2 = vextq_u8(st->prev, in, 14);
+  uint8x16_t prev3 = vextq_u8(st->prev, in, 13);
+  uint8x16_t third = vqsubq_u8(prev2, vdupq_n_u8(0xE0u - 0x80u));
+  uint8x16_t fourth = vqsubq_u8(prev3, vdupq_n_u8(0xF0u - 0x80u));
+  uint8x16_t must = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80u));
+
+  st->err = vorrq_u8(st->err, veorq_u8(must, special));
+  st->incomplete = vqsubq_u8(in, st->t_max);
+  st->prev = in;
+}
+
+static bool lp__utf8_ok_neon(const uint8_t* p, size_t n) {
+  lp__u8_neon st;
+  st.err = st.prev = st.incomplete = vdupq_n_u8(0);
+  st.t_prev_hi = vld1q_u8(lp__u8_prev_hi);
+  st.t_prev_lo = vld1q_u8(lp__u8_prev_lo);
+  st.t_cur_hi = vld1q_u8(lp__u8_cur_hi);
+  st.t_max = vld1q_u8(lp__u8_incomplete + 16);
+
+  size_t i = 0;
+  for (; n - i >= 64u; i += 64u) {
+    uint8x16_t v0 = vld1q_u8(p + i);
+    uint8x16_t v1 = vld1q_u8(p + i + 16);
+    uint8x16_t v2 = vld1q_u8(p + i + 32);
+    uint8x16_t v3 = vld1q_u8(p + i + 48);
+    if (vmaxvq_u8(vorrq_u8(vorrq_u8(v0, v1), vorrq_u8(v2, v3))) < 0x80u) {
+      st.err = vorrq_u8(st.err, st.incomplete);
+      st.incomplete = vdupq_n_u8(0);
+      st.prev = v3;
+      continue;
+    }
+    lp__u8_block_neon(&st, v0);
+    lp__u8_block_neon(&st, v1);
+    lp__u8_block_neon(&st, v2);
+    lp__u8_block_neon(&st, v3);
+  }
+  for (; n - i >= 16u; i += 16u) lp__u8_block_neon(&st, vld1q_u8(p + i));
+  if (i < n) {
+    uint8_t tail[16] = { 0 };
+    memcpy(tail, p + i, n - i);
+    lp__u8_block_neon(&st, vld1q_u8(tail));
+  }
+  st.err = vorrq_u8(st.err, st.incomplete);
+  return vmaxvq_u8(st.err) == 0;
+}
+
+static size_t lp__utf8_conts_neon(const uint8_t* p, size_t n) {
+  const int8x16_t lim = vdupq_n_s8(-64);
+  size_t c = 0, i = 0;
+  while (n - i >= 16u) {
+    uint8x16_t acc = vdupq_n_u8(0);
+    for (uint32_t k = 0; k < 255u && n - i >= 16u; k++, i += 16u) {
+      uint8x16_t m = vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(p + i)), lim);
+      acc = vsubq_u8(acc, m);
+    }
+    c += vaddlvq_u8(acc);
+  }
+  return c;
+}
+
+#endif // LP__U8_NEON
+
+// -------------------------
+// API
+// -------------------------
+
+static bool lp__utf8_ok(const uint8_t* p, size_t n) {
+#if LP__U8_X86
+  if (n >= 64u && lp__cpu_has_avx2()) return lp__utf8_ok_avx2(p, n);
+  if (n >= 16u && lp__cpu_has_ssse3()) return lp__utf8_ok_ssse3(p, n);
+#elif LP__U8_NEON
+  if (n >= 16u) return lp__utf8_ok_neon(p, n);
+#endif
+  return lp__utf8_scan(p, n) == n;
+}
+
+lp_status_t lp_utf8_validate(lp_strview s) {
+  if (!s.ptr && s.len != 0) return LP_ERR_INVALID;
+  return lp__utf8_ok((const uint8_t*)s.ptr, s.len) ? LP_OK : LP_ERR_INVALID;
+}
+
+size_t lp_utf8_valid_len(lp_strview s) {
+  if (!s.ptr) return 0;
+  const uint8_t* p = (const uint8_t*)s.ptr;
+  // Valid input (the common case) never touches the scalar scan.
+  if (lp__utf8_ok(p, s.len)) return s.len;
+  return lp__utf8_scan(p, s.len);
+}
+
+size_t lp_utf8_count(lp_strview s) {
+  if (!s.ptr) return 0;
+  const uint8_t* p = (const uint8_t*)s.ptr;
+  size_t n = s.len, head = 0, conts = 0;
+#if LP__U8_X86
+  if (n >= 64u && lp__cpu_has_avx2()) {
+    head = n & ~(size_t)31u;
+    conts = lp__utf8_conts_avx2(p, head);
+  } else {
+    head = n & ~(size_t)15u;
+    conts = lp__utf8_conts_sse2(p, head);
+  }
+#elif LP__U8_NEON
+  head = n & ~(size_t)15u;
+  conts = lp__utf8_conts_neon(p, head);
+#endif
+  conts += lp__utf8_conts(p + head, n - head);
+  return n - conts;
+}
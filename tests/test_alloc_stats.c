@@ -0,0 +1,63 @@
+#include "lp/lp.h"
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static void test_dump(void) {
+  char buf[128];
+  lp_fmtbuf fb = lp_fmtbuf_make(buf, sizeof(buf));
+  lp_alloc_stats s = { 0 };
+
+  lp_alloc_stats_hit(&s, 10, 6, 16);
+  lp_alloc_stats_hit(&s, 4, 0, 20);
+  lp_alloc_stats_miss(&s);
+
+  T_ASSERT(lp_alloc_stats_dump(&fb, "req", &s) == LP_OK);
+  T_ASSERT(lp_sv_eq(lp_sv(buf),
+    lp_sv("req: allocs=2 fail=1 req=14 used=20 pad=6 hwm=20 blocks=0")));
+}
+
+#if LP_CFG_ALLOC_STATS
+static void test_arena_stats(void) {
+  uint64_t mem[8];
+  lp_arena a;
+  void* p = NULL;
+  lp_arena_init(&a, mem, sizeof(mem));
+
+  T_ASSERT(lp_arena_alloc(&a, 3, 1, &p) == LP_OK);
+  T_ASSERT(lp_arena_alloc(&a, 8, 8, &p) == LP_OK); // 5 bytes padding
+  T_ASSERT(lp_arena_alloc(&a, 64, 1, &p) == LP_ERR_NOMEM);
+  lp_arena_reset(&a);
+  T_ASSERT(lp_arena_alloc(&a, 4, 1, &p) == LP_OK);
+
+  T_ASSERT(a.stats.allocs == 3);
+  T_ASSERT(a.stats.failures == 1);
+  T_ASSERT(a.stats.bytes_requested == 15);
+  T_ASSERT(a.stats.bytes_padding == 5);
+  T_ASSERT(a.stats.bytes_consumed == 20);
+  T_ASSERT(a.stats.high_water == 16); // survives the reset
+}
+
+static void test_pool_stats(void) {
+  uint64_t mem[8];
+  lp_pool p;
+  void* o = NULL;
+  T_ASSERT(lp_pool_init(&p, mem, sizeof(mem), 12, 8) == LP_OK);
+
+  while (lp_pool_alloc(&p, &o) == LP_OK) {}
+  T_ASSERT(p.stats.allocs == p.count);
+  T_ASSERT(p.stats.failures == 1);
+  T_ASSERT(p.stats.bytes_requested == 12u * p.count);
+  T_ASSERT(p.stats.bytes_padding == (p.stride - 12u) * p.count);
+  T_ASSERT(p.stats.high_water == p.count * p.stride);
+}
+#endif
+
+int main(void) {
+  test_dump();
+#if LP_CFG_ALLOC_STATS
+  test_arena_stats();
+  test_pool_stats();
+#endif
+  return g_fail ? 1 : 0;
+}
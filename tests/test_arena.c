@@ -0,0 +1,131 @@
+#include "lp/lp.h"
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static void test_alloc_align(void) {
+  uint64_t mem[16];
+  lp_arena a;
+  void* p = NULL;
+  void* q = NULL;
+  lp_arena_init(&a, mem, sizeof(mem));
+
+  T_ASSERT(lp_arena_alloc(&a, 1, 1, &p) == LP_OK);
+  T_ASSERT(p == (void*)mem);
+  T_ASSERT(lp_arena_alloc(&a, 8, 8, &q) == LP_OK);
+  T_ASSERT(((uintptr_t)q & 7u) == 0);
+  T_ASSERT((uint8_t*)q == (uint8_t*)mem + 8);
+
+  T_ASSERT(lp_arena_alloc(&a, 4, 3, &p) == LP_ERR_INVALID);
+  T_ASSERT(lp_arena_alloc(&a, 0, 8, &p) == LP_OK && p == NULL);
+  T_ASSERT(lp_arena_alloc(&a, sizeof(mem), 1, &p) == LP_ERR_NOMEM);
+  T_ASSERT(a.off == 16);
+
+  lp_arena_reset(&a);
+  T_ASSERT(a.off == 0);
+  T_ASSERT(lp_arena_alloc(&a, sizeof(mem), 1, &p) == LP_OK);
+}
+
+// Alignment is by address even when the region itself is misaligned.
+static void test_unaligned_region(void) {
+  uint64_t mem[8];
+  lp_arena a;
+  void* p = NULL;
+  lp_arena_init(&a, (uint8_t*)mem + 1, sizeof(mem) - 1);
+
+  T_ASSERT(lp_arena_alloc(&a, 4, 4, &p) == LP_OK);
+  T_ASSERT(((uintptr_t)p & 3u) == 0);
+  T_ASSERT(a.off == 3 + 4);
+}
+
+static void test_mark_rewind(void) {
+  uint8_t mem[64];
+  lp_arena a;
+  void* p = NULL;
+  lp_arena_init(&a, mem, sizeof(mem));
+
+  T_ASSERT(lp_arena_alloc(&a, 10, 1, &p) == LP_OK);
+  lp_arena_pos outer = lp_arena_mark(&a);
+
+  T_ASSERT(lp_arena_alloc(&a, 20, 1, &p) == LP_OK);
+  lp_arena_temp t = lp_arena_temp_begin(&a);
+  T_ASSERT(lp_arena_alloc(&a, 30, 1, &p) == LP_OK);
+  T_ASSERT(a.off == 60);
+  lp_arena_temp_end(t);
+  T_ASSERT(a.off == 30);
+
+  lp_arena_rewind(&a, outer);
+  T_ASSERT(a.off == 10);
+  T_ASSERT(lp_arena_alloc(&a, 54, 1, &p) == LP_OK);
+  T_ASSERT(p == (void*)(mem + 10));
+}
+
+static void test_resize_top(void) {
+  uint8_t mem[64];
+  lp_arena a;
+  void* p = NULL;
+  void* q = NULL;
+  lp_arena_init(&a, mem, sizeof(mem));
+
+  T_ASSERT(lp_arena_alloc(&a, 8, 1, &p) == LP_OK);
+  T_ASSERT(lp_arena_resize_top(&a, p, 8, 40));
+  T_ASSERT(a.off == 40);
+  T_ASSERT(!lp_arena_resize_top(&a, p, 40, 65)); // past the end
+  T_ASSERT(!lp_arena_resize_top(&a, p, 8, 16));  // wrong size: not the top
+  T_ASSERT(lp_arena_resize_top(&a, p, 40, 4));
+  T_ASSERT(a.off == 4);
+
+  T_ASSERT(lp_arena_alloc(&a, 4, 1, &q) == LP_OK);
+  T_ASSERT(!lp_arena_resize_top(&a, p, 4, 8)); // no longer the top
+  T_ASSERT(lp_arena_resize_top(&a, q, 4, 0));
+  T_ASSERT(a.off == 4);
+  uint8_t other[4];
+  T_ASSERT(!lp_arena_resize_top(&a, other, 0, 1));
+}
+
+#if LP_CFG_ENABLE_ALLOC
+static void test_chained(void) {
+  uint8_t mem[32];
+  lp_arena a;
+  void* p = NULL;
+  lp_arena_init_chained(&a, mem, sizeof(mem), 64, LP_ARENA_KEEP_BLOCKS);
+
+  T_ASSERT(lp_arena_alloc(&a, 24, 1, &p) == LP_OK);
+  lp_arena_pos m = lp_arena_mark(&a);
+
+  T_ASSERT(lp_arena_alloc(&a, 16, 8, &p) == LP_OK); // spills to a heap block
+  T_ASSERT(a.chain != NULL);
+  T_ASSERT(((uintptr_t)p & 7u) == 0);
+  T_ASSERT(lp_arena_alloc(&a, 100, 1, &p) == LP_OK); // oversized block
+  void* big = a.chain;
+
+  lp_arena_rewind(&a, m);
+  T_ASSERT(a.chain == NULL && a.mem == mem && a.off == 24);
+  T_ASSERT(a.spare != NULL);
+
+  // reuse kept blocks: the 100-byte request must get the big spare back
+  T_ASSERT(lp_arena_alloc(&a, 100, 1, &p) == LP_OK);
+  T_ASSERT(a.chain == big);
+
+  lp_arena_release(&a);
+  T_ASSERT(a.chain == NULL && a.spare == NULL && a.off == 0);
+
+  // heap-only arena
+  lp_arena_init_chained(&a, NULL, 0, 128, LP_ARENA_FREE_BLOCKS);
+  T_ASSERT(lp_arena_alloc(&a, 8, 8, &p) == LP_OK);
+  lp_arena_reset(&a);
+  T_ASSERT(a.chain == NULL && a.spare == NULL);
+  lp_arena_release(&a);
+}
+#endif
+
+int main(void) {
+  test_alloc_align();
+  test_unaligned_region();
+  test_mark_rewind();
+  test_resize_top();
+#if LP_CFG_ENABLE_ALLOC
+  test_chained();
+#endif
+  return g_fail ? 1 : 0;
+}
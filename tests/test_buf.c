@@ -0,0 +1,207 @@
+#include "lp/lp.h"
+#include <string.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+typedef struct {
+  uint32_t a;
+  uint64_t b;
+} pair;
+
+LP_VEC_DEFINE(vec_u32, uint32_t)
+LP_VEC_DEFINE(vec_pair, pair)
+
+static void test_fixed(void) {
+  uint8_t mem[8];
+  lp_buf b;
+  lp_buf_init(&b, mem, sizeof mem);
+  T_ASSERT(b.data == mem && b.len == 0 && b.cap == 8);
+  T_ASSERT(lp_buf_append(&b, "abcde", 5) == LP_OK);
+  T_ASSERT(lp_buf_append_sv(&b, lp_sv("fgh")) == LP_OK);
+  T_ASSERT(lp_buf_append(&b, "i", 1) == LP_ERR_NOMEM);
+  T_ASSERT(b.len == 8 && memcmp(mem, "abcdefgh", 8) == 0);
+  T_ASSERT(lp_buf_reserve(&b, SIZE_MAX) == LP_ERR_OVERFLOW);
+  T_ASSERT(lp_buf_append(&b, NULL, 1) == LP_ERR_INVALID);
+  T_ASSERT(lp_buf_append(&b, NULL, 0) == LP_OK);
+  T_ASSERT(lp_buf_shrink(&b) == LP_OK && b.cap == 8);
+
+  lp_span_u8_mut out;
+  T_ASSERT(lp_buf_detach(&b, &out) == LP_OK);
+  T_ASSERT(out.ptr == mem && out.len == 8);
+  T_ASSERT(b.len == 0 && b.cap == 0);
+  T_ASSERT(lp_buf_append(&b, "x", 1) == LP_ERR_NOMEM); // the memory went with it
+}
+
+// Short contents stay in the inline storage; longer ones move to the arena
+// and, while on top, keep growing in place.
+static void test_arena(void) {
+  static uint64_t amem[512];
+  lp_arena a;
+  lp_arena_init(&a, amem, sizeof amem);
+  char small[16];
+  lp_buf b;
+  lp_buf_init_arena(&b, &a, small, sizeof small);
+
+  T_ASSERT(lp_buf_append_sv(&b, lp_sv("0123456789abcdef")) == LP_OK);
+  T_ASSERT(b.data == (uint8_t*)small && a.off == 0);
+
+  T_ASSERT(lp_buf_append(&b, "!", 1) == LP_OK);
+  uint8_t* moved = b.data;
+  T_ASSERT(moved == (uint8_t*)amem && b.cap == 32 && a.off == 32);
+  T_ASSERT(b.len == 17 && memcmp(b.data, "0123456789abcdef!", 17) == 0);
+
+  bool ok = true;
+  for (int i = 0; i < 500; i++) ok &= lp_buf_append(&b, "xyz", 3) == LP_OK;
+  T_ASSERT(ok);
+  T_ASSERT(b.data == moved); // grew in place the whole time
+  T_ASSERT(a.off == b.cap && b.len == 17 + 1500);
+
+  T_ASSERT(lp_buf_shrink(&b) == LP_OK);
+  T_ASSERT(b.cap == b.len && a.off == b.len);
+
+  // once something else is allocated on top, growing copies
+  void* other = NULL;
+  T_ASSERT(lp_arena_alloc(&a, 8, 1, &other) == LP_OK);
+  T_ASSERT(lp_buf_append(&b, "+", 1) == LP_OK);
+  T_ASSERT(b.data != moved && memcmp(b.data, "0123456789abcdef!xyz", 20) == 0);
+  T_ASSERT(b.data[b.len - 1] == '+');
+
+  // the arena can't hold the next doubling, but can hold what's needed
+  size_t left = a.cap - a.off;
+  T_ASSERT(lp_buf_reserve(&b, left - b.len + b.cap) == LP_OK);
+  T_ASSERT(a.off == a.cap);
+  T_ASSERT(lp_buf_reserve(&b, b.cap - b.len + 1u) == LP_ERR_NOMEM);
+  T_ASSERT(b.len == 17 + 1500 + 1); // contents kept
+
+  // detach trims the block to the contents and leaves b on inline storage
+  lp_span_u8_mut out;
+  size_t len = b.len;
+  T_ASSERT(lp_buf_detach(&b, &out) == LP_OK);
+  T_ASSERT(out.len == len && out.ptr[0] == '0' && a.off == (size_t)(out.ptr - (uint8_t*)amem) + len);
+  T_ASSERT(b.data == (uint8_t*)small && b.len == 0 && b.cap == sizeof small);
+
+  // data still inline is copied out on detach, not handed over
+  T_ASSERT(lp_buf_append(&b, "hi", 2) == LP_OK);
+  T_ASSERT(lp_buf_detach(&b, &out) == LP_OK);
+  T_ASSERT(out.len == 2 && out.ptr != (uint8_t*)small && memcmp(out.ptr, "hi", 2) == 0);
+  T_ASSERT(lp_buf_detach(&b, &out) == LP_OK && out.ptr == NULL && out.len == 0);
+}
+
+// Shrink goes back to the inline storage when the contents fit; free gives
+// the top of the arena back.
+static void test_arena_shrink_free(void) {
+  static uint64_t amem[64];
+  lp_arena a;
+  lp_arena_init(&a, amem, sizeof amem);
+  char small[8];
+  lp_buf b;
+  lp_buf_init_arena(&b, &a, small, sizeof small);
+  T_ASSERT(lp_buf_append(&b, "0123456789", 10) == LP_OK);
+  T_ASSERT(a.off == 16);
+  b.len = 4;
+  T_ASSERT(lp_buf_shrink(&b) == LP_OK);
+  T_ASSERT(b.data == (uint8_t*)small && b.cap == 8 && memcmp(small, "0123", 4) == 0);
+  T_ASSERT(a.off == 0);
+
+  T_ASSERT(lp_buf_append(&b, "456789", 6) == LP_OK);
+  T_ASSERT(a.off == 16);
+  lp_buf_free(&b);
+  T_ASSERT(a.off == 0 && b.len == 0 && b.data == (uint8_t*)small);
+
+  // no inline storage at all
+  lp_buf_init_arena(&b, &a, NULL, 0);
+  T_ASSERT(b.data == NULL && b.cap == 0);
+  T_ASSERT(lp_buf_append(&b, "a", 1) == LP_OK && b.cap == 16);
+  lp_buf_clear(&b);
+  T_ASSERT(lp_buf_shrink(&b) == LP_OK && b.data == NULL && a.off == 0);
+}
+
+static void test_vec(void) {
+  static uint64_t amem[4096];
+  lp_arena a;
+  lp_arena_init(&a, amem, sizeof amem);
+  void* pad = NULL;
+  T_ASSERT(lp_arena_alloc(&a, 3, 1, &pad) == LP_OK); // misalign the top
+
+  pair small[2];
+  vec_pair v;
+  vec_pair_init_arena(&v, &a, small, 2);
+  T_ASSERT(vec_pair_len(&v) == 0 && vec_pair_cap(&v) == 2);
+  bool ok = true;
+  for (uint32_t i = 0; i < 1000; i++) ok &= vec_pair_push(&v, (pair){ i, (uint64_t)i * 3u }) == LP_OK;
+  T_ASSERT(ok);
+  T_ASSERT(vec_pair_len(&v) == 1000);
+  T_ASSERT(((uintptr_t)vec_pair_data(&v) % _Alignof(pair)) == 0);
+  for (uint32_t i = 0; i < 1000; i++) ok &= vec_pair_at(&v, i)->a == i && vec_pair_data(&v)[i].b == i * 3u;
+  T_ASSERT(ok);
+  pair last;
+  T_ASSERT(vec_pair_pop(&v, &last) && last.a == 999u && vec_pair_len(&v) == 999);
+  T_ASSERT(vec_pair_reserve(&v, SIZE_MAX / 2u) == LP_ERR_OVERFLOW);
+  T_ASSERT(vec_pair_push_n(&v, small, SIZE_MAX / 4u) == LP_ERR_OVERFLOW);
+  vec_pair_clear(&v);
+  T_ASSERT(!vec_pair_pop(&v, NULL));
+
+  uint32_t fixed[4];
+  vec_u32 u;
+  vec_u32_init(&u, fixed, 4);
+  static const uint32_t xs[] = { 1, 2, 3 };
+  T_ASSERT(vec_u32_push_n(&u, xs, 3) == LP_OK);
+  T_ASSERT(vec_u32_push(&u, 4) == LP_OK);
+  T_ASSERT(vec_u32_push(&u, 5) == LP_ERR_NOMEM);
+  T_ASSERT(vec_u32_len(&u) == 4 && fixed[3] == 4u);
+  T_ASSERT(vec_u32_reserve(&u, 0) == LP_OK);
+
+  uint32_t* items = NULL;
+  size_t n = 0;
+  T_ASSERT(vec_u32_detach(&u, &items, &n) == LP_OK && items == fixed && n == 4);
+
+  // an element count whose byte size wraps leaves the vector with no storage
+  T_ASSERT(vec_u32_init(&u, fixed, SIZE_MAX / 2u) == LP_ERR_OVERFLOW);
+  T_ASSERT(vec_u32_cap(&u) == 0 && vec_u32_push(&u, 1) == LP_ERR_NOMEM);
+  T_ASSERT(vec_u32_init(&u, fixed, 4) == LP_OK && vec_u32_cap(&u) == 4);
+}
+
+#if LP_CFG_ENABLE_ALLOC
+static void test_heap(void) {
+  char small[4];
+  lp_buf b;
+  lp_buf_init_heap(&b, small, sizeof small);
+  T_ASSERT(lp_buf_append(&b, "abc", 3) == LP_OK && b.data == (uint8_t*)small);
+  bool ok = true;
+  for (int i = 0; i < 10000; i++) ok &= lp_buf_append(&b, "0123456789", 10) == LP_OK;
+  T_ASSERT(ok);
+  T_ASSERT(b.len == 100003 && b.cap >= b.len && b.cap < 2u * b.len + 32u);
+  T_ASSERT(memcmp(b.data + 99993, "0123456789", 10) == 0);
+  T_ASSERT(lp_buf_shrink(&b) == LP_OK && b.cap == b.len);
+  T_ASSERT(memcmp(b.data, "abc0123", 7) == 0);
+
+  lp_span_u8_mut out;
+  T_ASSERT(lp_buf_detach(&b, &out) == LP_OK && out.len == 100003);
+  T_ASSERT(b.data == (uint8_t*)small && b.len == 0);
+  lp_port_free(out.ptr);
+
+  T_ASSERT(lp_buf_append(&b, "xy", 2) == LP_OK);
+  T_ASSERT(lp_buf_detach(&b, &out) == LP_OK && out.ptr != (uint8_t*)small && out.len == 2);
+  lp_port_free(out.ptr);
+
+  vec_u32 v;
+  vec_u32_init_heap(&v, NULL, 0);
+  for (uint32_t i = 0; i < 100000; i++) ok &= vec_u32_push(&v, i) == LP_OK;
+  for (uint32_t i = 0; i < 100000; i++) ok &= vec_u32_data(&v)[i] == i;
+  T_ASSERT(ok);
+  vec_u32_free(&v);
+  T_ASSERT(vec_u32_len(&v) == 0 && v.buf.data == NULL);
+}
+#endif
+
+int main(void) {
+  test_fixed();
+  test_arena();
+  test_arena_shrink_free();
+  test_vec();
+#if LP_CFG_ENABLE_ALLOC
+  test_heap();
+#endif
+  return g_fail ? 1 : 0;
+}
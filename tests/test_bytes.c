@@ -1,5 +1,7 @@
 #include "lp/lp.h"
 
+#include <string.h>
+
 static int g_fail = 0;
 
 #define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
@@ -44,9 +46,66 @@ static void test_endian_load_store(void) {
   T_ASSERT(lp_load_u64_be(b) == 0x0102030405060708ull);
 }
 
+// Array forms must agree with the single-value helpers at every count and
+// source alignment, through both the vector body and the scalar tail.
+static void test_endian_arrays(void) {
+  static uint8_t raw[8 * 80 + 8];
+  static uint8_t out[8 * 80 + 8];
+  static uint16_t a16[80];
+  static uint32_t a32[80];
+  static uint64_t a64[80];
+
+  for (size_t i = 0; i < sizeof raw; i++) raw[i] = (uint8_t)(i * 37u + 11u);
+
+  for (size_t count = 0; count <= 80; count++) {
+    const uint8_t* src = raw + (count % 8);
+    bool ok = true;
+
+    lp_load_u16_be_n(a16, src, count);
+    for (size_t i = 0; i < count; i++) ok &= a16[i] == lp_load_u16_be(src + 2 * i);
+    lp_store_u16_be_n(out + 1, a16, count);
+    ok &= count == 0 || memcmp(out + 1, src, 2 * count) == 0;
+    lp_load_u16_le_n(a16, src, count);
+    for (size_t i = 0; i < count; i++) ok &= a16[i] == lp_load_u16_le(src + 2 * i);
+    lp_store_u16_le_n(out + 1, a16, count);
+    ok &= count == 0 || memcmp(out + 1, src, 2 * count) == 0;
+
+    lp_load_u32_be_n(a32, src, count);
+    for (size_t i = 0; i < count; i++) ok &= a32[i] == lp_load_u32_be(src + 4 * i);
+    lp_store_u32_be_n(out + 3, a32, count);
+    ok &= count == 0 || memcmp(out + 3, src, 4 * count) == 0;
+    lp_load_u32_le_n(a32, src, count);
+    for (size_t i = 0; i < count; i++) ok &= a32[i] == lp_load_u32_le(src + 4 * i);
+    lp_store_u32_le_n(out + 3, a32, count);
+    ok &= count == 0 || memcmp(out + 3, src, 4 * count) == 0;
+
+    lp_load_u64_be_n(a64, src, count);
+    for (size_t i = 0; i < count; i++) ok &= a64[i] == lp_load_u64_be(src + 8 * i);
+    lp_store_u64_be_n(out + 5, a64, count);
+    ok &= count == 0 || memcmp(out + 5, src, 8 * count) == 0;
+    lp_load_u64_le_n(a64, src, count);
+    for (size_t i = 0; i < count; i++) ok &= a64[i] == lp_load_u64_le(src + 8 * i);
+    lp_store_u64_le_n(out + 5, a64, count);
+    ok &= count == 0 || memcmp(out + 5, src, 8 * count) == 0;
+
+    T_ASSERT(ok);
+  }
+
+  // in place
+  for (size_t i = 0; i < 80; i++) a32[i] = (uint32_t)i * 0x01020304u;
+  lp_store_u32_be_n(a32, a32, 80);
+  lp_load_u32_be_n(a32, a32, 80);
+  bool ok = true;
+  for (size_t i = 0; i < 80; i++) ok &= a32[i] == (uint32_t)i * 0x01020304u;
+  T_ASSERT(ok);
+
+  lp_load_u32_be_n(NULL, NULL, 0);
+}
+
 int main(void) {
   test_checked_math();
   test_endian_load_store();
+  test_endian_arrays();
   return g_fail ? 1 : 0;
 }
 
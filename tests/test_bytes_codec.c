@@ -0,0 +1,204 @@
+#include "lp/lp.h"
+
+#include <string.h>
+
+static int g_fail = 0;
+
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static lp_strview sv(const char* s) {
+  lp_strview v = { s, strlen(s) };
+  return v;
+}
+
+static uint32_t g_rng = 0x12345678u;
+
+static uint8_t rnd8(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 17;
+  g_rng ^= g_rng << 5;
+  return (uint8_t)g_rng;
+}
+
+// Plain reference encoders, one char at a time.
+static size_t ref_hex(char* d, const uint8_t* s, size_t n, bool upper) {
+  const char* dig = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  for (size_t i = 0; i < n; i++) {
+    d[2 * i] = dig[s[i] >> 4];
+    d[2 * i + 1] = dig[s[i] & 15];
+  }
+  return 2 * n;
+}
+
+static size_t ref_b64(char* d, const uint8_t* s, size_t n, bool url) {
+  const char* t = url ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                      : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  size_t o = 0;
+  for (size_t i = 0; i < n; i += 3) {
+    uint32_t v = (uint32_t)s[i] << 16;
+    size_t k = n - i < 3 ? n - i : 3;
+    if (k > 1) v |= (uint32_t)s[i + 1] << 8;
+    if (k > 2) v |= s[i + 2];
+    d[o++] = t[(v >> 18) & 63];
+    d[o++] = t[(v >> 12) & 63];
+    if (k > 1) d[o++] = t[(v >> 6) & 63];
+    else if (!url) d[o++] = '=';
+    if (k > 2) d[o++] = t[v & 63];
+    else if (!url) d[o++] = '=';
+  }
+  return o;
+}
+
+static void test_hex_vectors(void) {
+  uint8_t out[64];
+  size_t n = 0;
+  const uint8_t in[] = { 0x00, 0x01, 0x7F, 0x80, 0xAB, 0xFF };
+
+  lp_span_u8_mut dst = { out, sizeof out };
+  lp_span_u8 src = { in, sizeof in };
+  T_ASSERT(lp_hex_encode(dst, src, false, &n) == LP_OK);
+  T_ASSERT(n == 12 && memcmp(out, "00017f80abff", 12) == 0);
+  T_ASSERT(lp_hex_encode(dst, src, true, &n) == LP_OK);
+  T_ASSERT(n == 12 && memcmp(out, "00017F80ABFF", 12) == 0);
+
+  T_ASSERT(lp_hex_decode(dst, sv("00017f80AbFf"), &n) == LP_OK);
+  T_ASSERT(n == 6 && memcmp(out, in, 6) == 0);
+
+  // errors
+  T_ASSERT(lp_hex_decode(dst, sv("abc"), &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_hex_decode(dst, sv("0g"), &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_hex_decode(dst, sv("0:"), &n) == LP_ERR_INVALID);
+  lp_span_u8_mut small = { out, 2 };
+  T_ASSERT(lp_hex_decode(small, sv("000102"), &n) == LP_ERR_RANGE);
+  T_ASSERT(lp_hex_encode(small, src, false, &n) == LP_ERR_RANGE);
+  T_ASSERT(lp_hex_encode(dst, src, false, NULL) == LP_ERR_INVALID);
+
+  lp_span_u8 empty = { NULL, 0 };
+  lp_span_u8_mut none = { NULL, 0 };
+  T_ASSERT(lp_hex_encode(none, empty, false, &n) == LP_OK && n == 0);
+}
+
+static void test_base64_vectors(void) {
+  // RFC 4648 section 10
+  static const char* const plain[] = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+  static const char* const std[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy" };
+  static const char* const url[] = { "", "Zg", "Zm8", "Zm9v", "Zm9vYg", "Zm9vYmE", "Zm9vYmFy" };
+  uint8_t out[32];
+  size_t n = 0;
+  lp_span_u8_mut dst = { out, sizeof out };
+
+  for (size_t i = 0; i < 7; i++) {
+    lp_span_u8 src = { (const uint8_t*)plain[i], strlen(plain[i]) };
+
+    T_ASSERT(lp_base64_encode(dst, src, LP_BASE64_STD, &n) == LP_OK);
+    T_ASSERT(n == strlen(std[i]) && memcmp(out, std[i], n) == 0);
+    T_ASSERT(lp_base64_encoded_len(src.len, LP_BASE64_STD) == n);
+    T_ASSERT(lp_base64_decode(dst, sv(std[i]), LP_BASE64_STD, &n) == LP_OK);
+    T_ASSERT(n == src.len && memcmp(out, plain[i], n) == 0);
+
+    T_ASSERT(lp_base64_encode(dst, src, LP_BASE64_URL, &n) == LP_OK);
+    T_ASSERT(n == strlen(url[i]) && memcmp(out, url[i], n) == 0);
+    T_ASSERT(lp_base64_decode(dst, sv(url[i]), LP_BASE64_URL, &n) == LP_OK);
+    T_ASSERT(n == src.len && memcmp(out, plain[i], n) == 0);
+    T_ASSERT(lp_base64_decoded_max(strlen(url[i])) >= src.len);
+  }
+
+  // alphabet-specific characters
+  T_ASSERT(lp_base64_decode(dst, sv("+/+/"), LP_BASE64_STD, &n) == LP_OK);
+  T_ASSERT(n == 3 && out[0] == 0xFB && out[1] == 0xFF && out[2] == 0xBF);
+  T_ASSERT(lp_base64_decode(dst, sv("-_-_"), LP_BASE64_URL, &n) == LP_OK);
+  T_ASSERT(n == 3 && out[0] == 0xFB && out[1] == 0xFF && out[2] == 0xBF);
+  T_ASSERT(lp_base64_decode(dst, sv("-_-_"), LP_BASE64_STD, &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_base64_decode(dst, sv("+/+/"), LP_BASE64_URL, &n) == LP_ERR_INVALID);
+
+  // malformed input
+  T_ASSERT(lp_base64_decode(dst, sv("Zg="), LP_BASE64_STD, &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_base64_decode(dst, sv("Z==="), LP_BASE64_STD, &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_base64_decode(dst, sv("===="), LP_BASE64_STD, &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_base64_decode(dst, sv("Zg=="), LP_BASE64_URL, &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_base64_decode(dst, sv("Zm=v"), LP_BASE64_STD, &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_base64_decode(dst, sv("Zh=="), LP_BASE64_STD, &n) == LP_ERR_INVALID); // stray low bits
+  T_ASSERT(lp_base64_decode(dst, sv("Zm9="), LP_BASE64_STD, &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_base64_decode(dst, sv("Zm9vY"), LP_BASE64_URL, &n) == LP_ERR_INVALID);
+  T_ASSERT(lp_base64_decode(dst, sv("Zm 9v"), LP_BASE64_URL, &n) == LP_ERR_INVALID);
+
+  lp_span_u8_mut small = { out, 5 };
+  T_ASSERT(lp_base64_decode(small, sv("Zm9vYmFy"), LP_BASE64_STD, &n) == LP_ERR_RANGE);
+  lp_span_u8 src = { (const uint8_t*)"foobar", 6 };
+  T_ASSERT(lp_base64_encode(small, src, LP_BASE64_STD, &n) == LP_ERR_RANGE);
+}
+
+// Long random inputs at every length and misalignment, so the SIMD bulk
+// paths, the scalar tails and the seam between them are all compared
+// against the reference.
+static void test_round_trip(void) {
+  static uint8_t in[600];
+  static char ref[1300];
+  static uint8_t enc[1300];
+  static uint8_t dec[700];
+
+  for (size_t i = 0; i < sizeof in; i++) in[i] = rnd8();
+
+  for (size_t len = 0; len < 520; len++) {
+    size_t off = len % 7;
+    lp_span_u8 src = { in + off, len };
+    lp_span_u8_mut e = { enc, sizeof enc };
+    lp_span_u8_mut d = { dec, sizeof dec };
+    size_t n = 0, m = 0;
+
+    for (int upper = 0; upper < 2; upper++) {
+      size_t rn = ref_hex(ref, src.ptr, len, upper != 0);
+      T_ASSERT(lp_hex_encode(e, src, upper != 0, &n) == LP_OK);
+      T_ASSERT(n == rn && memcmp(enc, ref, n) == 0);
+      lp_strview s = { (const char*)enc, n };
+      T_ASSERT(lp_hex_decode(d, s, &m) == LP_OK);
+      T_ASSERT(m == len && memcmp(dec, src.ptr, len) == 0);
+    }
+
+    for (int url = 0; url < 2; url++) {
+      lp_base64_alphabet a = url ? LP_BASE64_URL : LP_BASE64_STD;
+      size_t rn = ref_b64(ref, src.ptr, len, url != 0);
+      T_ASSERT(lp_base64_encode(e, src, a, &n) == LP_OK);
+      T_ASSERT(n == rn && memcmp(enc, ref, n) == 0);
+
+      // exact-size destination: the SIMD decoders must not overrun it
+      lp_span_u8_mut exact = { dec, len };
+      lp_strview s = { (const char*)enc, n };
+      T_ASSERT(lp_base64_decode(exact, s, a, &m) == LP_OK);
+      T_ASSERT(m == len && memcmp(dec, src.ptr, len) == 0);
+
+      // larger destination: nothing after the output is written
+      memset(dec, 0xAA, sizeof dec);
+      T_ASSERT(lp_base64_decode(d, s, a, &m) == LP_OK);
+      T_ASSERT(m == len && memcmp(dec, src.ptr, len) == 0);
+      bool guard = true;
+      for (size_t k = len; k < len + 32u; k++) guard &= dec[k] == 0xAA;
+      T_ASSERT(guard);
+    }
+  }
+
+  // one bad character anywhere must be caught
+  for (size_t pos = 0; pos < 256; pos += 5) {
+    lp_span_u8 src = { in, 300 };
+    lp_span_u8_mut e = { enc, sizeof enc };
+    lp_span_u8_mut d = { dec, sizeof dec };
+    size_t n = 0, m = 0;
+
+    T_ASSERT(lp_hex_encode(e, src, false, &n) == LP_OK);
+    enc[pos] = 'x';
+    lp_strview s = { (const char*)enc, n };
+    T_ASSERT(lp_hex_decode(d, s, &m) == LP_ERR_INVALID);
+
+    T_ASSERT(lp_base64_encode(e, src, LP_BASE64_STD, &n) == LP_OK);
+    enc[pos] = '.';
+    s.len = n;
+    T_ASSERT(lp_base64_decode(d, s, LP_BASE64_STD, &m) == LP_ERR_INVALID);
+  }
+}
+
+int main(void) {
+  test_hex_vectors();
+  test_base64_vectors();
+  test_round_trip();
+  return g_fail ? 1 : 0;
+}
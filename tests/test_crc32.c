@@ -0,0 +1,53 @@
+#include "lp/lp.h"
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static void test_check_values(void) {
+  T_ASSERT(lp_crc32("123456789", 9) == 0xCBF43926u);
+  T_ASSERT(lp_crc32c("123456789", 9) == 0xE3069283u);
+  T_ASSERT(lp_crc32("", 0) == 0u);
+  T_ASSERT(lp_crc32c("", 0) == 0u);
+  T_ASSERT(lp_crc32("The quick brown fox jumps over the lazy dog", 43) == 0x414FA339u);
+}
+
+static void test_incremental(void) {
+  uint32_t st = lp_crc32_init();
+  st = lp_crc32_update(st, "1234", 4);
+  st = lp_crc32_update(st, "56789", 5);
+  T_ASSERT(lp_crc32_final(st) == 0xCBF43926u);
+
+  st = lp_crc32c_init();
+  st = lp_crc32c_update(st, "12345678", 8);
+  st = lp_crc32c_update(st, "9", 1);
+  T_ASSERT(lp_crc32c_final(st) == 0xE3069283u);
+}
+
+// Hardware/sliced paths must match the byte-table path at every length and
+// misalignment, including the 64-byte fold threshold.
+static void test_paths_agree(void) {
+  static uint8_t buf[4096 + 16];
+  uint32_t x = 0x12345678u;
+  for (size_t i = 0; i < sizeof(buf); i++) {
+    x = x * 1103515245u + 12345u;
+    buf[i] = (uint8_t)(x >> 24);
+  }
+
+  for (size_t off = 0; off < 8; off++) {
+    for (size_t n = 0; n <= 300; n++) {
+      T_ASSERT(lp_crc32_update(0xFFFFFFFFu, buf + off, n) ==
+               lp_crc32_update_sw(0xFFFFFFFFu, buf + off, n));
+      T_ASSERT(lp_crc32c_update(0xFFFFFFFFu, buf + off, n) ==
+               lp_crc32c_update_sw(0xFFFFFFFFu, buf + off, n));
+    }
+  }
+  T_ASSERT(lp_crc32_update(0u, buf, 4096) == lp_crc32_update_sw(0u, buf, 4096));
+  T_ASSERT(lp_crc32c_update(0u, buf, 4096) == lp_crc32c_update_sw(0u, buf, 4096));
+}
+
+int main(void) {
+  test_check_values();
+  test_incremental();
+  test_paths_agree();
+  return g_fail ? 1 : 0;
+}
@@ -0,0 +1,279 @@
+#if !defined(_POSIX_C_SOURCE)
+  #define _POSIX_C_SOURCE 200809L // fileno, dup2
+#endif
+#include "lp/lp.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static uint64_t g_now = 0;
+static uint64_t fake_clock(void) { return g_now; }
+
+static bool next_eq(lp_dlog* log, const char* want) {
+  char line[512];
+  lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+  if (!lp_dlog_next(log, &fb)) return false;
+  return lp_sv_eq(lp_sv_n(line, fb.len), lp_sv(want));
+}
+
+// Number following `key` in s.
+static uint64_t field(lp_strview s, const char* key) {
+  lp_strview k = lp_sv(key);
+  size_t at = lp_sv_find(s, k);
+  uint64_t v = UINT64_MAX;
+  size_t used = 0;
+  if (at == LP_SV_NPOS) return v;
+  if (lp_parse_u64(lp_sv_sub(s, at + k.len, SIZE_MAX), &v, &used) != LP_OK) return UINT64_MAX;
+  return v;
+}
+
+static void test_format(void) {
+  static uint8_t mem[1024];
+  lp_dlog log;
+  lp_dlog_chan ch;
+  lp_dlog_init(&log, fake_clock, LP_LOG_DEBUG);
+  T_ASSERT(lp_dlog_chan_init(&log, &ch, mem, 1000) == LP_ERR_INVALID); // not pow2
+  T_ASSERT(lp_dlog_chan_init(&log, &ch, mem, 128) == LP_ERR_INVALID);  // < a record
+  T_ASSERT(lp_dlog_chan_init(&log, &ch, mem, sizeof mem) == LP_OK);
+
+  char name[8] = "abc";
+  g_now = 1234567890123ull;
+  T_ASSERT(LP_DLOG(&ch, LP_LOG_INFO, "x={} s={} v={:.2} h={:#x}", 7, name, 2.5, 255u) == LP_OK);
+  name[0] = 'X'; // copied at the call site
+  g_now = 5;
+  T_ASSERT(LP_DLOG(&ch, LP_LOG_ERROR, "sv={} neg={}", lp_sv("hello"), -3) == LP_OK);
+  T_ASSERT(LP_DLOG_MSG(&ch, LP_LOG_WARN, "plain {braces}") == LP_OK);
+  T_ASSERT(LP_DLOG(&ch, LP_LOG_DEBUG, "null={}", (const char*)NULL) == LP_OK);
+  T_ASSERT(LP_DLOG(&ch, LP_LOG_DEBUG, "missing {} {}", 1) == LP_OK);
+
+  T_ASSERT(next_eq(&log, "1234.567890123 INF x=7 s=abc v=2.50 h=0xff"));
+  T_ASSERT(next_eq(&log, "0.000000005 ERR sv=hello neg=-3"));
+  T_ASSERT(next_eq(&log, "0.000000005 WRN plain {braces}"));
+  T_ASSERT(next_eq(&log, "0.000000005 DBG null=(null)"));
+  char line[64];
+  lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+  T_ASSERT(lp_dlog_next(&log, &fb));
+  T_ASSERT(lp_sv_ends_with(lp_sv_n(line, fb.len), lp_sv("[bad format]")));
+  fb = lp_fmtbuf_make(line, sizeof line);
+  T_ASSERT(!lp_dlog_next(&log, &fb) && fb.len == 0);
+  T_ASSERT(lp_spsc_ring_len(&ch.ring) == 0);
+}
+
+static int g_evaluated = 0;
+static int side_effect(void) { return ++g_evaluated; }
+
+static void test_level_filter(void) {
+  static uint8_t mem[512];
+  lp_dlog log;
+  lp_dlog_chan ch;
+  lp_dlog_init(&log, NULL, LP_LOG_WARN);
+  T_ASSERT(lp_dlog_chan_init(&log, &ch, mem, sizeof mem) == LP_OK);
+  T_ASSERT(LP_DLOG(&ch, LP_LOG_INFO, "skipped {}", side_effect()) == LP_OK);
+  T_ASSERT(LP_DLOG_MSG(&ch, LP_LOG_DEBUG, "skipped") == LP_OK);
+  T_ASSERT(g_evaluated == 0 && lp_spsc_ring_len(&ch.ring) == 0);
+  T_ASSERT(LP_DLOG(&ch, LP_LOG_ERROR, "kept {}", side_effect()) == LP_OK);
+  T_ASSERT(g_evaluated == 1);
+  T_ASSERT(next_eq(&log, "0.000000000 ERR kept 1"));
+}
+
+// Long strings are cut to fit a record, on a UTF-8 boundary, and leave
+// room for the fields after them.
+static void test_long_strings(void) {
+  static uint8_t mem[1024];
+  lp_dlog log;
+  lp_dlog_chan ch;
+  lp_dlog_init(&log, NULL, LP_LOG_DEBUG);
+  T_ASSERT(lp_dlog_chan_init(&log, &ch, mem, sizeof mem) == LP_OK);
+
+  char big[1000];
+  for (size_t i = 0; i < sizeof big - 1u; i += 2) memcpy(big + i, "\xC3\xA9", 2); // é
+  big[sizeof big - 1u] = '\0';
+  T_ASSERT(LP_DLOG(&ch, LP_LOG_INFO, "{}|{}|{}", big, lp_sv(big), 42) == LP_OK);
+  T_ASSERT(lp_spsc_ring_len(&ch.ring) <= LP_CFG_DLOG_MAX_RECORD);
+
+  char line[1024];
+  lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+  T_ASSERT(lp_dlog_next(&log, &fb));
+  lp_strview s = lp_sv_n(line, fb.len);
+  T_ASSERT(lp_utf8_validate(s) == LP_OK);
+  T_ASSERT(lp_sv_ends_with(s, lp_sv("|42")));
+  T_ASSERT(s.len > 200 && s.len < LP_CFG_DLOG_MAX_RECORD);
+}
+
+static void test_drops(void) {
+  static uint8_t mem[256];
+  lp_dlog log;
+  lp_dlog_chan ch;
+  lp_dlog_init(&log, NULL, LP_LOG_DEBUG);
+  T_ASSERT(lp_dlog_chan_init(&log, &ch, mem, sizeof mem) == LP_OK);
+
+  size_t kept = 0, dropped = 0;
+  for (uint32_t i = 0; i < 20; i++) {
+    lp_status_t st = LP_DLOG(&ch, LP_LOG_INFO, "i={}", i);
+    if (st == LP_OK) kept++;
+    else if (st == LP_ERR_FULL) dropped++;
+  }
+  T_ASSERT(kept > 0 && dropped > 0 && kept + dropped == 20);
+  T_ASSERT(lp_dlog_dropped(&log) == dropped);
+
+  char want[64];
+  lp_fmtbuf w = lp_fmtbuf_make(want, sizeof want);
+  lp_fmt_appendf(&w, "0.000000000 WRN dlog: {} records dropped on channel 0", dropped);
+  T_ASSERT(next_eq(&log, want));
+  T_ASSERT(next_eq(&log, "0.000000000 INF i=0"));
+  size_t lines = 1;
+  char line[64];
+  lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+  while (lp_dlog_next(&log, &fb)) {
+    lines++;
+    fb = lp_fmtbuf_make(line, sizeof line);
+  }
+  T_ASSERT(lines == kept);
+
+  // reported once
+  T_ASSERT(LP_DLOG(&ch, LP_LOG_INFO, "again") == LP_OK);
+  T_ASSERT(next_eq(&log, "0.000000000 INF again"));
+  T_ASSERT(lp_dlog_dropped(&log) == dropped);
+}
+
+static void test_channel_limit(void) {
+  static uint8_t mem[LP_CFG_DLOG_MAX_CHANS + 1u][256];
+  static lp_dlog_chan chans[LP_CFG_DLOG_MAX_CHANS + 1u];
+  lp_dlog log;
+  lp_dlog_init(&log, NULL, LP_LOG_DEBUG);
+  bool ok = true;
+  for (size_t i = 0; i < LP_CFG_DLOG_MAX_CHANS; i++) ok &= lp_dlog_chan_init(&log, &chans[i], mem[i], 256) == LP_OK;
+  T_ASSERT(ok);
+  T_ASSERT(lp_dlog_chan_init(&log, &chans[LP_CFG_DLOG_MAX_CHANS], mem[LP_CFG_DLOG_MAX_CHANS], 256) == LP_ERR_FULL);
+
+  // round-robin across channels, in order within each
+  T_ASSERT(LP_DLOG(&chans[3], LP_LOG_INFO, "c3 a") == LP_OK);
+  T_ASSERT(LP_DLOG(&chans[3], LP_LOG_INFO, "c3 b") == LP_OK);
+  T_ASSERT(LP_DLOG(&chans[1], LP_LOG_INFO, "c1 a") == LP_OK);
+  T_ASSERT(next_eq(&log, "0.000000000 INF c1 a"));
+  T_ASSERT(next_eq(&log, "0.000000000 INF c3 a"));
+  T_ASSERT(next_eq(&log, "0.000000000 INF c3 b"));
+  T_ASSERT(!next_eq(&log, ""));
+}
+
+// Producers on their own channels, retrying on a full ring; a concurrent
+// consumer checks every thread's sequence arrives whole and in order.
+#define N_PROD  4
+#define PER_PROD 20000u
+
+static lp_dlog g_log;
+static lp_atomic_size g_done;
+
+typedef struct {
+  lp_dlog_chan ch;
+  uint8_t      mem[1024];
+  uint32_t     id;
+} producer;
+
+static void* producer_main(void* arg) {
+  producer* p = (producer*)arg;
+  if (lp_dlog_chan_init(&g_log, &p->ch, p->mem, sizeof p->mem) != LP_OK) return NULL;
+  for (uint32_t i = 0; i < PER_PROD;) {
+    if (LP_DLOG(&p->ch, LP_LOG_INFO, "t={} i={} s={}", p->id, i, "payload") == LP_OK) i++;
+    else sched_yield();
+  }
+  lp_port_atomic_fetch_add(&g_done, (size_t)1, LP_MO_RELEASE);
+  return NULL;
+}
+
+static void test_threads(void) {
+  static producer prods[N_PROD];
+  pthread_t th[N_PROD];
+  lp_dlog_init(&g_log, NULL, LP_LOG_DEBUG);
+  lp_port_atomic_store(&g_done, (size_t)0, LP_MO_RELAXED);
+  for (uint32_t i = 0; i < N_PROD; i++) {
+    prods[i].id = i;
+    pthread_create(&th[i], NULL, producer_main, &prods[i]);
+  }
+
+  uint64_t next[N_PROD] = { 0 };
+  size_t notices = 0;
+  bool ok = true;
+  for (;;) {
+    bool done = lp_port_atomic_load(&g_done, LP_MO_ACQUIRE) == N_PROD;
+    char line[128];
+    lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+    if (!lp_dlog_next(&g_log, &fb)) {
+      if (done) break;
+      sched_yield();
+      continue;
+    }
+    lp_strview s = lp_sv_n(line, fb.len);
+    if (lp_sv_find(s, lp_sv("dropped")) != LP_SV_NPOS) {
+      notices += (size_t)field(s, "dlog: ");
+      continue;
+    }
+    uint64_t t = field(s, "t="), i = field(s, " i=");
+    ok &= t < N_PROD && lp_sv_ends_with(s, lp_sv(" s=payload"));
+    if (t < N_PROD) {
+      ok &= i == next[t];
+      next[t] = i + 1u;
+    }
+  }
+  for (uint32_t i = 0; i < N_PROD; i++) pthread_join(th[i], NULL);
+  T_ASSERT(ok);
+  for (uint32_t i = 0; i < N_PROD; i++) T_ASSERT(next[i] == PER_PROD);
+  T_ASSERT(notices == lp_dlog_dropped(&g_log));
+}
+
+// The POSIX drain thread writes lines to stderr; point stderr at a file.
+static void test_drain_thread(void) {
+  static uint8_t mem[4096];
+  static lp_dlog log;
+  lp_dlog_chan ch;
+  lp_dlog_init(&log, NULL, LP_LOG_DEBUG);
+  T_ASSERT(lp_dlog_chan_init(&log, &ch, mem, sizeof mem) == LP_OK);
+
+  FILE* f = tmpfile();
+  T_ASSERT(f != NULL);
+  if (!f) return;
+  int saved = dup(STDERR_FILENO);
+  dup2(fileno(f), STDERR_FILENO);
+
+  T_ASSERT(lp_port_dlog_start(&log) == LP_OK);
+  T_ASSERT(lp_port_dlog_start(&log) == LP_ERR_INVALID);
+  for (uint32_t i = 0; i < 1000;) {
+    if (LP_DLOG(&ch, LP_LOG_INFO, "n={}", i) == LP_OK) i++;
+    else sched_yield();
+  }
+  lp_port_dlog_stop();
+
+  dup2(saved, STDERR_FILENO);
+  close(saved);
+
+  static char out[64 * 1024];
+  rewind(f);
+  size_t n = fread(out, 1, sizeof out, f);
+  fclose(f);
+  lp_sv_split it = lp_sv_split_on(lp_sv_n(out, n), '\n', 0);
+  lp_strview tok;
+  uint64_t want = 0;
+  bool ok = true;
+  while (lp_sv_split_next(&it, &tok)) {
+    if (tok.len == 0) continue;
+    if (lp_sv_find(tok, lp_sv("dropped")) != LP_SV_NPOS) continue;
+    ok &= field(tok, "n=") == want++;
+  }
+  T_ASSERT(ok && want == 1000);
+}
+
+int main(void) {
+  test_format();
+  test_level_filter();
+  test_long_strings();
+  test_drops();
+  test_channel_limit();
+  test_threads();
+  test_drain_thread();
+  return g_fail ? 1 : 0;
+}
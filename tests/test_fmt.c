@@ -1,5 +1,8 @@
 #include "lp/lp.h"
 
+#include <stdio.h>
+#include <string.h>
+
 static int g_fail = 0;
 #define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
 
@@ -57,10 +60,220 @@ static void test_hex_fixed_width(void) {
     lp_sv("a1b2c3d4 0102030405060708")));
 }
 
+// Every digit count and both division regimes (above/below UINT32_MAX),
+// checked against snprintf.
+static void test_decimal_vs_snprintf(void) {
+  char buf[32];
+  char ref[32];
+  bool ok = true;
+
+  uint64_t p = 1;
+  for (int d = 0; d < 20; d++) {
+    const uint64_t vals[3] = { p - 1u, p, p + 7u };
+    for (int k = 0; k < 3; k++) {
+      lp_fmtbuf fb = lp_fmtbuf_make(buf, sizeof(buf));
+      lp_fmt_append_u64(&fb, vals[k]);
+      snprintf(ref, sizeof ref, "%llu", (unsigned long long)vals[k]);
+      ok &= strcmp(buf, ref) == 0 && fb.len == strlen(ref);
+
+      fb = lp_fmtbuf_make(buf, sizeof(buf));
+      lp_fmt_append_i64(&fb, -(int64_t)(vals[k] >> 1));
+      snprintf(ref, sizeof ref, "%lld", -(long long)(vals[k] >> 1));
+      ok &= strcmp(buf, ref) == 0;
+    }
+    p *= 10u;
+  }
+
+  const int64_t edges[] = { INT64_MIN, INT64_MIN + 1, -1, 0, INT64_MAX };
+  for (size_t i = 0; i < sizeof edges / sizeof edges[0]; i++) {
+    lp_fmtbuf fb = lp_fmtbuf_make(buf, sizeof(buf));
+    lp_fmt_append_i64(&fb, edges[i]);
+    snprintf(ref, sizeof ref, "%lld", (long long)edges[i]);
+    ok &= strcmp(buf, ref) == 0;
+  }
+
+  char wide[48];
+  lp_fmtbuf fb = lp_fmtbuf_make(wide, sizeof(wide));
+  lp_fmt_append_u64(&fb, UINT64_MAX);
+  lp_fmt_append_char(&fb, ' ');
+  lp_fmt_append_i32(&fb, INT32_MIN);
+  ok &= strcmp(wide, "18446744073709551615 -2147483648") == 0;
+
+  T_ASSERT(ok);
+}
+
+// At every capacity a number is cut to the longest prefix that fits,
+// NUL-terminated, with truncated set only when something was dropped.
+static void test_decimal_truncation(void) {
+  static const char full[] = "x-9223372036854775808";
+  bool ok = true;
+
+  for (size_t cap = 0; cap <= sizeof full + 1; cap++) {
+    char buf[32];
+    memset(buf, '#', sizeof buf);
+    lp_fmtbuf fb = lp_fmtbuf_make(cap ? buf : NULL, cap);
+    ok &= lp_fmt_append_char(&fb, 'x') == LP_OK;
+    ok &= lp_fmt_append_i64(&fb, INT64_MIN) == LP_OK;
+
+    size_t want = (cap == 0) ? 0 : ((cap - 1 < sizeof full - 1) ? cap - 1 : sizeof full - 1);
+    ok &= fb.len == want;
+    ok &= fb.truncated == (want != sizeof full - 1);
+    if (cap) ok &= memcmp(buf, full, want) == 0 && buf[want] == '\0';
+    if (cap < sizeof buf) ok &= cap == 0 || buf[cap] == '#'; // never past cap
+  }
+
+  lp_fmtbuf bad = { NULL, 4, 0, false };
+  ok &= lp_fmt_append_u64(&bad, 1) == LP_ERR_INVALID;
+  ok &= lp_fmt_append_u64(NULL, 1) == LP_ERR_INVALID;
+
+  T_ASSERT(ok);
+}
+
+static bool fmt_is(const char* want, lp_status_t st, lp_status_t want_st, const char* got) {
+  return st == want_st && strcmp(got, want) == 0;
+}
+
+static void test_appendf(void) {
+  char buf[128];
+  lp_fmtbuf fb;
+  bool ok = true;
+
+#define CHECK(want, ...) \
+  do { fb = lp_fmtbuf_make(buf, sizeof(buf)); \
+       ok &= fmt_is((want), lp_fmt_appendf(&fb, __VA_ARGS__), LP_OK, buf); } while (0)
+
+  CHECK("plain", "plain");
+  CHECK("a 1 b", "a {} b", 1);
+  CHECK("-5 7 18446744073709551615", "{} {} {}", (int8_t)-5, (uint16_t)7, UINT64_MAX);
+  CHECK("-9223372036854775808", "{}", INT64_MIN);
+  // true/'Q' are int constants in C; typed values pick bool/char
+  CHECK("x=true c=Q s=str sv=view", "x={} c={} s={} sv={}", (bool)true, (char)'Q', "str", lp_sv("view"));
+  CHECK("(null)", "{}", (const char*)NULL);
+  CHECK("{} {x}", "{{}} {{x}}");
+
+  // width, alignment, padding, sign
+  CHECK("[   42]", "[{:5}]", 42);
+  CHECK("[42   ]", "[{:-5}]", 42);
+  CHECK("[00042]", "[{:05}]", 42);
+  CHECK("[-0042]", "[{:05}]", -42);
+  CHECK("[  +42]", "[{:+5}]", 42);
+  CHECK("[+0042]", "[{:+05}]", 42);
+  CHECK("[abc  |  abc]", "[{:-5}|{:5}]", "abc", "abc");
+  CHECK("[toolong]", "[{:3}]", "toolong");
+
+  // hex
+  CHECK("ff FF 0 0x1f", "{:x} {:X} {:x} {:#x}", 255, 255u, 0, 31);
+  CHECK("0x0001f", "{:#07x}", 31);
+  CHECK("ffffffff ffffffffffffffff", "{:x} {:x}", -1, (int64_t)-1);
+  CHECK("0x00FF", "{:#06X}", 255);  // prefix stays lower-case
+
+  int local = 0;
+  fb = lp_fmtbuf_make(buf, sizeof(buf));
+  ok &= lp_fmt_appendf(&fb, "{}", (void*)&local) == LP_OK;
+  ok &= buf[0] == '0' && buf[1] == 'x' && fb.len == 2 + sizeof(void*) * 2;
+
+  // errors
+  fb = lp_fmtbuf_make(buf, sizeof(buf));
+  ok &= lp_fmt_appendf(&fb, "{} {}", 1) == LP_ERR_INVALID;
+  ok &= lp_fmt_appendf(&fb, "{}", 1, 2) == LP_ERR_INVALID;
+  ok &= lp_fmt_appendf(&fb, "{", 1) == LP_ERR_INVALID;
+  ok &= lp_fmt_appendf(&fb, "}", 1) == LP_ERR_INVALID;
+  ok &= lp_fmt_appendf(&fb, "{:q}", 1) == LP_ERR_INVALID;
+  ok &= lp_fmt_appendf(&fb, "{:300}", 1) == LP_ERR_INVALID;
+  ok &= lp_fmt_appendf(&fb, "{:x}", "str") == LP_ERR_INVALID;
+
+#undef CHECK
+  T_ASSERT(ok);
+}
+
+// Truncation inside a padded field and inside digits behaves like the
+// single-value appends: longest prefix, NUL-terminated, flag set.
+static void test_appendf_truncation(void) {
+  static const char full[] = "id=  0042|name";
+  bool ok = true;
+  for (size_t cap = 0; cap <= sizeof full + 2; cap++) {
+    char buf[32];
+    memset(buf, '#', sizeof buf);
+    lp_fmtbuf fb = lp_fmtbuf_make(cap ? buf : NULL, cap);
+    ok &= lp_fmt_appendf(&fb, "id={:6}|{}", "0042", "name") == LP_OK;
+    size_t want = (cap == 0) ? 0 : ((cap - 1 < sizeof full - 1) ? cap - 1 : sizeof full - 1);
+    ok &= fb.len == want && fb.truncated == (want != sizeof full - 1);
+    if (cap) ok &= memcmp(buf, full, want) == 0 && buf[want] == '\0';
+    if (cap && cap < sizeof buf) ok &= buf[cap] == '#';
+  }
+  T_ASSERT(ok);
+}
+
+// A cut never leaves half a UTF-8 sequence, and nothing is appended after
+// the gap it leaves ("caf" + "!" would read as a different word).
+static void test_utf8_truncation(void) {
+  static const char text[] = "caf\xC3\xA9 \xE2\x82\xAC" "5 \xF0\x9F\x98\x80!";
+  static const char text_all[] = "caf\xC3\xA9 \xE2\x82\xAC" "5 \xF0\x9F\x98\x80!!7";
+  lp_strview full = lp_sv(text), all = lp_sv(text_all);
+  bool ok = true;
+  for (size_t cap = 1; cap <= all.len + 2; cap++) {
+    for (int how = 0; how < 2; how++) {
+      char buf[64];
+      memset(buf, '#', sizeof buf);
+      lp_fmtbuf fb = lp_fmtbuf_make(buf, cap);
+      if (how == 0) ok &= lp_fmt_append_sv(&fb, full) == LP_OK;
+      else ok &= lp_fmt_appendf(&fb, "{:-3}", text) == LP_OK;
+      ok &= lp_fmt_append_char(&fb, '!') == LP_OK;
+      ok &= lp_fmt_append_u32(&fb, 7) == LP_OK;
+
+      size_t want = lp_utf8_truncate(all, cap - 1).len;
+      ok &= fb.len == want && fb.truncated == (want != all.len);
+      ok &= memcmp(buf, all.ptr, want) == 0 && buf[want] == '\0';
+      if (fb.truncated) ok &= lp_fmt_remaining(&fb) == 0;
+      ok &= lp_utf8_validate(lp_sv_n(buf, fb.len)) == LP_OK;
+      ok &= buf[cap] == '#';
+    }
+  }
+  T_ASSERT(ok);
+}
+
+static void test_compiled(void) {
+  lp_fmt_spec specs[8];
+  lp_fmt_compiled c;
+  char buf[64];
+  bool ok = true;
+
+  ok &= lp_fmt_compile(&c, "[{:4}] {}={:#x}{{ok}}", specs, 8) == LP_OK;
+  ok &= c.nargs == 3;
+
+  for (int i = 0; i < 3; i++) {
+    lp_fmtbuf fb = lp_fmtbuf_make(buf, sizeof(buf));
+    ok &= lp_fmt_appendcf(&fb, &c, i, "key", 255u + (unsigned)i) == LP_OK;
+    char want[64];
+    snprintf(want, sizeof want, "[%4d] key=%#x{ok}", i, 255u + (unsigned)i);
+    ok &= strcmp(buf, want) == 0;
+  }
+
+  lp_fmtbuf fb = lp_fmtbuf_make(buf, sizeof(buf));
+  ok &= lp_fmt_appendcf(&fb, &c, 1, "key") == LP_ERR_INVALID;
+  ok &= fb.len == 0;
+
+  ok &= lp_fmt_compile(&c, "a{}b{}c{}d", specs, 3) == LP_ERR_RANGE;
+  ok &= lp_fmt_compile(&c, "a{}b{}c{}d", specs, 4) == LP_OK && c.count == 4;
+  ok &= lp_fmt_compile(&c, "bad{", specs, 8) == LP_ERR_INVALID;
+
+  ok &= lp_fmt_compile(&c, "no fields", specs, 8) == LP_OK && c.nargs == 0;
+  fb = lp_fmtbuf_make(buf, sizeof(buf));
+  ok &= lp_fmt_appendc(&fb, &c, NULL, 0) == LP_OK && strcmp(buf, "no fields") == 0;
+
+  T_ASSERT(ok);
+}
+
 int main(void) {
   test_basic_append();
   test_truncation();
   test_decimal();
+  test_decimal_vs_snprintf();
+  test_decimal_truncation();
+  test_appendf();
+  test_appendf_truncation();
+  test_utf8_truncation();
+  test_compiled();
   test_hex_fixed_width();
   return g_fail ? 1 : 0;
 }
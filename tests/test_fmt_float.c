@@ -0,0 +1,242 @@
+#include "lp/lp.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+static const char* f64s(char* buf, size_t cap, double v) {
+  lp_fmtbuf fb = lp_fmtbuf_make(buf, cap);
+  lp_fmt_append_f64(&fb, v);
+  return buf;
+}
+
+static const char* f32s(char* buf, size_t cap, float v) {
+  lp_fmtbuf fb = lp_fmtbuf_make(buf, cap);
+  lp_fmt_append_f32(&fb, v);
+  return buf;
+}
+
+// Significant digits, ignoring leading and trailing zeros.
+static int sig_digits(const char* s) {
+  int n = 0, z = 0;
+  bool started = false;
+  for (; *s && *s != 'e'; s++) {
+    if (*s < '0' || *s > '9') continue;
+    if (*s != '0') { started = true; z = 0; }
+    else if (started) z++;
+    if (started) n++;
+  }
+  return n - z;
+}
+
+// Fewest digits that round-trip, found the slow way through libc.
+static int shortest_f64(double v) {
+  char r[40];
+  for (int p = 1; p < 17; p++) {
+    snprintf(r, sizeof r, "%.*e", p - 1, v);
+    if (strtod(r, NULL) == v) return p;
+  }
+  return 17;
+}
+
+static int shortest_f32(float v) {
+  char r[40];
+  for (int p = 1; p < 9; p++) {
+    snprintf(r, sizeof r, "%.*e", p - 1, (double)v);
+    if (strtof(r, NULL) == v) return p;
+  }
+  return 9;
+}
+
+static void test_vectors(void) {
+  char b[64];
+  bool ok = true;
+
+  ok &= strcmp(f64s(b, sizeof b, 0.0), "0") == 0;
+  ok &= strcmp(f64s(b, sizeof b, -0.0), "-0") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 1.0), "1") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 0.1), "0.1") == 0;
+  ok &= strcmp(f64s(b, sizeof b, -2.5), "-2.5") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 123456.0), "123456") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 0.3), "0.3") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 0.1 + 0.2), "0.30000000000000004") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 1e-4), "0.0001") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 1.5e-5), "1.5e-05") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 1e16), "10000000000000000") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 1e17), "1e+17") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 1e21), "1e+21") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 5e-324), "5e-324") == 0;
+  ok &= strcmp(f64s(b, sizeof b, DBL_MAX), "1.7976931348623157e+308") == 0;
+  ok &= strcmp(f64s(b, sizeof b, DBL_MIN), "2.2250738585072014e-308") == 0;
+  ok &= strcmp(f64s(b, sizeof b, 9007199254740993.0), "9007199254740992") == 0;
+  ok &= strcmp(f64s(b, sizeof b, INFINITY), "inf") == 0;
+  ok &= strcmp(f64s(b, sizeof b, -INFINITY), "-inf") == 0;
+  ok &= strcmp(f64s(b, sizeof b, NAN), "nan") == 0;
+
+  ok &= strcmp(f32s(b, sizeof b, 0.1f), "0.1") == 0;
+  ok &= strcmp(f32s(b, sizeof b, 1.0f / 3.0f), "0.33333334") == 0;
+  ok &= strcmp(f32s(b, sizeof b, 16777216.0f), "16777216") == 0;
+  ok &= strcmp(f32s(b, sizeof b, FLT_MAX), "3.4028235e+38") == 0;
+  ok &= strcmp(f32s(b, sizeof b, FLT_MIN), "1.1754944e-38") == 0;
+  ok &= strcmp(f32s(b, sizeof b, 1e-45f), "1e-45") == 0;
+
+  T_ASSERT(ok);
+}
+
+static void test_random_f64(void) {
+  char b[64];
+  int bad = 0;
+  for (int i = 0; i < 200000; i++) {
+    uint64_t bits = rnd64();
+    double v;
+    memcpy(&v, &bits, sizeof v);
+    if (isnan(v) || isinf(v)) continue;
+
+    f64s(b, sizeof b, v);
+    double back = strtod(b, NULL);
+    if (memcmp(&back, &v, sizeof v) != 0) { bad++; continue; }
+    // the (cheaper) shortness check on a subset
+    if ((i & 7) == 0 && sig_digits(b) > shortest_f64(v)) bad++;
+  }
+  T_ASSERT(bad == 0);
+}
+
+// Every float when run with --exhaustive (a few minutes); otherwise a
+// stride through the whole bit space that still hits every binade.
+static void test_f32_sweep(uint64_t stride) {
+  char b[64];
+  long bad = 0;
+  for (uint64_t u = 0; u <= 0xFFFFFFFFull; u += stride) {
+    uint32_t bits = (uint32_t)u;
+    float v;
+    memcpy(&v, &bits, sizeof v);
+    if (isnan(v) || isinf(v)) continue;
+
+    f32s(b, sizeof b, v);
+    float back = strtof(b, NULL);
+    if (memcmp(&back, &v, sizeof v) != 0) { bad++; continue; }
+    if (sig_digits(b) > shortest_f32(v)) bad++;
+  }
+  T_ASSERT(bad == 0);
+}
+
+// printf("%.*f") prints the exact binary value; fixed mode rounds the
+// shortest digits instead. They must agree unless the cut falls past the
+// shortest digits, or those digits end in a 5 right at the cut.
+static bool printf_may_differ(double v, uint32_t prec) {
+  char r[40];
+  int n = shortest_f64(v);
+  snprintf(r, sizeof r, "%.*e", n - 1, v);
+  const char* e = strchr(r, 'e');
+  int keep = atoi(e + 1) + 1 + (int)prec;
+  return keep >= n || (n == keep + 1 && e[-1] == '5');
+}
+
+static void test_fixed(void) {
+  char b[512], r[512];
+  bool ok = true;
+
+#define FIX(v, p, want) \
+  do { lp_fmtbuf fb = lp_fmtbuf_make(b, sizeof b); lp_fmt_append_f64_fixed(&fb, (v), (p)); \
+       ok &= strcmp(b, (want)) == 0; } while (0)
+
+  FIX(0.0, 2, "0.00");
+  FIX(-0.0, 1, "-0.0");
+  FIX(1.0, 0, "1");
+  FIX(0.5, 0, "0");
+  FIX(1.5, 0, "2");
+  FIX(2.5, 0, "2");
+  FIX(9.995, 2, "10.00"); // shortest digits tie; printf gives 9.99 (see lp_fmt.h)
+  FIX(9.9949, 2, "9.99");
+  FIX(0.125, 2, "0.12");
+  FIX(0.375, 2, "0.38");
+  FIX(123.456, 1, "123.5");
+  FIX(0.0004, 3, "0.000");
+  FIX(0.0006, 3, "0.001");
+  FIX(-0.0004, 3, "-0.000");
+  FIX(1e-10, 12, "0.000000000100");
+  FIX(1e20, 2, "100000000000000000000.00");
+  FIX(NAN, 2, "nan");
+  FIX(-INFINITY, 2, "-inf");
+
+  lp_fmtbuf fb = lp_fmtbuf_make(b, sizeof b);
+  ok &= lp_fmt_append_f64_fixed(&fb, 1.0, LP_FMT_MAX_PRECISION + 1u) == LP_ERR_RANGE;
+  fb = lp_fmtbuf_make(b, sizeof b);
+  ok &= lp_fmt_append_f32_fixed(&fb, 0.1f, 3) == LP_OK && strcmp(b, "0.100") == 0;
+
+  // dyadic values: shortest digits are exact, so printf must agree
+  for (int i = 0; i < 20000; i++) {
+    double v = (double)(int64_t)(rnd64() % 2000001u - 1000000) / (double)(1u << (rnd64() % 20u));
+    uint32_t p = (uint32_t)(rnd64() % 8u);
+    FIX(v, p, (snprintf(r, sizeof r, "%.*f", (int)p, v), r));
+  }
+
+  // general values
+  int mismatches = 0;
+  for (int i = 0; i < 20000; i++) {
+    double v = ldexp((double)(rnd64() >> 11), -(int)(rnd64() % 60u)) * ((rnd64() & 1) ? 1 : -1);
+    uint32_t p = (uint32_t)(rnd64() % 10u);
+    snprintf(r, sizeof r, "%.*f", (int)p, v);
+    fb = lp_fmtbuf_make(b, sizeof b);
+    lp_fmt_append_f64_fixed(&fb, v, p);
+    if (strcmp(b, r) != 0 && !printf_may_differ(v, p)) mismatches++;
+  }
+  ok &= mismatches == 0;
+
+#undef FIX
+  T_ASSERT(ok);
+}
+
+static void test_appendf_floats(void) {
+  char b[128];
+  lp_fmtbuf fb = lp_fmtbuf_make(b, sizeof b);
+  T_ASSERT(lp_fmt_appendf(&fb, "{} {} {:.2} [{:8.3}] [{:-7.1}] [{:+08.2}] [{:6}]",
+                          0.5, 0.25f, 3.14159, -2.0, 1.25, 3.5, -INFINITY) == LP_OK);
+  T_ASSERT(strcmp(b, "0.5 0.25 3.14 [  -2.000] [1.2    ] [+0003.50] [  -inf]") == 0);
+
+  fb = lp_fmtbuf_make(b, sizeof b);
+  T_ASSERT(lp_fmt_appendf(&fb, "{:x}", 1.0) == LP_ERR_INVALID);
+  T_ASSERT(lp_fmt_appendf(&fb, "{:.2}", 1) == LP_ERR_INVALID);
+  T_ASSERT(lp_fmt_appendf(&fb, "{:.}", 1.0) == LP_ERR_INVALID);
+}
+
+static void test_truncation(void) {
+  static const char full[] = "-1.7976931348623157e+308";
+  bool ok = true;
+  for (size_t cap = 0; cap <= sizeof full + 1; cap++) {
+    char b[40];
+    memset(b, '#', sizeof b);
+    lp_fmtbuf fb = lp_fmtbuf_make(cap ? b : NULL, cap);
+    ok &= lp_fmt_append_f64(&fb, -DBL_MAX) == LP_OK;
+    size_t want = (cap == 0) ? 0 : ((cap - 1 < sizeof full - 1) ? cap - 1 : sizeof full - 1);
+    ok &= fb.len == want && fb.truncated == (want != sizeof full - 1);
+    if (cap) ok &= memcmp(b, full, want) == 0 && b[want] == '\0' && b[cap] == '#';
+  }
+  T_ASSERT(ok);
+}
+
+int main(int argc, char** argv) {
+  bool exhaustive = (argc > 1 && strcmp(argv[1], "--exhaustive") == 0);
+
+  test_vectors();
+  test_random_f64();
+  test_f32_sweep(exhaustive ? 1u : 4099u);
+  test_fixed();
+  test_appendf_floats();
+  test_truncation();
+  return g_fail ? 1 : 0;
+}
@@ -0,0 +1,238 @@
+#include "lp/lp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+static void fill_random(uint8_t* p, size_t n) {
+  for (size_t i = 0; i < n; i++) p[i] = (uint8_t)rnd64();
+}
+
+static int cmp_u64(const void* a, const void* b) {
+  uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+  return (x > y) - (x < y);
+}
+
+// Number of equal adjacent pairs after sorting (h is sorted in place).
+static size_t collisions(uint64_t* h, size_t n, uint64_t mask) {
+  for (size_t i = 0; i < n; i++) h[i] &= mask;
+  qsort(h, n, sizeof h[0], cmp_u64);
+  size_t c = 0;
+  for (size_t i = 1; i < n; i++) c += (h[i] == h[i - 1]);
+  return c;
+}
+
+// Output values are part of the contract (they may be persisted).
+static void test_pinned(void) {
+  static const char* const keys[] = {
+    "", "a", "abc", "message digest", "abcdefghijklmnopqrstuvwxyz",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+    "12345678901234567890123456789012345678901234567890123456789012345678901234567890",
+  };
+  static const uint64_t want[] = {
+    0x93228A4DE0EEC5A2ull, 0xC5BAC3DB178713C4ull, 0xA97F2F7B1D9B3314ull, 0x786D1F1DF3801DF4ull,
+    0xDCA5A8138AD37C87ull, 0xB9E734F117CFAF70ull, 0x6CC5EAB49A92D617ull,
+  };
+  for (size_t i = 0; i < sizeof keys / sizeof keys[0]; i++) {
+    T_ASSERT(lp_hash64(keys[i], strlen(keys[i]), (uint64_t)i) == want[i]);
+    T_ASSERT(lp_hash_sv(lp_sv(keys[i]), (uint64_t)i) == want[i]);
+  }
+  T_ASSERT(lp_hash64(NULL, 0, 0) == lp_hash64("", 0, 0));
+  T_ASSERT(lp_hash_u64(0, 0) == 0u); // fmix64 maps 0 to 0
+  T_ASSERT(lp_hash_u64(1, 0) == 0xB456BCFC34C2CB2Cull);
+}
+
+// Every split of the input, at every length around the 16/48-byte
+// thresholds, gives the one-shot value.
+static void test_streaming(void) {
+  static uint8_t buf[400];
+  fill_random(buf, sizeof buf);
+  bool ok = true;
+  for (size_t n = 0; n <= 200; n++) {
+    uint64_t seed = rnd64();
+    uint64_t want = lp_hash64(buf, n, seed);
+    for (size_t cut = 0; cut <= n; cut++) {
+      lp_hash64_state st;
+      lp_hash64_init(&st, seed);
+      lp_hash64_update(&st, buf, cut);
+      lp_hash64_update(&st, buf + cut, n - cut);
+      ok &= lp_hash64_final(&st) == want;
+    }
+    for (int rep = 0; rep < 20; rep++) {
+      lp_hash64_state st;
+      lp_hash64_init(&st, seed);
+      size_t i = 0;
+      while (i < n) {
+        size_t k = 1u + (size_t)(rnd64() % 60u);
+        if (k > n - i) k = n - i;
+        lp_hash64_update(&st, buf + i, k);
+        i += k;
+      }
+      ok &= lp_hash64_final(&st) == want;
+      ok &= lp_hash64_final(&st) == want; // final doesn't consume
+    }
+  }
+  lp_hash64_state st;
+  lp_hash64_init(&st, 7);
+  lp_hash64_update(&st, buf, sizeof buf);
+  ok &= lp_hash64_final(&st) == lp_hash64(buf, sizeof buf, 7);
+  T_ASSERT(ok);
+}
+
+// SMHasher "Avalanche": flipping any input bit flips each output bit with
+// probability 1/2. With 4000 samples per cell the standard deviation is
+// under 0.008, so a bias of 0.05 is far outside noise.
+static void test_avalanche(void) {
+  static const size_t lens[] = { 3, 4, 8, 12, 16, 17, 32, 48, 49, 64, 100 };
+  enum { SAMPLES = 4000 };
+  static uint32_t flips[100 * 8][64];
+  double worst = 0.0;
+  for (size_t li = 0; li < sizeof lens / sizeof lens[0]; li++) {
+    size_t n = lens[li];
+    memset(flips, 0, sizeof flips);
+    uint8_t key[100];
+    for (int s = 0; s < SAMPLES; s++) {
+      fill_random(key, n);
+      uint64_t h0 = lp_hash64(key, n, 0);
+      for (size_t bit = 0; bit < n * 8u; bit++) {
+        key[bit >> 3] ^= (uint8_t)(1u << (bit & 7u));
+        uint64_t d = h0 ^ lp_hash64(key, n, 0);
+        key[bit >> 3] ^= (uint8_t)(1u << (bit & 7u));
+        for (uint32_t o = 0; o < 64; o++) flips[bit][o] += (uint32_t)((d >> o) & 1u);
+      }
+    }
+    for (size_t bit = 0; bit < n * 8u; bit++) {
+      for (uint32_t o = 0; o < 64; o++) {
+        double bias = (double)flips[bit][o] / SAMPLES - 0.5;
+        if (bias < 0) bias = -bias;
+        if (bias > worst) worst = bias;
+      }
+    }
+  }
+  T_ASSERT(worst < 0.05);
+
+  // same for the integer finalizer and for the seed
+  double worst_u64 = 0.0, worst_seed = 0.0;
+  for (uint32_t bit = 0; bit < 64; bit++) {
+    uint32_t cnt[64] = { 0 }, cnt_seed[64] = { 0 };
+    for (int s = 0; s < SAMPLES; s++) {
+      uint64_t x = rnd64(), seed = rnd64();
+      uint64_t d = lp_hash_u64(x, seed) ^ lp_hash_u64(x ^ (1ull << bit), seed);
+      uint64_t e = lp_hash64(&x, 8, seed) ^ lp_hash64(&x, 8, seed ^ (1ull << bit));
+      for (uint32_t o = 0; o < 64; o++) {
+        cnt[o] += (uint32_t)((d >> o) & 1u);
+        cnt_seed[o] += (uint32_t)((e >> o) & 1u);
+      }
+    }
+    for (uint32_t o = 0; o < 64; o++) {
+      double b0 = (double)cnt[o] / SAMPLES - 0.5, b1 = (double)cnt_seed[o] / SAMPLES - 0.5;
+      if (b0 < 0) b0 = -b0;
+      if (b1 < 0) b1 = -b1;
+      if (b0 > worst_u64) worst_u64 = b0;
+      if (b1 > worst_seed) worst_seed = b1;
+    }
+  }
+  T_ASSERT(worst_u64 < 0.05);
+  T_ASSERT(worst_seed < 0.05);
+}
+
+// SMHasher "Sparse" and "TwoBytes"/"Zeroes": highly structured key sets.
+// None may collide in 64 bits; in the low 32 bits the count must stay near
+// the n^2 / 2^33 a random function gives.
+static void test_structured_keys(void) {
+  // 32-byte keys with at most two bits set: 1 + 256 + 32640 keys
+  size_t n = 0;
+  uint64_t* h = (uint64_t*)malloc(70000 * sizeof(uint64_t));
+  uint64_t* h2 = (uint64_t*)malloc(70000 * sizeof(uint64_t));
+  if (!h || !h2) { g_fail++; free(h); free(h2); return; }
+  uint8_t key[32] = { 0 };
+  h[n++] = lp_hash64(key, 32, 0);
+  for (uint32_t i = 0; i < 256; i++) {
+    key[i >> 3] ^= (uint8_t)(1u << (i & 7u));
+    h[n++] = lp_hash64(key, 32, 0);
+    for (uint32_t j = i + 1u; j < 256; j++) {
+      key[j >> 3] ^= (uint8_t)(1u << (j & 7u));
+      h[n++] = lp_hash64(key, 32, 0);
+      key[j >> 3] ^= (uint8_t)(1u << (j & 7u));
+    }
+    key[i >> 3] ^= (uint8_t)(1u << (i & 7u));
+  }
+  memcpy(h2, h, n * sizeof h[0]);
+  T_ASSERT(collisions(h, n, ~0ull) == 0u);
+  T_ASSERT(collisions(h2, n, 0xFFFFFFFFull) <= 3u); // expect ~0.12
+
+  // every 1- and 2-byte key, and zero runs of every length up to 4 KiB:
+  // length must matter even when the bytes are all the same
+  n = 0;
+  for (uint32_t v = 0; v < 256; v++) {
+    uint8_t b = (uint8_t)v;
+    h[n++] = lp_hash64(&b, 1, 0);
+  }
+  for (uint32_t v = 0; v < 65536; v++) {
+    uint8_t b[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+    h[n++] = lp_hash64(b, 2, 0);
+  }
+  static uint8_t zeros[4096];
+  for (size_t len = 0; len <= 4096; len++) {
+    if (len != 1 && len != 2) h[n++] = lp_hash64(zeros, len, 0); // 1, 2: already above
+  }
+  memcpy(h2, h, n * sizeof h[0]);
+  T_ASSERT(collisions(h, n, ~0ull) == 0u);
+  T_ASSERT(collisions(h2, n, 0xFFFFFFFFull) <= 4u); // expect ~0.6
+
+  free(h);
+  free(h2);
+}
+
+// Hash-table use: identifier-like keys and sequential integers spread
+// evenly over 4096 buckets (chi-square, 4095 degrees of freedom; the 0.1%
+// critical value is about 4380).
+static double chi2(const uint32_t* counts, size_t buckets, size_t n) {
+  double e = (double)n / (double)buckets, x = 0.0;
+  for (size_t i = 0; i < buckets; i++) {
+    double d = (double)counts[i] - e;
+    x += d * d / e;
+  }
+  return x;
+}
+
+static void test_buckets(void) {
+  enum { B = 4096, N = 400000 };
+  static uint32_t lo[B], hi[B], ints[B], ints_lo[B];
+  char key[32];
+  for (uint32_t i = 0; i < N; i++) {
+    lp_fmtbuf fb = lp_fmtbuf_make(key, sizeof key);
+    lp_fmt_appendf(&fb, "field_{}", i);
+    uint64_t h = lp_hash64(key, fb.len, 0);
+    lo[h & (B - 1u)]++;
+    hi[h >> 52]++;
+    uint64_t x = i;
+    ints[lp_hash64(&x, sizeof x, 0) & (B - 1u)]++;
+    ints_lo[lp_hash_u64(x, 0) & (B - 1u)]++;
+  }
+  T_ASSERT(chi2(lo, B, N) < 4380.0);
+  T_ASSERT(chi2(hi, B, N) < 4380.0);
+  T_ASSERT(chi2(ints, B, N) < 4380.0);
+  T_ASSERT(chi2(ints_lo, B, N) < 4380.0);
+}
+
+int main(void) {
+  test_pinned();
+  test_streaming();
+  test_avalanche();
+  test_structured_keys();
+  test_buckets();
+  return g_fail ? 1 : 0;
+}
@@ -0,0 +1,255 @@
+#include "lp/lp.h"
+#include <string.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+static bool same(const lp_hist* a, const lp_hist* b) {
+  return a->nbuckets == b->nbuckets && a->total == b->total && a->sum == b->sum && a->min == b->min &&
+         a->max == b->max && a->clamped == b->clamped &&
+         memcmp(a->counts, b->counts, a->nbuckets * sizeof(uint64_t)) == 0;
+}
+
+static void test_init(void) {
+  T_ASSERT(lp_hist_buckets(7, 40) == 34u * 128u);
+  T_ASSERT(lp_hist_buckets(1, 64) == 64u * 2u);
+  T_ASSERT(lp_hist_buckets(0, 10) == 0);
+  T_ASSERT(lp_hist_buckets(17, 40) == 0);
+  T_ASSERT(lp_hist_buckets(8, 8) == 0);
+  T_ASSERT(lp_hist_buckets(8, 65) == 0);
+
+  uint64_t counts[64];
+  lp_hist h;
+  T_ASSERT(lp_hist_init(&h, counts, 64, 0, 10) == LP_ERR_INVALID);
+  T_ASSERT(lp_hist_init(&h, counts, 63, 3, 10) == LP_ERR_NOMEM); // needs 64
+  T_ASSERT(lp_hist_init(&h, counts, 64, 3, 10) == LP_OK);
+  T_ASSERT(h.nbuckets == 64 && h.highest == 1023u);
+  T_ASSERT(lp_hist_percentile(&h, 50.0) == 0 && lp_hist_mean(&h) == 0);
+
+  static uint64_t amem[512];
+  lp_arena a;
+  lp_arena_init(&a, amem, sizeof amem);
+  T_ASSERT(lp_hist_init_arena(&h, &a, 7, 40) == LP_ERR_NOMEM); // 4352 counters
+  T_ASSERT(lp_hist_init_arena(&h, &a, 3, 10) == LP_OK && a.off == 64u * 8u);
+}
+
+// Indices stay in range and in order, and every bucket is narrower than
+// 2^-sub_bits of the values in it.
+static void test_index(void) {
+  for (uint32_t sub = 1; sub <= 10; sub++) {
+    size_t n = lp_hist_buckets(sub, 64);
+    bool ok = true;
+    size_t prev = 0;
+    for (uint64_t v = 0; v < 100000u; v++) {
+      size_t i = lp__hist_index(v, sub);
+      ok &= i >= prev && i - prev <= 1u && i < n;
+      prev = i;
+    }
+    for (int k = 0; k < 100000; k++) {
+      uint64_t v = rnd64() >> (rnd64() & 63u);
+      size_t i = lp__hist_index(v, sub);
+      ok &= i < n && lp__hist_index(v + (v != UINT64_MAX), sub) >= i;
+    }
+    ok &= lp__hist_index(UINT64_MAX, sub) == n - 1u;
+    T_ASSERT(ok);
+  }
+
+  uint64_t counts[4352];
+  lp_hist h;
+  T_ASSERT(lp_hist_init(&h, counts, 4352, 7, 40) == LP_OK);
+  bool ok = true;
+  for (int k = 0; k < 20000; k++) {
+    uint64_t v = (rnd64() >> (rnd64() % 40u)) & h.highest;
+    lp_hist_reset(&h);
+    lp_hist_record(&h, v);
+    lp_hist_record(&h, h.highest); // so the top isn't clamped to v
+    uint64_t p = lp_hist_percentile(&h, 50.0);
+    ok &= p >= v && (double)(p - v) <= (double)v / 128.0;
+  }
+  T_ASSERT(ok);
+}
+
+static void test_percentiles(void) {
+  static uint64_t counts[4352];
+  lp_hist h;
+  T_ASSERT(lp_hist_init(&h, counts, 4352, 7, 40) == LP_OK);
+  for (uint64_t v = 1; v <= 100000u; v++) lp_hist_record(&h, v);
+  T_ASSERT(h.total == 100000u && h.min == 1u && h.max == 100000u);
+  T_ASSERT(lp_hist_mean(&h) == 50000u);
+
+  static const double ps[] = { 0.0, 1.0, 50.0, 90.0, 99.0, 99.9, 100.0 };
+  uint64_t out[7];
+  lp_hist_percentiles(&h, ps, out, 7);
+  bool ok = true;
+  for (int k = 1; k < 6; k++) {
+    double want = ps[k] * 1000.0;
+    ok &= (double)out[k] >= want && (double)out[k] <= want * (1.0 + 1.0 / 128.0);
+    ok &= out[k] == lp_hist_percentile(&h, ps[k]);
+  }
+  T_ASSERT(ok);
+  T_ASSERT(out[0] == 1u && out[6] == 100000u);
+
+  // record_n is n records
+  lp_hist_reset(&h);
+  lp_hist_record_n(&h, 7, 3);
+  lp_hist_record(&h, 1000);
+  T_ASSERT(h.total == 4 && h.sum == 1021u);
+  T_ASSERT(lp_hist_percentile(&h, 75.0) == 7u && lp_hist_percentile(&h, 76.0) == 1000u);
+}
+
+static void test_clamp(void) {
+  uint64_t counts[64];
+  lp_hist h;
+  T_ASSERT(lp_hist_init(&h, counts, 64, 3, 10) == LP_OK);
+  lp_hist_record(&h, 5000);
+  lp_hist_record(&h, UINT64_MAX);
+  lp_hist_record(&h, 3);
+  T_ASSERT(h.clamped == 2 && h.max == 1023u && counts[63] == 2u);
+  T_ASSERT(lp_hist_percentile(&h, 100.0) == 1023u);
+  T_ASSERT(lp_hist_percentile(&h, 10.0) == 3u);
+}
+
+static void test_merge(void) {
+  static uint64_t ca[4352], cb[4352], cc[4352], cs[1152];
+  lp_hist a, b, all, small;
+  T_ASSERT(lp_hist_init(&a, ca, 4352, 7, 40) == LP_OK);
+  T_ASSERT(lp_hist_init(&b, cb, 4352, 7, 40) == LP_OK);
+  T_ASSERT(lp_hist_init(&all, cc, 4352, 7, 40) == LP_OK);
+  T_ASSERT(lp_hist_init(&small, cs, 1152, 7, 15) == LP_OK);
+  for (int k = 0; k < 10000; k++) {
+    uint64_t v = rnd64() >> (24u + rnd64() % 40u);
+    lp_hist_record((k & 1) ? &a : &b, v);
+    lp_hist_record(&all, v);
+  }
+  T_ASSERT(lp_hist_merge(&a, &b) == LP_OK);
+  T_ASSERT(same(&a, &all));
+
+  // a narrower destination folds the top into its last bucket
+  T_ASSERT(lp_hist_merge(&small, &all) == LP_OK);
+  T_ASSERT(small.total == all.total && small.max <= small.highest);
+  uint64_t above = 0;
+  for (size_t i = 0; i < all.nbuckets; i++) {
+    if (i >= small.nbuckets) above += cc[i];
+  }
+  T_ASSERT(small.clamped == all.clamped + above);
+
+  uint64_t c3[64];
+  lp_hist other;
+  T_ASSERT(lp_hist_init(&other, c3, 64, 3, 10) == LP_OK);
+  T_ASSERT(lp_hist_merge(&other, &all) == LP_ERR_INVALID);
+
+  // merging an empty histogram changes nothing
+  lp_hist_reset(&b);
+  T_ASSERT(lp_hist_merge(&a, &b) == LP_OK && same(&a, &all));
+}
+
+static void test_encode(void) {
+  static uint64_t ca[4352], cb[4352];
+  lp_hist a, b;
+  T_ASSERT(lp_hist_init(&a, ca, 4352, 7, 40) == LP_OK);
+  T_ASSERT(lp_hist_init(&b, cb, 4352, 7, 40) == LP_OK);
+
+  uint8_t buf[4096];
+  size_t len = 0;
+  T_ASSERT(lp_hist_encode(&a, (lp_span_u8_mut){ buf, sizeof buf }, &len) == LP_OK);
+  T_ASSERT(len == lp_hist_encoded_len(&a) && len == 8);
+  T_ASSERT(lp_hist_decode_add(&b, (lp_span_u8){ buf, len }) == LP_OK && same(&a, &b));
+
+  for (int k = 0; k < 5000; k++) lp_hist_record(&a, 1000u + (rnd64() % 50000u));
+  lp_hist_record(&a, 1ull << 45); // clamped
+  len = lp_hist_encoded_len(&a);
+  T_ASSERT(len < 2500); // ~1.5 KiB of non-empty buckets, vs 34 KiB of counters
+  size_t got = 0;
+  T_ASSERT(lp_hist_encode(&a, (lp_span_u8_mut){ buf, len - 1u }, &got) == LP_ERR_RANGE && got == 0);
+  T_ASSERT(lp_hist_encode(&a, (lp_span_u8_mut){ buf, sizeof buf }, &got) == LP_OK && got == len);
+  T_ASSERT(lp_hist_decode_add(&b, (lp_span_u8){ buf, len }) == LP_OK && same(&a, &b));
+
+  // decode adds, like merge
+  T_ASSERT(lp_hist_decode_add(&b, (lp_span_u8){ buf, len }) == LP_OK);
+  T_ASSERT(b.total == 2u * a.total && b.clamped == 2u);
+
+  // every strict prefix is rejected and leaves the target alone
+  lp_hist_reset(&b);
+  bool ok = true;
+  for (size_t n = 0; n < len; n++) ok &= lp_hist_decode_add(&b, (lp_span_u8){ buf, n }) == LP_ERR_INVALID;
+  ok &= b.total == 0 && b.min == UINT64_MAX;
+  for (size_t i = 0; i < b.nbuckets; i++) ok &= cb[i] == 0;
+  T_ASSERT(ok);
+
+  static uint8_t bad[4096];
+  memcpy(bad, buf, len);
+  bad[0] = 2; // version
+  T_ASSERT(lp_hist_decode_add(&b, (lp_span_u8){ bad, len }) == LP_ERR_INVALID);
+  memcpy(bad, buf, len);
+  bad[1] = 6; // sub_bits
+  T_ASSERT(lp_hist_decode_add(&b, (lp_span_u8){ bad, len }) == LP_ERR_INVALID);
+  uint8_t trailing[4096];
+  memcpy(trailing, buf, len);
+  trailing[len] = 0;
+  trailing[len + 1u] = 1; // one count past total
+  T_ASSERT(lp_hist_decode_add(&b, (lp_span_u8){ trailing, len + 2u }) == LP_ERR_INVALID);
+  T_ASSERT(b.total == 0);
+}
+
+static void test_dump(void) {
+  uint64_t counts[64];
+  lp_hist h;
+  T_ASSERT(lp_hist_init(&h, counts, 64, 3, 10) == LP_OK);
+  char line[160];
+  lp_fmtbuf fb = lp_fmtbuf_make(line, sizeof line);
+  T_ASSERT(lp_hist_dump(&fb, "rtt", &h) == LP_OK);
+  T_ASSERT(lp_sv_eq(lp_sv(line), lp_sv("rtt: n=0 min=0 p50=0 p90=0 p99=0 p999=0 max=0 mean=0 clamped=0")));
+
+  for (uint64_t v = 1; v <= 10; v++) lp_hist_record(&h, v);
+  lp_hist_record(&h, 2000);
+  fb = lp_fmtbuf_make(line, sizeof line);
+  T_ASSERT(lp_hist_dump(&fb, NULL, &h) == LP_OK);
+  T_ASSERT(lp_sv_eq(lp_sv(line), lp_sv("hist: n=11 min=1 p50=6 p90=10 p99=1023 p999=1023 max=1023 mean=98 clamped=1")));
+
+  // base64url of the binary form, in pieces that decode back to it
+  uint8_t bin[256];
+  size_t len = 0;
+  T_ASSERT(lp_hist_encode(&h, (lp_span_u8_mut){ bin, sizeof bin }, &len) == LP_OK);
+  char text[512];
+  fb = lp_fmtbuf_make(text, sizeof text);
+  T_ASSERT(lp_hist_dump_encoded(&fb, &h) == LP_OK);
+  uint8_t back[256];
+  size_t blen = 0;
+  T_ASSERT(lp_base64_decode((lp_span_u8_mut){ back, sizeof back }, lp_sv_n(text, fb.len), LP_BASE64_URL, &blen) == LP_OK);
+  T_ASSERT(blen == len && memcmp(back, bin, len) == 0);
+
+  // longer than one chunk, and a buffer that's too small
+  static uint64_t big[4352];
+  lp_hist g;
+  T_ASSERT(lp_hist_init(&g, big, 4352, 7, 40) == LP_OK);
+  for (uint64_t v = 0; v < 300; v++) lp_hist_record(&g, v * 37u);
+  static char gtext[4096];
+  static uint8_t gbin[4096], gback[4096];
+  fb = lp_fmtbuf_make(gtext, sizeof gtext);
+  T_ASSERT(lp_hist_dump_encoded(&fb, &g) == LP_OK);
+  T_ASSERT(lp_hist_encode(&g, (lp_span_u8_mut){ gbin, sizeof gbin }, &len) == LP_OK);
+  T_ASSERT(lp_base64_decode((lp_span_u8_mut){ gback, sizeof gback }, lp_sv_n(gtext, fb.len), LP_BASE64_URL, &blen) == LP_OK);
+  T_ASSERT(blen == len && len > 48u && memcmp(gback, gbin, len) == 0);
+  fb = lp_fmtbuf_make(text, 16);
+  T_ASSERT(lp_hist_dump_encoded(&fb, &g) == LP_OK && fb.truncated);
+}
+
+int main(void) {
+  test_init();
+  test_index();
+  test_percentiles();
+  test_clamp();
+  test_merge();
+  test_encode();
+  test_dump();
+  return g_fail ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+#include "lp/lp.h"
+#include <pthread.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static size_t key_of(char* buf, size_t cap, uint32_t i) {
+  lp_fmtbuf fb = lp_fmtbuf_make(buf, cap);
+  lp_fmt_appendf(&fb, "field.{}", i);
+  return fb.len;
+}
+
+static void test_basic(void) {
+  static uint64_t mem[4096];
+  lp_arena a;
+  lp_arena_init(&a, mem, sizeof mem);
+  lp_interner in;
+  T_ASSERT(lp_intern_init(&in, &a, 0, 0) == LP_ERR_INVALID);
+  T_ASSERT(lp_intern_init(&in, &a, LP_INTERN_MAX_IDS + 1u, 0) == LP_ERR_INVALID);
+  T_ASSERT(lp_intern_init(&in, &a, 4, 0x80) == LP_ERR_INVALID);
+  T_ASSERT(lp_intern_init(&in, &a, 100, 0) == LP_OK);
+  T_ASSERT(a.off <= lp_intern_table_size(100));
+  T_ASSERT(lp_intern_count(&in) == 0);
+  T_ASSERT(lp_intern_find(&in, lp_sv("host")) == LP_INTERN_NONE);
+
+  // canonical views: equal strings share one copy, distinct ones don't
+  char buf[8] = "host";
+  lp_intern_id id0 = LP_INTERN_NONE, id1 = LP_INTERN_NONE, id2 = LP_INTERN_NONE;
+  lp_strview c0, c1, c2;
+  T_ASSERT(lp_intern(&in, lp_sv("host"), &id0, &c0) == LP_OK);
+  T_ASSERT(lp_intern(&in, lp_sv("port"), &id1, &c1) == LP_OK);
+  T_ASSERT(lp_intern(&in, lp_sv_n(buf, 4), &id2, &c2) == LP_OK);
+  T_ASSERT(id0 == 0 && id1 == 1 && id2 == 0);
+  T_ASSERT(lp_intern_eq(c0, c2) && !lp_intern_eq(c0, c1));
+  T_ASSERT(c0.ptr != buf && lp_sv_eq(c0, lp_sv("host")));
+  T_ASSERT(c0.ptr[c0.len] == '\0');
+  T_ASSERT(lp_intern_count(&in) == 2);
+  T_ASSERT(lp_intern_find(&in, lp_sv("port")) == 1u);
+  T_ASSERT(lp_intern_str(&in, 1).ptr == c1.ptr);
+  T_ASSERT(lp_intern_str(&in, 2).len == 0);
+  T_ASSERT(lp_intern_str(&in, LP_INTERN_NONE).len == 0);
+
+  // prefixes and the empty string are distinct entries
+  lp_intern_id e = LP_INTERN_NONE, p = LP_INTERN_NONE;
+  T_ASSERT(lp_intern(&in, lp_sv_n(NULL, 0), &e, NULL) == LP_OK);
+  T_ASSERT(lp_intern(&in, lp_sv("hos"), &p, NULL) == LP_OK);
+  T_ASSERT(e == 2 && p == 3);
+  T_ASSERT(lp_intern_find(&in, lp_sv("")) == 2u);
+  T_ASSERT(lp_intern(&in, lp_sv_n(NULL, 1), NULL, NULL) == LP_ERR_INVALID);
+  T_ASSERT(lp_intern_find(&in, lp_sv_n(NULL, 1)) == LP_INTERN_NONE);
+}
+
+// Ids are dense and stable; the table stops at max_ids; a full arena
+// leaves the interner usable.
+static void test_limits(void) {
+  static uint64_t mem[16384];
+  lp_arena a;
+  lp_arena_init(&a, mem, sizeof mem);
+  lp_interner in;
+  enum { N = 2000 };
+  T_ASSERT(lp_intern_init(&in, &a, N, 0) == LP_OK);
+
+  char key[32];
+  bool ok = true;
+  for (uint32_t i = 0; i < N; i++) {
+    lp_intern_id id = LP_INTERN_NONE;
+    ok &= lp_intern(&in, lp_sv_n(key, key_of(key, sizeof key, i)), &id, NULL) == LP_OK && id == i;
+  }
+  for (uint32_t i = 0; i < N; i++) {
+    size_t n = key_of(key, sizeof key, i);
+    ok &= lp_intern_find(&in, lp_sv_n(key, n)) == i;
+    ok &= lp_sv_eq(lp_intern_str(&in, i), lp_sv_n(key, n));
+  }
+  T_ASSERT(ok);
+  T_ASSERT(lp_intern(&in, lp_sv("one.more"), NULL, NULL) == LP_ERR_FULL);
+  T_ASSERT(lp_intern(&in, lp_sv("field.7"), NULL, NULL) == LP_OK); // existing still fine
+  T_ASSERT(lp_intern_count(&in) == N);
+
+  uint64_t small[64];
+  lp_arena b;
+  lp_arena_init(&b, small, sizeof small);
+  T_ASSERT(lp_intern_init(&in, &b, 1000, 0) == LP_ERR_NOMEM);
+  T_ASSERT(b.off == 0); // nothing left behind
+  T_ASSERT(lp_intern_init(&in, &b, 4, 0) == LP_OK);
+  char big[400];
+  memset(big, 'x', sizeof big);
+  T_ASSERT(lp_intern(&in, lp_sv_n(big, sizeof big), NULL, NULL) == LP_ERR_NOMEM);
+  T_ASSERT(lp_intern_count(&in) == 0);
+  T_ASSERT(lp_intern(&in, lp_sv("ok"), NULL, NULL) == LP_OK);
+  T_ASSERT(lp_intern_find(&in, lp_sv_n(big, sizeof big)) == LP_INTERN_NONE);
+}
+
+#if LP_CFG_ENABLE_ATOMICS
+// Several threads intern overlapping key sets in different orders while
+// reader threads look up a preloaded set: every string gets one id, the
+// same on every thread, and readers never miss a preloaded key.
+#define MT_WRITERS 3
+#define MT_READERS 2
+#define MT_PRELOAD 500u
+#define MT_KEYS    6000u
+
+static lp_interner g_in;
+static lp_intern_id g_ids[MT_WRITERS][MT_KEYS];
+static int g_mt_fail[MT_WRITERS + MT_READERS];
+static volatile int g_writers_done;
+
+static void* mt_writer(void* arg) {
+  size_t t = (size_t)(uintptr_t)arg;
+  char key[32];
+  for (uint32_t j = 0; j < MT_KEYS; j++) {
+    static const uint32_t mult[MT_WRITERS] = { 1, 7, 11 }; // coprime to MT_KEYS: per-thread orders
+    uint32_t i = (j * mult[t] + (uint32_t)t * 977u) % MT_KEYS;
+    size_t n = key_of(key, sizeof key, i);
+    lp_strview c;
+    if (lp_intern(&g_in, lp_sv_n(key, n), &g_ids[t][i], &c) != LP_OK) g_mt_fail[t]++;
+    else if (!lp_sv_eq(c, lp_sv_n(key, n))) g_mt_fail[t]++;
+  }
+  return NULL;
+}
+
+static void* mt_reader(void* arg) {
+  size_t t = (size_t)(uintptr_t)arg;
+  char key[32];
+  do {
+    for (uint32_t i = 0; i < MT_PRELOAD; i++) {
+      size_t n = key_of(key, sizeof key, i);
+      lp_intern_id id = lp_intern_find(&g_in, lp_sv_n(key, n));
+      if (id != i || !lp_sv_eq(lp_intern_str(&g_in, id), lp_sv_n(key, n))) g_mt_fail[t]++;
+    }
+  } while (!__atomic_load_n(&g_writers_done, __ATOMIC_ACQUIRE));
+  return NULL;
+}
+
+static void test_concurrent(void) {
+  static uint64_t mem[65536];
+  lp_arena a;
+  lp_arena_init(&a, mem, sizeof mem);
+  T_ASSERT(lp_intern_init(&g_in, &a, MT_KEYS, LP_INTERN_CONCURRENT) == LP_OK);
+  char key[32];
+  for (uint32_t i = 0; i < MT_PRELOAD; i++) {
+    T_ASSERT(lp_intern(&g_in, lp_sv_n(key, key_of(key, sizeof key, i)), NULL, NULL) == LP_OK);
+  }
+
+  pthread_t th[MT_WRITERS + MT_READERS];
+  for (size_t i = 0; i < MT_READERS; i++) pthread_create(&th[MT_WRITERS + i], NULL, mt_reader, (void*)(uintptr_t)(MT_WRITERS + i));
+  for (size_t i = 0; i < MT_WRITERS; i++) pthread_create(&th[i], NULL, mt_writer, (void*)(uintptr_t)i);
+  for (size_t i = 0; i < MT_WRITERS; i++) pthread_join(th[i], NULL);
+  __atomic_store_n(&g_writers_done, 1, __ATOMIC_RELEASE);
+  for (size_t i = 0; i < MT_READERS; i++) pthread_join(th[MT_WRITERS + i], NULL);
+
+  for (size_t t = 0; t < MT_WRITERS + MT_READERS; t++) T_ASSERT(g_mt_fail[t] == 0);
+  T_ASSERT(lp_intern_count(&g_in) == MT_KEYS);
+  bool ok = true;
+  static uint8_t seen[MT_KEYS];
+  for (uint32_t i = 0; i < MT_KEYS; i++) {
+    lp_intern_id id = g_ids[0][i];
+    for (size_t t = 1; t < MT_WRITERS; t++) ok &= g_ids[t][i] == id;
+    ok &= id < MT_KEYS && (i >= MT_PRELOAD || id == i);
+    if (id < MT_KEYS) seen[id]++;
+  }
+  for (uint32_t i = 0; i < MT_KEYS; i++) ok &= seen[i] == 1u;
+  T_ASSERT(ok);
+}
+#endif
+
+int main(void) {
+  test_basic();
+  test_limits();
+#if LP_CFG_ENABLE_ATOMICS
+  test_concurrent();
+#endif
+  return g_fail ? 1 : 0;
+}
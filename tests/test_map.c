@@ -0,0 +1,348 @@
+#include "lp/lp.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static uint64_t g_rng = 0x2545F4914F6CDD1Dull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+static void test_basic(void) {
+  static uint64_t mem[1024];
+  lp_map m;
+  T_ASSERT(lp_map_init(&m, LP_MAP_KEY_U64, sizeof(uint32_t), mem, sizeof mem) == LP_OK);
+  T_ASSERT(lp_map_len(&m) == 0);
+  T_ASSERT(lp_map_get_u64(&m, 1) == NULL);
+
+  uint32_t v = 11;
+  T_ASSERT(lp_map_put_u64(&m, 1, &v) == LP_OK);
+  v = 22;
+  T_ASSERT(lp_map_put_u64(&m, 0, &v) == LP_OK);
+  T_ASSERT(lp_map_len(&m) == 2);
+  uint32_t* p = (uint32_t*)lp_map_get_u64(&m, 1);
+  T_ASSERT(p && *p == 11u && ((uintptr_t)p & 7u) == 0);
+  p = (uint32_t*)lp_map_get_u64(&m, 0);
+  T_ASSERT(p && *p == 22u);
+
+  // overwrite keeps the count
+  v = 33;
+  T_ASSERT(lp_map_put_u64(&m, 1, &v) == LP_OK);
+  T_ASSERT(lp_map_len(&m) == 2);
+  T_ASSERT(*(uint32_t*)lp_map_get_u64(&m, 1) == 33u);
+
+  void* slot = NULL;
+  bool ins = false;
+  T_ASSERT(lp_map_emplace_u64(&m, 7, &slot, &ins) == LP_OK && ins);
+  T_ASSERT(*(uint32_t*)slot == 0u); // new values are zeroed
+  *(uint32_t*)slot = 77;
+  T_ASSERT(lp_map_emplace_u64(&m, 7, &slot, &ins) == LP_OK && !ins);
+  T_ASSERT(*(uint32_t*)slot == 77u);
+
+  T_ASSERT(lp_map_remove_u64(&m, 1));
+  T_ASSERT(!lp_map_remove_u64(&m, 1));
+  T_ASSERT(lp_map_get_u64(&m, 1) == NULL);
+  T_ASSERT(lp_map_len(&m) == 2);
+
+  // wrong key kind / bad args
+  T_ASSERT(lp_map_get_sv(&m, lp_sv("x")) == NULL);
+  T_ASSERT(lp_map_put_sv(&m, lp_sv("x"), &v) == LP_ERR_INVALID);
+  T_ASSERT(lp_map_put_u64(&m, 5, NULL) == LP_ERR_INVALID);
+  T_ASSERT(lp_map_emplace_u64(&m, 5, NULL, NULL) == LP_ERR_INVALID);
+  T_ASSERT(lp_map_init(&m, (lp_map_key_kind)9, 8, mem, sizeof mem) == LP_ERR_INVALID);
+
+  lp_map_clear(&m);
+  T_ASSERT(lp_map_len(&m) == 0);
+  T_ASSERT(lp_map_get_u64(&m, 7) == NULL);
+  T_ASSERT(lp_map_put_u64(&m, 7, &v) == LP_OK);
+}
+
+// Caller memory: too small fails, lp_map_mem_size is enough for its count
+// even when the block is misaligned.
+static void test_mem_size(void) {
+  static uint8_t mem[1 << 16];
+  lp_map m;
+  T_ASSERT(lp_map_init(&m, LP_MAP_KEY_U64, 8, mem, 64) == LP_ERR_NOMEM);
+  T_ASSERT(lp_map_init(&m, LP_MAP_KEY_U64, 8, NULL, 0) == LP_ERR_NOMEM);
+  T_ASSERT(lp_map_mem_size(LP_MAP_KEY_U64, 8, SIZE_MAX) == 0u);
+  T_ASSERT(lp_map_mem_size(LP_MAP_KEY_U64, SIZE_MAX - 4u, 1) == 0u);
+
+  static const size_t counts[] = { 0, 1, 14, 15, 100, 500, 1000 };
+  for (size_t c = 0; c < sizeof counts / sizeof counts[0]; c++) {
+    size_t n = counts[c];
+    size_t need = lp_map_mem_size(LP_MAP_KEY_U64, 12, n);
+    T_ASSERT(need > 0 && need + 3u <= sizeof mem);
+    T_ASSERT(lp_map_init(&m, LP_MAP_KEY_U64, 12, mem + 3, need) == LP_OK);
+    T_ASSERT(((uintptr_t)m.t.slots & 7u) == 0);
+    bool ok = true;
+    for (size_t i = 0; i < n; i++) {
+      uint8_t val[12] = { (uint8_t)i };
+      ok &= lp_map_put_u64(&m, i * 977u, val) == LP_OK;
+    }
+    for (size_t i = 0; i < n; i++) {
+      const uint8_t* val = (const uint8_t*)lp_map_get_u64(&m, i * 977u);
+      ok &= val && val[0] == (uint8_t)i;
+    }
+    T_ASSERT(ok);
+    T_ASSERT(lp_map_len(&m) == n);
+  }
+}
+
+// A fixed map stops at 7/8 of its slots; existing keys still work.
+static void test_full(void) {
+  static uint64_t mem[512];
+  lp_map m;
+  T_ASSERT(lp_map_init(&m, LP_MAP_KEY_U64, 8, mem, sizeof mem) == LP_OK);
+  size_t cap = m.t.cap, max = cap - cap / 8u;
+  uint64_t k = 0;
+  for (; k < max; k++) T_ASSERT(lp_map_put_u64(&m, k, &k) == LP_OK);
+  T_ASSERT(lp_map_len(&m) == max);
+  T_ASSERT(lp_map_put_u64(&m, k, &k) == LP_ERR_FULL);
+  T_ASSERT(lp_map_get_u64(&m, k) == NULL);
+  void* slot = NULL;
+  bool ins = true;
+  T_ASSERT(lp_map_emplace_u64(&m, 3, &slot, &ins) == LP_OK && !ins);
+  T_ASSERT(*(uint64_t*)slot == 3u);
+
+  // a removal makes room again
+  T_ASSERT(lp_map_remove_u64(&m, 5));
+  T_ASSERT(lp_map_put_u64(&m, k, &k) == LP_OK);
+  T_ASSERT(lp_map_put_u64(&m, k + 1u, &k) == LP_ERR_FULL);
+  bool ok = true;
+  for (uint64_t i = 0; i <= k; i++) {
+    uint64_t* v = (uint64_t*)lp_map_get_u64(&m, i);
+    ok &= (i == 5) ? (v == NULL) : (v && *v == i);
+  }
+  T_ASSERT(ok);
+}
+
+// Random operations against a plain array, over a key range a little
+// above the capacity so the map runs full, leaves tombstones and rebuilds
+// in place. Values are 13 bytes to exercise an odd stride.
+static void test_random_fixed(void) {
+  enum { KEYS = 480, OPS = 400000 };
+  static uint64_t mem[2048];
+  static uint8_t  ref[KEYS][13];
+  static bool     have[KEYS];
+  memset(have, 0, sizeof have);
+  lp_map m;
+  T_ASSERT(lp_map_init(&m, LP_MAP_KEY_U64, 13, mem, sizeof mem) == LP_OK);
+  size_t max = m.t.cap - m.t.cap / 8u, n = 0;
+  T_ASSERT(max < KEYS);
+
+  bool ok = true;
+  for (int op = 0; op < OPS; op++) {
+    uint64_t r = rnd64();
+    size_t k = (size_t)(r % KEYS);
+    uint64_t key = (uint64_t)k * 0x9E3779B97F4A7C15ull; // spread, incl. 0
+    switch ((r >> 32) % 4u) {
+      case 0:
+      case 1: {
+        uint8_t val[13];
+        memset(val, (int)(r >> 40), sizeof val);
+        val[12] = (uint8_t)k;
+        lp_status_t st = lp_map_put_u64(&m, key, val);
+        if (!have[k] && n == max) {
+          ok &= st == LP_ERR_FULL;
+        } else {
+          ok &= st == LP_OK;
+          if (!have[k]) n++;
+          have[k] = true;
+          memcpy(ref[k], val, sizeof val);
+        }
+        break;
+      }
+      case 2:
+        ok &= lp_map_remove_u64(&m, key) == have[k];
+        if (have[k]) n--;
+        have[k] = false;
+        break;
+      default: {
+        const uint8_t* v = (const uint8_t*)lp_map_get_u64(&m, key);
+        ok &= have[k] ? (v && memcmp(v, ref[k], 13) == 0) : (v == NULL);
+        break;
+      }
+    }
+    ok &= lp_map_len(&m) == n;
+  }
+  for (size_t k = 0; k < KEYS; k++) {
+    const uint8_t* v = (const uint8_t*)lp_map_get_u64(&m, (uint64_t)k * 0x9E3779B97F4A7C15ull);
+    ok &= have[k] ? (v && memcmp(v, ref[k], 13) == 0) : (v == NULL);
+  }
+  T_ASSERT(ok);
+}
+
+// Insert/remove churn of never-repeating keys at a steady size near the
+// limit: every slot eventually becomes a tombstone, so this only keeps
+// going if tombstones are reclaimed.
+static void test_churn(void) {
+  static uint64_t mem[1024];
+  lp_map m;
+  T_ASSERT(lp_map_init(&m, LP_MAP_KEY_U64, 0, mem, sizeof mem) == LP_OK);
+  size_t live = m.t.cap - m.t.cap / 8u - 1u;
+  bool ok = true;
+  for (uint64_t k = 0; k < live; k++) ok &= lp_map_put_u64(&m, k, NULL) == LP_OK;
+  for (uint64_t k = live; k < 100000; k++) {
+    ok &= lp_map_put_u64(&m, k, NULL) == LP_OK;
+    ok &= lp_map_remove_u64(&m, k - live);
+  }
+  ok &= lp_map_len(&m) == live;
+  for (uint64_t k = 100000 - live; k < 100000; k++) ok &= lp_map_get_u64(&m, k) != NULL;
+  ok &= lp_map_get_u64(&m, 100000 - live - 1u) == NULL;
+  T_ASSERT(ok);
+}
+
+// lp_strview keys in an arena-backed map, iteration.
+static void test_sv_arena(void) {
+  static uint64_t amem[8192];
+  lp_arena a;
+  lp_arena_init(&a, amem, sizeof amem);
+  lp_map m;
+  T_ASSERT(lp_map_init_arena(&m, LP_MAP_KEY_SV, sizeof(uint32_t), &a, 1000) == LP_OK);
+  T_ASSERT(lp_map_init_arena(&m, LP_MAP_KEY_SV, sizeof(uint32_t), NULL, 10) == LP_ERR_INVALID);
+
+  enum { N = 1000 };
+  static char keys[N][16];
+  bool ok = true;
+  for (uint32_t i = 0; i < N; i++) {
+    lp_fmtbuf fb = lp_fmtbuf_make(keys[i], sizeof keys[i]);
+    lp_fmt_appendf(&fb, "key_{}", i);
+    ok &= lp_map_put_sv(&m, lp_sv_n(keys[i], fb.len), &i) == LP_OK;
+  }
+  T_ASSERT(lp_map_len(&m) == N);
+  // lookups through a different buffer with the same bytes
+  for (uint32_t i = 0; i < N; i++) {
+    char probe[16];
+    lp_fmtbuf fb = lp_fmtbuf_make(probe, sizeof probe);
+    lp_fmt_appendf(&fb, "key_{}", i);
+    uint32_t* v = (uint32_t*)lp_map_get_sv(&m, lp_sv_n(probe, fb.len));
+    ok &= v && *v == i;
+  }
+  ok &= lp_map_get_sv(&m, lp_sv("key_")) == NULL;
+  ok &= lp_map_get_sv(&m, lp_sv("key_1000")) == NULL;
+  T_ASSERT(ok);
+
+  // the empty view is a key like any other
+  uint32_t z = 5;
+  T_ASSERT(lp_map_put_sv(&m, lp_sv_n(NULL, 0), &z) == LP_OK);
+  T_ASSERT(lp_map_get_sv(&m, lp_sv("")) && *(uint32_t*)lp_map_get_sv(&m, lp_sv("")) == 5u);
+  T_ASSERT(lp_map_remove_sv(&m, lp_sv("")));
+  T_ASSERT(lp_map_put_sv(&m, lp_sv_n(NULL, 3), &z) == LP_ERR_INVALID);
+
+  for (uint32_t i = 0; i < N; i += 2) T_ASSERT(lp_map_remove_sv(&m, lp_sv(keys[i])));
+
+  // every remaining entry exactly once
+  static uint8_t seen[N];
+  memset(seen, 0, sizeof seen);
+  size_t it = 0, count = 0;
+  lp_map_entry e;
+  while (lp_map_next(&m, &it, &e)) {
+    uint32_t i = *(const uint32_t*)e.val;
+    ok &= i < N && lp_sv_eq(e.key_sv, lp_sv(keys[i]));
+    if (i < N) seen[i]++;
+    count++;
+  }
+  ok &= !lp_map_next(&m, &it, &e);
+  ok &= count == N / 2;
+  for (uint32_t i = 0; i < N; i++) ok &= seen[i] == ((i & 1u) ? 1u : 0u);
+  T_ASSERT(ok);
+
+  // the arena can't hold another table this size
+  lp_map m2;
+  T_ASSERT(lp_map_init_arena(&m2, LP_MAP_KEY_SV, sizeof(uint32_t), &a, 1000) == LP_ERR_NOMEM);
+}
+
+#if LP_CFG_ENABLE_ALLOC
+// Heap maps grow one group at a time: during a resize both tables hold
+// entries, and everything stays reachable throughout.
+static void test_heap_grow(void) {
+  lp_map m;
+  T_ASSERT(lp_map_init_heap(&m, LP_MAP_KEY_U64, sizeof(uint64_t), 0) == LP_OK);
+  T_ASSERT(m.t.cap == 0);
+  T_ASSERT(lp_map_get_u64(&m, 1) == NULL);
+  T_ASSERT(!lp_map_remove_u64(&m, 1));
+
+  enum { N = 50000 };
+  bool ok = true, saw_migration = false;
+  for (uint64_t k = 0; k < N; k++) {
+    uint64_t v = k * 3u;
+    ok &= lp_map_put_u64(&m, k, &v) == LP_OK;
+    if (m.old.cap) {
+      saw_migration = true;
+      ok &= m.old.used + m.t.used == k + 1u;
+    }
+    if ((k & 1023u) == 1023u) {
+      for (uint64_t j = 0; j <= k; j++) {
+        uint64_t* p = (uint64_t*)lp_map_get_u64(&m, j);
+        ok &= p && *p == j * 3u;
+      }
+    }
+  }
+  T_ASSERT(saw_migration);
+  T_ASSERT(lp_map_len(&m) == N);
+
+  // removing and overwriting mid-migration
+  for (uint64_t k = 0; k < N; k += 3) ok &= lp_map_remove_u64(&m, k);
+  for (uint64_t k = 1; k < N; k += 3) {
+    uint64_t v = 1;
+    ok &= lp_map_put_u64(&m, k, &v) == LP_OK;
+  }
+  for (uint64_t k = 0; k < N; k++) {
+    uint64_t* p = (uint64_t*)lp_map_get_u64(&m, k);
+    if (k % 3u == 0) ok &= p == NULL;
+    else if (k % 3u == 1) ok &= p && *p == 1u;
+    else ok &= p && *p == k * 3u;
+  }
+  size_t it = 0, count = 0;
+  lp_map_entry e;
+  while (lp_map_next(&m, &it, &e)) count++;
+  ok &= count == lp_map_len(&m);
+  T_ASSERT(ok);
+
+  lp_map_clear(&m);
+  T_ASSERT(lp_map_len(&m) == 0 && m.old.cap == 0);
+  lp_map_destroy(&m);
+  T_ASSERT(m.t.cap == 0);
+}
+
+// Steady-state churn in a heap map rebuilds at the same size instead of
+// growing without bound.
+static void test_heap_churn(void) {
+  lp_map m;
+  T_ASSERT(lp_map_init_heap(&m, LP_MAP_KEY_SV, 0, 64) == LP_OK);
+  static char keys[200000][8];
+  bool ok = true;
+  for (uint32_t k = 0; k < 200000; k++) {
+    memcpy(keys[k], &k, sizeof k);
+    memcpy(keys[k] + 4, "abcd", 4);
+    ok &= lp_map_put_sv(&m, lp_sv_n(keys[k], 8), NULL) == LP_OK;
+    if (k >= 50) ok &= lp_map_remove_sv(&m, lp_sv_n(keys[k - 50], 8));
+  }
+  ok &= lp_map_len(&m) == 50;
+  ok &= m.t.cap <= 256;
+  for (uint32_t k = 200000 - 50; k < 200000; k++) ok &= lp_map_get_sv(&m, lp_sv_n(keys[k], 8)) != NULL;
+  T_ASSERT(ok);
+  lp_map_destroy(&m);
+}
+#endif
+
+int main(void) {
+  test_basic();
+  test_mem_size();
+  test_full();
+  test_random_fixed();
+  test_churn();
+  test_sv_arena();
+#if LP_CFG_ENABLE_ALLOC
+  test_heap_grow();
+  test_heap_churn();
+#endif
+  return g_fail ? 1 : 0;
+}
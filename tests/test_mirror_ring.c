@@ -0,0 +1,59 @@
+#include "lp/lp.h"
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static void test_mirror_alias(void) {
+  lp_mirror_ring r;
+  T_ASSERT(lp_mirror_ring_create(&r, 0) == LP_ERR_INVALID);
+  T_ASSERT(lp_mirror_ring_create(&r, 100) == LP_OK);
+  T_ASSERT(r.cap >= 100);
+
+  r.buf[3] = 0x5A;
+  T_ASSERT(r.buf[r.cap + 3] == 0x5A);
+  r.buf[r.cap + 7] = 0xA5;
+  T_ASSERT(r.buf[7] == 0xA5);
+
+  lp_mirror_ring_destroy(&r);
+  T_ASSERT(r.buf == NULL && r.cap == 0);
+}
+
+static void test_wrapped_record_contiguous(void) {
+  lp_mirror_ring r;
+  T_ASSERT(lp_mirror_ring_create(&r, 1) == LP_OK);
+  size_t cap = r.cap;
+
+  // park tail 3 bytes before the end
+  lp_span_u8_mut w;
+  T_ASSERT(lp_mirror_ring_reserve(&r, cap - 3, &w) == LP_OK);
+  T_ASSERT(lp_mirror_ring_commit(&r, cap - 3) == LP_OK);
+  T_ASSERT(lp_mirror_ring_consume(&r, cap - 3) == LP_OK);
+
+  T_ASSERT(lp_mirror_ring_push(&r, "record!", 7) == LP_OK);
+  lp_span_u8 rd;
+  T_ASSERT(lp_mirror_ring_peek(&r, 7, &rd) == LP_OK);
+  T_ASSERT(rd.len == 7);
+  T_ASSERT(lp_sv_eq((lp_strview){ (const char*)rd.ptr, rd.len }, lp_sv("record!")));
+  T_ASSERT(r.buf[0] == 'o'); // the wrapped part landed at the start
+
+  // fill to capacity in one contiguous span
+  T_ASSERT(lp_mirror_ring_reserve(&r, cap - 6, &w) == LP_ERR_FULL);
+  T_ASSERT(lp_mirror_ring_reserve(&r, cap - 7, &w) == LP_OK);
+  T_ASSERT(w.len == cap - 7);
+  T_ASSERT(lp_mirror_ring_commit(&r, cap - 7) == LP_OK);
+  T_ASSERT(lp_mirror_ring_free(&r) == 0);
+
+  char out[7];
+  T_ASSERT(lp_mirror_ring_pop(&r, out, 7) == LP_OK);
+  T_ASSERT(out[0] == 'r' && out[6] == '!');
+  T_ASSERT(lp_mirror_ring_len(&r) == cap - 7);
+  T_ASSERT(lp_mirror_ring_consume(&r, cap) == LP_ERR_RANGE);
+
+  lp_mirror_ring_destroy(&r);
+}
+
+int main(void) {
+  test_mirror_alias();
+  test_wrapped_record_contiguous();
+  return g_fail ? 1 : 0;
+}
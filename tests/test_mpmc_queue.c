@@ -0,0 +1,101 @@
+#include "lp/lp.h"
+#include <pthread.h>
+#include <sched.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static void test_init(void) {
+  lp_mpmc_queue q;
+  size_t mem[64];
+  size_t need = 0;
+
+  T_ASSERT(lp_mpmc_queue_mem_size(3, 4, &need) == LP_ERR_INVALID);
+  T_ASSERT(lp_mpmc_queue_mem_size(4, 0, &need) == LP_ERR_INVALID);
+  T_ASSERT(lp_mpmc_queue_mem_size(4, 4, &need) == LP_OK);
+  T_ASSERT(need == 4 * lp_align_up_size(sizeof(size_t) + 4, sizeof(size_t)));
+
+  T_ASSERT(lp_mpmc_queue_init(&q, mem, need - 1, 4, 4) == LP_ERR_NOMEM);
+  T_ASSERT(lp_mpmc_queue_init(&q, (uint8_t*)mem + 1, sizeof(mem), 4, 4) == LP_ERR_INVALID);
+  T_ASSERT(lp_mpmc_queue_init(&q, mem, sizeof(mem), 4, 4) == LP_OK);
+  T_ASSERT(lp_mpmc_queue_cap(&q) == 4);
+  T_ASSERT(lp_mpmc_queue_len(&q) == 0);
+}
+
+static void test_fifo(void) {
+  lp_mpmc_queue q;
+  size_t mem[64];
+  uint32_t v = 0;
+  T_ASSERT(lp_mpmc_queue_init(&q, mem, sizeof(mem), 4, sizeof(uint32_t)) == LP_OK);
+
+  T_ASSERT(lp_mpmc_queue_pop(&q, &v) == LP_ERR_EMPTY);
+  for (uint32_t i = 0; i < 4; i++) T_ASSERT(lp_mpmc_queue_push(&q, &i) == LP_OK);
+  T_ASSERT(lp_mpmc_queue_push(&q, &v) == LP_ERR_FULL);
+  T_ASSERT(lp_mpmc_queue_len(&q) == 4);
+
+  // several laps around the slots
+  for (uint32_t i = 4; i < 20; i++) {
+    T_ASSERT(lp_mpmc_queue_pop(&q, &v) == LP_OK);
+    T_ASSERT(v == i - 4);
+    T_ASSERT(lp_mpmc_queue_push(&q, &i) == LP_OK);
+  }
+  for (uint32_t i = 16; i < 20; i++) {
+    T_ASSERT(lp_mpmc_queue_pop(&q, &v) == LP_OK);
+    T_ASSERT(v == i);
+  }
+  T_ASSERT(lp_mpmc_queue_pop(&q, &v) == LP_ERR_EMPTY);
+}
+
+// Several producers/consumers: every item must come out exactly once
+#define MT_THREADS 3
+#define MT_ITEMS   20000u
+
+static lp_mpmc_queue g_q;
+static uint64_t g_sum[MT_THREADS];
+static uint32_t g_count[MT_THREADS];
+
+static void* mt_producer(void* arg) {
+  uint32_t base = (uint32_t)(uintptr_t)arg * MT_ITEMS;
+  for (uint32_t i = 0; i < MT_ITEMS; i++) {
+    uint32_t v = base + i;
+    while (lp_mpmc_queue_push(&g_q, &v) != LP_OK) sched_yield();
+  }
+  return NULL;
+}
+
+static void* mt_consumer(void* arg) {
+  size_t id = (size_t)(uintptr_t)arg;
+  for (uint32_t i = 0; i < MT_ITEMS; i++) {
+    uint32_t v;
+    while (lp_mpmc_queue_pop(&g_q, &v) != LP_OK) sched_yield();
+    g_sum[id] += v;
+    g_count[id]++;
+  }
+  return NULL;
+}
+
+static void test_threads(void) {
+  static size_t mem[2 * 64];
+  T_ASSERT(lp_mpmc_queue_init(&g_q, mem, sizeof(mem), 64, sizeof(uint32_t)) == LP_OK);
+
+  pthread_t th[2 * MT_THREADS];
+  for (size_t i = 0; i < MT_THREADS; i++) {
+    pthread_create(&th[i], NULL, mt_producer, (void*)(uintptr_t)i);
+    pthread_create(&th[MT_THREADS + i], NULL, mt_consumer, (void*)(uintptr_t)i);
+  }
+  for (size_t i = 0; i < 2 * MT_THREADS; i++) pthread_join(th[i], NULL);
+
+  uint64_t n = (uint64_t)MT_THREADS * MT_ITEMS;
+  uint64_t sum = 0, count = 0;
+  for (size_t i = 0; i < MT_THREADS; i++) { sum += g_sum[i]; count += g_count[i]; }
+  T_ASSERT(count == n);
+  T_ASSERT(sum == n * (n - 1u) / 2u);
+  T_ASSERT(lp_mpmc_queue_len(&g_q) == 0);
+}
+
+int main(void) {
+  test_init();
+  test_fifo();
+  test_threads();
+  return g_fail ? 1 : 0;
+}
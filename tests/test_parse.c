@@ -0,0 +1,235 @@
+#include "lp/lp.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+static lp_strview sv_n(const char* s, size_t n) { return (lp_strview){ .ptr = s, .len = n }; }
+
+static uint64_t bits_of(double v) {
+  uint64_t b;
+  memcpy(&b, &v, sizeof b);
+  return b;
+}
+
+static void test_u64(void) {
+  uint64_t v = 7;
+  size_t n = 99;
+
+  T_ASSERT(lp_parse_u64(lp_sv("0"), &v, NULL) == LP_OK && v == 0);
+  T_ASSERT(lp_parse_u64(lp_sv("12345"), &v, NULL) == LP_OK && v == 12345u);
+  T_ASSERT(lp_parse_u64(lp_sv("0000000000000000000000042"), &v, NULL) == LP_OK && v == 42u);
+  T_ASSERT(lp_parse_u64(lp_sv("18446744073709551615"), &v, NULL) == LP_OK && v == UINT64_MAX);
+
+  // overflow saturates and still consumes every digit
+  T_ASSERT(lp_parse_u64(lp_sv("18446744073709551616"), &v, &n) == LP_ERR_OVERFLOW);
+  T_ASSERT(v == UINT64_MAX && n == 20);
+  T_ASSERT(lp_parse_u64(lp_sv("99999999999999999999999x"), &v, &n) == LP_ERR_OVERFLOW && n == 23);
+
+  // invalid leaves *out alone
+  v = 7;
+  T_ASSERT(lp_parse_u64(lp_sv(""), &v, &n) == LP_ERR_INVALID && n == 0 && v == 7);
+  T_ASSERT(lp_parse_u64(lp_sv("x1"), &v, &n) == LP_ERR_INVALID && n == 0);
+  T_ASSERT(lp_parse_u64(lp_sv("+1"), &v, NULL) == LP_ERR_INVALID);
+  T_ASSERT(lp_parse_u64(lp_sv(" 1"), &v, NULL) == LP_ERR_INVALID);
+  T_ASSERT(lp_parse_u64(lp_sv("12abc"), &v, NULL) == LP_ERR_INVALID);
+  T_ASSERT(lp_parse_u64(lp_sv("12abc"), &v, &n) == LP_OK && v == 12u && n == 2);
+  T_ASSERT(lp_parse_u64(sv_n(NULL, 0), &v, NULL) == LP_ERR_INVALID);
+
+  // the view bounds the parse, no NUL needed
+  T_ASSERT(lp_parse_u64(sv_n("1234567890123", 3), &v, NULL) == LP_OK && v == 123u);
+  T_ASSERT(lp_parse_u64(sv_n("1234567890123", 9), &v, NULL) == LP_OK && v == 123456789u);
+
+  // every length and SWAR/tail split against strtoull
+  char buf[32];
+  for (int iter = 0; iter < 20000; iter++) {
+    size_t len = 1u + (size_t)(rnd64() % 20u);
+    for (size_t i = 0; i < len; i++) buf[i] = (char)('0' + rnd64() % 10u);
+    buf[len] = (rnd64() & 1u) ? 'z' : '\0';
+    buf[len + 1] = '\0';
+    errno = 0;
+    unsigned long long ref = strtoull(buf, NULL, 10);
+    bool ref_ovf = errno == ERANGE;
+    lp_status_t st = lp_parse_u64(sv_n(buf, len + 1), &v, &n);
+    T_ASSERT(st == (ref_ovf ? LP_ERR_OVERFLOW : LP_OK));
+    T_ASSERT(v == ref && n == len);
+  }
+}
+
+static void test_i64(void) {
+  int64_t v = 0;
+  size_t n = 0;
+
+  T_ASSERT(lp_parse_i64(lp_sv("-0"), &v, NULL) == LP_OK && v == 0);
+  T_ASSERT(lp_parse_i64(lp_sv("+17"), &v, NULL) == LP_OK && v == 17);
+  T_ASSERT(lp_parse_i64(lp_sv("-17"), &v, NULL) == LP_OK && v == -17);
+  T_ASSERT(lp_parse_i64(lp_sv("9223372036854775807"), &v, NULL) == LP_OK && v == INT64_MAX);
+  T_ASSERT(lp_parse_i64(lp_sv("-9223372036854775808"), &v, NULL) == LP_OK && v == INT64_MIN);
+
+  T_ASSERT(lp_parse_i64(lp_sv("9223372036854775808"), &v, &n) == LP_ERR_OVERFLOW);
+  T_ASSERT(v == INT64_MAX && n == 19);
+  T_ASSERT(lp_parse_i64(lp_sv("-9223372036854775809"), &v, &n) == LP_ERR_OVERFLOW);
+  T_ASSERT(v == INT64_MIN && n == 20);
+  T_ASSERT(lp_parse_i64(lp_sv("-99999999999999999999999"), &v, NULL) == LP_ERR_OVERFLOW && v == INT64_MIN);
+
+  T_ASSERT(lp_parse_i64(lp_sv("-"), &v, &n) == LP_ERR_INVALID && n == 0);
+  T_ASSERT(lp_parse_i64(lp_sv("--1"), &v, NULL) == LP_ERR_INVALID);
+  T_ASSERT(lp_parse_i64(lp_sv("-12,"), &v, &n) == LP_OK && v == -12 && n == 3);
+}
+
+// Bit-exact agreement with strtod on a NUL-terminated copy, including
+// where parsing stops.
+static int check_vs_strtod(const char* s) {
+  char* end;
+  errno = 0;
+  double ref = strtod(s, &end);
+  size_t ref_n = (size_t)(end - s);
+
+  double v = 0.0;
+  size_t n = 0;
+  lp_status_t st = lp_parse_f64(lp_sv(s), &v, &n);
+  if (ref_n == 0) return st == LP_ERR_INVALID && n == 0;
+  if (n != ref_n || bits_of(v) != bits_of(ref)) return 0;
+  bool inf = (bits_of(ref) & 0x7FFFFFFFFFFFFFFFull) == 0x7FF0000000000000ull;
+  bool overflow = inf && !strpbrk(s, "iI"); // "inf" itself is not an overflow
+  return st == (overflow ? LP_ERR_OVERFLOW : LP_OK);
+}
+
+static void test_f64_vectors(void) {
+  static const char* const cases[] = {
+    "0", "-0", "0.0", "1", "-1", "1.5", ".5", "5.", "-.25", "+3.25",
+    "0.1", "0.2", "0.3", "3.14159", "1e10", "1E-10", "2.5e+3", "6.02214076e23",
+    "9007199254740992", "9007199254740993", "9007199254740995", "123456789012345678",
+    "1e22", "1e23", "8.98846567431158e307", "1.7976931348623157e308",
+    "1.7976931348623158e308", "1.7976931348623159e308", "1e309", "-1e309",
+    "2.2250738585072011e-308", "2.2250738585072012e-308", "2.2250738585072014e-308",
+    "4.9406564584124654e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+    "1e-324", "1e-400", "1e-350", "3e-320", "7.2e-310",
+    "0.000000000000000000000000000000000000001", "1e-5000", "1e5000", "0e5000",
+    // halfway and near-halfway with more than 19 digits
+    "9007199254740993.0000000000000000000000000000001",
+    "9007199254740992.9999999999999999999999999999999",
+    "9007199254740993.0000000000000000000000000000000",
+    "9007199254740991.5000000000000000000000000000001",
+    "9007199254740991.4999999999999999999999999999999",
+    "9.3326361850321887899008954472381716961709e-302", // just under 2^-1000
+    "2.00000000000000011102230246251565404236316680908203125",
+    "2.00000000000000011102230246251565404236316680908203124",
+    "2.00000000000000011102230246251565404236316680908203126",
+    "7.4109846876186981626485318930233205854758970392148714663837852375101326090531312779794975454245398856969484704316857659638998506553390969459816219401617281718945106978546710679176872575177347315553307795408549809608457500958111373034747658096871009590975442271004757307809711118935784838675653998783503015228055934046593739791790738723868299395818481660169122019456499931289798411362062484498678713572180352209017023903285791732520220528974020802906854021606612375549983402671300035812486479041385743401875520901590172592547146296175134159774938718574737870961645638908718119841271673056017045493004705269590165763776884908267986972573366521765567941072508764337560846003984904972149117463085539556354188641513168478436313080237596295773983001708984375e-318",
+    "44444444444444444444444444444444444444444444444444444444444444444444444444444444"
+    "44444444444444444444444444444444444444444444444444444444444444444444444444444444e-300",
+    "inf", "-Infinity", "INF", "infinit", "nan", "NaN",
+    // where parsing stops
+    "1e", "1e+", "1e-x", "1.5.5", "1..5", "12e3e4", "-", "+", ".", "-.", ".e1", "e1",
+    "x", "", "1ex", "00001.25000e0002",
+  };
+  for (size_t i = 0; i < sizeof cases / sizeof cases[0]; i++) {
+    T_ASSERT(check_vs_strtod(cases[i]));
+  }
+
+  double v = 0.0;
+  size_t n = 0;
+  T_ASSERT(lp_parse_f64(lp_sv("1e309"), &v, NULL) == LP_ERR_OVERFLOW && v > 1e308);
+  T_ASSERT(lp_parse_f64(lp_sv("nan"), &v, NULL) == LP_OK && v != v);
+  T_ASSERT(lp_parse_f64(lp_sv("1.5x"), &v, NULL) == LP_ERR_INVALID);
+  T_ASSERT(lp_parse_f64(lp_sv("1.5x"), &v, &n) == LP_OK && v == 1.5 && n == 3);
+  T_ASSERT(lp_parse_f64(sv_n("2.5e10", 3), &v, NULL) == LP_OK && v == 2.5);
+  T_ASSERT(lp_parse_f64(sv_n("2.5e10", 4), &v, &n) == LP_OK && v == 2.5 && n == 3);
+
+  // a halfway value with a 1000-digit tail: the nonzero digit past 800
+  // decides the rounding
+  char big[1100];
+  memcpy(big, "9007199254740993.", 17);
+  memset(big + 17, '0', 1000);
+  big[1017] = '1';
+  big[1018] = '\0';
+  T_ASSERT(check_vs_strtod(big));
+  big[1017] = '\0';
+  T_ASSERT(check_vs_strtod(big));
+  big[1017] = '1';
+  T_ASSERT(lp_parse_f64(lp_sv(big), &v, NULL) == LP_OK && v == 9007199254740994.0);
+}
+
+static void test_f64_roundtrip(void) {
+  char buf[64];
+  for (int iter = 0; iter < 100000; iter++) {
+    uint64_t bits = rnd64();
+    if ((bits & 0x7FF0000000000000ull) == 0x7FF0000000000000ull) continue;
+    double d;
+    memcpy(&d, &bits, sizeof d);
+
+    lp_fmtbuf fb = lp_fmtbuf_make(buf, sizeof buf);
+    lp_fmt_append_f64(&fb, d);
+    double v = 0.0;
+    T_ASSERT(lp_parse_f64(sv_n(buf, fb.len), &v, NULL) == LP_OK && bits_of(v) == bits);
+
+    snprintf(buf, sizeof buf, "%.*e", (int)(rnd64() % 20u), d);
+    T_ASSERT(check_vs_strtod(buf));
+  }
+}
+
+static void test_f64_random_text(void) {
+  // random digit strings around the interesting exponents and halfway points
+  char buf[128];
+  for (int iter = 0; iter < 100000; iter++) {
+    size_t len = 0;
+    if (rnd64() & 1u) buf[len++] = '-';
+    size_t digits = 1u + (size_t)(rnd64() % 40u);
+    size_t dot = (size_t)(rnd64() % (digits + 1u));
+    for (size_t i = 0; i < digits; i++) {
+      if (i == dot && (rnd64() & 1u)) buf[len++] = '.';
+      // long runs of 0/9 land near halfway points
+      uint64_t r = rnd64() % 8u;
+      buf[len++] = (char)(r == 0 ? '0' : r == 1 ? '9' : '0' + rnd64() % 10u);
+    }
+    int e = (int)(rnd64() % 700u) - 350;
+    len += (size_t)snprintf(buf + len, sizeof buf - len, "e%d", e);
+    T_ASSERT(check_vs_strtod(buf));
+  }
+
+  // past the 800 digits the slow path keeps exactly
+  static char longbuf[1200];
+  for (int iter = 0; iter < 200; iter++) {
+    size_t len = 0;
+    size_t digits = 780u + (size_t)(rnd64() % 100u);
+    for (size_t i = 0; i < digits; i++) {
+      uint64_t r = rnd64() % 4u;
+      longbuf[len++] = (char)(r == 0 ? '0' : r == 1 ? '9' : '0' + rnd64() % 10u);
+      if (i == 0) longbuf[len++] = '.';
+    }
+    snprintf(longbuf + len, sizeof longbuf - len, "e%d", (int)(rnd64() % 640u) - 330);
+    T_ASSERT(check_vs_strtod(longbuf));
+  }
+
+  // syntax fuzz: where parsing stops must match strtod
+  static const char alpha[] = "0123456789.eE+-z";
+  for (int iter = 0; iter < 100000; iter++) {
+    size_t len = (size_t)(rnd64() % 12u);
+    for (size_t i = 0; i < len; i++) buf[i] = alpha[rnd64() % (sizeof alpha - 1u)];
+    buf[len] = '\0';
+    T_ASSERT(check_vs_strtod(buf));
+  }
+}
+
+int main(void) {
+  test_u64();
+  test_i64();
+  test_f64_vectors();
+  test_f64_roundtrip();
+  test_f64_random_text();
+  return g_fail ? 1 : 0;
+}
@@ -0,0 +1,132 @@
+#include "lp/lp.h"
+#include <pthread.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+typedef struct { uint64_t a; uint32_t b; } obj_t;
+
+static void test_alloc_free(void) {
+  uint64_t mem[32];
+  lp_pool p;
+  void* o[16];
+
+  T_ASSERT(lp_pool_init(&p, mem, sizeof(mem), 0, 8) == LP_ERR_INVALID);
+  T_ASSERT(lp_pool_init(&p, mem, sizeof(mem), sizeof(obj_t), 3) == LP_ERR_INVALID);
+  T_ASSERT(lp_pool_init(&p, mem, sizeof(mem), sizeof(obj_t), 8) == LP_OK);
+  T_ASSERT(p.stride == lp_align_up_size(sizeof(lp_pool_node) > sizeof(obj_t) ? sizeof(lp_pool_node) : sizeof(obj_t), 8));
+  size_t n = p.count;
+  T_ASSERT(n >= 1 && n <= 16);
+
+  for (size_t i = 0; i < n; i++) {
+    T_ASSERT(lp_pool_alloc(&p, &o[i]) == LP_OK);
+    T_ASSERT(((uintptr_t)o[i] & 7u) == 0);
+    ((obj_t*)o[i])->a = i;
+  }
+  T_ASSERT(lp_pool_alloc(&p, &o[15]) == LP_ERR_NOMEM);
+  T_ASSERT(lp_pool_live(&p) == n);
+  T_ASSERT(lp_pool_high_water(&p) == n);
+
+  T_ASSERT(lp_pool_free(&p, o[0]) == LP_OK);
+  T_ASSERT(lp_pool_live(&p) == n - 1);
+  void* again = NULL;
+  T_ASSERT(lp_pool_alloc(&p, &again) == LP_OK);
+  T_ASSERT(again == o[0]); // LIFO reuse
+
+  for (size_t i = 0; i < n; i++) T_ASSERT(lp_pool_free(&p, o[i]) == LP_OK);
+  T_ASSERT(lp_pool_live(&p) == 0);
+  T_ASSERT(lp_pool_high_water(&p) == n);
+
+  uint8_t other[16];
+  T_ASSERT(lp_pool_free(&p, other) == LP_ERR_INVALID); // not ours
+}
+
+static void test_arena_backed(void) {
+  uint8_t mem[512];
+  lp_arena a;
+  lp_pool p;
+  void* o = NULL;
+  lp_arena_init(&a, mem, sizeof(mem));
+
+  T_ASSERT(lp_pool_init_arena(&p, &a, 1000, 8, 8) == LP_ERR_NOMEM);
+  T_ASSERT(lp_pool_init_arena(&p, &a, 4, 24, 16) == LP_OK);
+  T_ASSERT(p.count == 4);
+  for (int i = 0; i < 4; i++) {
+    T_ASSERT(lp_pool_alloc(&p, &o) == LP_OK);
+    T_ASSERT(((uintptr_t)o & 15u) == 0);
+  }
+  T_ASSERT(lp_pool_alloc(&p, &o) == LP_ERR_NOMEM);
+}
+
+#if LP_CFG_DEBUG
+static void test_debug_checks(void) {
+  uint64_t mem[16];
+  lp_pool p;
+  void* o = NULL;
+  T_ASSERT(lp_pool_init(&p, mem, sizeof(mem), 32, 8) == LP_OK);
+
+  T_ASSERT(lp_pool_alloc(&p, &o) == LP_OK);
+  T_ASSERT(((uint8_t*)o)[31] == 0xCD); // fresh fill
+  T_ASSERT(lp_pool_free(&p, (uint8_t*)o + 4) == LP_ERR_INVALID); // interior pointer
+  T_ASSERT(lp_pool_free(&p, o) == LP_OK);
+  T_ASSERT(((uint8_t*)o)[31] == 0xDD); // poisoned
+  T_ASSERT(lp_pool_free(&p, o) == LP_ERR_INVALID); // double free
+  T_ASSERT(lp_pool_live(&p) == 0);
+}
+#endif
+
+// Threads churning the lock-free pool; every object must stay exclusive.
+#define MT_THREADS 4
+#define MT_ROUNDS  20000
+
+static lp_pool_mt g_mt;
+
+static void* mt_worker(void* arg) {
+  uint32_t id = (uint32_t)(uintptr_t)arg;
+  int bad = 0;
+  for (int r = 0; r < MT_ROUNDS; r++) {
+    void* o[3];
+    int got = 0;
+    for (; got < 3; got++) {
+      if (lp_pool_mt_alloc(&g_mt, &o[got]) != LP_OK) break;
+      *(volatile uint32_t*)((uint8_t*)o[got] + 4) = id;
+    }
+    for (int i = 0; i < got; i++) {
+      bad += (*(volatile uint32_t*)((uint8_t*)o[i] + 4) != id);
+      lp_pool_mt_free(&g_mt, o[i]);
+    }
+  }
+  return (void*)(uintptr_t)bad;
+}
+
+static void test_mt(void) {
+  static uint64_t mem[8 * 2];
+  void* o = NULL;
+  T_ASSERT(lp_pool_mt_init(&g_mt, mem, sizeof(mem), 16, 8) == LP_OK);
+  T_ASSERT(g_mt.count == 8);
+
+  pthread_t th[MT_THREADS];
+  for (uintptr_t i = 0; i < MT_THREADS; i++) pthread_create(&th[i], NULL, mt_worker, (void*)i);
+  for (int i = 0; i < MT_THREADS; i++) {
+    void* bad = NULL;
+    pthread_join(th[i], &bad);
+    T_ASSERT(bad == NULL);
+  }
+
+  // all 8 objects must be back
+  int n = 0;
+  while (lp_pool_mt_alloc(&g_mt, &o) == LP_OK) n++;
+  T_ASSERT(n == 8);
+  uint8_t other[16];
+  T_ASSERT(lp_pool_mt_free(&g_mt, other) == LP_ERR_INVALID); // not ours
+}
+
+int main(void) {
+  test_alloc_free();
+  test_arena_backed();
+#if LP_CFG_DEBUG
+  test_debug_checks();
+#endif
+  test_mt();
+  return g_fail ? 1 : 0;
+}
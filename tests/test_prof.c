@@ -0,0 +1,140 @@
+#if !defined(_POSIX_C_SOURCE)
+  #define _POSIX_C_SOURCE 200809L // nanosleep
+#endif
+#include "lp/lp.h"
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static LP_PORT_THREAD_LOCAL volatile uint64_t g_sink;
+
+static void sleep_ms(long ms) {
+  struct timespec ts = { 0, ms * 1000000L };
+  nanosleep(&ts, NULL);
+}
+
+static const lp_prof_stat* find(const lp_prof_stat* st, size_t n, const char* name) {
+  for (size_t i = 0; i < n; i++) {
+    if (lp_sv_eq(lp_sv(st[i].name), lp_sv(name))) return &st[i];
+  }
+  return NULL;
+}
+
+static void test_time(void) {
+  uint64_t t0 = lp_port_now_ns(), c0 = lp_port_cycles();
+  bool mono = true;
+  uint64_t prev = t0;
+  for (int i = 0; i < 1000; i++) {
+    uint64_t t = lp_port_now_ns();
+    mono &= t >= prev;
+    prev = t;
+  }
+  T_ASSERT(mono);
+  sleep_ms(20);
+  uint64_t t1 = lp_port_now_ns(), c1 = lp_port_cycles();
+  T_ASSERT(t1 - t0 >= 20000000u && t1 - t0 < 2000000000u);
+  T_ASSERT(lp_port_now_us() >= t1 / 1000u);
+
+  uint64_t hz = lp_port_cycles_per_sec();
+  T_ASSERT(hz > 0 && hz == lp_port_cycles_per_sec());
+  T_ASSERT(c1 > c0);
+  // the cycle counter agrees with the clock to within a wide margin
+  double secs = (double)(c1 - c0) / (double)hz;
+  double want = (double)(t1 - t0) * 1e-9;
+  T_ASSERT(secs > want * 0.5 && secs < want * 2.0);
+}
+
+static void work(uint32_t n) {
+  LP_PROF_BEGIN(work);
+  uint64_t x = 0;
+  for (uint32_t i = 0; i < n; i++) x += i * 2654435761u;
+  g_sink = x;
+  LP_PROF_END(work);
+}
+
+static void idle(void) {
+  LP_PROF_BEGIN(idle);
+  LP_PROF_END(idle);
+}
+
+static void test_probes(void) {
+  lp_prof_stat st[8];
+  T_ASSERT(lp_prof_snapshot(st, 8) == 0);
+  for (uint32_t i = 0; i < 100; i++) work(i == 50 ? 100000u : 10u);
+  idle();
+  size_t n = lp_prof_snapshot(st, 8);
+  T_ASSERT(n == 2);
+  const lp_prof_stat* w = find(st, n, "work");
+  const lp_prof_stat* z = find(st, n, "idle");
+  T_ASSERT(w && z);
+  if (!w || !z) return;
+  T_ASSERT(w == &st[0]); // registration order
+  T_ASSERT(w->calls == 100 && z->calls == 1);
+  T_ASSERT(w->max_cycles > 0 && w->cycles >= w->max_cycles);
+  T_ASSERT(w->max_cycles * 2u > w->cycles / 2u); // the long call dominates
+  T_ASSERT(lp_prof_snapshot(st, 1) == 1);
+  T_ASSERT(lp_prof_snapshot(NULL, 8) == 0);
+}
+
+// The test build allows 4 probe sites: a third and fourth fit, a fifth
+// is dropped.
+static void p3(void) { LP_PROF_BEGIN(p3); LP_PROF_END(p3); }
+static void p4(void) { LP_PROF_BEGIN(p4); LP_PROF_END(p4); }
+static void p5(void) { LP_PROF_BEGIN(p5); LP_PROF_END(p5); }
+
+static void test_probe_limit(void) {
+  p3();
+  p4();
+  p5();
+  p5();
+  lp_prof_stat st[8];
+  size_t n = lp_prof_snapshot(st, 8);
+  T_ASSERT(n == LP_CFG_PROF_MAX_PROBES);
+  T_ASSERT(find(st, n, "p4") && !find(st, n, "p5"));
+  T_ASSERT(lp_prof_dropped_probes() == 1);
+}
+
+// Main plus three workers fill the 4 thread slots; a fifth thread is not
+// counted.
+#define N_WORKERS 3
+#define PER_WORKER 10000u
+
+static void* worker(void* arg) {
+  (void)arg;
+  for (uint32_t i = 0; i < PER_WORKER; i++) work(1);
+  return NULL;
+}
+
+static void test_threads(void) {
+  lp_prof_stat st[8];
+  size_t n = lp_prof_snapshot(st, 8);
+  const lp_prof_stat* w = find(st, n, "work");
+  uint64_t before = w ? w->calls : 0;
+
+  pthread_t th[N_WORKERS];
+  for (int i = 0; i < N_WORKERS; i++) pthread_create(&th[i], NULL, worker, NULL);
+  for (int i = 0; i < N_WORKERS; i++) pthread_join(th[i], NULL);
+  n = lp_prof_snapshot(st, 8);
+  w = find(st, n, "work");
+  T_ASSERT(w && w->calls == before + N_WORKERS * PER_WORKER);
+  T_ASSERT(lp_prof_dropped_threads() == 0);
+
+  pthread_t extra;
+  pthread_create(&extra, NULL, worker, NULL);
+  pthread_join(extra, NULL);
+  n = lp_prof_snapshot(st, 8);
+  w = find(st, n, "work");
+  T_ASSERT(w && w->calls == before + N_WORKERS * PER_WORKER);
+  T_ASSERT(lp_prof_dropped_threads() == 1);
+}
+
+int main(void) {
+  test_time();
+  test_probes();
+  test_probe_limit();
+  test_threads();
+  return g_fail ? 1 : 0;
+}
@@ -0,0 +1,79 @@
+#include "lp/lp.h"
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static void test_push_pop(void) {
+  lp_ring r;
+  uint8_t mem[8];
+  uint8_t out[8];
+  lp_ring_init(&r, mem, sizeof(mem));
+
+  T_ASSERT(lp_ring_push(&r, "abcdef", 6) == LP_OK);
+  T_ASSERT(lp_ring_push(&r, "xyz", 3) == LP_ERR_FULL);
+  T_ASSERT(lp_ring_pop(&r, out, 4) == LP_OK);
+  T_ASSERT(out[0] == 'a' && out[3] == 'd');
+
+  T_ASSERT(lp_ring_push(&r, "123456", 6) == LP_OK); // wraps
+  T_ASSERT(lp_ring_len(&r) == 8);
+  T_ASSERT(lp_ring_free(&r) == 0);
+
+  T_ASSERT(lp_ring_pop(&r, out, 8) == LP_OK);
+  T_ASSERT(lp_sv_eq((lp_strview){ (const char*)out, 8 }, lp_sv("ef123456")));
+  T_ASSERT(lp_ring_pop(&r, out, 1) == LP_ERR_EMPTY);
+}
+
+static void test_reserve_commit(void) {
+  lp_ring r;
+  uint8_t mem[8];
+  lp_span_u8_mut w[2];
+  lp_span_u8 rd[2];
+  lp_ring_init(&r, mem, sizeof(mem));
+
+  // move head/tail to 5 so the next region wraps
+  T_ASSERT(lp_ring_push(&r, "xxxxx", 5) == LP_OK);
+  T_ASSERT(lp_ring_consume(&r, 5) == LP_OK);
+
+  T_ASSERT(lp_ring_reserve(&r, 9, w) == LP_ERR_FULL);
+  T_ASSERT(lp_ring_reserve(&r, lp_ring_free(&r), w) == LP_OK);
+  T_ASSERT(w[0].ptr == mem + 5 && w[0].len == 3);
+  T_ASSERT(w[1].ptr == mem && w[1].len == 5);
+
+  w[0].ptr[0] = 'a'; w[0].ptr[1] = 'b'; w[0].ptr[2] = 'c';
+  w[1].ptr[0] = 'd';
+  T_ASSERT(lp_ring_commit(&r, 4) == LP_OK);
+  T_ASSERT(lp_ring_len(&r) == 4);
+
+  T_ASSERT(lp_ring_peek(&r, 5, rd) == LP_ERR_EMPTY);
+  T_ASSERT(lp_ring_peek(&r, 4, rd) == LP_OK);
+  T_ASSERT(rd[0].len == 3 && rd[0].ptr[0] == 'a' && rd[0].ptr[2] == 'c');
+  T_ASSERT(rd[1].len == 1 && rd[1].ptr[0] == 'd');
+  T_ASSERT(lp_ring_len(&r) == 4); // peek doesn't consume
+
+  T_ASSERT(lp_ring_consume(&r, 3) == LP_OK);
+  T_ASSERT(lp_ring_peek(&r, lp_ring_len(&r), rd) == LP_OK);
+  T_ASSERT(rd[0].ptr == mem && rd[0].len == 1 && rd[1].len == 0);
+  T_ASSERT(lp_ring_consume(&r, 2) == LP_ERR_RANGE);
+  T_ASSERT(lp_ring_consume(&r, 1) == LP_OK);
+  T_ASSERT(lp_ring_len(&r) == 0);
+}
+
+static void test_commit_full(void) {
+  lp_ring r;
+  uint8_t mem[4];
+  lp_span_u8_mut w[2];
+  lp_ring_init(&r, mem, sizeof(mem));
+
+  T_ASSERT(lp_ring_reserve(&r, 4, w) == LP_OK);
+  T_ASSERT(w[0].len == 4 && w[1].len == 0);
+  T_ASSERT(lp_ring_commit(&r, 4) == LP_OK);
+  T_ASSERT(r.full == true && lp_ring_len(&r) == 4);
+  T_ASSERT(lp_ring_commit(&r, 1) == LP_ERR_RANGE);
+}
+
+int main(void) {
+  test_push_pop();
+  test_reserve_commit();
+  test_commit_full();
+  return g_fail ? 1 : 0;
+}
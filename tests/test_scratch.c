@@ -0,0 +1,122 @@
+#include "lp/lp.h"
+#include <pthread.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static void test_single_thread(void) {
+  static uint64_t mem[64]; // 512 bytes
+  lp_scratch s;
+  void* p = NULL;
+  void* q = NULL;
+
+  T_ASSERT(lp_scratch_init(&s, mem, sizeof(mem), sizeof(void*)) == LP_ERR_INVALID);
+  T_ASSERT(lp_scratch_init(&s, mem, sizeof(mem), 128) == LP_OK);
+
+  lp_arena_pos start = lp_scratch_mark(&s);
+  T_ASSERT(lp_scratch_alloc(&s, 200, 1, &p) == LP_ERR_RANGE);
+  T_ASSERT(lp_scratch_alloc(&s, 16, 16, &p) == LP_OK);
+  T_ASSERT(((uintptr_t)p & 15u) == 0);
+  T_ASSERT(lp_port_atomic_load(&s.next, LP_MO_RELAXED) == 128);
+
+  lp_arena_pos m = lp_scratch_mark(&s);
+  T_ASSERT(lp_scratch_alloc(&s, 100, 1, &q) == LP_OK); // second block
+  T_ASSERT(lp_port_atomic_load(&s.next, LP_MO_RELAXED) == 256);
+  lp_scratch_rewind(&s, m);
+
+  // rewound: the second block is reused rather than claimed again
+  T_ASSERT(lp_scratch_alloc(&s, 100, 1, &p) == LP_OK);
+  T_ASSERT(p == q);
+  T_ASSERT(lp_port_atomic_load(&s.next, LP_MO_RELAXED) == 256);
+
+  lp_scratch_rewind(&s, start);
+  T_ASSERT(lp_scratch_alloc(&s, 16, 16, &q) == LP_OK);
+  T_ASSERT((uintptr_t)q <= (uintptr_t)mem + 16 + 16);
+
+  // exhaust the region (4 blocks)
+  int n = 0;
+  while (lp_scratch_alloc(&s, 100, 1, &p) == LP_OK) n++;
+  T_ASSERT(n == 3);
+  // failed claims leave `next` at the end of the region
+  T_ASSERT(lp_port_atomic_load(&s.next, LP_MO_RELAXED) == 512);
+
+  lp_scratch_reset(&s);
+  T_ASSERT(lp_scratch_alloc(&s, 100, 1, &p) == LP_OK);
+  T_ASSERT(lp_port_atomic_load(&s.next, LP_MO_RELAXED) == 128);
+}
+
+// Each thread's blocks are private: writes from one never show up in another.
+#define MT_THREADS 4
+
+static lp_scratch g_s;
+
+static void* mt_worker(void* arg) {
+  uint8_t id = (uint8_t)(uintptr_t)arg;
+  uintptr_t bad = 0;
+  for (int round = 0; round < 2000; round++) {
+    lp_arena_pos m = lp_scratch_mark(&g_s);
+    uint8_t* ptrs[8];
+    for (int i = 0; i < 8; i++) {
+      void* p = NULL;
+      if (lp_scratch_alloc(&g_s, 40, 8, &p) != LP_OK) return (void*)(uintptr_t)1000;
+      ptrs[i] = (uint8_t*)p;
+      for (int k = 0; k < 40; k++) ptrs[i][k] = id;
+    }
+    for (int i = 0; i < 8; i++) {
+      for (int k = 0; k < 40; k++) bad += (ptrs[i][k] != id);
+    }
+    lp_scratch_rewind(&g_s, m);
+  }
+  return (void*)bad;
+}
+
+static void test_threads(void) {
+  static uint64_t mem[1024];
+  T_ASSERT(lp_scratch_init(&g_s, mem, sizeof(mem), 256) == LP_OK);
+
+  pthread_t th[MT_THREADS];
+  for (uintptr_t i = 0; i < MT_THREADS; i++) pthread_create(&th[i], NULL, mt_worker, (void*)(i + 1));
+  for (int i = 0; i < MT_THREADS; i++) {
+    void* bad = NULL;
+    pthread_join(th[i], &bad);
+    T_ASSERT(bad == NULL);
+  }
+  // 8 * 40B per round needs 2 blocks of 256B per thread, claimed once
+  T_ASSERT(lp_port_atomic_load(&g_s.next, LP_MO_RELAXED) == MT_THREADS * 2 * 256);
+}
+
+// Re-initialising a scratch drops every thread's cached blocks, even one
+// that never saw a reset: the block this thread held before must not be
+// shared with the next thread to claim.
+static void* reinit_worker(void* arg) {
+  (void)arg;
+  void* p = NULL;
+  if (lp_scratch_alloc(&g_s, 16, 8, &p) != LP_OK) return NULL;
+  return p;
+}
+
+static void test_reinit(void) {
+  static uint64_t mem[128]; // 4 blocks of 256B
+  void* p = NULL;
+  T_ASSERT(lp_scratch_init(&g_s, mem, sizeof(mem), 256) == LP_OK);
+  T_ASSERT(lp_scratch_alloc(&g_s, 16, 8, &p) == LP_OK);
+  T_ASSERT(lp_scratch_init(&g_s, mem, sizeof(mem), 256) == LP_OK);
+
+  pthread_t th;
+  void* q = NULL;
+  pthread_create(&th, NULL, reinit_worker, NULL);
+  pthread_join(th, &q);
+  T_ASSERT(lp_scratch_alloc(&g_s, 16, 8, &p) == LP_OK);
+  T_ASSERT(q != NULL);
+  size_t bp = (size_t)((uint8_t*)p - (uint8_t*)mem) / 256u;
+  size_t bq = (size_t)((uint8_t*)q - (uint8_t*)mem) / 256u;
+  T_ASSERT(bp != bq);
+  T_ASSERT(lp_port_atomic_load(&g_s.next, LP_MO_RELAXED) == 2u * 256u);
+}
+
+int main(void) {
+  test_single_thread();
+  test_threads();
+  test_reinit();
+  return g_fail ? 1 : 0;
+}
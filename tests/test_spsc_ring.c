@@ -0,0 +1,85 @@
+#include "lp/lp.h"
+#include <pthread.h>
+#include <sched.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static void test_init(void) {
+  lp_spsc_ring r;
+  uint8_t mem[16];
+
+  T_ASSERT(lp_spsc_ring_init(&r, mem, 12) == LP_ERR_INVALID); // not pow2
+  T_ASSERT(lp_spsc_ring_init(&r, mem, 0) == LP_ERR_INVALID);
+  T_ASSERT(lp_spsc_ring_init(&r, mem, sizeof(mem)) == LP_OK);
+  T_ASSERT(lp_spsc_ring_len(&r) == 0);
+  T_ASSERT(lp_spsc_ring_free(&r) == 16);
+}
+
+static void test_push_pop_wrap(void) {
+  lp_spsc_ring r;
+  uint8_t mem[8];
+  uint8_t out[8];
+  T_ASSERT(lp_spsc_ring_init(&r, mem, sizeof(mem)) == LP_OK);
+
+  T_ASSERT(lp_spsc_ring_push(&r, "abcdef", 6) == LP_OK);
+  T_ASSERT(lp_spsc_ring_push(&r, "xyz", 3) == LP_ERR_FULL);
+  T_ASSERT(lp_spsc_ring_pop(&r, out, 4) == LP_OK);
+  T_ASSERT(out[0] == 'a' && out[3] == 'd');
+
+  // wraps: head at 6, writes 6..7 then 0..3
+  T_ASSERT(lp_spsc_ring_push(&r, "123456", 6) == LP_OK);
+  T_ASSERT(lp_spsc_ring_len(&r) == 8);
+  T_ASSERT(lp_spsc_ring_push(&r, "!", 1) == LP_ERR_FULL);
+
+  T_ASSERT(lp_spsc_ring_pop(&r, out, 8) == LP_OK);
+  T_ASSERT(lp_sv_eq((lp_strview){ (const char*)out, 8 }, lp_sv("ef123456")));
+  T_ASSERT(lp_spsc_ring_pop(&r, out, 1) == LP_ERR_EMPTY);
+}
+
+// Two-thread stress: counter bytes must arrive in order
+#define STRESS_BYTES (1u << 20)
+
+static void* stress_producer(void* arg) {
+  lp_spsc_ring* r = (lp_spsc_ring*)arg;
+  uint8_t chunk[7];
+  uint32_t seq = 0;
+  while (seq < STRESS_BYTES) {
+    size_t n = sizeof(chunk);
+    if (STRESS_BYTES - seq < n) n = STRESS_BYTES - seq;
+    for (size_t i = 0; i < n; i++) chunk[i] = (uint8_t)(seq + i);
+    if (lp_spsc_ring_push(r, chunk, n) != LP_OK) { sched_yield(); continue; }
+    seq += (uint32_t)n;
+  }
+  return NULL;
+}
+
+static void test_two_threads(void) {
+  static uint8_t mem[4096];
+  lp_spsc_ring r;
+  T_ASSERT(lp_spsc_ring_init(&r, mem, sizeof(mem)) == LP_OK);
+
+  pthread_t th;
+  T_ASSERT(pthread_create(&th, NULL, stress_producer, &r) == 0);
+
+  uint8_t chunk[5];
+  uint32_t seq = 0;
+  int bad = 0;
+  while (seq < STRESS_BYTES) {
+    size_t n = sizeof(chunk);
+    if (STRESS_BYTES - seq < n) n = STRESS_BYTES - seq;
+    if (lp_spsc_ring_pop(&r, chunk, n) != LP_OK) { sched_yield(); continue; }
+    for (size_t i = 0; i < n; i++) bad += (chunk[i] != (uint8_t)(seq + i));
+    seq += (uint32_t)n;
+  }
+  pthread_join(th, NULL);
+  T_ASSERT(bad == 0);
+  T_ASSERT(lp_spsc_ring_len(&r) == 0);
+}
+
+int main(void) {
+  test_init();
+  test_push_pop_wrap();
+  test_two_threads();
+  return g_fail ? 1 : 0;
+}
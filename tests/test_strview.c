@@ -0,0 +1,236 @@
+#include "lp/lp.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+// Reference implementations, one byte at a time.
+
+static size_t ref_find_char(lp_strview s, char c) {
+  for (size_t i = 0; i < s.len; i++) if (s.ptr[i] == c) return i;
+  return LP_SV_NPOS;
+}
+
+static size_t ref_find(lp_strview s, lp_strview n) {
+  if (n.len > s.len) return LP_SV_NPOS;
+  for (size_t i = 0; i + n.len <= s.len; i++) {
+    if (memcmp(s.ptr + i, n.ptr, n.len) == 0) return i;
+  }
+  return LP_SV_NPOS;
+}
+
+static int sign(int v) { return (v > 0) - (v < 0); }
+
+static int ref_cmp_ci(lp_strview a, lp_strview b) {
+  size_t n = a.len < b.len ? a.len : b.len;
+  for (size_t i = 0; i < n; i++) {
+    int x = (unsigned char)a.ptr[i], y = (unsigned char)b.ptr[i];
+    if (x >= 'A' && x <= 'Z') x |= 0x20;
+    if (y >= 'A' && y <= 'Z') y |= 0x20;
+    if (x != y) return x < y ? -1 : 1;
+  }
+  return (a.len > b.len) - (a.len < b.len);
+}
+
+static void test_len_and_slices(void) {
+  // every start alignment and length, with junk after the NUL
+  char buf[96];
+  for (size_t off = 0; off < 16; off++) {
+    for (size_t len = 0; len < 64; len++) {
+      memset(buf, 'x', sizeof buf);
+      buf[off + len] = '\0';
+      T_ASSERT(lp_cstr_len(buf + off) == len);
+    }
+  }
+  T_ASSERT(lp_sv(NULL).len == 0);
+  T_ASSERT(lp_sv("abc").len == 3);
+
+  lp_strview s = lp_sv("hello world");
+  T_ASSERT(lp_sv_eq(lp_sv_sub(s, 6, 5), lp_sv("world")));
+  T_ASSERT(lp_sv_eq(lp_sv_sub(s, 6, 100), lp_sv("world")));
+  T_ASSERT(lp_sv_sub(s, 100, 5).len == 0);
+  T_ASSERT(lp_sv_starts_with(s, lp_sv("hello")));
+  T_ASSERT(!lp_sv_starts_with(s, lp_sv("world")));
+  T_ASSERT(lp_sv_ends_with(s, lp_sv("world")));
+  T_ASSERT(lp_sv_ends_with(s, lp_sv("")));
+  T_ASSERT(!lp_sv_ends_with(lp_sv("ld"), s));
+
+  T_ASSERT(lp_sv_eq(lp_sv_trim(lp_sv(" \t\r\n x y \v\f")), lp_sv("x y")));
+  T_ASSERT(lp_sv_eq(lp_sv_trim_left(lp_sv("  x ")), lp_sv("x ")));
+  T_ASSERT(lp_sv_eq(lp_sv_trim_right(lp_sv("  x ")), lp_sv("  x")));
+  T_ASSERT(lp_sv_trim(lp_sv("   ")).len == 0);
+}
+
+static void test_compare(void) {
+  T_ASSERT(lp_sv_eq(lp_sv(""), lp_sv_n(NULL, 0)));
+  T_ASSERT(lp_sv_cmp(lp_sv("abc"), lp_sv("abd")) < 0);
+  T_ASSERT(lp_sv_cmp(lp_sv("ab"), lp_sv("abc")) < 0);
+  T_ASSERT(lp_sv_cmp(lp_sv("b"), lp_sv("abc")) > 0);
+  T_ASSERT(lp_sv_cmp(lp_sv("\x80"), lp_sv("\x7f")) > 0); // unsigned bytes
+  T_ASSERT(lp_sv_eq_ci(lp_sv("Content-Length"), lp_sv("content-length")));
+  T_ASSERT(!lp_sv_eq_ci(lp_sv("Content-Length"), lp_sv("content-lengtH2")));
+  T_ASSERT(!lp_sv_eq_ci(lp_sv("@"), lp_sv("`"))); // 0x40/0x60 are not letters
+  T_ASSERT(!lp_sv_eq_ci(lp_sv("["), lp_sv("{")));
+  T_ASSERT(!lp_sv_eq_ci(lp_sv("\xC1"), lp_sv("\xE1")));
+  T_ASSERT(lp_sv_cmp_ci(lp_sv("ABC"), lp_sv("abd")) < 0);
+
+  // random pairs over letters and their neighbours, all lengths/alignments
+  static const char alpha[] = "aAzZ@[`{mM\x80\xC1\xE1 0";
+  char a[200], b[200];
+  for (int iter = 0; iter < 20000; iter++) {
+    size_t n = (size_t)(rnd64() % 80u);
+    size_t oa = (size_t)(rnd64() % 16u), ob = (size_t)(rnd64() % 16u);
+    for (size_t i = 0; i < n; i++) {
+      char c = alpha[rnd64() % (sizeof alpha - 1u)];
+      a[oa + i] = c;
+      // mostly the same letter, case flipped at random
+      if (rnd64() % 16u == 0) c = alpha[rnd64() % (sizeof alpha - 1u)];
+      else if (((c | 0x20) >= 'a' && (c | 0x20) <= 'z') && (rnd64() & 1u)) c ^= 0x20;
+      b[ob + i] = c;
+    }
+    size_t nb = n - (size_t)(rnd64() % 2u && n ? 1u : 0u);
+    lp_strview x = lp_sv_n(a + oa, n), y = lp_sv_n(b + ob, nb);
+    int want = ref_cmp_ci(x, y);
+    T_ASSERT(sign(lp_sv_cmp_ci(x, y)) == want);
+    T_ASSERT(lp_sv_eq_ci(x, y) == (want == 0));
+    int want_cs = (n == nb) ? sign(memcmp(x.ptr, y.ptr, n)) : 2;
+    if (want_cs != 2) T_ASSERT(sign(lp_sv_cmp(x, y)) == want_cs);
+  }
+}
+
+static void test_find(void) {
+  lp_strview s = lp_sv("GET /index.html HTTP/1.1\r\nHost: x\r\n\r\n");
+  T_ASSERT(lp_sv_find_char(s, ' ') == 3);
+  T_ASSERT(lp_sv_find_char(s, '#') == LP_SV_NPOS);
+  T_ASSERT(lp_sv_find(s, lp_sv("\r\n\r\n")) == s.len - 4);
+  T_ASSERT(lp_sv_find(s, lp_sv("HTTP/")) == 16);
+  T_ASSERT(lp_sv_find(s, lp_sv("")) == 0);
+  T_ASSERT(lp_sv_find(lp_sv("ab"), lp_sv("abc")) == LP_SV_NPOS);
+  T_ASSERT(lp_sv_find_char(lp_sv_n(NULL, 0), 'a') == LP_SV_NPOS);
+
+  // random haystacks over a small alphabet so matches are common, at every
+  // length up to a few vectors and at every alignment
+  char hay[400], nd[40];
+  for (int iter = 0; iter < 30000; iter++) {
+    size_t n = (size_t)(rnd64() % 300u);
+    size_t off = (size_t)(rnd64() % 32u);
+    uint32_t k = 2u + (uint32_t)(rnd64() % 3u);
+    for (size_t i = 0; i < n; i++) hay[off + i] = (char)('a' + rnd64() % k);
+    lp_strview h = lp_sv_n(hay + off, n);
+
+    char c = (char)('a' + rnd64() % (k + 1u));
+    T_ASSERT(lp_sv_find_char(h, c) == ref_find_char(h, c));
+
+    size_t m = 1u + (size_t)(rnd64() % 12u);
+    for (size_t i = 0; i < m; i++) nd[i] = (char)('a' + rnd64() % k);
+    lp_strview needle = lp_sv_n(nd, m);
+    T_ASSERT(lp_sv_find(h, needle) == ref_find(h, needle));
+    // a needle that is known to occur
+    if (n) {
+      size_t at = (size_t)(rnd64() % n);
+      needle = lp_sv_sub(h, at, m);
+      T_ASSERT(lp_sv_find(h, needle) == ref_find(h, needle));
+    }
+  }
+}
+
+static void test_find_any(void) {
+  lp_sv_charset ws, delims, hi;
+  lp_sv_charset_init(&ws, lp_sv(" \t\r\n"));
+  lp_sv_charset_init(&delims, lp_sv("=;,&"));
+  lp_sv_charset_init(&hi, lp_sv(",\xFF"));
+  T_ASSERT(ws.ascii && !hi.ascii);
+  T_ASSERT(lp_sv_charset_has(&ws, '\t') && !lp_sv_charset_has(&ws, 'a'));
+  T_ASSERT(lp_sv_charset_has(&hi, (char)0xFF));
+
+  T_ASSERT(lp_sv_find_any(lp_sv("key=value"), &delims) == 3);
+  T_ASSERT(lp_sv_find_any(lp_sv("keyvalue"), &delims) == LP_SV_NPOS);
+
+  const lp_sv_charset* sets[3] = { &ws, &delims, &hi };
+  char buf[300];
+  for (int iter = 0; iter < 20000; iter++) {
+    const lp_sv_charset* cs = sets[rnd64() % 3u];
+    size_t n = (size_t)(rnd64() % 200u);
+    size_t off = (size_t)(rnd64() % 32u);
+    for (size_t i = 0; i < n; i++) {
+      // sparse hits, plus bytes that share a nibble with the set members
+      uint64_t r = rnd64() % 64u;
+      buf[off + i] = (char)(r == 0 ? " \t=;,&\xFF"[rnd64() % 7u] : r < 8 ? (char)(rnd64() & 0xFFu) : 'a' + (char)(r % 26u));
+    }
+    lp_strview s = lp_sv_n(buf + off, n);
+    size_t want = LP_SV_NPOS;
+    for (size_t i = 0; i < n; i++) {
+      if (lp_sv_charset_has(cs, s.ptr[i])) { want = i; break; }
+    }
+    T_ASSERT(lp_sv_find_any(s, cs) == want);
+  }
+}
+
+static size_t collect(lp_sv_split it, lp_strview* out, size_t cap) {
+  size_t n = 0;
+  lp_strview tok;
+  while (lp_sv_split_next(&it, &tok)) {
+    if (n < cap) out[n] = tok;
+    n++;
+  }
+  return n;
+}
+
+static void test_split(void) {
+  lp_strview t[8];
+
+  T_ASSERT(collect(lp_sv_split_on(lp_sv("a,,b,"), ',', 0), t, 8) == 4);
+  T_ASSERT(lp_sv_eq(t[0], lp_sv("a")) && t[1].len == 0 && lp_sv_eq(t[2], lp_sv("b")) && t[3].len == 0);
+  T_ASSERT(collect(lp_sv_split_on(lp_sv(""), ',', 0), t, 8) == 1 && t[0].len == 0);
+  T_ASSERT(collect(lp_sv_split_on(lp_sv("abc"), ',', 0), t, 8) == 1 && lp_sv_eq(t[0], lp_sv("abc")));
+
+  T_ASSERT(collect(lp_sv_split_on(lp_sv(",,a,,b,"), ',', LP_SV_SPLIT_SKIP_EMPTY), t, 8) == 2);
+  T_ASSERT(lp_sv_eq(t[0], lp_sv("a")) && lp_sv_eq(t[1], lp_sv("b")));
+  T_ASSERT(collect(lp_sv_split_on(lp_sv(",,,"), ',', LP_SV_SPLIT_SKIP_EMPTY), t, 8) == 0);
+
+  lp_sv_charset ws;
+  lp_sv_charset_init(&ws, lp_sv(" \t\r\n"));
+  lp_strview line = lp_sv("  GET\t/a/b  HTTP/1.1\r\n");
+  T_ASSERT(collect(lp_sv_split_any(line, &ws, LP_SV_SPLIT_SKIP_EMPTY), t, 8) == 3);
+  T_ASSERT(lp_sv_eq(t[0], lp_sv("GET")) && lp_sv_eq(t[1], lp_sv("/a/b")) && lp_sv_eq(t[2], lp_sv("HTTP/1.1")));
+  // tokens point into the input
+  T_ASSERT(t[0].ptr == line.ptr + 2);
+
+  // done stays done
+  lp_sv_split it = lp_sv_split_on(lp_sv("x"), ',', 0);
+  lp_strview tok;
+  T_ASSERT(lp_sv_split_next(&it, &tok) && !lp_sv_split_next(&it, &tok) && !lp_sv_split_next(&it, &tok));
+
+  // a long line exercises the vector paths between separators
+  char big[2000];
+  size_t len = 0, expect = 0;
+  for (int i = 0; i < 50; i++) {
+    size_t w = (size_t)(rnd64() % 60u);
+    memset(big + len, 'k', w);
+    len += w;
+    big[len++] = ';';
+    expect++;
+  }
+  T_ASSERT(collect(lp_sv_split_on(lp_sv_n(big, len), ';', 0), t, 8) == expect + 1u);
+}
+
+int main(void) {
+  test_len_and_slices();
+  test_compare();
+  test_find();
+  test_find_any();
+  test_split();
+  return g_fail ? 1 : 0;
+}
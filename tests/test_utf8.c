@@ -0,0 +1,243 @@
+#include "lp/lp.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static int g_fail = 0;
+#define T_ASSERT(expr) do { if (!(expr)) { g_fail++; } } while (0)
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+
+static uint64_t rnd64(void) {
+  g_rng ^= g_rng << 13;
+  g_rng ^= g_rng >> 7;
+  g_rng ^= g_rng << 17;
+  return g_rng;
+}
+
+// Reference: decode each code point and check its value, rather than the
+// byte ranges the library uses.
+static size_t ref_valid_len(const uint8_t* p, size_t n) {
+  static const uint32_t min_cp[5] = { 0, 0, 0x80u, 0x800u, 0x10000u };
+  size_t i = 0;
+  while (i < n) {
+    uint8_t b = p[i];
+    size_t len;
+    uint32_t cp;
+    if (b < 0x80u) { i++; continue; }
+    if ((b & 0xE0u) == 0xC0u) { len = 2; cp = b & 0x1Fu; }
+    else if ((b & 0xF0u) == 0xE0u) { len = 3; cp = b & 0x0Fu; }
+    else if ((b & 0xF8u) == 0xF0u) { len = 4; cp = b & 0x07u; }
+    else return i;
+    if (n - i < len) return i;
+    for (size_t k = 1; k < len; k++) {
+      if ((p[i + k] & 0xC0u) != 0x80u) return i;
+      cp = (cp << 6) | (p[i + k] & 0x3Fu);
+    }
+    if (cp < min_cp[len] || cp > 0x10FFFFu || (cp >= 0xD800u && cp <= 0xDFFFu)) return i;
+    i += len;
+  }
+  return n;
+}
+
+static size_t ref_count(const uint8_t* p, size_t n) {
+  size_t c = 0;
+  for (size_t i = 0; i < n; i++) c += ((p[i] & 0xC0u) != 0x80u);
+  return c;
+}
+
+// Encodes any value up to 21 bits, including ones that are not valid.
+static size_t encode(uint32_t cp, uint8_t* out) {
+  if (cp < 0x80u) { out[0] = (uint8_t)cp; return 1; }
+  if (cp < 0x800u) {
+    out[0] = (uint8_t)(0xC0u | (cp >> 6));
+    out[1] = (uint8_t)(0x80u | (cp & 0x3Fu));
+    return 2;
+  }
+  if (cp < 0x10000u) {
+    out[0] = (uint8_t)(0xE0u | (cp >> 12));
+    out[1] = (uint8_t)(0x80u | ((cp >> 6) & 0x3Fu));
+    out[2] = (uint8_t)(0x80u | (cp & 0x3Fu));
+    return 3;
+  }
+  out[0] = (uint8_t)(0xF0u | (cp >> 18));
+  out[1] = (uint8_t)(0x80u | ((cp >> 12) & 0x3Fu));
+  out[2] = (uint8_t)(0x80u | ((cp >> 6) & 0x3Fu));
+  out[3] = (uint8_t)(0x80u | (cp & 0x3Fu));
+  return 4;
+}
+
+static uint32_t random_scalar(void) {
+  static const uint32_t edges[] = { 0x7Fu, 0x80u, 0x7FFu, 0x800u, 0xD7FFu, 0xE000u, 0xFFFDu, 0xFFFFu, 0x10000u, 0x10FFFFu };
+  switch (rnd64() % 5u) {
+    case 0: return edges[rnd64() % (sizeof edges / sizeof edges[0])];
+    case 1: return 0x80u + (uint32_t)(rnd64() % 0x780u);
+    case 2: {
+      uint32_t cp = 0x800u + (uint32_t)(rnd64() % 0xF800u);
+      return (cp >= 0xD800u && cp <= 0xDFFFu) ? cp - 0x800u : cp;
+    }
+    case 3: return 0x10000u + (uint32_t)(rnd64() % 0x100000u);
+    default: return (uint32_t)(rnd64() % 0x80u);
+  }
+}
+
+// Mostly valid text in runs of ASCII and multibyte characters; with
+// `corrupt`, an occasional bad sequence. Returns the length.
+static size_t random_text(uint8_t* out, size_t cap, bool corrupt) {
+  size_t n = 0;
+  while (n + 8u < cap && rnd64() % 40u != 0) {
+    if (rnd64() % 3u == 0) {
+      size_t run = (size_t)(rnd64() % 70u);
+      for (size_t i = 0; i < run && n + 8u < cap; i++) out[n++] = (uint8_t)(' ' + rnd64() % 90u);
+      continue;
+    }
+    if (!corrupt || rnd64() % 12u != 0) {
+      n += encode(random_scalar(), out + n);
+      continue;
+    }
+    uint8_t seq[4];
+    switch (rnd64() % 6u) {
+      case 0: out[n++] = (uint8_t)(0x80u + rnd64() % 0x80u); break;             // stray or bad lead
+      case 1: out[n++] = (uint8_t)(0xC2u + rnd64() % 0x33u); out[n++] = 'x'; break; // lead, no continuation
+      case 2: n += encode(0xD800u + (uint32_t)(rnd64() % 0x800u), out + n); break; // surrogate
+      case 3: n += encode(0x110000u + (uint32_t)(rnd64() % 0xEFFFFu), out + n); break; // too large
+      case 4: {                                                                  // overlong
+        uint32_t cp = (uint32_t)(rnd64() % 0x80u);
+        out[n++] = (uint8_t)(0xC0u | (cp >> 6));
+        out[n++] = (uint8_t)(0x80u | (cp & 0x3Fu));
+        break;
+      }
+      default: {                                                                 // cut short
+        size_t len = encode(0x800u + (uint32_t)(rnd64() % 0x100000u), seq);
+        size_t keep = 1u + (size_t)(rnd64() % (len - 1u));
+        memcpy(out + n, seq, keep);
+        n += keep;
+        break;
+      }
+    }
+  }
+  return n;
+}
+
+static bool valid(const char* s, size_t n) {
+  return lp_utf8_validate(lp_sv_n(s, n)) == LP_OK;
+}
+
+static void test_known(void) {
+  T_ASSERT(lp_utf8_validate(lp_sv("")) == LP_OK);
+  T_ASSERT(lp_utf8_validate(lp_sv_n(NULL, 0)) == LP_OK);
+  T_ASSERT(lp_utf8_validate(lp_sv_n(NULL, 1)) == LP_ERR_INVALID);
+  T_ASSERT(lp_utf8_validate(lp_sv("plain ascii")) == LP_OK);
+  T_ASSERT(lp_utf8_validate(lp_sv("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80")) == LP_OK);
+
+  // Table 3-7 edges, each on its own and buried in a long ASCII run
+  static const char* const good[] = {
+    "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80",
+    "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF",
+  };
+  static const char* const bad[] = {
+    "\x80", "\xBF", "\xC0\x80", "\xC1\xBF", "\xC2", "\xC2\x41", "\xE0\x9F\xBF",
+    "\xED\xA0\x80", "\xED\xBF\xBF", "\xE1\x80", "\xE1\x80\x41", "\xF0\x8F\xBF\xBF",
+    "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80", "\xFF",
+    "\xF1\x80\x80", "\xC2\x80\x80",
+  };
+  char buf[200];
+  for (size_t g = 0; g < sizeof good / sizeof good[0]; g++) {
+    size_t m = strlen(good[g]);
+    T_ASSERT(valid(good[g], m));
+    for (size_t pos = 0; pos + m <= 150; pos++) {
+      memset(buf, 'a', 150);
+      memcpy(buf + pos, good[g], m);
+      T_ASSERT(valid(buf, 150));
+      T_ASSERT(lp_utf8_count(lp_sv_n(buf, 150)) == 150u - m + 1u);
+    }
+  }
+  for (size_t b = 0; b < sizeof bad / sizeof bad[0]; b++) {
+    size_t m = strlen(bad[b]);
+    T_ASSERT(!valid(bad[b], m));
+    T_ASSERT(lp_utf8_valid_len(lp_sv_n(bad[b], m)) == ref_valid_len((const uint8_t*)bad[b], m));
+    for (size_t pos = 0; pos + m <= 150; pos++) {
+      memset(buf, 'a', 150);
+      memcpy(buf + pos, bad[b], m);
+      T_ASSERT(!valid(buf, 150));
+      T_ASSERT(lp_utf8_valid_len(lp_sv_n(buf, 150)) == ref_valid_len((const uint8_t*)buf, 150));
+    }
+  }
+
+  // a sequence left open at the end of a block, then a block of ASCII
+  memset(buf, 'a', 192);
+  buf[63] = (char)0xE2;
+  T_ASSERT(!valid(buf, 192));
+  T_ASSERT(lp_utf8_valid_len(lp_sv_n(buf, 192)) == 63u);
+  buf[63] = (char)0xC3;
+  buf[64] = (char)0xA9;
+  T_ASSERT(valid(buf, 192));
+}
+
+static void test_random(void) {
+  uint8_t buf[600];
+  for (int iter = 0; iter < 40000; iter++) {
+    size_t off = (size_t)(rnd64() % 32u);
+    size_t n = random_text(buf + off, sizeof buf - 32u, (iter & 1) != 0);
+    const uint8_t* p = buf + off;
+    lp_strview s = lp_sv_n((const char*)p, n);
+    size_t ref = ref_valid_len(p, n);
+
+    T_ASSERT((lp_utf8_validate(s) == LP_OK) == (ref == n));
+    T_ASSERT(lp_utf8_valid_len(s) == ref);
+    T_ASSERT(lp_utf8_count(s) == ref_count(p, n));
+
+    // every prefix of a valid string: valid exactly at character boundaries
+    if (ref == n && (iter & 6) == 0) {
+      for (size_t k = 0; k <= n; k++) {
+        bool boundary = (k == n) || (p[k] & 0xC0u) != 0x80u;
+        T_ASSERT(valid((const char*)p, k) == boundary);
+      }
+    }
+  }
+}
+
+static void test_count_long(void) {
+  // long enough for the per-byte SIMD counters to be flushed many times
+  static char big[30001];
+  for (size_t i = 0; i < 30000; i += 3) memcpy(big + i, "\xE2\x82\xAC", 3);
+  for (size_t n = 29000; n <= 30000; n += 97) {
+    T_ASSERT(lp_utf8_count(lp_sv_n(big, n)) == ref_count((const uint8_t*)big, n));
+  }
+  T_ASSERT(lp_utf8_count(lp_sv_n(big, 30000)) == 10000u);
+  T_ASSERT(lp_utf8_validate(lp_sv_n(big, 30000)) == LP_OK);
+  T_ASSERT(lp_utf8_validate(lp_sv_n(big, 29999)) == LP_ERR_INVALID);
+  T_ASSERT(lp_utf8_valid_len(lp_sv_n(big, 29999)) == 29997u);
+  memset(big, 0x80, 30000); // every byte a continuation: counters run full
+  T_ASSERT(lp_utf8_count(lp_sv_n(big, 30000)) == 0u);
+}
+
+static void test_truncate(void) {
+  uint8_t buf[300];
+  for (int iter = 0; iter < 3000; iter++) {
+    size_t n = random_text(buf, sizeof buf, false);
+    lp_strview s = lp_sv_n((const char*)buf, n);
+    for (size_t k = 0; k <= n + 2u; k++) {
+      lp_strview t = lp_utf8_truncate(s, k);
+      size_t want = (k >= n) ? n : k;
+      while (want < n && (buf[want] & 0xC0u) == 0x80u) want--;
+      T_ASSERT(t.ptr == s.ptr && t.len == want);
+      T_ASSERT(lp_utf8_validate(t) == LP_OK);
+    }
+  }
+
+  // not UTF-8: cut where asked
+  const char stray[] = "ab\x80\x80\x80\x80";
+  T_ASSERT(lp_utf8_truncate(lp_sv(stray), 4).len == 4u);
+  const char done[] = "\xC3\xA9\x80";
+  T_ASSERT(lp_utf8_truncate(lp_sv(done), 2).len == 2u);
+  T_ASSERT(lp_utf8_truncate(lp_sv("\xE2\x82\xAC"), 2).len == 0u);
+}
+
+int main(void) {
+  test_known();
+  test_random();
+  test_count_long();
+  test_truncate();
+  return g_fail ? 1 : 0;
+}